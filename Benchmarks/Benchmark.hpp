@@ -0,0 +1,28 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+namespace acid::test {
+/**
+ * Times a function, when it is run more than once the fastest run is kept so runs slowed by the rest of the system are not counted.
+ * @tparam Function The type of the function.
+ * @param function The function to time.
+ * @param runs The number of times to run the function.
+ * @return The milliseconds the fastest run took.
+ */
+template<typename Function>
+double Measure(Function &&function, uint32_t runs = 1) {
+	auto best = std::numeric_limits<double>::max();
+
+	for (uint32_t run = 0; run < runs; run++) {
+		auto start = std::chrono::steady_clock::now();
+		function();
+		best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+	}
+
+	return best;
+}
+}
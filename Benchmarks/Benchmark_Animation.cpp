@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <iostream>
+
+#include <Animations/Animator.hpp>
+#include <Helpers/ThreadPool.hpp>
+
+#include "Animations.hpp"
+#include "Benchmark.hpp"
+
+TEST(Animation, crowd) {
+	constexpr uint32_t JointCount = 50;
+	constexpr uint32_t CharacterCount = 500;
+	constexpr uint32_t FrameCount = 10;
+	auto headJoint = acid::test::CreateSkeleton(JointCount);
+	acid::Skeleton skeleton(headJoint);
+	auto animation = acid::test::CreateAnimation(JointCount, 30, 1.0f);
+	acid::CompiledAnimation compiled(animation, skeleton);
+
+	// Characters start at different times, so they sample different keyframes.
+	std::vector<acid::Time> times(CharacterCount);
+	std::vector<acid::Animator> animators(CharacterCount);
+	std::vector<std::vector<acid::Matrix4>> jointMatrices(CharacterCount, std::vector<acid::Matrix4>(JointCount));
+
+	for (uint32_t i = 0; i < CharacterCount; i++) {
+		animators[i].DoAnimation(&compiled);
+		animators[i].IncreaseAnimationTime(acid::Time::Seconds(0.013f * static_cast<float>(i)));
+		times[i] = animators[i].GetAnimationTime();
+	}
+
+	// Characters updated per millisecond, over a few frames.
+	auto rate = [&](auto &&update) {
+		return CharacterCount * FrameCount / acid::test::Measure([&]() {
+			for (uint32_t frame = 0; frame < FrameCount; frame++)
+				update();
+		});
+	};
+
+	auto reference = rate([&]() {
+		for (uint32_t i = 0; i < CharacterCount; i++) {
+			times[i] = acid::Time::Seconds(std::fmod((times[i] + acid::Time::Seconds(1.0f / 60.0f)).AsSeconds(), 1.0f));
+			acid::test::ReferenceUpdate(animation, times[i], headJoint, jointMatrices[i]);
+		}
+	});
+	auto serial = rate([&]() {
+		for (uint32_t i = 0; i < CharacterCount; i++)
+			animators[i].Update(acid::Time::Seconds(1.0f / 60.0f), skeleton, jointMatrices[i]);
+	});
+
+	acid::ThreadPool pool;
+	auto parallel = rate([&]() {
+		pool.ParallelFor(0, CharacterCount, [&](std::size_t i) {
+			animators[i].Update(acid::Time::Seconds(1.0f / 60.0f), skeleton, jointMatrices[i]);
+		});
+	});
+
+	std::cout << CharacterCount << " characters with " << JointCount << " joints: map based " << reference << ", compiled " << serial
+		<< ", compiled across " << pool.GetWorkers().size() << " workers " << parallel << " characters per ms\n";
+	EXPECT_GT(serial, reference);
+}
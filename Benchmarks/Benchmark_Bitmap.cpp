@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+#include <Bitmaps/Bitmap.hpp>
+
+#include "Benchmark.hpp"
+#include "Textures.hpp"
+
+static const std::filesystem::path BitmapPath = std::filesystem::temp_directory_path() / "AcidBenchmarkBitmaps";
+
+TEST(Bitmap, loadAll) {
+	// A level worth of textures.
+	constexpr uint32_t TextureCount = 32;
+	constexpr uint32_t TextureSize = 512;
+
+	std::filesystem::create_directories(BitmapPath);
+	std::vector<std::filesystem::path> filenames;
+
+	for (uint32_t i = 0; i < TextureCount; i++) {
+		filenames.emplace_back(BitmapPath / ("Texture" + std::to_string(i) + ".png"));
+		acid::test::CreateBitmap(TextureSize, i)->Write(filenames.back());
+	}
+
+	std::vector<std::unique_ptr<acid::Bitmap>> serial, parallel;
+	auto serialElapsed = acid::test::Measure([&]() {
+		serial = acid::Bitmap::LoadAll(filenames);
+	});
+
+	acid::ThreadPool pool;
+	auto parallelElapsed = acid::test::Measure([&]() {
+		parallel = acid::Bitmap::LoadAll(filenames, &pool);
+	});
+
+	EXPECT_EQ(parallel.size(), TextureCount);
+	std::cout << TextureCount << " " << TextureSize << "x" << TextureSize << " png textures: loaded serially in " << serialElapsed << "ms, across "
+		<< pool.GetWorkers().size() << " workers in " << parallelElapsed << "ms\n";
+
+	std::filesystem::remove_all(BitmapPath);
+}
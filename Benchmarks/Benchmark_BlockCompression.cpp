@@ -0,0 +1,33 @@
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+#include <Bitmaps/BlockCompression.hpp>
+
+#include "Benchmark.hpp"
+#include "Textures.hpp"
+
+using Format = acid::BlockCompression::Format;
+
+TEST(BlockCompression, encode) {
+	acid::Vector2ui size(512, 512);
+	auto pixels = acid::test::CreateTexture(size, 11);
+	acid::ThreadPool pool;
+
+	for (auto [format, name] : {std::pair(Format::Bc1, "BC1"), std::pair(Format::Bc3, "BC3"), std::pair(Format::Bc5, "BC5"), std::pair(Format::Bc7, "BC7")}) {
+		std::vector<uint8_t> serial, parallel;
+		auto serialElapsed = acid::test::Measure([&]() {
+			serial = acid::BlockCompression::Encode(format, pixels.data(), size);
+		});
+		auto parallelElapsed = acid::test::Measure([&]() {
+			parallel = acid::BlockCompression::Encode(format, pixels.data(), size, &pool);
+		});
+
+		std::vector<uint8_t> decoded(pixels.size());
+		acid::BlockCompression::Decode(format, serial.data(), size, decoded.data());
+
+		std::cout << name << ' ' << size.m_x << 'x' << size.m_y << ": " << serial.size() / 1024 << "KiB (" << pixels.size() / serial.size()
+			<< ":1 of RGBA8), encoded in " << serialElapsed << "ms on one thread, " << parallelElapsed << "ms across " << pool.GetWorkers().size()
+			<< " workers, RMS error " << acid::test::RmsError(pixels, decoded, format == Format::Bc5 ? 0b0011 : format == Format::Bc1 ? 0b0111 : 0b1111) << '\n';
+	}
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <random>
+
+#include <Meshes/DrawList.hpp>
+#include <Maths/Vector3.hpp>
+
+#include "Benchmark.hpp"
+
+namespace {
+// How meshes were found before, a entity with components that were looked up with a dynamic cast.
+class Component {
+public:
+	virtual ~Component() = default;
+};
+
+class Position : public Component {
+public:
+	explicit Position(const acid::Vector3f &position) : m_position(position) {}
+	acid::Vector3f m_position;
+};
+
+class Other : public Component {
+};
+
+class Item {
+public:
+	template<typename T>
+	T *GetComponent() const {
+		for (const auto &component : m_components) {
+			if (auto casted = dynamic_cast<T *>(component.get()))
+				return casted;
+		}
+		return nullptr;
+	}
+
+	std::vector<std::unique_ptr<Component>> m_components;
+	int *m_pipeline;
+	int *m_model;
+};
+}
+
+static bool IsSorted(const acid::DrawList &drawList) {
+	return std::is_sorted(drawList.GetDraws().begin(), drawList.GetDraws().end(), [](const auto &a, const auto &b) {
+		return a.m_key < b.m_key;
+	});
+}
+
+TEST(DrawList, sort) {
+	constexpr std::size_t Count = 50000;
+	std::mt19937 random(29);
+	std::uniform_real_distribution<float> distribution(-500.0f, 500.0f);
+	std::uniform_int_distribution<std::size_t> stateDistribution(0, 7);
+	int pipelines[8]{}, models[8]{};
+
+	std::vector<std::unique_ptr<Item>> items;
+	for (std::size_t i = 0; i < Count; i++) {
+		auto item = std::make_unique<Item>();
+		item->m_components.emplace_back(std::make_unique<Other>());
+		item->m_components.emplace_back(std::make_unique<Position>(acid::Vector3f(distribution(random), distribution(random), distribution(random))));
+		item->m_pipeline = &pipelines[stateDistribution(random)];
+		item->m_model = &models[stateDistribution(random)];
+		items.emplace_back(std::move(item));
+	}
+
+	std::vector<Item *> pointers;
+	for (const auto &item : items)
+		pointers.emplace_back(item.get());
+
+	acid::Vector3f camera;
+
+	// Before, every comparison looked up both components and calculated both distances.
+	auto comparatorTime = acid::test::Measure([&]() {
+		std::sort(pointers.begin(), pointers.end(), [&](const Item *a, const Item *b) {
+			return (camera - a->GetComponent<Position>()->m_position).LengthSquared() > (camera - b->GetComponent<Position>()->m_position).LengthSquared();
+		});
+	});
+
+	std::vector<uint64_t> keys(Count);
+	auto buildKeys = [&]() {
+		for (std::size_t i = 0; i < Count; i++) {
+			auto depth = (camera - items[i]->GetComponent<Position>()->m_position).LengthSquared();
+			keys[i] = acid::DrawList::CreateKey(items[i]->m_pipeline, items[i]->m_model, depth, acid::DrawList::Order::BackToFront);
+		}
+	};
+
+	acid::DrawList drawList;
+	auto keysTime = acid::test::Measure(buildKeys);
+	auto radixTime = acid::test::Measure([&]() {
+		drawList.Sort(keys);
+	});
+	EXPECT_TRUE(IsSorted(drawList));
+
+	// The next frames the camera is still and then moves a little, so few draws change places.
+	auto resort = [&]() {
+		buildKeys();
+		auto time = acid::test::Measure([&]() {
+			drawList.Resort(keys);
+		});
+		EXPECT_TRUE(IsSorted(drawList));
+		return time;
+	};
+
+	auto stillTime = resort();
+	camera = {0.01f, 0.0f, 0.005f};
+	auto movedTime = resort();
+
+	std::cout << Count << " meshes: comparator lookups " << comparatorTime << "ms, building keys " << keysTime << "ms, radix sort " << radixTime
+		<< "ms, resorting with a still camera " << stillTime << "ms and a moving camera " << movedTime << "ms\n";
+	EXPECT_LT(keysTime + radixTime, comparatorTime);
+}
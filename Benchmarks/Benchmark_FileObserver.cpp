@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#include <Files/FileObserver.hpp>
+
+#include "Benchmark.hpp"
+#include "ChangeLog.hpp"
+
+using namespace std::chrono_literals;
+
+static const std::filesystem::path ObserverPath = std::filesystem::temp_directory_path() / "AcidBenchmarkFileObserver";
+
+TEST(FileObserver, watch) {
+	// A large content tree, where a few files change at a time.
+	constexpr std::size_t FileCount = 20000;
+	constexpr std::size_t ModifyCount = 10;
+	std::filesystem::remove_all(ObserverPath);
+
+	for (std::size_t i = 0; i < FileCount; i++) {
+		auto filename = ObserverPath / ("Folder" + std::to_string(i % 200)) / ("File" + std::to_string(i) + ".txt");
+		std::filesystem::create_directories(filename.parent_path());
+		std::ofstream(filename) << i;
+	}
+
+	auto watch = [&](acid::FileObserver::Backend backend, double &cpu, double &latency) {
+		acid::test::ChangeLog changes;
+		acid::FileObserver observer(ObserverPath, 500ms, backend, 20ms);
+		changes.Listen(observer);
+
+		// The CPU time used by the process while nothing changes, the test thread sleeps.
+		auto cpuStart = std::clock();
+		auto wallElapsed = acid::test::Measure([]() {
+			std::this_thread::sleep_for(2s);
+		});
+		cpu = 1000.0 * static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC / wallElapsed;
+
+		latency = 0.0;
+		for (std::size_t i = 0; i < ModifyCount; i++) {
+			auto index = i * 1999;
+			auto filename = ObserverPath / ("Folder" + std::to_string(index % 200)) / ("File" + std::to_string(index) + ".txt");
+			latency += acid::test::Measure([&]() {
+				std::ofstream(filename) << "modified " << i;
+				EXPECT_EQ(changes.Wait(filename), acid::FileObserver::Status::Modified);
+			}) / ModifyCount;
+		}
+	};
+
+	double pollingCpu, pollingLatency, inotifyCpu, inotifyLatency;
+	watch(acid::FileObserver::Backend::Polling, pollingCpu, pollingLatency);
+	watch(acid::FileObserver::Backend::Inotify, inotifyCpu, inotifyLatency);
+
+	std::cout << FileCount << " files: polling every 500ms uses " << pollingCpu * 100.0 << "% of a core with " << pollingLatency
+		<< "ms latency, inotify with a 20ms debounce uses " << inotifyCpu * 100.0 << "% of a core with " << inotifyLatency << "ms latency\n";
+
+	std::filesystem::remove_all(ObserverPath);
+}
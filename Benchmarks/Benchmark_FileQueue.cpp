@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+#if defined(ACID_BUILD_LINUX)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <Bitmaps/Bitmap.hpp>
+#include <Files/FileQueue.hpp>
+
+#include "Benchmark.hpp"
+#include "Textures.hpp"
+
+static const std::filesystem::path QueuePath = std::filesystem::temp_directory_path() / "AcidBenchmarkFileQueue";
+
+// Drops the files from the page cache, so reads go to the disk.
+static void EvictFiles(const std::vector<std::filesystem::path> &filenames) {
+#if defined(ACID_BUILD_LINUX)
+	for (const auto &filename : filenames) {
+		auto fd = open(filename.c_str(), O_RDONLY);
+		if (fd < 0)
+			continue;
+		fdatasync(fd);
+		posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+		close(fd);
+	}
+#endif
+}
+
+TEST(FileQueue, load) {
+	// A level's worth of textures, read from disk and decoded.
+	constexpr std::size_t FileCount = 64;
+	constexpr uint32_t Size = 256;
+	std::filesystem::create_directories(QueuePath);
+
+	std::vector<std::filesystem::path> filenames;
+	std::size_t totalLength = 0;
+	for (std::size_t i = 0; i < FileCount; i++) {
+		filenames.emplace_back(QueuePath / ("Texture" + std::to_string(i) + ".png"));
+		acid::test::CreateBitmap(Size, static_cast<uint32_t>(i))->Write(filenames.back());
+		totalLength += std::filesystem::file_size(filenames.back());
+	}
+
+	acid::ThreadPool pool;
+
+	auto load = [&](auto &&loadAll) {
+		EvictFiles(filenames);
+		std::vector<std::unique_ptr<acid::Bitmap>> bitmaps(FileCount);
+		auto elapsed = acid::test::Measure([&]() {
+			loadAll(bitmaps);
+		});
+
+		for (const auto &bitmap : bitmaps)
+			EXPECT_TRUE(bitmap && *bitmap && bitmap->GetSize() == acid::Vector2ui(Size, Size));
+		return elapsed;
+	};
+
+	// Each file is read and then decoded on the calling thread.
+	auto blockingElapsed = load([&](auto &bitmaps) {
+		for (std::size_t i = 0; i < FileCount; i++)
+			bitmaps[i] = std::make_unique<acid::Bitmap>(filenames[i]);
+	});
+
+	// Pool workers block on reads, then decode.
+	auto poolElapsed = load([&](auto &bitmaps) {
+		bitmaps = acid::Bitmap::LoadAll(filenames, &pool);
+	});
+
+	// Reads are queued, and each file is decoded on the pool as soon as it is read.
+	auto queueElapsed = [&](acid::FileQueue::Backend backend) {
+		return load([&](auto &bitmaps) {
+			acid::FileQueue queue(&pool, backend);
+			for (std::size_t i = 0; i < FileCount; i++) {
+				queue.Read(filenames[i], [&bitmaps, i](acid::FileRequest &request) {
+					bitmaps[i] = std::make_unique<acid::Bitmap>();
+					bitmaps[i]->LoadMemory(request.GetData());
+				});
+			}
+			queue.Wait();
+		});
+	};
+
+	auto threadsElapsed = queueElapsed(acid::FileQueue::Backend::Threads);
+	auto ringElapsed = queueElapsed(acid::FileQueue::Backend::IoUring);
+
+	std::cout << FileCount << " png files, " << totalLength / 1024 << "KiB, " << pool.GetWorkers().size() << " workers: blocking " << blockingElapsed
+		<< "ms, pool " << poolElapsed << "ms, queue with I/O threads " << threadsElapsed << "ms, queue with io_uring " << ringElapsed << "ms\n";
+
+	std::filesystem::remove_all(QueuePath);
+}
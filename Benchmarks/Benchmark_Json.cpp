@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+
+#include <iostream>
+#include <sstream>
+
+#include <Files/Json/Json.hpp>
+
+#include "Benchmark.hpp"
+#include "Documents.hpp"
+
+TEST(Json, parse) {
+	auto source = acid::test::CreateJsonDocument(200000, false);
+	auto megabytes = static_cast<double>(source.size()) / (1024.0 * 1024.0);
+
+	// Megabytes parsed per second.
+	auto rate = [&](auto &&parse) {
+		return 1000.0 * megabytes / acid::test::Measure(parse);
+	};
+
+	auto legacyRate = rate([&]() {
+		acid::test::LegacyJson json;
+		json.ParseString(source);
+	});
+	auto stringRate = rate([&]() {
+		acid::Json json;
+		json.ParseString(source);
+	});
+	auto streamRate = rate([&]() {
+		std::istringstream stream(source);
+		acid::Json json;
+		json.ParseStream(stream);
+	});
+	auto documentRate = rate([&]() {
+		auto document = acid::Json::ParseDocument(source);
+	});
+
+	std::cout << megabytes << "MB: legacy tokenizer " << legacyRate << "MB/s, block tokenizer " << stringRate << "MB/s, from a stream " << streamRate
+		<< "MB/s, into a document " << documentRate << "MB/s\n";
+}
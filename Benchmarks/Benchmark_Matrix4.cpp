@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+
+#include <iostream>
+#include <random>
+
+#include <Maths/Matrix4.hpp>
+#include <Physics/Frustum.hpp>
+
+#include "Benchmark.hpp"
+#include "Matrices.hpp"
+
+TEST(Matrix4, kernels) {
+	// Small enough to stay in cache, larger batches only measure memory bandwidth.
+	constexpr std::size_t Count = 1024;
+	constexpr uint32_t RunCount = 500;
+	std::mt19937 random(19);
+	std::uniform_real_distribution<float> distribution(-5.0f, 5.0f);
+
+	std::vector<acid::Matrix4> left(Count), right(Count), results(Count);
+	std::vector<acid::Vector3f> points(Count), transformedPoints(Count);
+	std::vector<float> x(Count), y(Count), z(Count), radius(Count, 1.0f);
+	std::vector<uint8_t> visible(Count);
+
+	for (std::size_t i = 0; i < Count; i++) {
+		left[i] = acid::test::RandomMatrix(random);
+		right[i] = acid::test::RandomMatrix(random);
+		points[i] = {distribution(random), distribution(random), distribution(random)};
+		x[i] = 10.0f * distribution(random);
+		y[i] = 10.0f * distribution(random);
+		z[i] = 10.0f * distribution(random);
+	}
+
+	auto matrix = left.front();
+	acid::Frustum frustum;
+	frustum.Update(acid::Matrix4::ViewMatrix({}, {0.2f, 0.4f, 0.0f}), acid::Matrix4::PerspectiveMatrix(1.2f, 1.6f, 0.1f, 100.0f));
+
+	// Nanoseconds for each element, the fastest of many runs.
+	auto perElement = [&](auto &&function) {
+		return 1e6 * acid::test::Measure(function, RunCount) / Count;
+	};
+
+	// Only the kernels are timed, the library built with ACID_SIMD off times the scalar backend to compare against.
+	auto multiply = perElement([&]() {
+		acid::Matrix4::Multiply(left.data(), right.data(), results.data(), Count);
+	});
+	auto transform = perElement([&]() {
+		matrix.TransformPoints(points.data(), transformedPoints.data(), Count);
+	});
+	auto inverse = perElement([&]() {
+		for (std::size_t i = 0; i < Count; i++)
+			results[i] = left[i].Inverse();
+	});
+	auto spheres = perElement([&]() {
+		frustum.SpheresInFrustum(x.data(), y.data(), z.data(), radius.data(), Count, visible.data());
+	});
+
+	std::cout << "Nanoseconds per element: multiply " << multiply << ", transform point " << transform << ", inverse " << inverse
+		<< ", sphere in frustum " << spheres << '\n';
+}
@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+#include <Files/Json/Json.hpp>
+
+#include "Benchmark.hpp"
+#include "Documents.hpp"
+
+TEST(NodeDocument, parse) {
+	auto source = acid::test::CreateScene(100000);
+	auto megabytes = static_cast<double>(source.size()) / (1024.0 * 1024.0);
+
+	acid::Json json;
+	auto nodeElapsed = acid::test::Measure([&]() {
+		json.ParseString(source);
+	});
+
+	acid::NodeDocument document;
+	auto documentElapsed = acid::test::Measure([&]() {
+		document = acid::Json::ParseDocument(source);
+	});
+
+	// Reads one value out of every entity, the common case for loaders.
+	float sum = 0.0f;
+	auto readElapsed = acid::test::Measure([&]() {
+		for (const auto &entity : document["entities"].GetProperties())
+			sum += entity["transform"]["position"][0].Get<float>();
+	});
+
+	EXPECT_GT(sum, 0.0f);
+	EXPECT_EQ(document.GetRoot().ToNode(), json);
+	std::cout << megabytes << "MB: Node tree " << nodeElapsed << "ms (" << megabytes / nodeElapsed * 1000.0 << "MB/s), document " << documentElapsed << "ms ("
+		<< megabytes / documentElapsed * 1000.0 << "MB/s), " << document.GetSize() << " elements, reading one value per entity " << readElapsed << "ms\n";
+}
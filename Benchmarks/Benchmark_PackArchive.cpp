@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <iostream>
+
+#include <Files/Pack/PackArchive.hpp>
+#include <Files/Zip/ZipArchive.hpp>
+
+#include "Benchmark.hpp"
+#include "Documents.hpp"
+
+static const std::filesystem::path PackPath = std::filesystem::temp_directory_path() / "AcidBenchmarkPacks";
+
+TEST(PackArchive, load) {
+	// A content set of many small files, like shaders, materials and scene files.
+	constexpr std::size_t FileCount = 20000;
+	auto loosePath = PackPath / "Loose";
+	std::filesystem::remove_all(PackPath);
+	std::filesystem::create_directories(PackPath);
+
+	std::vector<std::string> names(FileCount);
+	std::size_t totalLength = 0;
+	{
+		acid::PackWriter stored(PackPath / "Stored.pak");
+		acid::PackWriter deflated(PackPath / "Deflated.pak");
+		acid::ZipArchive zip;
+		zip.Create(PackPath / "Content.zip");
+
+		for (std::size_t i = 0; i < FileCount; i++) {
+			names[i] = "Folder" + std::to_string(i % 100) + "/File" + std::to_string(i) + ".txt";
+			auto data = acid::test::CreateText(i, 256 + i * 7919 % 3840);
+			totalLength += data.size();
+
+			std::filesystem::create_directories((loosePath / names[i]).parent_path());
+			std::ofstream(loosePath / names[i], std::ios::binary) << data;
+			stored.AddEntry(names[i], data);
+			deflated.AddEntry(names[i], data, acid::PackArchive::Compression::Deflate);
+			zip.AddEntry(names[i], data);
+		}
+
+		zip.Write();
+	}
+
+	// Every file is read and checksummed, the memory is what stays allocated for the file contents.
+	uint64_t looseSum = 0;
+	std::size_t looseMemory = 0;
+	auto looseElapsed = acid::test::Measure([&]() {
+		for (const auto &name : names) {
+			std::ifstream is(loosePath / name, std::ios::binary);
+			std::string data(std::istreambuf_iterator<char>(is), {});
+			looseSum += std::hash<std::string_view>()(data);
+			looseMemory += data.capacity();
+		}
+	});
+
+	uint64_t zipSum = 0;
+	auto zipElapsed = acid::test::Measure([&]() {
+		acid::ZipArchive zip(PackPath / "Content.zip");
+		for (const auto &name : names)
+			zipSum += std::hash<std::string>()(zip.GetEntry(name)->GetDataAsString());
+	});
+
+	auto packElapsed = [&](const std::filesystem::path &filename, uint64_t &sum) {
+		return acid::test::Measure([&]() {
+			acid::PackArchive archive(filename);
+			for (const auto &name : names)
+				sum += std::hash<std::string_view>()(*archive.ReadView(name));
+		});
+	};
+
+	uint64_t storedSum = 0, deflatedSum = 0;
+	auto storedElapsed = packElapsed(PackPath / "Stored.pak", storedSum);
+	auto deflatedElapsed = packElapsed(PackPath / "Deflated.pak", deflatedSum);
+
+	EXPECT_EQ(zipSum, looseSum);
+	EXPECT_EQ(storedSum, looseSum);
+	EXPECT_EQ(deflatedSum, looseSum);
+
+	std::cout << FileCount << " files, " << totalLength / 1024 << "KiB: loose " << looseElapsed << "ms (" << looseMemory / 1024 << "KiB copied), zip " << zipElapsed
+		<< "ms (" << std::filesystem::file_size(PackPath / "Content.zip") / 1024 << "KiB), stored pack " << storedElapsed << "ms ("
+		<< std::filesystem::file_size(PackPath / "Stored.pak") / 1024 << "KiB, views into the mapping), deflated pack " << deflatedElapsed << "ms ("
+		<< std::filesystem::file_size(PackPath / "Deflated.pak") / 1024 << "KiB)\n";
+
+	std::filesystem::remove_all(PackPath);
+}
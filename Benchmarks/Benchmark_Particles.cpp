@@ -0,0 +1,28 @@
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+#include <Particles/ParticleStore.hpp>
+
+#include "Benchmark.hpp"
+#include "Particles.hpp"
+
+TEST(Particles, update) {
+	constexpr std::size_t Count = 1000000;
+	constexpr uint32_t FrameCount = 20;
+	acid::ThreadPool pool;
+
+	for (auto threadPool : {static_cast<acid::ThreadPool *>(nullptr), &pool}) {
+		acid::ParticleStore store;
+		acid::test::FillStore(store, Count);
+
+		auto elapsed = acid::test::Measure([&]() {
+			for (uint32_t frame = 0; frame < FrameCount; frame++)
+				store.Update(1.0f / 60.0f, {0.0f, 10.0f, 0.0f}, threadPool);
+		});
+
+		EXPECT_EQ(store.GetDrawOrder().size(), store.GetSize());
+		std::cout << Count << " particles " << (threadPool ? "on the thread pool" : "on one thread") << ": " << elapsed / FrameCount
+			<< "ms per update, including compaction and sort\n";
+	}
+}
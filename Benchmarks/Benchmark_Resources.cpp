@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+#include <Resources/Resources.hpp>
+
+#include "Benchmark.hpp"
+#include "ResourceNodes.hpp"
+
+TEST(Resources, find) {
+	constexpr uint32_t LookupCount = 10000;
+
+	for (uint32_t count : {1000, 10000, 100000}) {
+		acid::Resources resources;
+		std::vector<std::shared_ptr<acid::test::TestResource>> alive;
+		alive.reserve(count);
+
+		for (uint32_t i = 0; i < count; i++) {
+			auto resource = alive.emplace_back(std::make_shared<acid::test::TestResource>());
+			resources.Add(acid::test::CreateResourceNode(i), resource);
+		}
+
+		std::vector<acid::Node> queries;
+		queries.reserve(LookupCount);
+		for (uint32_t i = 0; i < LookupCount; i++)
+			queries.emplace_back(acid::test::CreateResourceNode((i * 7919) % count));
+
+		uint32_t found = 0;
+		auto elapsed = acid::test::Measure([&]() {
+			for (const auto &query : queries) {
+				if (resources.Find<acid::test::TestResource>(query))
+					found++;
+			}
+		});
+
+		EXPECT_EQ(found, LookupCount);
+		std::cout << "Resources::Find with " << count << " resources: " << 1e6 * elapsed / LookupCount << "ns per lookup\n";
+	}
+}
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <iostream>
+
+#include <Graphics/Pipelines/Shader.hpp>
+#include <Graphics/Pipelines/ShaderCache.hpp>
+
+#include "Benchmark.hpp"
+
+static const std::filesystem::path CacheDirectory = "Cache/BenchmarkShaders";
+static const std::filesystem::path ShadersPath = std::filesystem::path(__FILE__).parent_path().parent_path() / "Resources/Shaders";
+
+TEST(ShaderCache, warm) {
+	// Stages without includes, they compile without the files module, with the defines materials and filters set.
+	const std::string defaultDefines = "#define DIFFUSE_MAPPING 1\n#define MATERIAL_MAPPING 1\n#define NORMAL_MAPPING 1\n#define ANIMATED 1\n#define MAX_JOINTS 50\n"
+		"#define MAX_WEIGHTS 3\n";
+	const std::vector<std::pair<std::filesystem::path, std::string>> stages = {{"Defaults/Default.vert", defaultDefines},
+		{"Defaults/Default.frag", defaultDefines}, {"Guis/Gui.vert", ""}, {"Guis/Gui.frag", ""},
+		{"Fonts/Font.vert", ""}, {"Fonts/Font.frag", ""}, {"Particles/Particle.vert", ""}, {"Particles/Particle.frag", ""}, {"Post/Blur.frag", "#define BLUR_TYPE 9\n"}};
+
+	std::vector<std::string> sources;
+	for (const auto &[filename, preamble] : stages) {
+		std::ifstream stream(ShadersPath / filename);
+		ASSERT_TRUE(stream) << filename;
+		sources.emplace_back(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+	}
+
+	acid::Shader::Compiler compiler;
+	acid::ShaderCache cache(CacheDirectory);
+	cache.Clear();
+
+	auto compileAll = [&](std::vector<std::vector<uint32_t>> &spirvs) {
+		return acid::test::Measure([&]() {
+			for (std::size_t i = 0; i < stages.size(); i++) {
+				const auto &[filename, preamble] = stages[i];
+				acid::Shader shader;
+				spirvs.emplace_back(shader.CompileModule(filename, sources[i], preamble, acid::Shader::GetShaderStage(filename), &cache));
+			}
+		});
+	};
+
+	// The first pass runs glslang and stores every stage, the second only loads them.
+	std::vector<std::vector<uint32_t>> cold, warm;
+	auto coldElapsed = compileAll(cold);
+	auto warmElapsed = compileAll(warm);
+	EXPECT_EQ(cold, warm);
+
+	std::cout << stages.size() << " shader stages: compiled by glslang in " << coldElapsed << "ms, loaded from the cache in " << warmElapsed << "ms\n";
+
+	cache.Clear();
+}
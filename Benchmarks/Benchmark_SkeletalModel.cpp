@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+#include <Animations/SkeletalModel.hpp>
+#include <Animations/Animator.hpp>
+
+#include "Benchmark.hpp"
+#include "SkeletalModels.hpp"
+
+TEST(SkeletalModel, spawn) {
+	constexpr std::size_t InstanceCount = 200;
+	// Parsing is slow, so the old per instance path is timed for a few instances and scaled up.
+	constexpr std::size_t ParsedCount = 10;
+	auto source = acid::test::ReadFile(acid::test::ColladaPath);
+
+	// Before, each instance parsed the document and kept its own geometry, skeleton and animation.
+	std::vector<std::unique_ptr<acid::SkeletalModel>> parsed;
+	auto parsedTime = acid::test::Measure([&]() {
+		for (std::size_t i = 0; i < ParsedCount; i++) {
+			parsed.emplace_back(std::make_unique<acid::SkeletalModel>("", false));
+			acid::test::LoadCollada(source, *parsed.back());
+		}
+	}) * InstanceCount / ParsedCount;
+
+	const auto &skeletalModel = *parsed.front();
+	auto sharedBytes = skeletalModel.GetVertices().size() * sizeof(acid::VertexAnimated) + skeletalModel.GetIndices().size() * sizeof(uint32_t) +
+		skeletalModel.GetSkeleton().GetJointCount() * (2 * sizeof(acid::Matrix4) + sizeof(int32_t) + sizeof(uint32_t)) +
+		(skeletalModel.GetAnimation()->GetTimes().size() + skeletalModel.GetAnimation()->GetTracks().size()) * sizeof(float);
+	auto instanceBytes = sizeof(acid::Animator) + 50 * sizeof(acid::Matrix4);
+
+	// Now, the baked file is read once and each instance only has a animator and joint matrices.
+	auto data = skeletalModel.WriteMemory();
+	auto shared = std::make_shared<acid::SkeletalModel>("", false);
+	auto bakedTime = acid::test::Measure([&]() {
+		EXPECT_TRUE(shared->LoadMemory(data));
+	});
+
+	std::vector<std::pair<std::shared_ptr<acid::SkeletalModel>, acid::Animator>> instances(InstanceCount);
+	auto sharedTime = bakedTime + acid::test::Measure([&]() {
+		for (auto &[model, animator] : instances) {
+			model = shared;
+			animator.DoAnimation(model->GetAnimation());
+		}
+	});
+
+	std::cout << InstanceCount << " instances: parsing each took " << parsedTime << "ms and " << (sharedBytes + instanceBytes) * InstanceCount / 1024
+		<< "KiB, sharing a baked model took " << sharedTime << "ms (" << bakedTime << "ms to load) and " << (sharedBytes + instanceBytes * InstanceCount) / 1024
+		<< "KiB\n";
+	EXPECT_LT(sharedTime, parsedTime);
+}
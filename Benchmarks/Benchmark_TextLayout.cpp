@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+#include <Fonts/TextLayout.hpp>
+
+#include "Benchmark.hpp"
+#include "Fonts.hpp"
+
+TEST(TextLayout, counters) {
+	auto &atlas = acid::test::GetAtlas();
+	acid::TextLayout::Style style;
+	style.m_fontSize = 13.0f;
+	style.m_maxWidth = 300.0f;
+
+	// Hundreds of counters on a HUD, each changing every frame.
+	constexpr std::size_t CounterCount = 500;
+	constexpr std::size_t FrameCount = 200;
+
+	auto counter = [](std::size_t index, std::size_t frame) {
+		return L"Counter " + std::to_wstring(index) + L": " + std::to_wstring(1000 * index + frame);
+	};
+
+	std::size_t glyphs = 0;
+	auto fullElapsed = acid::test::Measure([&]() {
+		for (std::size_t frame = 0; frame < FrameCount; frame++) {
+			for (std::size_t i = 0; i < CounterCount; i++) {
+				acid::TextLayout layout;
+				layout.Update(atlas, counter(i, frame), style);
+				glyphs += layout.GetGlyphs().size();
+			}
+		}
+	});
+
+	std::vector<std::shared_ptr<const acid::TextLayout>> layouts(CounterCount);
+	acid::TextLayoutCache cache;
+	auto incrementalElapsed = acid::test::Measure([&]() {
+		for (std::size_t frame = 0; frame < FrameCount; frame++) {
+			for (std::size_t i = 0; i < CounterCount; i++)
+				layouts[i] = cache.Get(atlas, counter(i, frame), style, layouts[i]);
+		}
+	});
+
+	EXPECT_EQ(layouts[7]->GetString(), counter(7, FrameCount - 1));
+
+	std::cout << CounterCount << " counters over " << FrameCount << " frames (" << glyphs / FrameCount << " glyphs a frame): laid out from scratch "
+		<< fullElapsed / FrameCount << "ms a frame, incremental through the cache " << incrementalElapsed / FrameCount << "ms a frame\n";
+}
+
+TEST(TextLayout, console) {
+	auto &atlas = acid::test::GetAtlas();
+	acid::TextLayout::Style style;
+	style.m_fontSize = 13.0f;
+	style.m_maxWidth = 600.0f;
+
+	// A console with a long history where only the last line changes every frame.
+	std::wstring history;
+	for (std::size_t i = 0; i < 200; i++)
+		history += L"[" + std::to_wstring(i) + L"] Loaded resource Shaders/Fonts/Font.vert, Shaders/Fonts/Font.frag and Fonts/ProximaNova-Regular.ttf\n";
+
+	constexpr std::size_t FrameCount = 200;
+
+	acid::TextLayout full;
+	auto fullElapsed = acid::test::Measure([&]() {
+		for (std::size_t frame = 0; frame < FrameCount; frame++) {
+			full = {};
+			full.Update(atlas, history + L"> " + std::to_wstring(frame), style);
+		}
+	});
+
+	acid::TextLayout incremental;
+	auto incrementalElapsed = acid::test::Measure([&]() {
+		for (std::size_t frame = 0; frame < FrameCount; frame++)
+			incremental.Update(atlas, history + L"> " + std::to_wstring(frame), style);
+	});
+
+	EXPECT_EQ(incremental.GetGlyphs().size(), full.GetGlyphs().size());
+
+	std::cout << history.size() << " characters on " << full.GetLineCount() << " lines: laid out from scratch " << fullElapsed / FrameCount
+		<< "ms a frame, incremental " << incrementalElapsed / FrameCount << "ms a frame\n";
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <iostream>
+#include <queue>
+
+#include <Helpers/ThreadPool.hpp>
+
+#include "Benchmark.hpp"
+
+// The single mutex pool ThreadPool replaced, kept as a baseline.
+class MutexThreadPool {
+public:
+	explicit MutexThreadPool(uint32_t threadCount) {
+		for (uint32_t i = 0; i < threadCount; ++i) {
+			m_workers.emplace_back([this] {
+				while (true) {
+					std::function<void()> task;
+
+					{
+						std::unique_lock<std::mutex> lock(m_queueMutex);
+						m_condition.wait(lock, [this] {
+							return m_stop || !m_tasks.empty();
+						});
+
+						if (m_stop && m_tasks.empty())
+							return;
+
+						task = std::move(m_tasks.front());
+						m_tasks.pop();
+					}
+
+					task();
+				}
+			});
+		}
+	}
+
+	~MutexThreadPool() {
+		{
+			std::unique_lock<std::mutex> lock(m_queueMutex);
+			m_stop = true;
+		}
+
+		m_condition.notify_all();
+
+		for (auto &worker : m_workers)
+			worker.join();
+	}
+
+	template<typename F>
+	void Enqueue(F &&f) {
+		auto task = std::make_shared<std::packaged_task<void()>>(std::forward<F>(f));
+
+		{
+			std::unique_lock<std::mutex> lock(m_queueMutex);
+			m_tasks.emplace([task]() {
+				(*task)();
+			});
+		}
+
+		m_condition.notify_one();
+	}
+
+private:
+	std::vector<std::thread> m_workers;
+	std::queue<std::function<void()>> m_tasks;
+	std::mutex m_queueMutex;
+	std::condition_variable m_condition;
+	bool m_stop = false;
+};
+
+TEST(ThreadPool, submit) {
+	constexpr uint32_t TaskCount = 200000;
+	auto maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+	for (uint32_t threads = 1; threads <= maxThreads; threads *= 2) {
+		std::atomic<uint32_t> done = 0;
+
+		auto mutexElapsed = acid::test::Measure([&]() {
+			MutexThreadPool pool(threads);
+			for (uint32_t i = 0; i < TaskCount; i++) {
+				pool.Enqueue([&done]() {
+					++done;
+				});
+			}
+		});
+		EXPECT_EQ(done, TaskCount);
+
+		done = 0;
+		auto injectedElapsed = acid::test::Measure([&]() {
+			acid::ThreadPool pool(threads);
+			for (uint32_t i = 0; i < TaskCount; i++) {
+				pool.Submit([&done]() {
+					++done;
+				});
+			}
+			pool.Wait();
+		});
+		EXPECT_EQ(done, TaskCount);
+
+		done = 0;
+		auto stealingElapsed = acid::test::Measure([&]() {
+			acid::ThreadPool pool(threads);
+			pool.ParallelFor(0, TaskCount, [&pool, &done](std::size_t) {
+				pool.Submit([&done]() {
+					++done;
+				});
+			});
+			pool.Wait();
+		});
+		EXPECT_EQ(done, TaskCount);
+
+		std::cout << threads << " threads, " << TaskCount << " tasks: mutex pool " << mutexElapsed << "ms, job pool submitted externally " << injectedElapsed
+			<< "ms, job pool submitted from workers " << stealingElapsed << "ms\n";
+	}
+}
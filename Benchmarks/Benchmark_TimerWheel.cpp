@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <random>
+
+#include <Timers/TimerWheel.hpp>
+
+#include "Benchmark.hpp"
+
+TEST(TimerWheel, advance) {
+	constexpr uint32_t TimerCount = 100000;
+	constexpr uint32_t TickCount = 100000;
+	auto start = acid::Time::Now();
+
+	std::mt19937 generator(5);
+	std::uniform_real_distribution<float> delay(1.0f, static_cast<float>(TickCount));
+	std::vector<std::shared_ptr<acid::Timer>> timers;
+	for (uint32_t i = 0; i < TimerCount; i++)
+		timers.emplace_back(std::make_shared<acid::Timer>(acid::Time::Milliseconds(delay(generator)), 1));
+
+	// The sorted vector Timers used to keep, sorted every time the front timer was checked.
+	auto sorted = timers;
+	constexpr uint32_t SortedTickCount = 50;
+	double sortedElapsed = 0.0;
+	for (uint32_t tick = 0; tick < SortedTickCount; tick++) {
+		sortedElapsed += acid::test::Measure([&]() {
+			std::sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b) {
+				return a->GetNext() < b->GetNext();
+			});
+		});
+	}
+
+	acid::TimerWheel wheel(start);
+	auto addElapsed = acid::test::Measure([&]() {
+		for (const auto &timer : timers)
+			wheel.Add(timer);
+	});
+
+	std::vector<double> tickCosts;
+	tickCosts.reserve(TickCount + 1);
+	std::vector<std::shared_ptr<acid::Timer>> due;
+	int64_t maxLateness = 0;
+	uint32_t dueCount = 0;
+
+	for (uint32_t tick = 0; wheel.GetSize() != 0; tick++) {
+		auto time = start + acid::Time::Milliseconds(tick);
+		tickCosts.emplace_back(1000.0 * acid::test::Measure([&]() {
+			wheel.Advance(time, due);
+		}));
+
+		for (const auto &timer : due)
+			maxLateness = std::max(maxLateness, (time - timer->GetNext()).AsMicroseconds());
+		dueCount += static_cast<uint32_t>(due.size());
+		due.clear();
+	}
+
+	EXPECT_EQ(dueCount, TimerCount);
+	EXPECT_LT(maxLateness, wheel.GetResolution().AsMicroseconds());
+
+	std::sort(tickCosts.begin(), tickCosts.end());
+	auto mean = std::accumulate(tickCosts.begin(), tickCosts.end(), 0.0) / tickCosts.size();
+	std::cout << TimerCount << " timers: sorted vector " << 1000.0 * sortedElapsed / SortedTickCount << "us per tick, wheel insert " << addElapsed
+		<< "ms, wheel tick mean " << mean << "us, p99 " << tickCosts[tickCosts.size() * 99 / 100] << "us, max " << tickCosts.back() << "us, max lateness "
+		<< maxLateness << "us\n";
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+#include <Maths/Transform.hpp>
+#include <Maths/TransformHierarchy.hpp>
+#include <Helpers/ThreadPool.hpp>
+
+#include "Benchmark.hpp"
+#include "Transforms.hpp"
+
+TEST(Transform, update) {
+	constexpr std::size_t TransformCount = 10000;
+	constexpr std::size_t RootCount = 16;
+	constexpr uint32_t FrameCount = 20;
+	auto transforms = acid::test::CreateHierarchy(TransformCount, RootCount);
+	std::vector<acid::Transform *> pointers;
+	for (const auto &transform : transforms)
+		pointers.emplace_back(transform.get());
+
+	// Before, every read walked up every parent, each node is read once a frame like a mesh being rendered.
+	auto referenceTime = acid::test::Measure([&]() {
+		for (const auto &transform : transforms) {
+			acid::Vector3f position, rotation, scale;
+			acid::test::ReferenceWorldMatrix(*transform, position, rotation, scale);
+		}
+	});
+
+	// Every root moves or turns each frame, so every transform is recalculated, turning also changes every rotation.
+	acid::TransformHierarchy hierarchy;
+	auto update = [&](acid::ThreadPool *pool, bool turn) {
+		return acid::test::Measure([&]() {
+			for (uint32_t frame = 0; frame < FrameCount; frame++) {
+				for (std::size_t i = 0; i < RootCount; i++) {
+					if (turn)
+						transforms[i]->SetLocalRotation(acid::Vector3f(0.0f, 0.01f * frame, 0.0f));
+					else
+						transforms[i]->SetLocalPosition(acid::Vector3f(static_cast<float>(frame), 0.0f, 0.0f));
+				}
+				hierarchy.Update(pointers, pool);
+			}
+		}) / FrameCount;
+	};
+
+	// The first pass flattens the hierarchy.
+	update(nullptr, false);
+	auto serialTime = update(nullptr, false);
+	auto turnTime = update(nullptr, true);
+	acid::ThreadPool pool;
+	auto parallelTime = update(&pool, false);
+
+	// With one leaf moving the pass only walks down to it.
+	auto leafTime = acid::test::Measure([&]() {
+		transforms.back()->SetLocalScale(acid::Vector3f(2.0f));
+		hierarchy.Update(pointers);
+	});
+
+	std::cout << TransformCount << " transforms: walking parents " << referenceTime << "ms, updating every transform " << serialTime << "ms, across "
+		<< pool.GetWorkers().size() << " workers " << parallelTime << "ms, with every rotation changed " << turnTime << "ms, with one leaf changed "
+		<< leafTime << "ms\n";
+	EXPECT_LT(serialTime, referenceTime);
+}
@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+
+#include <iostream>
+#include <sstream>
+
+#include <Files/Xml/Xml.hpp>
+#include <Files/Xml/XmlReader.hpp>
+
+#include "Benchmark.hpp"
+#include "Documents.hpp"
+
+TEST(Xml, parse) {
+	auto source = acid::test::CreateXmlDocument(200000);
+	auto megabytes = static_cast<double>(source.size()) / (1024.0 * 1024.0);
+
+	// Megabytes parsed per second.
+	auto rate = [&](auto &&parse) {
+		return 1000.0 * megabytes / acid::test::Measure(parse);
+	};
+
+	uint32_t elements = 0;
+	auto pullRate = rate([&]() {
+		acid::XmlReader reader(source);
+
+		for (auto event = reader.Next(); event != acid::XmlReader::Event::EndDocument; event = reader.Next()) {
+			if (event == acid::XmlReader::Event::StartElement)
+				elements++;
+		}
+	});
+	auto treeRate = rate([&]() {
+		acid::Xml xml("root");
+		xml.ParseString(source);
+	});
+	auto streamRate = rate([&]() {
+		std::istringstream stream(source);
+		acid::Xml xml("root");
+		xml.ParseStream(stream);
+	});
+
+	EXPECT_EQ(elements, 1u + 200000u * 4u);
+	std::cout << megabytes << "MB: pull reader " << pullRate << "MB/s, into a node tree " << treeRate << "MB/s, from a stream " << streamRate << "MB/s\n";
+}
@@ -2,24 +2,25 @@
 #extension GL_ARB_separate_shader_objects : enable
 #extension GL_ARB_shading_language_420pack : enable
 
-layout(binding = 0) uniform UniformObject {
-	mat4 modelView;
-	float alpha;
-
-	vec4 colour;
-} object;
-
 layout(location = 0) in vec2 inPosition;
-layout(location = 1) in vec3 inUV;
+layout(location = 1) in vec2 inUV;
+
+layout(location = 2) in vec4 inRectangle;
+layout(location = 3) in vec3 inGlyph;
+layout(location = 4) in vec4 inColour;
 
 layout(location = 0) out vec3 outUV;
+layout(location = 1) out float outScale;
+layout(location = 2) out vec4 outColour;
 
 out gl_PerVertex {
 	vec4 gl_Position;
 };
 
 void main() {
-	gl_Position = object.modelView * vec4(inPosition, 0.0f, 1.0f);
+	gl_Position = vec4(inRectangle.xy + inPosition * inRectangle.zw, inGlyph.y, 1.0f);
 
-	outUV = inUV;
+	outUV = vec3(inUV, inGlyph.x);
+	outScale = inGlyph.z;
+	outColour = inColour;
 }
@@ -2,25 +2,35 @@
 
 #include "Animations/Animation/Animation.hpp"
 #include "Animations/Animation/AnimationLoader.hpp"
+#include "Animations/Animation/CompiledAnimation.hpp"
 #include "Animations/Animation/JointTransform.hpp"
 #include "Animations/Animation/Keyframe.hpp"
 #include "Animations/Animator.hpp"
 #include "Animations/Geometry/GeometryLoader.hpp"
 #include "Animations/Geometry/VertexAnimated.hpp"
 #include "Animations/MeshAnimated.hpp"
+#include "Animations/SkeletalModel.hpp"
 #include "Animations/Skeleton/Joint.hpp"
+#include "Animations/Skeleton/Skeleton.hpp"
 #include "Animations/Skeleton/SkeletonLoader.hpp"
 #include "Animations/Skin/SkinLoader.hpp"
 #include "Animations/Skin/VertexWeights.hpp"
 #include "Audio/Audio.hpp"
 #include "Audio/Flac/SoundBufferFlac.hpp"
 #include "Audio/Mp3/SoundBufferMp3.hpp"
+#include "Audio/Mp3/SoundDecoderMp3.hpp"
 #include "Audio/Ogg/SoundBufferOgg.hpp"
+#include "Audio/Ogg/SoundDecoderOgg.hpp"
 #include "Audio/Opus/SoundBufferOpus.hpp"
 #include "Audio/Sound.hpp"
 #include "Audio/SoundBuffer.hpp"
+#include "Audio/SoundDecoder.hpp"
+#include "Audio/SoundStream.hpp"
 #include "Audio/Wave/SoundBufferWave.hpp"
+#include "Audio/Wave/SoundDecoderWave.hpp"
 #include "Bitmaps/Bitmap.hpp"
+#include "Bitmaps/BlockCompression.hpp"
+#include "Bitmaps/CompressedBitmap.hpp"
 #include "Bitmaps/Png/BitmapPng.hpp"
 #include "Devices/Instance.hpp"
 #include "Devices/Joysticks.hpp"
@@ -37,18 +47,22 @@
 #include "Engine/Module.hpp"
 #include "Files/File.hpp"
 #include "Files/FileObserver.hpp"
+#include "Files/FileQueue.hpp"
 #include "Files/Files.hpp"
 #include "Files/Json/Json.hpp"
 #include "Files/Node.hpp"
 #include "Files/NodeView.hpp"
+#include "Files/Pack/PackArchive.hpp"
 #include "Files/Xml/Xml.hpp"
 #include "Files/Zip/miniz.h"
 #include "Files/Zip/ZipArchive.hpp"
 #include "Files/Zip/ZipEntry.hpp"
 #include "Files/Zip/ZipException.hpp"
 #include "Fonts/FontType.hpp"
+#include "Fonts/GlyphAtlas.hpp"
 #include "Fonts/SubrenderFonts.hpp"
 #include "Fonts/Text.hpp"
+#include "Fonts/TextLayout.hpp"
 #include "Gizmos/Gizmo.hpp"
 #include "Gizmos/Gizmos.hpp"
 #include "Gizmos/GizmoType.hpp"
@@ -88,6 +102,7 @@
 #include "Helpers/EnumClass.hpp"
 #include "Helpers/Factory.hpp"
 #include "Helpers/Future.hpp"
+#include "Helpers/Hash.hpp"
 #include "Helpers/NonCopyable.hpp"
 #include "Helpers/RingBuffer.hpp"
 #include "Helpers/StreamFactory.hpp"
@@ -124,6 +139,7 @@
 #include "Maths/Quaternion.hpp"
 #include "Maths/Time.hpp"
 #include "Maths/Transform.hpp"
+#include "Maths/TransformHierarchy.hpp"
 #include "Maths/Vector2.hpp"
 #include "Maths/Vector3.hpp"
 #include "Maths/Vector4.hpp"
@@ -134,6 +150,7 @@
 #include "Uis/Drivers/LinearDriver.hpp"
 #include "Uis/Drivers/SinewaveDriver.hpp"
 #include "Uis/Drivers/SlideDriver.hpp"
+#include "Meshes/DrawList.hpp"
 #include "Meshes/Mesh.hpp"
 #include "Meshes/SubrenderMeshes.hpp"
 #include "Models/Gltf/ModelGltf.hpp"
@@ -225,7 +242,9 @@
 #include "Shadows/Shadows.hpp"
 #include "Shadows/SubrenderShadows.hpp"
 #include "Skyboxes/MaterialSkybox.hpp"
+#include "Timers/Timer.hpp"
 #include "Timers/Timers.hpp"
+#include "Timers/TimerWheel.hpp"
 #include "Uis/Inputs/UiInputBoolean.hpp"
 #include "Uis/Inputs/UiInputButton.hpp"
 #include "Uis/Inputs/UiInputDropdown.hpp"
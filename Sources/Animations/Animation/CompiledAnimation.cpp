@@ -0,0 +1,98 @@
+#include "CompiledAnimation.hpp"
+
+namespace acid {
+CompiledAnimation::CompiledAnimation(const Animation &animation, const Skeleton &skeleton) :
+	m_length(animation.GetLength()),
+	m_jointCount(skeleton.GetJointCount()),
+	m_stride((m_jointCount + 3) & ~3u) {
+	auto keyframes = animation.GetKeyframes();
+
+	// A animation without keyframes holds the bind pose.
+	if (keyframes.empty())
+		keyframes.emplace_back(Keyframe(0s, {}));
+
+	auto poseLength = GetPoseLength();
+	m_times.reserve(keyframes.size());
+	m_tracks.resize(keyframes.size() * poseLength);
+
+	for (std::size_t k = 0; k < keyframes.size(); k++) {
+		m_times.emplace_back(keyframes[k].GetTimeStamp().AsSeconds());
+		auto tracks = &m_tracks[k * poseLength];
+
+		for (uint32_t j = 0; j < m_stride; j++) {
+			// Padding is the identity transform, so it normalizes like any other joint.
+			JointTransform transform;
+
+			if (j < m_jointCount) {
+				const auto &pose = keyframes[k].GetPose();
+				auto it = pose.find(skeleton.GetNames()[j]);
+				transform = it != pose.end() ? it->second : JointTransform(skeleton.GetLocalBindTransforms()[j]);
+			}
+
+			auto rotation = transform.GetRotation();
+
+			// Keyframes are kept in the same hemisphere as the previous keyframe, so sampling can interpolate without checking.
+			if (k > 0) {
+				auto previous = tracks - poseLength;
+				auto dot = previous[RotationX * m_stride + j] * rotation.m_x + previous[RotationY * m_stride + j] * rotation.m_y +
+					previous[RotationZ * m_stride + j] * rotation.m_z + previous[RotationW * m_stride + j] * rotation.m_w;
+				if (dot < 0.0f)
+					rotation *= -1.0f;
+			}
+
+			tracks[TranslationX * m_stride + j] = transform.GetPosition().m_x;
+			tracks[TranslationY * m_stride + j] = transform.GetPosition().m_y;
+			tracks[TranslationZ * m_stride + j] = transform.GetPosition().m_z;
+			tracks[RotationX * m_stride + j] = rotation.m_x;
+			tracks[RotationY * m_stride + j] = rotation.m_y;
+			tracks[RotationZ * m_stride + j] = rotation.m_z;
+			tracks[RotationW * m_stride + j] = rotation.m_w;
+			tracks[ScaleX * m_stride + j] = transform.GetScale().m_x;
+			tracks[ScaleY * m_stride + j] = transform.GetScale().m_y;
+			tracks[ScaleZ * m_stride + j] = transform.GetScale().m_z;
+		}
+	}
+}
+
+CompiledAnimation::CompiledAnimation(const Time &length, uint32_t jointCount, std::vector<float> times, std::vector<float> tracks) :
+	m_length(length),
+	m_jointCount(jointCount),
+	m_stride((m_jointCount + 3) & ~3u),
+	m_times(std::move(times)),
+	m_tracks(std::move(tracks)) {
+}
+
+void CompiledAnimation::Sample(float time, uint32_t &cursor, float *pose) const {
+	auto keyframeCount = static_cast<uint32_t>(m_times.size());
+
+	// The cursor only moves forward, unless the animation has looped.
+	if (cursor >= keyframeCount || m_times[cursor] > time)
+		cursor = 0;
+
+	while (cursor + 1 < keyframeCount && m_times[cursor + 1] <= time)
+		cursor++;
+
+	auto next = std::min(cursor + 1, keyframeCount - 1);
+	auto span = m_times[next] - m_times[cursor];
+	auto progression = span > 0.0f ? std::clamp((time - m_times[cursor]) / span, 0.0f, 1.0f) : 0.0f;
+
+	auto poseLength = GetPoseLength();
+	auto previous = &m_tracks[cursor * poseLength];
+	auto following = &m_tracks[next * poseLength];
+
+	// Every track is interpolated linearly.
+	for (std::size_t i = 0; i < poseLength; i++)
+		pose[i] = previous[i] + (following[i] - previous[i]) * progression;
+
+	// Rotations are then normalized, this is close to a slerp between keyframes that are near each other.
+	auto x = pose + RotationX * m_stride, y = pose + RotationY * m_stride, z = pose + RotationZ * m_stride, w = pose + RotationW * m_stride;
+
+	for (uint32_t j = 0; j < m_stride; j++) {
+		auto scale = 1.0f / std::sqrt(x[j] * x[j] + y[j] * y[j] + z[j] * z[j] + w[j] * w[j]);
+		x[j] *= scale;
+		y[j] *= scale;
+		z[j] *= scale;
+		w[j] *= scale;
+	}
+}
+}
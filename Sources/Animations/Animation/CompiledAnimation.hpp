@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Animations/Skeleton/Skeleton.hpp"
+#include "Animation.hpp"
+
+namespace acid {
+/**
+ * @brief Class that represents a {@link Animation} compiled for a {@link Skeleton}, joints are referenced by index instead of by name.
+ * Each keyframe stores one packed array per track, holding that track for every joint. Sampling interpolates whole arrays at once,
+ * and a pose is stored in the same layout as a keyframe.
+ */
+class ACID_EXPORT CompiledAnimation {
+public:
+	enum Track : uint32_t {
+		TranslationX, TranslationY, TranslationZ,
+		RotationX, RotationY, RotationZ, RotationW,
+		ScaleX, ScaleY, ScaleZ,
+		TrackCount
+	};
+
+	/**
+	 * Creates a new compiled animation.
+	 * @param animation The animation to compile.
+	 * @param skeleton The skeleton the animation is played on, joints missing from a keyframe keep their bind transform.
+	 */
+	CompiledAnimation(const Animation &animation, const Skeleton &skeleton);
+
+	/**
+	 * Creates a new compiled animation from tracks that were already compiled.
+	 * @param length The length of the animation.
+	 * @param jointCount The number of joints in the skeleton the tracks were compiled for.
+	 * @param times The time of each keyframe, in seconds.
+	 * @param tracks The tracks of each keyframe, with {@link CompiledAnimation#GetPoseLength} floats per keyframe.
+	 */
+	CompiledAnimation(const Time &length, uint32_t jointCount, std::vector<float> times, std::vector<float> tracks);
+
+	/**
+	 * Samples the local-space transforms of every joint at a time, by interpolating between the keyframes around that time.
+	 * @param time The time in the animation, in seconds.
+	 * @param cursor The keyframe to start searching from, usually the one found last sample. Set to the keyframe before the time.
+	 * @param pose The pose to write to, with {@link CompiledAnimation#GetPoseLength} floats.
+	 */
+	void Sample(float time, uint32_t &cursor, float *pose) const;
+
+	const Time &GetLength() const { return m_length; }
+	uint32_t GetJointCount() const { return m_jointCount; }
+	uint32_t GetKeyframeCount() const { return static_cast<uint32_t>(m_times.size()); }
+	const std::vector<float> &GetTimes() const { return m_times; }
+	const std::vector<float> &GetTracks() const { return m_tracks; }
+
+	/**
+	 * Gets the distance between tracks in a pose, the joint count rounded up to a multiple of 4.
+	 * @return The track stride.
+	 */
+	uint32_t GetStride() const { return m_stride; }
+
+	std::size_t GetPoseLength() const { return static_cast<std::size_t>(TrackCount) * m_stride; }
+
+private:
+	Time m_length;
+	uint32_t m_jointCount;
+	uint32_t m_stride;
+	std::vector<float> m_times;
+	// The tracks of each keyframe, one after the other.
+	std::vector<float> m_tracks;
+};
+}
@@ -1,24 +1,33 @@
 #include "JointTransform.hpp"
 
 namespace acid {
-JointTransform::JointTransform(const Vector3f &position, const Quaternion &rotation) :
+JointTransform::JointTransform(const Vector3f &position, const Quaternion &rotation, const Vector3f &scale) :
 	m_position(position),
-	m_rotation(rotation) {
+	m_rotation(rotation),
+	m_scale(scale) {
 }
 
 JointTransform::JointTransform(const Matrix4 &localTransform) :
 	m_position(localTransform[3]),
-	m_rotation(localTransform) {
+	m_scale(Vector3f(localTransform[0]).Length(), Vector3f(localTransform[1]).Length(), Vector3f(localTransform[2]).Length()) {
+	// The rotation is read from the axes with the scale removed.
+	auto rotation = localTransform;
+	for (uint32_t i = 0; i < 3; i++) {
+		if (m_scale[i] != 0.0f)
+			rotation[i] /= m_scale[i];
+	}
+	m_rotation = rotation;
 }
 
 Matrix4 JointTransform::GetLocalTransform() const {
-	return Matrix4().Translate(m_position) * m_rotation.ToRotationMatrix();
+	return Matrix4().Translate(m_position) * m_rotation.ToRotationMatrix().Scale(m_scale);
 }
 
 JointTransform JointTransform::Interpolate(const JointTransform &frameA, const JointTransform &frameB, float progression) {
 	auto position = Interpolate(frameA.GetPosition(), frameB.GetPosition(), progression);
 	auto rotation = frameA.GetRotation().Slerp(frameB.GetRotation(), progression);
-	return {position, rotation};
+	auto scale = Interpolate(frameA.GetScale(), frameB.GetScale(), progression);
+	return {position, rotation, scale};
 }
 
 Vector3f JointTransform::Interpolate(const Vector3f &start, const Vector3f &end, float progression) {
@@ -28,12 +37,14 @@ Vector3f JointTransform::Interpolate(const Vector3f &start, const Vector3f &end,
 const Node &operator>>(const Node &node, JointTransform &jointTransform) {
 	node["position"].Get(jointTransform.m_position);
 	node["rotation"].Get(jointTransform.m_rotation);
+	node["scale"].Get(jointTransform.m_scale);
 	return node;
 }
 
 Node &operator<<(Node &node, const JointTransform &jointTransform) {
 	node["position"].Set(jointTransform.m_position);
 	node["rotation"].Set(jointTransform.m_rotation);
+	node["scale"].Set(jointTransform.m_scale);
 	return node;
 }
 }
@@ -5,8 +5,8 @@
 namespace acid {
 /**
  * @brief Class that represents the local bone-space transform of a joint at a certain keyframe during an animation.
- * This includes the position and rotation of the joint, relative to the parent joint (or relative to the model's origin if it's the root joint).
- * The transform is stored as a position vector and a quaternion (rotation) so that these values can  be easily interpolated,
+ * This includes the position, rotation and scale of the joint, relative to the parent joint (or relative to the model's origin if it's the root joint).
+ * The transform is stored as a position vector, a quaternion (rotation) and a scale vector so that these values can be easily interpolated,
  * a functionality that this class also provides.
  */
 class ACID_EXPORT JointTransform {
@@ -20,8 +20,9 @@ public:
 	 * Creates a new joint transformation.
 	 * @param position The position of the joint relative to the parent joint (local-space) at a certain keyframe.
 	 * @param rotation The rotation of the joint relative to te parent joint (local-space) at a certain keyframe.
+	 * @param scale The scale of the joint relative to the parent joint (local-space) at a certain keyframe.
 	 */
-	JointTransform(const Vector3f &position, const Quaternion &rotation);
+	JointTransform(const Vector3f &position, const Quaternion &rotation, const Vector3f &scale = Vector3f(1.0f));
 
 	/**
 	 * Creates a new joint transformation.
@@ -30,7 +31,7 @@ public:
 	explicit JointTransform(const Matrix4 &localTransform);
 
 	/**
-	 * In this method the local-space transform matrix is constructed by translating an identity matrix using the position variable and then applying the rotation.
+	 * In this method the local-space transform matrix is constructed by translating an identity matrix using the position variable and then applying the rotation and scale.
 	 * The rotation is applied by first converting the quaternion into a rotation matrix, which is then multiplied with the transform matrix.
 	 * @return The local-space transform as a matrix.
 	 */
@@ -39,7 +40,7 @@ public:
 	/**
 	 * Interpolates between two transforms based on the progression value.
 	 * The result is a new transform which is part way between the two original transforms.
-	 * The translation can simply be linearly interpolated, but the rotation interpolation is slightly more complex,
+	 * The translation and scale can simply be linearly interpolated, but the rotation interpolation is slightly more complex,
 	 * using a method called "SLERP" to spherically-linearly interpolate between 2 quaternions (rotations).
 	 * This gives a much much better result than trying to linearly interpolate between Euler rotations.
 	 * @param frameA The previous transform
@@ -66,11 +67,15 @@ public:
 	const Quaternion &GetRotation() const { return m_rotation; }
 	void SetRotation(const Quaternion &rotation) { m_rotation = rotation; }
 
+	const Vector3f &GetScale() const { return m_scale; }
+	void SetScale(const Vector3f &scale) { m_scale = scale; }
+
 	friend const Node &operator>>(const Node &node, JointTransform &jointTransform);
 	friend Node &operator<<(Node &node, const JointTransform &jointTransform);
 
 private:
 	Vector3f m_position;
 	Quaternion m_rotation;
+	Vector3f m_scale = Vector3f(1.0f);
 };
 }
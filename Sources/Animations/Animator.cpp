@@ -1,85 +1,71 @@
 #include "Animator.hpp"
 
-#include "Engine/Engine.hpp"
-#include "Helpers/Enumerate.hpp"
-
 namespace acid {
-void Animator::Update(const Joint &rootJoint, std::vector<Matrix4> &jointMatrices) {
+void Animator::Update(const Time &delta, const Skeleton &skeleton, std::vector<Matrix4> &jointMatrices) {
 	if (!m_currentAnimation) {
 		return;
 	}
 
-	IncreaseAnimationTime();
-	auto currentPose = CalculateCurrentAnimationPose();
-	CalculateJointPose(currentPose, rootJoint, {}, jointMatrices);
+	// The pose is only needed while updating, so every animator on a thread shares the same buffers.
+	thread_local std::vector<float> pose;
+	thread_local std::vector<Matrix4> modelTransforms;
+
+	IncreaseAnimationTime(delta);
+	pose.resize(m_currentAnimation->GetPoseLength());
+	m_currentAnimation->Sample(m_animationTime.AsSeconds(), m_cursor, pose.data());
+	CalculateJointMatrices(skeleton, pose.data(), m_currentAnimation->GetStride(), modelTransforms, jointMatrices);
 }
 
-void Animator::IncreaseAnimationTime() {
-	m_animationTime += Engine::Get()->GetDelta();
+void Animator::IncreaseAnimationTime(const Time &delta) {
+	m_animationTime += delta;
 
 	if (m_animationTime > m_currentAnimation->GetLength()) {
 		m_animationTime = Time::Seconds(std::fmod(m_animationTime.AsSeconds(), m_currentAnimation->GetLength().AsSeconds()));
 	}
 }
 
-std::map<std::string, Matrix4> Animator::CalculateCurrentAnimationPose() const {
-	auto [frame0, frame1] = GetPreviousAndNextFrames();
-	auto progression = CalculateProgression(frame0, frame1);
-	return InterpolatePoses(frame0, frame1, progression);
-}
-
-std::pair<Keyframe, Keyframe> Animator::GetPreviousAndNextFrames() const {
-	const auto &allFrames = m_currentAnimation->GetKeyframes();
-	const Keyframe *previousFrame = nullptr;
-	const Keyframe *nextFrame = nullptr;
-
-	for (const auto &[i, frame] : Enumerate(allFrames)) {
-		nextFrame = &frame;
-		if (frame.GetTimeStamp() > m_animationTime)
-			break;
-
-		previousFrame = &frame;
-	}
-
-	return {*previousFrame, *nextFrame};
-}
-
-float Animator::CalculateProgression(const Keyframe &previousFrame, const Keyframe &nextFrame) const {
-	auto totalTime = nextFrame.GetTimeStamp() - previousFrame.GetTimeStamp();
-	auto currentTime = m_animationTime - previousFrame.GetTimeStamp();
-	return static_cast<float>(currentTime / totalTime);
-}
-
-std::map<std::string, Matrix4> Animator::InterpolatePoses(const Keyframe &previousFrame, const Keyframe &nextFrame, float progression) const {
-	std::map<std::string, Matrix4> currentPose;
-
-	for (const auto &[name, joint] : previousFrame.GetPose()) {
-		auto previousTransform = previousFrame.GetPose().find(name)->second;
-		auto nextTransform = nextFrame.GetPose().find(name)->second;
-		auto currentTransform = JointTransform::Interpolate(previousTransform, nextTransform, progression);
-		currentPose.emplace(name, currentTransform.GetLocalTransform());
-	}
-
-	return currentPose;
-}
-
-void Animator::CalculateJointPose(const std::map<std::string, Matrix4> &currentPose, const Joint &joint, const Matrix4 &parentTransform, std::vector<Matrix4> &jointMatrices) {
-	auto currentLocalTransform = currentPose.find(joint.GetName())->second;
-	auto currentTransform = parentTransform * currentLocalTransform;
-
-	for (const auto &childJoint : joint.GetChildren()) {
-		CalculateJointPose(currentPose, childJoint, currentTransform, jointMatrices);
-	}
-
-	currentTransform = currentTransform * joint.GetInverseBindTransform();
-
-	if (joint.GetIndex() < jointMatrices.size()) {
-		jointMatrices[joint.GetIndex()] = currentTransform;
+void Animator::CalculateJointMatrices(const Skeleton &skeleton, const float *pose, uint32_t stride, std::vector<Matrix4> &modelTransforms,
+	std::vector<Matrix4> &jointMatrices) {
+	auto jointCount = skeleton.GetJointCount();
+	const auto &parents = skeleton.GetParents();
+	const auto &matrixIndices = skeleton.GetMatrixIndices();
+	const auto &inverseBindTransforms = skeleton.GetInverseBindTransforms();
+	modelTransforms.resize(jointCount);
+
+	auto translation = pose + CompiledAnimation::TranslationX * stride;
+	auto rotation = pose + CompiledAnimation::RotationX * stride;
+	auto scale = pose + CompiledAnimation::ScaleX * stride;
+
+	for (uint32_t j = 0; j < jointCount; j++) {
+		auto x = rotation[j], y = rotation[stride + j], z = rotation[2 * stride + j], w = rotation[3 * stride + j];
+
+		// The same matrix as translating, rotating and then scaling a identity matrix, built directly.
+		Matrix4 localTransform;
+		localTransform[0][0] = (1.0f - 2.0f * (y * y + z * z)) * scale[j];
+		localTransform[0][1] = 2.0f * (x * y - z * w) * scale[j];
+		localTransform[0][2] = 2.0f * (x * z + y * w) * scale[j];
+		localTransform[1][0] = 2.0f * (x * y + z * w) * scale[stride + j];
+		localTransform[1][1] = (1.0f - 2.0f * (x * x + z * z)) * scale[stride + j];
+		localTransform[1][2] = 2.0f * (y * z - x * w) * scale[stride + j];
+		localTransform[2][0] = 2.0f * (x * z - y * w) * scale[2 * stride + j];
+		localTransform[2][1] = 2.0f * (y * z + x * w) * scale[2 * stride + j];
+		localTransform[2][2] = (1.0f - 2.0f * (x * x + y * y)) * scale[2 * stride + j];
+		localTransform[3][0] = translation[j];
+		localTransform[3][1] = translation[stride + j];
+		localTransform[3][2] = translation[2 * stride + j];
+
+		// Parents come before their children, so the parent transform is already in model-space.
+		modelTransforms[j] = parents[j] < 0 ? localTransform : modelTransforms[parents[j]] * localTransform;
+
+		if (matrixIndices[j] < jointMatrices.size()) {
+			jointMatrices[matrixIndices[j]] = modelTransforms[j] * inverseBindTransforms[j];
+		}
 	}
 }
 
-void Animator::DoAnimation(Animation *animation) {
+void Animator::DoAnimation(const CompiledAnimation *animation) {
 	m_animationTime = 0s;
 	m_currentAnimation = animation;
+	m_cursor = 0;
 }
 }
@@ -1,17 +1,13 @@
 #include "MeshAnimated.hpp"
 
-#include "Maths/Maths.hpp"
-#include "Files/File.hpp"
-#include "Maths/Matrix4.hpp"
-#include "Scenes/Entity.hpp"
-#include "Animation/AnimationLoader.hpp"
-#include "Skeleton/SkeletonLoader.hpp"
-#include "Skin/SkinLoader.hpp"
-#include "Geometry/GeometryLoader.hpp"
+#include "Engine/Engine.hpp"
+#include "Scenes/SceneStructure.hpp"
 #include "Maths/Transform.hpp"
 
 namespace acid {
-bool MeshAnimated::registered = Register("meshAnimated");
+bool MeshAnimated::registered = Register("meshAnimated") && RegisterBatchUpdate([](SceneStructure &structure, ThreadPool *pool) {
+	UpdateAll(structure.QueryComponents<MeshAnimated>(), Engine::Get()->GetDelta(), pool);
+});
 
 MeshAnimated::MeshAnimated(std::filesystem::path filename, std::unique_ptr<Material> &&material) :
 	m_material(std::move(material)),
@@ -25,46 +21,12 @@ void MeshAnimated::Start() {
 	if (m_filename.empty())
 		return;
 
-	//File file(m_filename, std::make_unique<Xml>("COLLADA"));
-	//file.Load();
-	//auto &fileNode = *file.GetNode();
-	File file(m_filename);
-	file.Load();
-	auto fileNode = (*file.GetNode())["COLLADA"];
+	// Every mesh loaded from the same file shares one skeletal model.
+	m_skeletalModel = SkeletalModel::Create(m_filename);
+	m_model = m_skeletalModel->GetModel();
 
-	// Because in Blender z is up, but Acid is y up. A correction must be applied to positions and normals.
-	static const auto Correction = Matrix4().Rotate(Maths::Radians(-90.0f), Vector3f::Right);
-
-	SkinLoader skinLoader(fileNode["library_controllers"], MaxWeights);
-	SkeletonLoader skeletonLoader(fileNode["library_visual_scenes"], skinLoader.GetJointOrder(), Correction);
-	GeometryLoader geometryLoader(fileNode["library_geometries"], skinLoader.GetVertexWeights(), Correction);
-
-	m_model = std::make_shared<Model>(geometryLoader.GetVertices(), geometryLoader.GetIndices());
-	m_headJoint = skeletonLoader.GetHeadJoint();
-
-	AnimationLoader animationLoader(fileNode["library_animations"], fileNode["library_visual_scenes"], Correction);
-
-	m_animation = std::make_unique<Animation>(animationLoader.GetLengthSeconds(), animationLoader.GetKeyframes());
-	m_animator.DoAnimation(m_animation.get());
-
-/*#if defined(ACID_DEBUG)
-	{
-		File fileModel("Animation/Model.json");
-		(*fileModel.GetNode())["vertices"].Set(m_model->GetVertices<VertexAnimated>());
-		(*fileModel.GetNode())["indices"].Set(m_model->GetIndices());
-		fileModel.Write(Node::Format::Beautified);
-	}
-	{
-		File fileJoints("Animation/Joints.json");
-		*fileJoints.GetNode() << m_headJoint;
-		fileJoints.Write(Node::Format::Beautified);
-	}
-	{
-		File fileAnimation0("Animation/Animation0.json");
-		*fileAnimation0.GetNode() << *m_animation;
-		fileAnimation0.Write(Node::Format::Beautified);
-	}
-#endif*/
+	if (auto animation = m_skeletalModel->GetAnimation())
+		m_animator.DoAnimation(animation);
 }
 
 void MeshAnimated::Update() {
@@ -72,10 +34,25 @@ void MeshAnimated::Update() {
 		auto transform = GetEntity()->GetComponent<Transform>();
 		m_material->PushUniforms(m_uniformObject, transform);
 	}
-	
-	std::vector<Matrix4> jointMatrices(MaxJoints);
-	m_animator.Update(m_headJoint, jointMatrices);
-	m_storageAnimation.Push(jointMatrices.data(), sizeof(Matrix4) * jointMatrices.size());
+}
+
+void MeshAnimated::UpdateAll(const std::vector<MeshAnimated *> &meshes, const Time &delta, ThreadPool *pool) {
+	auto update = [&meshes, &delta](std::size_t i) {
+		auto mesh = meshes[i];
+		if (!mesh->m_skeletalModel)
+			return;
+		mesh->m_jointMatrices.resize(MaxJoints);
+		mesh->m_animator.Update(delta, mesh->m_skeletalModel->GetSkeleton(), mesh->m_jointMatrices);
+		mesh->m_storageAnimation.Push(mesh->m_jointMatrices.data(), sizeof(Matrix4) * mesh->m_jointMatrices.size());
+	};
+
+	// Each mesh only writes its own animator and buffers.
+	if (pool) {
+		pool->ParallelFor(0, meshes.size(), update);
+	} else {
+		for (std::size_t i = 0; i < meshes.size(); i++)
+			update(i);
+	}
 }
 
 bool MeshAnimated::CmdRender(const CommandBuffer &commandBuffer, UniformHandler &uniformScene, const Pipeline::Stage &pipelineStage) {
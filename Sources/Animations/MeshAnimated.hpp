@@ -1,10 +1,10 @@
 #pragma once
 
 #include "Materials/Material.hpp"
-#include "Models/Model.hpp"
 #include "Scenes/Component.hpp"
 #include "Graphics/Buffers/StorageHandler.hpp"
-#include "Geometry/VertexAnimated.hpp"
+#include "Helpers/ThreadPool.hpp"
+#include "SkeletalModel.hpp"
 #include "Animator.hpp"
 
 namespace acid {
@@ -23,6 +23,14 @@ public:
 	void Start() override;
 	void Update() override;
 
+	/**
+	 * Advances the animation of every mesh and uploads their joint matrices, meshes are spread across the pool.
+	 * @param meshes The meshes to update.
+	 * @param delta The time since the last update.
+	 * @param pool The pool to update meshes on, or nullptr to update them on this thread.
+	 */
+	static void UpdateAll(const std::vector<MeshAnimated *> &meshes, const Time &delta, ThreadPool *pool = nullptr);
+
 	bool CmdRender(const CommandBuffer &commandBuffer, UniformHandler &uniformScene, const Pipeline::Stage &pipelineStage);
 
 	static Shader::VertexInput GetVertexInput(uint32_t binding = 0) { return VertexAnimated::GetVertexInput(binding); }
@@ -35,11 +43,14 @@ public:
 
 	StorageHandler &GetStorageAnimation() { return m_storageAnimation; }
 
+	const std::shared_ptr<SkeletalModel> &GetSkeletalModel() const { return m_skeletalModel; }
+	const std::vector<Matrix4> &GetJointMatrices() const { return m_jointMatrices; }
+
 	friend const Node &operator>>(const Node &node, MeshAnimated &meshAnimated);
 	friend Node &operator<<(Node &node, const MeshAnimated &meshAnimated);
 
 	static constexpr uint32_t MaxJoints = 50;
-	static constexpr uint32_t MaxWeights = 3;
+	static constexpr uint32_t MaxWeights = SkeletalModel::MaxWeights;
 
 private:
 	static bool registered;
@@ -48,10 +59,11 @@ private:
 	std::unique_ptr<Material> m_material;
 	
 	std::filesystem::path m_filename;
+	std::shared_ptr<SkeletalModel> m_skeletalModel;
+
+	// The only animation state each instance has, the time in the animation and the resulting joint matrices.
 	Animator m_animator;
-	Joint m_headJoint;
-	
-	std::unique_ptr<Animation> m_animation;
+	std::vector<Matrix4> m_jointMatrices;
 
 	DescriptorsHandler m_descriptorSet;
 	UniformHandler m_uniformObject;
@@ -0,0 +1,261 @@
+#include "SkeletalModel.hpp"
+
+#include <cstring>
+#include <fstream>
+
+#include "Engine/Log.hpp"
+#include "Files/File.hpp"
+#include "Files/Files.hpp"
+#include "Maths/Maths.hpp"
+#include "Resources/Resources.hpp"
+#include "Animation/AnimationLoader.hpp"
+#include "Skeleton/SkeletonLoader.hpp"
+#include "Skin/SkinLoader.hpp"
+#include "Geometry/GeometryLoader.hpp"
+
+namespace acid {
+static constexpr std::string_view BakedIdentifier = "ASKM";
+static constexpr uint32_t BakedVersion = 1;
+// The identifier, version, counts and animation length, before the arrays.
+static constexpr std::size_t BakedHeaderLength = 40;
+
+static void WriteValue(std::string &data, std::size_t offset, uint64_t value, std::size_t length) {
+	for (std::size_t i = 0; i < length; i++)
+		data[offset + i] = static_cast<char>(value >> 8 * i);
+}
+
+static uint64_t ReadValue(std::string_view data, std::size_t offset, std::size_t length) {
+	uint64_t value = 0;
+	for (std::size_t i = 0; i < length; i++)
+		value |= static_cast<uint64_t>(static_cast<uint8_t>(data[offset + i])) << 8 * i;
+	return value;
+}
+
+// Arrays are copied as they are in memory, baked files are read on the same platforms they are written on.
+template<typename T>
+static void WriteArray(std::string &data, const std::vector<T> &values) {
+	data.append(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+}
+
+template<typename T>
+static std::vector<T> ReadArray(std::string_view data, std::size_t &offset, std::size_t count) {
+	std::vector<T> values(count);
+	std::memcpy(values.data(), data.data() + offset, count * sizeof(T));
+	offset += count * sizeof(T);
+	return values;
+}
+
+std::shared_ptr<SkeletalModel> SkeletalModel::Create(const Node &node) {
+	if (auto resource = Resources::Get()->Find<SkeletalModel>(node))
+		return resource;
+
+	auto result = std::make_shared<SkeletalModel>("");
+	Resources::Get()->Add(node, std::dynamic_pointer_cast<Resource>(result));
+	node >> *result;
+	result->Load();
+	return result;
+}
+
+std::shared_ptr<SkeletalModel> SkeletalModel::Create(const std::filesystem::path &filename) {
+	SkeletalModel temp(filename, false);
+	Node node;
+	node << temp;
+	return Create(node);
+}
+
+SkeletalModel::SkeletalModel(std::filesystem::path filename, bool load) :
+	m_filename(std::move(filename)) {
+	if (load) {
+		Load();
+	}
+}
+
+void SkeletalModel::LoadCollada(const Node &collada) {
+	// Because in Blender z is up, but Acid is y up. A correction must be applied to positions and normals.
+	static const auto Correction = Matrix4().Rotate(Maths::Radians(-90.0f), Vector3f::Right);
+
+	SkinLoader skinLoader(collada["library_controllers"], MaxWeights);
+	SkeletonLoader skeletonLoader(collada["library_visual_scenes"], skinLoader.GetJointOrder(), Correction);
+	GeometryLoader geometryLoader(collada["library_geometries"], skinLoader.GetVertexWeights(), Correction);
+	AnimationLoader animationLoader(collada["library_animations"], collada["library_visual_scenes"], Correction);
+
+	m_vertices = geometryLoader.GetVertices();
+	m_indices = geometryLoader.GetIndices();
+	m_skeleton = Skeleton(skeletonLoader.GetHeadJoint());
+	m_animation = std::make_unique<CompiledAnimation>(Animation(animationLoader.GetLengthSeconds(), animationLoader.GetKeyframes()), m_skeleton);
+}
+
+bool SkeletalModel::LoadMemory(std::string_view data) {
+	if (data.size() < BakedHeaderLength || data.substr(0, BakedIdentifier.size()) != BakedIdentifier || ReadValue(data, 4, 4) != BakedVersion)
+		return false;
+
+	auto vertexCount = ReadValue(data, 8, 4);
+	auto indexCount = ReadValue(data, 12, 4);
+	auto jointCount = static_cast<uint32_t>(ReadValue(data, 16, 4));
+	auto keyframeCount = ReadValue(data, 20, 4);
+	auto length = Time::Microseconds(static_cast<int64_t>(ReadValue(data, 24, 8)));
+	auto namesLength = ReadValue(data, 32, 4);
+
+	// Each array is checked against what is left of the data, so the counts of a corrupt file can not overflow.
+	auto remaining = static_cast<uint64_t>(data.size() - BakedHeaderLength);
+	auto fits = [&remaining](uint64_t count, uint64_t size) {
+		if (size != 0 && count > remaining / size)
+			return false;
+		remaining -= count * size;
+		return true;
+	};
+
+	if (keyframeCount == 0 || !fits(vertexCount, sizeof(VertexAnimated)) || !fits(indexCount, sizeof(uint32_t)) ||
+		!fits(jointCount, sizeof(int32_t) + sizeof(uint32_t) + 2 * sizeof(Matrix4)))
+		return false;
+
+	auto poseLength = static_cast<uint64_t>(CompiledAnimation::TrackCount) * ((static_cast<uint64_t>(jointCount) + 3) & ~uint64_t(3));
+
+	if (!fits(keyframeCount, (1 + poseLength) * sizeof(float)) || !fits(namesLength, 1))
+		return false;
+
+	std::size_t offset = BakedHeaderLength;
+	m_vertices = ReadArray<VertexAnimated>(data, offset, vertexCount);
+	m_indices = ReadArray<uint32_t>(data, offset, indexCount);
+	auto parents = ReadArray<int32_t>(data, offset, jointCount);
+	auto matrixIndices = ReadArray<uint32_t>(data, offset, jointCount);
+	auto localBindTransforms = ReadArray<Matrix4>(data, offset, jointCount);
+	auto inverseBindTransforms = ReadArray<Matrix4>(data, offset, jointCount);
+	auto times = ReadArray<float>(data, offset, keyframeCount);
+	auto tracks = ReadArray<float>(data, offset, keyframeCount * poseLength);
+
+	// Names are stored one after the other, each ending with a null character.
+	std::vector<std::string> names;
+	names.reserve(jointCount);
+	auto namesData = data.substr(offset, namesLength);
+
+	for (uint32_t i = 0; i < jointCount; i++) {
+		auto end = namesData.find('\0');
+		if (end == std::string_view::npos)
+			return false;
+		names.emplace_back(namesData.substr(0, end));
+		namesData.remove_prefix(end + 1);
+	}
+
+	// Parents come before their children, the head joint has no parent.
+	for (uint32_t i = 0; i < jointCount; i++) {
+		if (parents[i] < -1 || parents[i] >= static_cast<int32_t>(i))
+			return false;
+	}
+
+	m_skeleton = Skeleton(std::move(names), std::move(parents), std::move(matrixIndices), std::move(localBindTransforms), std::move(inverseBindTransforms));
+	m_animation = std::make_unique<CompiledAnimation>(length, jointCount, std::move(times), std::move(tracks));
+	return true;
+}
+
+bool SkeletalModel::Bake(const std::filesystem::path &source, const std::filesystem::path &destination) {
+	SkeletalModel skeletalModel(source, false);
+	if (!skeletalModel.LoadSource())
+		return false;
+
+	skeletalModel.Write(destination);
+	return true;
+}
+
+void SkeletalModel::Write(const std::filesystem::path &filename) const {
+	if (auto parentPath = filename.parent_path(); !parentPath.empty())
+		std::filesystem::create_directories(parentPath);
+
+	auto data = WriteMemory();
+	std::ofstream os(filename, std::ios::binary | std::ios::out);
+	os.write(data.data(), data.size());
+}
+
+std::string SkeletalModel::WriteMemory() const {
+	std::string names;
+	for (const auto &name : m_skeleton.GetNames()) {
+		names += name;
+		names += '\0';
+	}
+
+	std::string data(BakedHeaderLength, '\0');
+	data.replace(0, BakedIdentifier.size(), BakedIdentifier);
+	WriteValue(data, 4, BakedVersion, 4);
+	WriteValue(data, 8, m_vertices.size(), 4);
+	WriteValue(data, 12, m_indices.size(), 4);
+	WriteValue(data, 16, m_skeleton.GetJointCount(), 4);
+	WriteValue(data, 20, m_animation ? m_animation->GetKeyframeCount() : 0, 4);
+	WriteValue(data, 24, m_animation ? static_cast<uint64_t>(m_animation->GetLength().AsMicroseconds()) : 0, 8);
+	WriteValue(data, 32, names.size(), 4);
+
+	WriteArray(data, m_vertices);
+	WriteArray(data, m_indices);
+	WriteArray(data, m_skeleton.GetParents());
+	WriteArray(data, m_skeleton.GetMatrixIndices());
+	WriteArray(data, m_skeleton.GetLocalBindTransforms());
+	WriteArray(data, m_skeleton.GetInverseBindTransforms());
+
+	if (m_animation) {
+		WriteArray(data, m_animation->GetTimes());
+		WriteArray(data, m_animation->GetTracks());
+	}
+
+	data += names;
+	return data;
+}
+
+const Node &operator>>(const Node &node, SkeletalModel &skeletalModel) {
+	node["filename"].Get(skeletalModel.m_filename);
+	return node;
+}
+
+Node &operator<<(Node &node, const SkeletalModel &skeletalModel) {
+	node["filename"].Set(skeletalModel.m_filename);
+	return node;
+}
+
+void SkeletalModel::Load() {
+	if (m_filename.empty()) {
+		return;
+	}
+
+#if defined(ACID_DEBUG)
+	auto debugStart = Time::Now();
+#endif
+
+	if (!LoadSource())
+		return;
+
+	// Instances only render the model, so the geometry is not kept after it is uploaded.
+	m_model = std::make_shared<Model>(m_vertices, m_indices);
+	m_vertices = {};
+	m_indices = {};
+
+#if defined(ACID_DEBUG)
+	Log::Out("Skeletal model ", m_filename, " loaded in ", (Time::Now() - debugStart).AsMilliseconds<float>(), "ms\n");
+#endif
+}
+bool SkeletalModel::LoadSource() {
+	if (m_filename.extension() == BakedExtension) {
+		std::optional<std::string> fileLoaded;
+		auto fileView = Files::ReadView(m_filename);
+		if (!fileView && (fileLoaded = Files::Read(m_filename)))
+			fileView = *fileLoaded;
+
+		if (!fileView || !LoadMemory(*fileView)) {
+			Log::Error("Skeletal model could not be loaded: ", m_filename, '\n');
+			return false;
+		}
+
+		return true;
+	}
+
+	if (!Files::ExistsInPath(m_filename) && !std::filesystem::exists(m_filename)) {
+		Log::Error("Skeletal model could not be found: ", m_filename, '\n');
+		return false;
+	}
+
+	//File file(m_filename, std::make_unique<Xml>("COLLADA"));
+	//file.Load();
+	//auto &fileNode = *file.GetNode();
+	File file(m_filename);
+	file.Load();
+	LoadCollada((*file.GetNode())["COLLADA"]);
+	return true;
+}
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "Models/Model.hpp"
+#include "Geometry/VertexAnimated.hpp"
+#include "Animation/CompiledAnimation.hpp"
+
+namespace acid {
+/**
+ * @brief Resource that represents the parts of a animated mesh every instance shares, the model, skeleton and compiled animation.
+ * Loaded from a COLLADA document, or from a baked file written by {@link SkeletalModel#Write} that is loaded with a single read.
+ */
+class ACID_EXPORT SkeletalModel : public Resource {
+public:
+	// The extension of baked files, any other file is loaded as a COLLADA document.
+	static constexpr std::string_view BakedExtension = ".skm";
+	static constexpr uint32_t MaxWeights = 3;
+
+	/**
+	 * Creates a new skeletal model, or finds one with the same values.
+	 * @param node The node to decode values from.
+	 * @return The skeletal model with the requested values.
+	 */
+	static std::shared_ptr<SkeletalModel> Create(const Node &node);
+
+	/**
+	 * Creates a new skeletal model, or finds one with the same values.
+	 * @param filename The file to load the skeletal model from.
+	 * @return The skeletal model with the requested values.
+	 */
+	static std::shared_ptr<SkeletalModel> Create(const std::filesystem::path &filename);
+
+	/**
+	 * Creates a new skeletal model.
+	 * @param filename The file to load the skeletal model from.
+	 * @param load If this resource will be loaded immediately, otherwise {@link SkeletalModel#Load} can be called later.
+	 */
+	explicit SkeletalModel(std::filesystem::path filename, bool load = true);
+
+	std::type_index GetTypeIndex() const override { return typeid(SkeletalModel); }
+
+	/**
+	 * Loads the skeleton, geometry and first animation from a COLLADA document.
+	 * @param collada The COLLADA node.
+	 */
+	void LoadCollada(const Node &collada);
+
+	/**
+	 * Loads from the contents of a baked file.
+	 * @param data The file contents.
+	 * @return If the data was a valid baked file.
+	 */
+	bool LoadMemory(std::string_view data);
+
+	/**
+	 * Loads a COLLADA document and writes it as a baked file, without uploading the geometry.
+	 * @param source The COLLADA file.
+	 * @param destination The baked file to write to.
+	 * @return If the source was loaded.
+	 */
+	static bool Bake(const std::filesystem::path &source, const std::filesystem::path &destination);
+
+	/**
+	 * Writes a baked file, the geometry must not have been uploaded yet, so it is only valid before {@link SkeletalModel#Load}
+	 * or after {@link SkeletalModel#LoadCollada} or {@link SkeletalModel#LoadMemory}.
+	 * @param filename The file to write to.
+	 */
+	void Write(const std::filesystem::path &filename) const;
+	std::string WriteMemory() const;
+
+	const std::filesystem::path &GetFilename() const { return m_filename; }
+	const std::shared_ptr<Model> &GetModel() const { return m_model; }
+	const Skeleton &GetSkeleton() const { return m_skeleton; }
+	const CompiledAnimation *GetAnimation() const { return m_animation.get(); }
+
+	/**
+	 * Gets the vertices that have not been uploaded to {@link SkeletalModel#GetModel}, they are released once uploaded.
+	 * @return The vertices.
+	 */
+	const std::vector<VertexAnimated> &GetVertices() const { return m_vertices; }
+	const std::vector<uint32_t> &GetIndices() const { return m_indices; }
+
+	friend const Node &operator>>(const Node &node, SkeletalModel &skeletalModel);
+	friend Node &operator<<(Node &node, const SkeletalModel &skeletalModel);
+
+private:
+	void Load();
+	bool LoadSource();
+
+	std::filesystem::path m_filename;
+
+	std::shared_ptr<Model> m_model;
+	Skeleton m_skeleton;
+	std::unique_ptr<CompiledAnimation> m_animation;
+
+	std::vector<VertexAnimated> m_vertices;
+	std::vector<uint32_t> m_indices;
+};
+}
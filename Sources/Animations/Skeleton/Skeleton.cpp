@@ -0,0 +1,38 @@
+#include "Skeleton.hpp"
+
+namespace acid {
+Skeleton::Skeleton(const Joint &headJoint) {
+	AddJoint(headJoint, -1);
+}
+
+Skeleton::Skeleton(std::vector<std::string> names, std::vector<int32_t> parents, std::vector<uint32_t> matrixIndices,
+	std::vector<Matrix4> localBindTransforms, std::vector<Matrix4> inverseBindTransforms) :
+	m_names(std::move(names)),
+	m_parents(std::move(parents)),
+	m_matrixIndices(std::move(matrixIndices)),
+	m_localBindTransforms(std::move(localBindTransforms)),
+	m_inverseBindTransforms(std::move(inverseBindTransforms)) {
+}
+
+std::optional<uint32_t> Skeleton::FindJoint(std::string_view name) const {
+	for (uint32_t i = 0; i < m_names.size(); i++) {
+		if (m_names[i] == name)
+			return i;
+	}
+
+	return std::nullopt;
+}
+
+void Skeleton::AddJoint(const Joint &joint, int32_t parent) {
+	auto index = static_cast<int32_t>(m_names.size());
+	m_names.emplace_back(joint.GetName());
+	m_parents.emplace_back(parent);
+	m_matrixIndices.emplace_back(joint.GetIndex());
+	m_localBindTransforms.emplace_back(joint.GetLocalBindTransform());
+	m_inverseBindTransforms.emplace_back(joint.GetInverseBindTransform());
+
+	// Depth first, so each joint comes after its parent.
+	for (const auto &child : joint.GetChildren())
+		AddJoint(child, index);
+}
+}
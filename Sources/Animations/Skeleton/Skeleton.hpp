@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Joint.hpp"
+
+namespace acid {
+/**
+ * @brief Class that represents a joint hierarchy flattened into arrays, joints are referenced by index instead of by name.
+ * Joints are ordered so every parent comes before its children, so a pose is resolved to model-space in a single pass.
+ */
+class ACID_EXPORT Skeleton {
+public:
+	/**
+	 * Creates a new empty skeleton.
+	 */
+	Skeleton() = default;
+
+	/**
+	 * Creates a new skeleton from a joint hierarchy, the inverse bind transforms must already be calculated.
+	 * @param headJoint The root joint of the hierarchy.
+	 */
+	explicit Skeleton(const Joint &headJoint);
+
+	/**
+	 * Creates a new skeleton from flattened arrays, every array has one value per joint.
+	 * @param names The joint names.
+	 * @param parents The index of each joints parent, each parent must come before its children.
+	 * @param matrixIndices The index in the joint matrix array each joint is written to.
+	 * @param localBindTransforms The bone-space bind transforms.
+	 * @param inverseBindTransforms The inverse model-space bind transforms.
+	 */
+	Skeleton(std::vector<std::string> names, std::vector<int32_t> parents, std::vector<uint32_t> matrixIndices,
+		std::vector<Matrix4> localBindTransforms, std::vector<Matrix4> inverseBindTransforms);
+
+	/**
+	 * Finds a joint by the name it has in the file it was loaded from.
+	 * @param name The name of the joint.
+	 * @return The index of the joint in this skeleton, or std::nullopt if there is no joint with that name.
+	 */
+	std::optional<uint32_t> FindJoint(std::string_view name) const;
+
+	uint32_t GetJointCount() const { return static_cast<uint32_t>(m_names.size()); }
+
+	const std::vector<std::string> &GetNames() const { return m_names; }
+
+	/**
+	 * Gets the index of each joints parent, the root joint has the parent -1.
+	 * @return The parent indices.
+	 */
+	const std::vector<int32_t> &GetParents() const { return m_parents; }
+
+	/**
+	 * Gets the index in the joint matrix array each joint is written to, this is the index from {@link Joint#GetIndex}.
+	 * @return The matrix indices.
+	 */
+	const std::vector<uint32_t> &GetMatrixIndices() const { return m_matrixIndices; }
+
+	const std::vector<Matrix4> &GetLocalBindTransforms() const { return m_localBindTransforms; }
+	const std::vector<Matrix4> &GetInverseBindTransforms() const { return m_inverseBindTransforms; }
+
+private:
+	void AddJoint(const Joint &joint, int32_t parent);
+
+	std::vector<std::string> m_names;
+	std::vector<int32_t> m_parents;
+	std::vector<uint32_t> m_matrixIndices;
+	std::vector<Matrix4> m_localBindTransforms;
+	std::vector<Matrix4> m_inverseBindTransforms;
+};
+}
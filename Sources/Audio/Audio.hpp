@@ -2,6 +2,7 @@
 
 #include "Engine/Engine.hpp"
 #include "Helpers/Delegate.hpp"
+#include "Scenes/Scenes.hpp"
 
 typedef struct ALCdevice_struct ALCdevice;
 typedef struct ALCcontext_struct ALCcontext;
@@ -10,7 +11,7 @@ namespace acid {
 /**
  * @brief Module used for loading, managing and playing a variety of different sound types.
  */
-class ACID_EXPORT Audio : public Module::Registrar<Audio, Module::Stage::Pre> {
+class ACID_EXPORT Audio : public Module::Registrar<Audio, Module::Stage::Pre, Module::Concurrent, Module::Reads<Scenes>> {
 public:
 	enum class Type { Master, General, Effect, Music };
 
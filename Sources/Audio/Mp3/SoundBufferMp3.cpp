@@ -9,7 +9,6 @@
 #include "Files/Files.hpp"
 #include "Maths/Time.hpp"
 
-#define DR_MP3_IMPLEMENTATION
 #define DR_MP3_NO_STDIO
 #define DR_MP3_NO_SIMD
 #include "dr_mp3.h"
@@ -39,7 +38,8 @@ void SoundBufferMp3::Load(SoundBuffer *soundBuffer, const std::filesystem::path
 
 	uint32_t buffer;
 	alGenBuffers(1, &buffer);
-	alBufferData(buffer, (config.outputChannels == 2) ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16, sampleData, totalPCMFrameCount, config.outputSampleRate);
+	alBufferData(buffer, (config.outputChannels == 2) ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16, sampleData,
+		static_cast<ALsizei>(totalPCMFrameCount * config.outputChannels * sizeof(int16_t)), config.outputSampleRate);
 
 	Audio::CheckAl(alGetError());
 
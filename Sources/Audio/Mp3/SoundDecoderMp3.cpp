@@ -0,0 +1,58 @@
+#include "SoundDecoderMp3.hpp"
+
+#include <stdexcept>
+
+#define DR_MP3_IMPLEMENTATION
+#define DR_MP3_NO_STDIO
+#define DR_MP3_NO_SIMD
+#include "dr_mp3.h"
+
+namespace acid {
+// The dr_mp3 decoder, a class so the header does not need dr_mp3.h.
+class SoundDecoderMp3::Mp3 : public drmp3 {
+};
+
+bool SoundDecoderMp3::registered = Register(".mp3");
+
+static size_t OnRead(void *userData, void *bufferOut, size_t bytesToRead) {
+	auto stream = static_cast<std::istream *>(userData);
+	stream->read(static_cast<char *>(bufferOut), bytesToRead);
+	auto bytesRead = static_cast<size_t>(stream->gcount());
+	// Reading past the end sets the fail bit, it is cleared so the stream can still seek.
+	stream->clear();
+	return bytesRead;
+}
+
+static drmp3_bool32 OnSeek(void *userData, int offset, drmp3_seek_origin origin) {
+	auto stream = static_cast<std::istream *>(userData);
+	stream->seekg(offset, origin == drmp3_seek_origin_start ? std::ios::beg : std::ios::cur);
+	return !stream->fail();
+}
+
+SoundDecoderMp3::SoundDecoderMp3(std::unique_ptr<std::istream> &&stream) :
+	m_stream(std::move(stream)),
+	m_mp3(std::make_unique<Mp3>()) {
+	if (!m_stream || !drmp3_init(m_mp3.get(), &OnRead, &OnSeek, m_stream.get(), nullptr, nullptr)) {
+		m_mp3 = nullptr;
+		throw std::runtime_error("Failed to read mp3 header");
+	}
+
+	m_channels = m_mp3->channels;
+	m_sampleRate = m_mp3->sampleRate;
+	// Mp3 files have no frame count in their header, every frame header is read and the decoder seeks back to the start.
+	m_frameCount = drmp3_get_pcm_frame_count(m_mp3.get());
+}
+
+SoundDecoderMp3::~SoundDecoderMp3() {
+	if (m_mp3)
+		drmp3_uninit(m_mp3.get());
+}
+
+uint64_t SoundDecoderMp3::Read(int16_t *samples, uint64_t frameCount) {
+	return drmp3_read_pcm_frames_s16(m_mp3.get(), frameCount, samples);
+}
+
+bool SoundDecoderMp3::Seek(uint64_t frame) {
+	return drmp3_seek_to_pcm_frame(m_mp3.get(), frame);
+}
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Audio/SoundDecoder.hpp"
+
+namespace acid {
+class ACID_EXPORT SoundDecoderMp3 : public SoundDecoder::Registrar<SoundDecoderMp3> {
+public:
+	explicit SoundDecoderMp3(std::unique_ptr<std::istream> &&stream);
+	~SoundDecoderMp3();
+
+	uint64_t Read(int16_t *samples, uint64_t frameCount) override;
+	bool Seek(uint64_t frame) override;
+
+private:
+	class Mp3;
+
+	static bool registered;
+
+	std::unique_ptr<std::istream> m_stream;
+	std::unique_ptr<Mp3> m_mp3;
+};
+}
@@ -9,6 +9,7 @@
 #include "Files/Files.hpp"
 #include "Maths/Time.hpp"
 
+#define STB_VORBIS_HEADER_ONLY
 #define STB_VORBIS_NO_STDIO
 #include "stb_vorbis.c"
 
@@ -39,7 +40,7 @@ void SoundBufferOgg::Load(SoundBuffer *soundBuffer, const std::filesystem::path
 
 	uint32_t buffer;
 	alGenBuffers(1, &buffer);
-	alBufferData(buffer, (channels == 2) ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16, data, size, samplesPerSec);
+	alBufferData(buffer, (channels == 2) ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16, data, size * channels * static_cast<ALsizei>(sizeof(int16_t)), samplesPerSec);
 
 	Audio::CheckAl(alGetError());
 
@@ -0,0 +1,41 @@
+#include "SoundDecoderOgg.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <iterator>
+#include <stdexcept>
+
+#define STB_VORBIS_NO_STDIO
+#include "stb_vorbis.c"
+
+namespace acid {
+bool SoundDecoderOgg::registered = Register(".ogg");
+
+SoundDecoderOgg::SoundDecoderOgg(std::unique_ptr<std::istream> &&stream) {
+	if (stream)
+		m_data.assign(std::istreambuf_iterator<char>(*stream), {});
+
+	int error = 0;
+	m_vorbis = stb_vorbis_open_memory(m_data.data(), static_cast<int>(m_data.size()), &error, nullptr);
+	if (!m_vorbis)
+		throw std::runtime_error("Failed to read ogg header, error " + std::to_string(error));
+
+	auto info = stb_vorbis_get_info(m_vorbis);
+	m_channels = static_cast<uint32_t>(info.channels);
+	m_sampleRate = info.sample_rate;
+	m_frameCount = stb_vorbis_stream_length_in_samples(m_vorbis);
+}
+
+SoundDecoderOgg::~SoundDecoderOgg() {
+	stb_vorbis_close(m_vorbis);
+}
+
+uint64_t SoundDecoderOgg::Read(int16_t *samples, uint64_t frameCount) {
+	auto sampleCount = static_cast<int>(std::min<uint64_t>(frameCount * m_channels, INT_MAX));
+	return static_cast<uint64_t>(stb_vorbis_get_samples_short_interleaved(m_vorbis, static_cast<int>(m_channels), samples, sampleCount));
+}
+
+bool SoundDecoderOgg::Seek(uint64_t frame) {
+	return stb_vorbis_seek(m_vorbis, static_cast<unsigned int>(frame)) != 0;
+}
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <vector>
+
+#include "Audio/SoundDecoder.hpp"
+
+typedef struct stb_vorbis stb_vorbis;
+
+namespace acid {
+/**
+ * @brief Class that decodes ogg vorbis files, stb_vorbis can only stream from memory so the compressed file is held, samples are still decoded a chunk at a time.
+ */
+class ACID_EXPORT SoundDecoderOgg : public SoundDecoder::Registrar<SoundDecoderOgg> {
+public:
+	explicit SoundDecoderOgg(std::unique_ptr<std::istream> &&stream);
+	~SoundDecoderOgg();
+
+	uint64_t Read(int16_t *samples, uint64_t frameCount) override;
+	bool Seek(uint64_t frame) override;
+
+private:
+	static bool registered;
+
+	std::vector<uint8_t> m_data;
+	stb_vorbis *m_vorbis = nullptr;
+};
+}
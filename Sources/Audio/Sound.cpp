@@ -5,19 +5,36 @@
 #else
 #include <al.h>
 #endif
+#include "Files/Files.hpp"
 #include "Maths/Transform.hpp"
 #include "Scenes/Entity.hpp"
 
 namespace acid {
+// A streamed sound queues at most this many chunks, about 1.5 seconds of samples at 44.1kHz.
+static constexpr uint32_t StreamBufferCount = 4;
+static constexpr uint64_t StreamChunkFrames = 16384;
+
 bool Sound::registered = Register("sound");
 
-Sound::Sound(const std::string &filename, const Audio::Type &type, bool begin, bool loop, float gain, float pitch) :
-	m_buffer(SoundBuffer::Create(filename)),
+Sound::Sound(const std::string &filename, const Audio::Type &type, bool begin, bool loop, float gain, float pitch, bool stream) :
 	m_type(type),
 	m_gain(gain),
 	m_pitch(pitch) {
 	alGenSources(1, &m_source);
-	alSourcei(m_source, AL_BUFFER, m_buffer->GetBuffer());
+
+	if (stream) {
+		try {
+			if (auto decoder = SoundDecoder::Create(std::filesystem::path(filename).extension().string(), std::make_unique<IFStream>(filename))) {
+				m_streamSink = std::make_unique<StreamSink>(m_source);
+				m_stream = std::make_unique<SoundStream>(std::move(decoder), m_streamSink.get(), StreamChunkFrames);
+			}
+		} catch (const std::exception &e) {
+			Log::Error("Sound could not be streamed: ", filename, ", ", e.what(), '\n');
+		}
+	} else {
+		m_buffer = SoundBuffer::Create(filename);
+		alSourcei(m_source, AL_BUFFER, m_buffer->GetBuffer());
+	}
 
 	Audio::CheckAl(alGetError());
 
@@ -36,6 +53,9 @@ Sound::Sound(const std::string &filename, const Audio::Type &type, bool begin, b
 }
 
 Sound::~Sound() {
+	// The stream thread queues buffers to the source, so it is stopped before the source is deleted.
+	m_stream = nullptr;
+	m_streamSink = nullptr;
 	alDeleteSources(1, &m_source);
 	Audio::CheckAl(alGetError());
 }
@@ -50,14 +70,25 @@ void Sound::Update() {
 }
 
 void Sound::Play(bool loop) {
-	alSourcei(m_source, AL_LOOPING, loop);
-	alSourcePlay(m_source);
-	Audio::CheckAl(alGetError());
+	if (m_stream) {
+		// Streams loop by decoding from the start again, the source starts once the first chunk is queued.
+		m_stream->SetLoop(loop);
+		m_streamSink->SetPlaying(true);
+		m_stream->Seek(0);
+	} else {
+		alSourcei(m_source, AL_LOOPING, loop);
+		alSourcePlay(m_source);
+		Audio::CheckAl(alGetError());
+	}
 
 	SetGain(m_gain);
 }
 
 void Sound::Pause() {
+	// A stream that ran out of chunks is not playing but would restart when the next chunk is queued.
+	if (m_streamSink)
+		m_streamSink->SetPlaying(false);
+
 	if (!IsPlaying()) {
 		return;
 	}
@@ -71,6 +102,9 @@ void Sound::Resume() {
 		return;
 	}
 
+	if (m_streamSink)
+		m_streamSink->SetPlaying(true);
+
 	alSourcePlay(m_source);
 	Audio::CheckAl(alGetError());
 
@@ -78,6 +112,15 @@ void Sound::Resume() {
 }
 
 void Sound::Stop() {
+	if (m_stream) {
+		// A stream that ran out of chunks is not playing but would restart, so it is always stopped and decodes from the start again.
+		m_streamSink->SetPlaying(false);
+		alSourceStop(m_source);
+		Audio::CheckAl(alGetError());
+		m_stream->Seek(0);
+		return;
+	}
+
 	if (!IsPlaying()) {
 		return;
 	}
@@ -92,6 +135,16 @@ bool Sound::IsPlaying() const {
 	return state == AL_PLAYING;
 }
 
+void Sound::Seek(const Time &time) {
+	if (m_stream) {
+		m_stream->Seek(static_cast<uint64_t>(time.AsSeconds<double>() * m_stream->GetDecoder().GetSampleRate()));
+		return;
+	}
+
+	alSourcef(m_source, AL_SEC_OFFSET, time.AsSeconds());
+	Audio::CheckAl(alGetError());
+}
+
 void Sound::SetPosition(const Vector3f &position) {
 	m_position = position;
 	alSource3f(m_source, AL_POSITION, m_position.m_x, m_position.m_y, m_position.m_z);
@@ -122,6 +175,68 @@ void Sound::SetPitch(float pitch) {
 	Audio::CheckAl(alGetError());
 }
 
+Sound::StreamSink::StreamSink(uint32_t source) :
+	m_source(source),
+	m_buffers(StreamBufferCount) {
+	alGenBuffers(static_cast<ALsizei>(m_buffers.size()), m_buffers.data());
+	Audio::CheckAl(alGetError());
+	m_freeBuffers = m_buffers;
+}
+
+Sound::StreamSink::~StreamSink() {
+	alSourceStop(m_source);
+	alSourcei(m_source, AL_BUFFER, 0);
+	alDeleteBuffers(static_cast<ALsizei>(m_buffers.size()), m_buffers.data());
+	Audio::CheckAl(alGetError());
+}
+
+uint32_t Sound::StreamSink::GetFreeChunks() {
+	ALint processed = 0;
+	alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &processed);
+
+	for (ALint i = 0; i < processed; i++) {
+		ALuint buffer;
+		alSourceUnqueueBuffers(m_source, 1, &buffer);
+		m_freeBuffers.emplace_back(buffer);
+	}
+
+	Audio::CheckAl(alGetError());
+	return static_cast<uint32_t>(m_freeBuffers.size());
+}
+
+void Sound::StreamSink::SetPlaying(bool playing) {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_playing = playing;
+}
+
+void Sound::StreamSink::Queue(const int16_t *samples, uint64_t frameCount, uint32_t channels, uint32_t sampleRate) {
+	auto buffer = m_freeBuffers.back();
+	m_freeBuffers.pop_back();
+
+	alBufferData(buffer, (channels == 2) ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16, samples, static_cast<ALsizei>(frameCount * channels * sizeof(int16_t)),
+		static_cast<ALsizei>(sampleRate));
+	alSourceQueueBuffers(m_source, 1, &buffer);
+
+	// A source that plays every queued chunk stops, it is restarted once a chunk is queued again.
+	// The state is checked under the lock so a pause or stop that has set playing to false is never undone.
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		ALint state;
+		alGetSourcei(m_source, AL_SOURCE_STATE, &state);
+		if (m_playing && state != AL_PLAYING)
+			alSourcePlay(m_source);
+	}
+
+	Audio::CheckAl(alGetError());
+}
+
+void Sound::StreamSink::Flush() {
+	alSourceStop(m_source);
+	alSourcei(m_source, AL_BUFFER, 0);
+	Audio::CheckAl(alGetError());
+	m_freeBuffers = m_buffers;
+}
+
 const Node &operator>>(const Node &node, Sound &sound) {
 	node["buffer"].Get(sound.m_buffer);
 	node["type"].Get(sound.m_type);
@@ -3,17 +3,19 @@
 #include "Maths/Vector3.hpp"
 #include "Scenes/Component.hpp"
 #include "SoundBuffer.hpp"
+#include "SoundStream.hpp"
 #include "Audio.hpp"
 
 namespace acid {
 /**
  * @brief Class that represents a playable sound.
+ * A sound is fully decoded into one buffer, unless it is streamed where chunks are decoded on a background thread as it plays.
  */
 class ACID_EXPORT Sound : public Component::Registrar<Sound> {
 public:
 	Sound() = default;
 	explicit Sound(const std::string &filename, const Audio::Type &type = Audio::Type::General, bool begin = false,
-		bool loop = false, float gain = 1.0f, float pitch = 1.0f);
+		bool loop = false, float gain = 1.0f, float pitch = 1.0f, bool stream = false);
 
 	~Sound();
 
@@ -27,6 +29,14 @@ public:
 
 	bool IsPlaying() const;
 
+	/**
+	 * Moves playback to a time from the start of the sound.
+	 * @param time The time to play from.
+	 */
+	void Seek(const Time &time);
+
+	bool IsStreaming() const { return m_stream != nullptr; }
+
 	void SetPosition(const Vector3f &position);
 	void SetDirection(const Vector3f &direction);
 	void SetVelocity(const Vector3f &velocity);
@@ -44,10 +54,40 @@ public:
 	friend Node &operator<<(Node &node, const Sound &sound);
 
 private:
+	/**
+	 * @brief Sink that queues streamed chunks to the source through a small ring of buffers.
+	 */
+	class StreamSink : public SoundSink {
+	public:
+		explicit StreamSink(uint32_t source);
+		~StreamSink();
+
+		uint32_t GetFreeChunks() override;
+		void Queue(const int16_t *samples, uint64_t frameCount, uint32_t channels, uint32_t sampleRate) override;
+		void Flush() override;
+
+		/**
+		 * Sets if the source is restarted when it ran out of chunks, once this returns a chunk being queued will not restart the source.
+		 * @param playing If the source is restarted.
+		 */
+		void SetPlaying(bool playing);
+
+	private:
+		uint32_t m_source;
+		std::vector<uint32_t> m_buffers;
+		std::vector<uint32_t> m_freeBuffers;
+		// Guards the restart in Queue against the source being paused or stopped.
+		std::mutex m_mutex;
+		// If the source is restarted when it ran out of chunks before the next chunk was queued.
+		bool m_playing = false;
+	};
+
 	static bool registered;
 	
 	std::shared_ptr<SoundBuffer> m_buffer;
 	uint32_t m_source = 0;
+	std::unique_ptr<StreamSink> m_streamSink;
+	std::unique_ptr<SoundStream> m_stream;
 
 	Vector3f m_position;
 	Vector3f m_direction;
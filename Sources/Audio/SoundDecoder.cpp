@@ -0,0 +1,12 @@
+#include "SoundDecoder.hpp"
+
+namespace acid {
+std::unique_ptr<SoundDecoder> SoundDecoder::Create(const std::string &extension, std::unique_ptr<std::istream> &&stream) {
+	try {
+		return Factory::Create(extension, std::move(stream));
+	} catch (const std::exception &e) {
+		Log::Error(e.what(), '\n');
+		return nullptr;
+	}
+}
+}
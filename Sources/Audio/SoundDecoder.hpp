@@ -0,0 +1,46 @@
+#pragma once
+
+#include <istream>
+#include <memory>
+
+#include "Helpers/Factory.hpp"
+
+namespace acid {
+/**
+ * @brief Class that decodes a sound file into 16 bit interleaved samples a chunk at a time, so a sound never has to be fully in memory.
+ */
+class ACID_EXPORT SoundDecoder : public Factory<SoundDecoder, std::unique_ptr<std::istream>> {
+public:
+	/**
+	 * Creates a decoder for a sound file.
+	 * @param extension The extension of the file, used to find the decoder.
+	 * @param stream The stream to read the file from, the decoder reads from it as samples are decoded.
+	 * @return The decoder, or nullptr if the file is not a supported format or could not be read.
+	 */
+	static std::unique_ptr<SoundDecoder> Create(const std::string &extension, std::unique_ptr<std::istream> &&stream);
+
+	/**
+	 * Decodes the next frames, a frame holds one sample for every channel.
+	 * @param samples The samples to decode into, must have space for frameCount * channels samples.
+	 * @param frameCount The maximum number of frames to decode.
+	 * @return The number of frames decoded, less than frameCount once the end is reached.
+	 */
+	virtual uint64_t Read(int16_t *samples, uint64_t frameCount) = 0;
+
+	/**
+	 * Moves the frame the next read starts from.
+	 * @param frame The frame to seek to.
+	 * @return If the seek succeeded.
+	 */
+	virtual bool Seek(uint64_t frame) = 0;
+
+	uint32_t GetChannels() const { return m_channels; }
+	uint32_t GetSampleRate() const { return m_sampleRate; }
+	uint64_t GetFrameCount() const { return m_frameCount; }
+
+protected:
+	uint32_t m_channels = 0;
+	uint32_t m_sampleRate = 0;
+	uint64_t m_frameCount = 0;
+};
+}
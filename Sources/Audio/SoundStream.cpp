@@ -0,0 +1,90 @@
+#include "SoundStream.hpp"
+
+namespace acid {
+SoundStream::SoundStream(std::unique_ptr<SoundDecoder> &&decoder, SoundSink *sink, uint64_t chunkFrames) :
+	m_decoder(std::move(decoder)),
+	m_sink(sink),
+	m_chunkFrames(chunkFrames),
+	m_pollInterval(Time::Seconds(0.25f * chunkFrames / m_decoder->GetSampleRate())),
+	m_samples(chunkFrames * m_decoder->GetChannels()),
+	m_thread(&SoundStream::DecodeLoop, this) {
+}
+
+SoundStream::~SoundStream() {
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_running = false;
+	}
+
+	m_condition.notify_one();
+	m_thread.join();
+}
+
+void SoundStream::Seek(uint64_t frame) {
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_seekFrame = frame;
+	}
+
+	m_condition.notify_one();
+}
+
+void SoundStream::DecodeLoop() {
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	while (m_running) {
+		if (m_seekFrame) {
+			auto frame = *m_seekFrame;
+			m_seekFrame = std::nullopt;
+			lock.unlock();
+
+			m_decoder->Seek(frame);
+			m_sink->Flush();
+			m_ended = false;
+
+			lock.lock();
+			continue;
+		}
+
+		// Samples are decoded without holding the lock, a seek requested while decoding drops the chunk.
+		for (auto freeChunks = m_ended ? 0 : m_sink->GetFreeChunks(); freeChunks > 0 && m_running && !m_seekFrame; freeChunks--) {
+			lock.unlock();
+			auto frameCount = DecodeChunk();
+			lock.lock();
+
+			if (m_seekFrame)
+				break;
+
+			if (frameCount > 0)
+				m_sink->Queue(m_samples.data(), frameCount, m_decoder->GetChannels(), m_decoder->GetSampleRate());
+
+			if (frameCount < m_chunkFrames) {
+				m_ended = true;
+				break;
+			}
+		}
+
+		m_condition.wait_for(lock, std::chrono::microseconds(m_pollInterval), [this]() {
+			return !m_running || m_seekFrame;
+		});
+	}
+}
+
+uint64_t SoundStream::DecodeChunk() {
+	auto channels = m_decoder->GetChannels();
+	auto frameCount = m_decoder->Read(m_samples.data(), m_chunkFrames);
+
+	while (m_loop && frameCount < m_chunkFrames) {
+		if (!m_decoder->Seek(0))
+			break;
+
+		auto read = m_decoder->Read(m_samples.data() + frameCount * channels, m_chunkFrames - frameCount);
+		if (read == 0)
+			break;
+
+		frameCount += read;
+	}
+
+	return frameCount;
+}
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "Maths/Time.hpp"
+#include "SoundDecoder.hpp"
+
+namespace acid {
+/**
+ * @brief Interface for where a {@link SoundStream} queues its decoded chunks, called from the stream thread.
+ */
+class ACID_EXPORT SoundSink {
+public:
+	virtual ~SoundSink() = default;
+
+	/**
+	 * Gets how many more chunks can be queued, chunks that have finished playing are freed.
+	 * @return The number of chunks.
+	 */
+	virtual uint32_t GetFreeChunks() = 0;
+
+	/**
+	 * Queues a chunk to be played after the chunks already queued.
+	 * @param samples The interleaved samples of the chunk, only valid during the call.
+	 * @param frameCount The number of frames in the chunk.
+	 * @param channels The number of channels.
+	 * @param sampleRate The sample rate in hertz.
+	 */
+	virtual void Queue(const int16_t *samples, uint64_t frameCount, uint32_t channels, uint32_t sampleRate) = 0;
+
+	/**
+	 * Drops every queued chunk, called after the stream seeks.
+	 */
+	virtual void Flush() = 0;
+};
+
+/**
+ * @brief Class that decodes a sound a chunk at a time on a background thread, and queues chunks to a sink whenever it has space.
+ * Only one chunk of samples is held by the stream, so memory does not grow with the length of the sound.
+ */
+class ACID_EXPORT SoundStream {
+public:
+	/**
+	 * Creates a new stream, decoding starts from the first frame straight away.
+	 * @param decoder The decoder to read chunks from.
+	 * @param sink The sink to queue chunks to, must outlive the stream.
+	 * @param chunkFrames The number of frames in a chunk.
+	 */
+	SoundStream(std::unique_ptr<SoundDecoder> &&decoder, SoundSink *sink, uint64_t chunkFrames = 16384);
+
+	~SoundStream();
+
+	/**
+	 * Moves decoding to a frame, chunks already queued are flushed from the sink.
+	 * @param frame The frame to decode from.
+	 */
+	void Seek(uint64_t frame);
+
+	bool IsLoop() const { return m_loop; }
+
+	/**
+	 * Sets if decoding continues from the first frame when the end is reached, so the sound loops without a gap.
+	 * @param loop If the stream loops.
+	 */
+	void SetLoop(bool loop) { m_loop = loop; }
+
+	/**
+	 * Gets if the last chunk of the sound has been queued, this is never true for a looping stream.
+	 * @return If the stream has ended.
+	 */
+	bool IsEnded() const { return m_ended; }
+
+	const SoundDecoder &GetDecoder() const { return *m_decoder; }
+	uint64_t GetChunkFrames() const { return m_chunkFrames; }
+
+private:
+	void DecodeLoop();
+
+	/**
+	 * Decodes the next chunk into the samples, wrapping to the first frame if the stream loops.
+	 * @return The number of frames decoded.
+	 */
+	uint64_t DecodeChunk();
+
+	std::unique_ptr<SoundDecoder> m_decoder;
+	SoundSink *m_sink;
+	uint64_t m_chunkFrames;
+	// How long the thread waits before checking the sink for free chunks again.
+	Time m_pollInterval;
+	std::vector<int16_t> m_samples;
+
+	std::atomic<bool> m_loop = false;
+	std::atomic<bool> m_ended = false;
+
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::optional<uint64_t> m_seekFrame;
+	bool m_running = true;
+	std::thread m_thread;
+};
+}
@@ -9,7 +9,6 @@
 #include "Files/Files.hpp"
 #include "Maths/Time.hpp"
 
-#define DR_WAV_IMPLEMENTATION
 #define DR_WAV_NO_STDIO
 #define DR_WAV_NO_SIMD
 #include "dr_wav.h"
@@ -40,7 +39,7 @@ void SoundBufferWave::Load(SoundBuffer *soundBuffer, const std::filesystem::path
 
 	uint32_t buffer;
 	alGenBuffers(1, &buffer);
-	alBufferData(buffer, (channels == 2) ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16, sampleData, totalPCMFrameCount, sampleRate);
+	alBufferData(buffer, (channels == 2) ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16, sampleData, static_cast<ALsizei>(totalPCMFrameCount * channels * sizeof(int16_t)), sampleRate);
 
 	Audio::CheckAl(alGetError());
 
@@ -0,0 +1,57 @@
+#include "SoundDecoderWave.hpp"
+
+#include <stdexcept>
+
+#define DR_WAV_IMPLEMENTATION
+#define DR_WAV_NO_STDIO
+#define DR_WAV_NO_SIMD
+#include "dr_wav.h"
+
+namespace acid {
+// The dr_wav decoder, a class so the header does not need dr_wav.h.
+class SoundDecoderWave::Wave : public drwav {
+};
+
+bool SoundDecoderWave::registered = Register(".wav") && Register(".wave");
+
+static size_t OnRead(void *userData, void *bufferOut, size_t bytesToRead) {
+	auto stream = static_cast<std::istream *>(userData);
+	stream->read(static_cast<char *>(bufferOut), bytesToRead);
+	auto bytesRead = static_cast<size_t>(stream->gcount());
+	// Reading past the end sets the fail bit, it is cleared so the stream can still seek.
+	stream->clear();
+	return bytesRead;
+}
+
+static drwav_bool32 OnSeek(void *userData, int offset, drwav_seek_origin origin) {
+	auto stream = static_cast<std::istream *>(userData);
+	stream->seekg(offset, origin == drwav_seek_origin_start ? std::ios::beg : std::ios::cur);
+	return !stream->fail();
+}
+
+SoundDecoderWave::SoundDecoderWave(std::unique_ptr<std::istream> &&stream) :
+	m_stream(std::move(stream)),
+	m_wav(std::make_unique<Wave>()) {
+	if (!m_stream || !drwav_init(m_wav.get(), &OnRead, &OnSeek, m_stream.get(), nullptr)) {
+		m_wav = nullptr;
+		throw std::runtime_error("Failed to read wave header");
+	}
+
+	m_channels = m_wav->channels;
+	m_sampleRate = m_wav->sampleRate;
+	m_frameCount = m_wav->totalPCMFrameCount;
+}
+
+SoundDecoderWave::~SoundDecoderWave() {
+	if (m_wav)
+		drwav_uninit(m_wav.get());
+}
+
+uint64_t SoundDecoderWave::Read(int16_t *samples, uint64_t frameCount) {
+	return drwav_read_pcm_frames_s16(m_wav.get(), frameCount, samples);
+}
+
+bool SoundDecoderWave::Seek(uint64_t frame) {
+	return drwav_seek_to_pcm_frame(m_wav.get(), frame);
+}
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Audio/SoundDecoder.hpp"
+
+namespace acid {
+class ACID_EXPORT SoundDecoderWave : public SoundDecoder::Registrar<SoundDecoderWave> {
+public:
+	explicit SoundDecoderWave(std::unique_ptr<std::istream> &&stream);
+	~SoundDecoderWave();
+
+	uint64_t Read(int16_t *samples, uint64_t frameCount) override;
+	bool Seek(uint64_t frame) override;
+
+private:
+	class Wave;
+
+	static bool registered;
+
+	std::unique_ptr<std::istream> m_stream;
+	std::unique_ptr<Wave> m_wav;
+};
+}
@@ -25,34 +25,65 @@ Bitmap::Bitmap(std::unique_ptr<uint8_t[]> &&data, const Vector2ui &size, uint32_
 	m_bytesPerPixel(bytesPerPixel) {
 }
 
+std::vector<std::unique_ptr<Bitmap>> Bitmap::LoadAll(const std::vector<std::filesystem::path> &filenames, ThreadPool *pool) {
+	std::vector<std::unique_ptr<Bitmap>> bitmaps(filenames.size());
+
+	auto load = [&](std::size_t i) {
+		bitmaps[i] = std::make_unique<Bitmap>(filenames[i]);
+	};
+
+	if (pool) {
+		pool->ParallelFor(0, filenames.size(), load, 1);
+	} else {
+		for (std::size_t i = 0; i < filenames.size(); i++)
+			load(i);
+	}
+
+	return bitmaps;
+}
+
 void Bitmap::Load(const std::filesystem::path &filename) {
 #if defined(ACID_DEBUG)
 	auto debugStart = Time::Now();
 #endif
 
-	auto fileLoaded = Files::Read(filename);
+	// Files in a mounted pack are decoded straight from the mapping.
+	std::optional<std::string> fileLoaded;
+	auto fileView = Files::ReadView(filename);
+	if (!fileView && (fileLoaded = Files::Read(filename)))
+		fileView = *fileLoaded;
 
-	if (!fileLoaded) {
+	if (!fileView) {
 		Log::Error("Image could not be loaded: ", filename, '\n');
 		return;
 	}
 
-	// TODO: Check if ext is registered, otherwise stb fallback for now.
-	if (auto it = Registry().find(filename.extension().string()); it != Registry().end()) {
-		it->second.first(this, filename);
-	} else {
-		m_data = std::unique_ptr<uint8_t[]>(stbi_load_from_memory(reinterpret_cast<uint8_t *>(fileLoaded->data()), static_cast<uint32_t>(fileLoaded->size()),
-			reinterpret_cast<int32_t *>(&m_size.m_x), reinterpret_cast<int32_t *>(&m_size.m_y), reinterpret_cast<int32_t *>(&m_bytesPerPixel), STBI_rgb_alpha));
-		m_bytesPerPixel = 4;
+	LoadMemory(*fileView);
+
+	if (!m_data) {
+		Log::Error("Image could not be decoded: ", filename, '\n');
+		return;
 	}
 
-	//Registry()[filename.extension().string()].first(this, filename);
-	
 #if defined(ACID_DEBUG)
 	Log::Out("Bitmap ", filename, " loaded in ", (Time::Now() - debugStart).AsMilliseconds<float>(), "ms\n");
 #endif
 }
 
+void Bitmap::LoadMemory(std::string_view data) {
+	for (const auto &[magic, load] : MagicRegistry()) {
+		if (data.substr(0, magic.size()) == magic) {
+			load(this, data);
+			return;
+		}
+	}
+
+	// Formats without a registered loader are decoded by stb, which finds the format itself.
+	m_data = std::unique_ptr<uint8_t[]>(stbi_load_from_memory(reinterpret_cast<const uint8_t *>(data.data()), static_cast<int32_t>(data.size()),
+		reinterpret_cast<int32_t *>(&m_size.m_x), reinterpret_cast<int32_t *>(&m_size.m_y), reinterpret_cast<int32_t *>(&m_bytesPerPixel), STBI_rgb_alpha));
+	m_bytesPerPixel = 4;
+}
+
 void Bitmap::Write(const std::filesystem::path &filename) const {
 #if defined(ACID_DEBUG)
 	auto debugStart = Time::Now();
@@ -2,16 +2,19 @@
 
 #include <unordered_map>
 #include <functional>
+#include <string_view>
 
 #include "Maths/Vector2.hpp"
+#include "Helpers/ThreadPool.hpp"
 
 namespace acid {
 template<typename Base>
 class BitmapFactory {
 public:
-	using TLoadMethod = std::function<void(Base *, const std::filesystem::path &)>;
+	using TLoadMethod = std::function<void(Base *, std::string_view)>;
 	using TWriteMethod = std::function<void(const Base *, const std::filesystem::path &)>;
 	using TRegistryMap = std::unordered_map<std::string, std::pair<TLoadMethod, TWriteMethod>>;
+	using TMagicMap = std::vector<std::pair<std::string_view, TLoadMethod>>;
 
 	virtual ~BitmapFactory() = default;
 
@@ -20,11 +23,27 @@ public:
 		return impl;
 	}
 
+	/**
+	 * Gets the loaders by the magic bytes at the start of the files they decode.
+	 * @return The magic registry.
+	 */
+	static TMagicMap &MagicRegistry() {
+		static TMagicMap impl;
+		return impl;
+	}
+
 	template<typename T>
 	class Registrar /*: public Base*/ {
 	protected:
+		/**
+		 * Registers a loader for data starting with magic bytes, and a writer for file extensions.
+		 * @param magic The bytes files of the format start with.
+		 * @param names The file extensions of the format.
+		 * @return If the format was registered.
+		 */
 		template<typename ...Args>
-		static bool Register(Args &&... names) {
+		static bool Register(std::string_view magic, Args &&... names) {
+			BitmapFactory::MagicRegistry().emplace_back(magic, &T::Load);
 			for (std::string &&name : {names...})
 				BitmapFactory::Registry()[name] = std::make_pair(&T::Load, &T::Write);
 			return true;
@@ -41,10 +60,25 @@ public:
 
 	~Bitmap() = default;
 
+	/**
+	 * Reads and decodes bitmaps across a thread pool, each file is read once and decoded by the worker that read it.
+	 * @param filenames The files to load.
+	 * @param pool The pool to load across, or nullptr to load on this thread.
+	 * @return The bitmaps in the order of their filenames, bitmaps that could not be loaded have no data.
+	 */
+	static std::vector<std::unique_ptr<Bitmap>> LoadAll(const std::vector<std::filesystem::path> &filenames, ThreadPool *pool = nullptr);
+
 	void Load(const std::filesystem::path &filename);
+
+	/**
+	 * Decodes a bitmap from the contents of a file, the format is found from the magic bytes the data starts with.
+	 * @param data The file contents.
+	 */
+	void LoadMemory(std::string_view data);
+
 	void Write(const std::filesystem::path &filename) const;
 
-	explicit operator bool() const noexcept { return !m_data; }
+	explicit operator bool() const noexcept { return m_data != nullptr; }
 
 	uint32_t GetLength() const;
 
@@ -0,0 +1,875 @@
+#include "BlockCompression.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace acid {
+// The 16 RGBA pixels of a 4x4 block, row by row.
+using Block = std::array<uint8_t, 64>;
+using Colour = std::array<float, 4>;
+
+static constexpr uint32_t Bc7Weights2[4] = {0, 21, 43, 64};
+static constexpr uint32_t Bc7Weights3[8] = {0, 9, 18, 27, 37, 46, 55, 64};
+static constexpr uint32_t Bc7Weights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+// The layout of each BC7 mode, bits are counted for a single field.
+struct Bc7Mode {
+	uint32_t m_subsets;
+	uint32_t m_partitionBits;
+	uint32_t m_rotationBits;
+	uint32_t m_indexSelectionBits;
+	uint32_t m_colourBits;
+	uint32_t m_alphaBits;
+	uint32_t m_endpointPBits;
+	uint32_t m_sharedPBits;
+	uint32_t m_indexBits;
+	uint32_t m_secondaryIndexBits;
+};
+
+static constexpr Bc7Mode Bc7Modes[8] = {
+	{3, 4, 0, 0, 4, 0, 1, 0, 3, 0},
+	{2, 6, 0, 0, 6, 0, 0, 1, 3, 0},
+	{3, 6, 0, 0, 5, 0, 0, 0, 2, 0},
+	{2, 6, 0, 0, 7, 0, 1, 0, 2, 0},
+	{1, 0, 2, 1, 5, 6, 0, 0, 2, 3},
+	{1, 0, 2, 0, 7, 8, 0, 0, 2, 2},
+	{1, 0, 0, 0, 7, 7, 1, 0, 4, 0},
+	{2, 6, 0, 0, 5, 5, 1, 0, 2, 0},
+};
+
+// Which subset each pixel of a two subset partition is in, bit i is pixel i.
+static constexpr uint16_t Bc7Partitions2[64] = {
+	0xcccc, 0x8888, 0xeeee, 0xecc8, 0xc880, 0xfeec, 0xfec8, 0xec80,
+	0xc800, 0xffec, 0xfe80, 0xe800, 0xffe8, 0xff00, 0xfff0, 0xf000,
+	0xf710, 0x008e, 0x7100, 0x08ce, 0x008c, 0x7310, 0x3100, 0x8cce,
+	0x088c, 0x3110, 0x6666, 0x366c, 0x17e8, 0x0ff0, 0x718e, 0x399c,
+	0xaaaa, 0xf0f0, 0x5a5a, 0x33cc, 0x3c3c, 0x55aa, 0x9696, 0xa55a,
+	0x73ce, 0x13c8, 0x324c, 0x3bdc, 0x6996, 0xc33c, 0x9966, 0x0660,
+	0x0272, 0x04e4, 0x4e40, 0x2720, 0xc936, 0x936c, 0x39c6, 0x639c,
+	0x9336, 0x9cc6, 0x817e, 0xe718, 0xccf0, 0x0fcc, 0x7744, 0xee22,
+};
+
+// Which subset each pixel of a three subset partition is in.
+static constexpr uint8_t Bc7Partitions3[64][16] = {
+	{0, 0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 1, 2, 2, 2, 2},
+	{0, 0, 0, 1, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 2, 1},
+	{0, 0, 0, 0, 2, 0, 0, 1, 2, 2, 1, 1, 2, 2, 1, 1},
+	{0, 2, 2, 2, 0, 0, 2, 2, 0, 0, 1, 1, 0, 1, 1, 1},
+	{0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2},
+	{0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 2, 2, 0, 0, 2, 2},
+	{0, 0, 2, 2, 0, 0, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1},
+	{0, 0, 1, 1, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1},
+	{0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2},
+	{0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2},
+	{0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2},
+	{0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2},
+	{0, 1, 1, 2, 0, 1, 1, 2, 0, 1, 1, 2, 0, 1, 1, 2},
+	{0, 1, 2, 2, 0, 1, 2, 2, 0, 1, 2, 2, 0, 1, 2, 2},
+	{0, 0, 1, 1, 0, 1, 1, 2, 1, 1, 2, 2, 1, 2, 2, 2},
+	{0, 0, 1, 1, 2, 0, 0, 1, 2, 2, 0, 0, 2, 2, 2, 0},
+	{0, 0, 0, 1, 0, 0, 1, 1, 0, 1, 1, 2, 1, 1, 2, 2},
+	{0, 1, 1, 1, 0, 0, 1, 1, 2, 0, 0, 1, 2, 2, 0, 0},
+	{0, 0, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1, 2, 2},
+	{0, 0, 2, 2, 0, 0, 2, 2, 0, 0, 2, 2, 1, 1, 1, 1},
+	{0, 1, 1, 1, 0, 1, 1, 1, 0, 2, 2, 2, 0, 2, 2, 2},
+	{0, 0, 0, 1, 0, 0, 0, 1, 2, 2, 2, 1, 2, 2, 2, 1},
+	{0, 0, 0, 0, 0, 0, 1, 1, 0, 1, 2, 2, 0, 1, 2, 2},
+	{0, 0, 0, 0, 1, 1, 0, 0, 2, 2, 1, 0, 2, 2, 1, 0},
+	{0, 1, 2, 2, 0, 1, 2, 2, 0, 0, 1, 1, 0, 0, 0, 0},
+	{0, 0, 1, 2, 0, 0, 1, 2, 1, 1, 2, 2, 2, 2, 2, 2},
+	{0, 1, 1, 0, 1, 2, 2, 1, 1, 2, 2, 1, 0, 1, 1, 0},
+	{0, 0, 0, 0, 0, 1, 1, 0, 1, 2, 2, 1, 1, 2, 2, 1},
+	{0, 0, 2, 2, 1, 1, 0, 2, 1, 1, 0, 2, 0, 0, 2, 2},
+	{0, 1, 1, 0, 0, 1, 1, 0, 2, 0, 0, 2, 2, 2, 2, 2},
+	{0, 0, 1, 1, 0, 1, 2, 2, 0, 1, 2, 2, 0, 0, 1, 1},
+	{0, 0, 0, 0, 2, 0, 0, 0, 2, 2, 1, 1, 2, 2, 2, 1},
+	{0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 2, 2, 2},
+	{0, 2, 2, 2, 0, 0, 2, 2, 0, 0, 1, 2, 0, 0, 1, 1},
+	{0, 0, 1, 1, 0, 0, 1, 2, 0, 0, 2, 2, 0, 2, 2, 2},
+	{0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0},
+	{0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 0, 0, 0, 0},
+	{0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0},
+	{0, 1, 2, 0, 2, 0, 1, 2, 1, 2, 0, 1, 0, 1, 2, 0},
+	{0, 0, 1, 1, 2, 2, 0, 0, 1, 1, 2, 2, 0, 0, 1, 1},
+	{0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 0, 0, 0, 0, 1, 1},
+	{0, 1, 0, 1, 0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2},
+	{0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 2, 1, 2, 1, 2, 1},
+	{0, 0, 2, 2, 1, 1, 2, 2, 0, 0, 2, 2, 1, 1, 2, 2},
+	{0, 0, 2, 2, 0, 0, 1, 1, 0, 0, 2, 2, 0, 0, 1, 1},
+	{0, 2, 2, 0, 1, 2, 2, 1, 0, 2, 2, 0, 1, 2, 2, 1},
+	{0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2, 0, 1, 0, 1},
+	{0, 0, 0, 0, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1},
+	{0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 2, 2, 2, 2},
+	{0, 2, 2, 2, 0, 1, 1, 1, 0, 2, 2, 2, 0, 1, 1, 1},
+	{0, 0, 0, 2, 1, 1, 1, 2, 0, 0, 0, 2, 1, 1, 1, 2},
+	{0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1, 2},
+	{0, 2, 2, 2, 0, 1, 1, 1, 0, 1, 1, 1, 0, 2, 2, 2},
+	{0, 0, 0, 2, 1, 1, 1, 2, 1, 1, 1, 2, 0, 0, 0, 2},
+	{0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 2, 2},
+	{0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 1, 2},
+	{0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 2, 2, 2, 2, 2, 2},
+	{0, 0, 2, 2, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 2, 2},
+	{0, 0, 2, 2, 1, 1, 2, 2, 1, 1, 2, 2, 0, 0, 2, 2},
+	{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2},
+	{0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1},
+	{0, 2, 2, 2, 1, 2, 2, 2, 0, 2, 2, 2, 1, 2, 2, 2},
+	{0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+	{0, 1, 1, 1, 2, 0, 1, 1, 2, 2, 0, 1, 2, 2, 2, 0},
+};
+
+// The pixel whose index has one bit less in the second subset of two subset partitions, and the second and third subsets of three subset partitions.
+static constexpr uint8_t Bc7Anchors2[64] = {
+	15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+	15, 2, 8, 2, 2, 8, 8, 15, 2, 8, 2, 2, 8, 8, 2, 2,
+	15, 15, 6, 8, 2, 8, 15, 15, 2, 8, 2, 2, 2, 15, 15, 6,
+	6, 2, 6, 8, 15, 15, 2, 2, 15, 15, 15, 15, 15, 2, 2, 15,
+};
+static constexpr uint8_t Bc7Anchors3Second[64] = {
+	3, 3, 15, 15, 8, 3, 15, 15, 8, 8, 6, 6, 6, 5, 3, 3,
+	3, 3, 8, 15, 3, 3, 6, 10, 5, 8, 8, 6, 8, 5, 15, 15,
+	8, 15, 3, 5, 6, 10, 8, 15, 15, 3, 15, 5, 15, 15, 15, 15,
+	3, 15, 5, 5, 5, 8, 5, 10, 5, 10, 8, 13, 15, 12, 3, 3,
+};
+static constexpr uint8_t Bc7Anchors3Third[64] = {
+	15, 8, 8, 3, 15, 15, 3, 8, 15, 15, 15, 15, 15, 15, 15, 8,
+	15, 8, 15, 3, 15, 8, 15, 8, 3, 15, 6, 10, 15, 15, 10, 8,
+	15, 3, 15, 10, 10, 8, 9, 10, 6, 15, 8, 15, 3, 6, 6, 8,
+	15, 3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 3, 15, 15, 8,
+};
+
+// Writes fields into a 128 bit block, starting from the lowest bit.
+class BitWriter {
+public:
+	explicit BitWriter(uint8_t *data) :
+		m_data(data) {
+		std::memset(m_data, 0, 16);
+	}
+
+	void Write(uint32_t value, uint32_t count) {
+		for (uint32_t i = 0; i < count; i++, m_position++) {
+			if (value >> i & 1)
+				m_data[m_position / 8] |= static_cast<uint8_t>(1 << m_position % 8);
+		}
+	}
+
+private:
+	uint8_t *m_data;
+	uint32_t m_position = 0;
+};
+
+class BitReader {
+public:
+	explicit BitReader(const uint8_t *data) :
+		m_data(data) {
+	}
+
+	uint32_t Read(uint32_t count) {
+		uint32_t value = 0;
+		for (uint32_t i = 0; i < count && m_position < 128; i++, m_position++)
+			value |= static_cast<uint32_t>(m_data[m_position / 8] >> m_position % 8 & 1) << i;
+		return value;
+	}
+
+private:
+	const uint8_t *m_data;
+	uint32_t m_position = 0;
+};
+
+static float SquaredError(const Colour &a, const Colour &b, uint32_t channels) {
+	auto error = 0.0f;
+	for (uint32_t c = 0; c < channels; c++)
+		error += (a[c] - b[c]) * (a[c] - b[c]);
+	return error;
+}
+
+static Colour Clamp(const Colour &colour) {
+	Colour result;
+	for (uint32_t c = 0; c < 4; c++)
+		result[c] = std::clamp(colour[c], 0.0f, 255.0f);
+	return result;
+}
+
+/**
+ * Fits the line through colours with the least squared error, and finds the endpoints of the colours projected onto it.
+ * @param colours The colours.
+ * @param count The number of colours.
+ * @param channels The number of channels to fit.
+ * @param e0 The endpoint with the lowest projection.
+ * @param e1 The endpoint with the highest projection.
+ */
+static void FitEndpoints(const Colour *colours, std::size_t count, uint32_t channels, Colour &e0, Colour &e1) {
+	Colour mean = {};
+	for (std::size_t i = 0; i < count; i++) {
+		for (uint32_t c = 0; c < channels; c++)
+			mean[c] += colours[i][c] / count;
+	}
+
+	float covariance[4][4] = {};
+	for (std::size_t i = 0; i < count; i++) {
+		for (uint32_t a = 0; a < channels; a++) {
+			for (uint32_t b = 0; b < channels; b++)
+				covariance[a][b] += (colours[i][a] - mean[a]) * (colours[i][b] - mean[b]);
+		}
+	}
+
+	// The direction of largest variance is found by power iteration, starting from the channel with the most variance.
+	uint32_t start = 0;
+	for (uint32_t c = 1; c < channels; c++) {
+		if (covariance[c][c] > covariance[start][start])
+			start = c;
+	}
+
+	Colour axis = {};
+	for (uint32_t c = 0; c < channels; c++)
+		axis[c] = covariance[start][c];
+
+	for (uint32_t iteration = 0; iteration < 8; iteration++) {
+		Colour next = {};
+		auto length = 0.0f;
+		for (uint32_t a = 0; a < channels; a++) {
+			for (uint32_t b = 0; b < channels; b++)
+				next[a] += covariance[a][b] * axis[b];
+			length = std::max(length, std::abs(next[a]));
+		}
+
+		if (length == 0.0f)
+			break;
+
+		for (uint32_t c = 0; c < channels; c++)
+			axis[c] = next[c] / length;
+	}
+
+	auto length = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2] + axis[3] * axis[3]);
+	if (length > 0.0f) {
+		for (auto &a : axis)
+			a /= length;
+	}
+
+	auto tMin = 0.0f, tMax = 0.0f;
+	for (std::size_t i = 0; i < count; i++) {
+		auto t = 0.0f;
+		for (uint32_t c = 0; c < channels; c++)
+			t += (colours[i][c] - mean[c]) * axis[c];
+		tMin = std::min(tMin, t);
+		tMax = std::max(tMax, t);
+	}
+
+	for (uint32_t c = 0; c < 4; c++) {
+		e0[c] = mean[c] + tMin * axis[c];
+		e1[c] = mean[c] + tMax * axis[c];
+	}
+
+	e0 = Clamp(e0);
+	e1 = Clamp(e1);
+}
+
+/**
+ * Solves for the endpoints that best reproduce colours given how far along the line between the endpoints each colour is.
+ * @param colours The colours.
+ * @param weights The weight of the second endpoint for each colour, colours with a negative weight are skipped.
+ * @param count The number of colours.
+ * @param e0 The first endpoint.
+ * @param e1 The second endpoint.
+ * @return If the endpoints could be solved, they are unchanged if every colour has the same weight.
+ */
+static bool RefineEndpoints(const Colour *colours, const float *weights, std::size_t count, Colour &e0, Colour &e1) {
+	auto aa = 0.0f, ab = 0.0f, bb = 0.0f;
+	Colour ax = {}, bx = {};
+
+	for (std::size_t i = 0; i < count; i++) {
+		if (weights[i] < 0.0f)
+			continue;
+
+		auto a = 1.0f - weights[i], b = weights[i];
+		aa += a * a;
+		ab += a * b;
+		bb += b * b;
+
+		for (uint32_t c = 0; c < 4; c++) {
+			ax[c] += a * colours[i][c];
+			bx[c] += b * colours[i][c];
+		}
+	}
+
+	auto determinant = aa * bb - ab * ab;
+	if (std::abs(determinant) < 1e-6f)
+		return false;
+
+	for (uint32_t c = 0; c < 4; c++) {
+		e0[c] = (bb * ax[c] - ab * bx[c]) / determinant;
+		e1[c] = (aa * bx[c] - ab * ax[c]) / determinant;
+	}
+
+	e0 = Clamp(e0);
+	e1 = Clamp(e1);
+	return true;
+}
+
+static uint16_t To565(const Colour &colour) {
+	auto r = static_cast<uint32_t>(std::lround(colour[0] * 31.0f / 255.0f));
+	auto g = static_cast<uint32_t>(std::lround(colour[1] * 63.0f / 255.0f));
+	auto b = static_cast<uint32_t>(std::lround(colour[2] * 31.0f / 255.0f));
+	return static_cast<uint16_t>(r << 11 | g << 5 | b);
+}
+
+static Colour From565(uint16_t value) {
+	auto r = value >> 11 & 31, g = value >> 5 & 63, b = value & 31;
+	return {static_cast<float>(r << 3 | r >> 2), static_cast<float>(g << 2 | g >> 4), static_cast<float>(b << 3 | b >> 2), 255.0f};
+}
+
+static void Bc1Palette(uint16_t c0, uint16_t c1, bool threeColour, Colour palette[4]) {
+	palette[0] = From565(c0);
+	palette[1] = From565(c1);
+
+	for (uint32_t c = 0; c < 3; c++) {
+		auto a = static_cast<uint32_t>(palette[0][c]), b = static_cast<uint32_t>(palette[1][c]);
+
+		if (threeColour) {
+			palette[2][c] = static_cast<float>((a + b) / 2);
+			palette[3][c] = 0.0f;
+		} else {
+			palette[2][c] = static_cast<float>((2 * a + b) / 3);
+			palette[3][c] = static_cast<float>((a + 2 * b) / 3);
+		}
+	}
+
+	palette[2][3] = 255.0f;
+	palette[3][3] = threeColour ? 0.0f : 255.0f;
+}
+
+/**
+ * Picks the closest palette entry for every pixel of a BC1 block.
+ * @return The squared error of the block.
+ */
+static float Bc1Indices(const Colour *colours, uint32_t transparent, uint16_t c0, uint16_t c1, uint32_t &indices) {
+	auto threeColour = c0 <= c1;
+	Colour palette[4];
+	Bc1Palette(c0, c1, threeColour, palette);
+
+	indices = 0;
+	auto error = 0.0f;
+
+	for (uint32_t i = 0; i < 16; i++) {
+		if (transparent >> i & 1) {
+			indices |= 3u << 2 * i;
+			continue;
+		}
+
+		uint32_t best = 0;
+		auto bestError = SquaredError(colours[i], palette[0], 3);
+		for (uint32_t p = 1; p < (threeColour ? 3u : 4u); p++) {
+			if (auto e = SquaredError(colours[i], palette[p], 3); e < bestError) {
+				best = p;
+				bestError = e;
+			}
+		}
+
+		indices |= best << 2 * i;
+		error += bestError;
+	}
+
+	return error;
+}
+
+static void EncodeBc1(const Block &block, uint8_t *output, bool allowAlpha) {
+	Colour colours[16];
+	Colour opaque[16];
+	std::size_t opaqueCount = 0;
+	uint32_t transparent = 0;
+
+	for (uint32_t i = 0; i < 16; i++) {
+		colours[i] = {static_cast<float>(block[4 * i]), static_cast<float>(block[4 * i + 1]), static_cast<float>(block[4 * i + 2]), 0.0f};
+
+		if (allowAlpha && block[4 * i + 3] < 128)
+			transparent |= 1u << i;
+		else
+			opaque[opaqueCount++] = colours[i];
+	}
+
+	uint16_t c0 = 0, c1 = 0;
+	uint32_t indices = 0xffffffff;
+
+	if (opaqueCount > 0) {
+		Colour e0, e1;
+		FitEndpoints(opaque, opaqueCount, 3, e0, e1);
+
+		// Four colour blocks need the first endpoint to be greater, blocks with transparent pixels need it to be smaller or equal.
+		auto order = [transparent](uint16_t &a, uint16_t &b) {
+			if (transparent ? a > b : a < b)
+				std::swap(a, b);
+		};
+
+		auto bestError = std::numeric_limits<float>::max();
+
+		for (uint32_t iteration = 0; iteration < 3; iteration++) {
+			auto q0 = To565(e1), q1 = To565(e0);
+			order(q0, q1);
+
+			uint32_t candidate;
+			auto error = Bc1Indices(colours, transparent, q0, q1, candidate);
+			if (error < bestError) {
+				bestError = error;
+				c0 = q0;
+				c1 = q1;
+				indices = candidate;
+			}
+
+			if (error == 0.0f)
+				break;
+
+			float weights[16];
+			auto threeColour = q0 <= q1;
+			for (uint32_t i = 0; i < 16; i++) {
+				auto index = candidate >> 2 * i & 3;
+				static constexpr float FourWeights[4] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+				static constexpr float ThreeWeights[4] = {0.0f, 1.0f, 0.5f, -1.0f};
+				weights[i] = (transparent >> i & 1) ? -1.0f : threeColour ? ThreeWeights[index] : FourWeights[index];
+			}
+
+			if (!RefineEndpoints(colours, weights, 16, e1, e0))
+				break;
+		}
+	}
+
+	output[0] = static_cast<uint8_t>(c0);
+	output[1] = static_cast<uint8_t>(c0 >> 8);
+	output[2] = static_cast<uint8_t>(c1);
+	output[3] = static_cast<uint8_t>(c1 >> 8);
+	for (uint32_t i = 0; i < 4; i++)
+		output[4 + i] = static_cast<uint8_t>(indices >> 8 * i);
+}
+
+static void DecodeBc1(const uint8_t *input, Block &block, bool alwaysFourColour) {
+	auto c0 = static_cast<uint16_t>(input[0] | input[1] << 8);
+	auto c1 = static_cast<uint16_t>(input[2] | input[3] << 8);
+	auto indices = static_cast<uint32_t>(input[4] | input[5] << 8 | input[6] << 16 | input[7] << 24);
+
+	Colour palette[4];
+	Bc1Palette(c0, c1, !alwaysFourColour && c0 <= c1, palette);
+
+	for (uint32_t i = 0; i < 16; i++) {
+		const auto &colour = palette[indices >> 2 * i & 3];
+		for (uint32_t c = 0; c < 4; c++)
+			block[4 * i + c] = static_cast<uint8_t>(colour[c]);
+	}
+}
+
+static void Bc4Palette(uint32_t e0, uint32_t e1, uint32_t palette[8]) {
+	palette[0] = e0;
+	palette[1] = e1;
+
+	if (e0 > e1) {
+		for (uint32_t i = 2; i < 8; i++)
+			palette[i] = ((8 - i) * e0 + (i - 1) * e1 + 3) / 7;
+	} else {
+		for (uint32_t i = 2; i < 6; i++)
+			palette[i] = ((6 - i) * e0 + (i - 1) * e1 + 2) / 5;
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+}
+
+static void EncodeBc4(const Block &block, uint32_t channel, uint8_t *output) {
+	uint32_t low = 255, high = 0;
+	for (uint32_t i = 0; i < 16; i++) {
+		low = std::min<uint32_t>(low, block[4 * i + channel]);
+		high = std::max<uint32_t>(high, block[4 * i + channel]);
+	}
+
+	// The eight value mode interpolates between the lowest and highest values.
+	uint32_t palette[8];
+	Bc4Palette(high, low, palette);
+
+	uint64_t indices = 0;
+	for (uint32_t i = 0; i < 16 && high > low; i++) {
+		auto value = static_cast<int32_t>(block[4 * i + channel]);
+		uint64_t best = 0;
+		for (uint32_t p = 1; p < 8; p++) {
+			if (std::abs(value - static_cast<int32_t>(palette[p])) < std::abs(value - static_cast<int32_t>(palette[best])))
+				best = p;
+		}
+
+		indices |= best << 3 * i;
+	}
+
+	output[0] = static_cast<uint8_t>(high);
+	output[1] = static_cast<uint8_t>(low);
+	for (uint32_t i = 0; i < 6; i++)
+		output[2 + i] = static_cast<uint8_t>(indices >> 8 * i);
+}
+
+static void DecodeBc4(const uint8_t *input, Block &block, uint32_t channel) {
+	uint32_t palette[8];
+	Bc4Palette(input[0], input[1], palette);
+
+	uint64_t indices = 0;
+	for (uint32_t i = 0; i < 6; i++)
+		indices |= static_cast<uint64_t>(input[2 + i]) << 8 * i;
+
+	for (uint32_t i = 0; i < 16; i++)
+		block[4 * i + channel] = static_cast<uint8_t>(palette[indices >> 3 * i & 7]);
+}
+
+static Colour Bc7Interpolate(const uint32_t e0[4], const uint32_t e1[4], uint32_t colourWeight, uint32_t alphaWeight) {
+	Colour colour;
+	for (uint32_t c = 0; c < 4; c++) {
+		auto weight = c < 3 ? colourWeight : alphaWeight;
+		colour[c] = static_cast<float>(((64 - weight) * e0[c] + weight * e1[c] + 32) >> 6);
+	}
+	return colour;
+}
+
+// Quantizes a mode 6 endpoint to 7 bits a channel plus a shared lowest bit, picking the shared bit with the least error.
+static void QuantizeBc7(const Colour &endpoint, uint32_t quantized[4], uint32_t &pBit) {
+	auto bestError = std::numeric_limits<float>::max();
+
+	for (uint32_t p = 0; p < 2; p++) {
+		uint32_t candidate[4];
+		auto error = 0.0f;
+		for (uint32_t c = 0; c < 4; c++) {
+			candidate[c] = static_cast<uint32_t>(std::clamp(std::lround((endpoint[c] - p) / 2.0f), 0l, 127l));
+			auto value = static_cast<float>(candidate[c] << 1 | p);
+			error += (value - endpoint[c]) * (value - endpoint[c]);
+		}
+
+		if (error < bestError) {
+			bestError = error;
+			pBit = p;
+			std::copy(candidate, candidate + 4, quantized);
+		}
+	}
+}
+
+static void EncodeBc7(const Block &block, uint8_t *output) {
+	Colour colours[16];
+	for (uint32_t i = 0; i < 16; i++) {
+		for (uint32_t c = 0; c < 4; c++)
+			colours[i][c] = block[4 * i + c];
+	}
+
+	Colour e0, e1;
+	FitEndpoints(colours, 16, 4, e0, e1);
+
+	uint32_t q0[4], q1[4], p0 = 0, p1 = 0;
+	uint32_t indices[16];
+	auto bestError = std::numeric_limits<float>::max();
+
+	for (uint32_t iteration = 0; iteration < 3; iteration++) {
+		uint32_t c0[4], c1[4], cp0, cp1;
+		QuantizeBc7(e0, c0, cp0);
+		QuantizeBc7(e1, c1, cp1);
+
+		uint32_t d0[4], d1[4];
+		for (uint32_t c = 0; c < 4; c++) {
+			d0[c] = c0[c] << 1 | cp0;
+			d1[c] = c1[c] << 1 | cp1;
+		}
+
+		Colour palette[16];
+		for (uint32_t w = 0; w < 16; w++)
+			palette[w] = Bc7Interpolate(d0, d1, Bc7Weights4[w], Bc7Weights4[w]);
+
+		uint32_t candidate[16];
+		float weights[16];
+		auto error = 0.0f;
+		for (uint32_t i = 0; i < 16; i++) {
+			candidate[i] = 0;
+			auto pixelError = SquaredError(colours[i], palette[0], 4);
+			for (uint32_t w = 1; w < 16; w++) {
+				if (auto e = SquaredError(colours[i], palette[w], 4); e < pixelError) {
+					candidate[i] = w;
+					pixelError = e;
+				}
+			}
+
+			weights[i] = Bc7Weights4[candidate[i]] / 64.0f;
+			error += pixelError;
+		}
+
+		if (error < bestError) {
+			bestError = error;
+			std::copy(c0, c0 + 4, q0);
+			std::copy(c1, c1 + 4, q1);
+			p0 = cp0;
+			p1 = cp1;
+			std::copy(candidate, candidate + 16, indices);
+		}
+
+		if (error == 0.0f || !RefineEndpoints(colours, weights, 16, e0, e1))
+			break;
+	}
+
+	// The highest bit of the first index is implied to be zero, so the endpoints are swapped if it is set.
+	if (indices[0] >= 8) {
+		std::swap_ranges(q0, q0 + 4, q1);
+		std::swap(p0, p1);
+		for (auto &index : indices)
+			index = 15 - index;
+	}
+
+	BitWriter writer(output);
+	writer.Write(1 << 6, 7);
+	for (uint32_t c = 0; c < 4; c++) {
+		writer.Write(q0[c], 7);
+		writer.Write(q1[c], 7);
+	}
+	writer.Write(p0, 1);
+	writer.Write(p1, 1);
+	for (uint32_t i = 0; i < 16; i++)
+		writer.Write(indices[i], i == 0 ? 3 : 4);
+}
+
+static bool DecodeBc7(const uint8_t *input, Block &block) {
+	BitReader reader(input);
+
+	uint32_t mode = 0;
+	while (mode < 8 && reader.Read(1) == 0)
+		mode++;
+
+	// A block without a mode bit is reserved.
+	if (mode == 8)
+		return false;
+
+	const auto &info = Bc7Modes[mode];
+	auto partition = reader.Read(info.m_partitionBits);
+	auto rotation = reader.Read(info.m_rotationBits);
+	auto indexSelection = reader.Read(info.m_indexSelectionBits);
+
+	// Every channel of every endpoint is stored before the next channel, two endpoints for each subset.
+	auto endpointCount = 2 * info.m_subsets;
+	uint32_t endpoints[6][4];
+	for (uint32_t c = 0; c < 4; c++) {
+		auto bits = c < 3 ? info.m_colourBits : info.m_alphaBits;
+		for (uint32_t e = 0; e < endpointCount; e++)
+			endpoints[e][c] = bits > 0 ? reader.Read(bits) : 255;
+	}
+
+	// Lowest bits are either stored for each endpoint or shared by the endpoints of a subset.
+	auto colourBits = info.m_colourBits, alphaBits = info.m_alphaBits;
+	if (info.m_endpointPBits || info.m_sharedPBits) {
+		uint32_t pBits[6];
+		for (uint32_t e = 0; e < endpointCount; e++)
+			pBits[e] = info.m_sharedPBits && e % 2 == 1 ? pBits[e - 1] : reader.Read(1);
+
+		for (uint32_t e = 0; e < endpointCount; e++) {
+			for (uint32_t c = 0; c < (alphaBits > 0 ? 4u : 3u); c++)
+				endpoints[e][c] = endpoints[e][c] << 1 | pBits[e];
+		}
+
+		colourBits++;
+		if (alphaBits > 0)
+			alphaBits++;
+	}
+
+	for (uint32_t e = 0; e < endpointCount; e++) {
+		for (uint32_t c = 0; c < 4; c++) {
+			auto bits = c < 3 ? colourBits : alphaBits;
+			if (bits > 0 && bits < 8)
+				endpoints[e][c] = endpoints[e][c] << (8 - bits) | endpoints[e][c] >> (2 * bits - 8);
+		}
+	}
+
+	uint32_t subsets[16];
+	for (uint32_t i = 0; i < 16; i++) {
+		if (info.m_subsets == 2)
+			subsets[i] = Bc7Partitions2[partition] >> i & 1;
+		else if (info.m_subsets == 3)
+			subsets[i] = Bc7Partitions3[partition][i];
+		else
+			subsets[i] = 0;
+	}
+
+	// The index of the first pixel of each subset, its anchor, has one bit less, its highest bit is zero.
+	auto isAnchor = [&](uint32_t i) {
+		if (i == 0)
+			return true;
+		if (info.m_subsets == 2)
+			return i == Bc7Anchors2[partition];
+		if (info.m_subsets == 3)
+			return i == Bc7Anchors3Second[partition] || i == Bc7Anchors3Third[partition];
+		return false;
+	};
+	auto readIndices = [&](uint32_t bits, uint32_t indices[16]) {
+		for (uint32_t i = 0; i < 16; i++)
+			indices[i] = reader.Read(isAnchor(i) ? bits - 1 : bits);
+	};
+	auto weightsOf = [](uint32_t bits) {
+		return bits == 2 ? Bc7Weights2 : bits == 3 ? Bc7Weights3 : Bc7Weights4;
+	};
+
+	uint32_t primary[16], secondary[16];
+	readIndices(info.m_indexBits, primary);
+
+	const uint32_t *colourIndices = primary, *alphaIndices = primary;
+	const uint32_t *colourWeights = weightsOf(info.m_indexBits), *alphaWeights = colourWeights;
+
+	// Modes with a second set of indices use it for alpha, unless the index selection bit swaps them.
+	if (info.m_secondaryIndexBits > 0) {
+		readIndices(info.m_secondaryIndexBits, secondary);
+		alphaIndices = secondary;
+		alphaWeights = weightsOf(info.m_secondaryIndexBits);
+
+		if (indexSelection) {
+			std::swap(colourIndices, alphaIndices);
+			std::swap(colourWeights, alphaWeights);
+		}
+	}
+
+	for (uint32_t i = 0; i < 16; i++) {
+		auto colour = Bc7Interpolate(endpoints[2 * subsets[i]], endpoints[2 * subsets[i] + 1], colourWeights[colourIndices[i]], alphaWeights[alphaIndices[i]]);
+		if (rotation > 0)
+			std::swap(colour[rotation - 1], colour[3]);
+
+		for (uint32_t c = 0; c < 4; c++)
+			block[4 * i + c] = static_cast<uint8_t>(colour[c]);
+	}
+
+	return true;
+}
+
+static void LoadBlock(const uint8_t *pixels, const Vector2ui &size, uint32_t blockX, uint32_t blockY, Block &block) {
+	for (uint32_t y = 0; y < 4; y++) {
+		auto row = std::min(4 * blockY + y, size.m_y - 1);
+		for (uint32_t x = 0; x < 4; x++) {
+			auto column = std::min(4 * blockX + x, size.m_x - 1);
+			std::memcpy(&block[4 * (4 * y + x)], &pixels[4 * (row * size.m_x + column)], 4);
+		}
+	}
+}
+
+static void StoreBlock(const Block &block, const Vector2ui &size, uint32_t blockX, uint32_t blockY, uint8_t *pixels) {
+	for (uint32_t y = 0; y < 4 && 4 * blockY + y < size.m_y; y++) {
+		for (uint32_t x = 0; x < 4 && 4 * blockX + x < size.m_x; x++)
+			std::memcpy(&pixels[4 * ((4 * blockY + y) * size.m_x + 4 * blockX + x)], &block[4 * (4 * y + x)], 4);
+	}
+}
+
+uint32_t BlockCompression::GetBlockLength(Format format) {
+	switch (format) {
+	case Format::Bc1:
+		return 8;
+	case Format::Bc3:
+	case Format::Bc5:
+	case Format::Bc7:
+		return 16;
+	default:
+		return 4;
+	}
+}
+
+std::size_t BlockCompression::GetLength(Format format, const Vector2ui &size) {
+	if (!IsCompressed(format))
+		return static_cast<std::size_t>(size.m_x) * size.m_y * 4;
+	return static_cast<std::size_t>((size.m_x + 3) / 4) * ((size.m_y + 3) / 4) * GetBlockLength(format);
+}
+
+std::vector<uint8_t> BlockCompression::Encode(Format format, const uint8_t *pixels, const Vector2ui &size, ThreadPool *pool) {
+	std::vector<uint8_t> data(GetLength(format, size));
+	if (!IsCompressed(format)) {
+		std::memcpy(data.data(), pixels, data.size());
+		return data;
+	}
+
+	auto blocksX = (size.m_x + 3) / 4;
+	auto blockLength = GetBlockLength(format);
+
+	auto encodeRow = [&](std::size_t blockY) {
+		Block block;
+		for (uint32_t blockX = 0; blockX < blocksX; blockX++) {
+			LoadBlock(pixels, size, blockX, static_cast<uint32_t>(blockY), block);
+			auto output = &data[(blockY * blocksX + blockX) * blockLength];
+
+			switch (format) {
+			case Format::Bc1:
+				EncodeBc1(block, output, true);
+				break;
+			case Format::Bc3:
+				EncodeBc4(block, 3, output);
+				EncodeBc1(block, output + 8, false);
+				break;
+			case Format::Bc5:
+				EncodeBc4(block, 0, output);
+				EncodeBc4(block, 1, output + 8);
+				break;
+			case Format::Bc7:
+				EncodeBc7(block, output);
+				break;
+			default:
+				break;
+			}
+		}
+	};
+
+	auto blocksY = (size.m_y + 3) / 4;
+	if (pool) {
+		pool->ParallelFor(0, blocksY, encodeRow, 1);
+	} else {
+		for (uint32_t blockY = 0; blockY < blocksY; blockY++)
+			encodeRow(blockY);
+	}
+
+	return data;
+}
+
+bool BlockCompression::Decode(Format format, const uint8_t *data, const Vector2ui &size, uint8_t *pixels, ThreadPool *pool) {
+	if (!IsCompressed(format)) {
+		std::memcpy(pixels, data, GetLength(format, size));
+		return true;
+	}
+
+	auto blocksX = (size.m_x + 3) / 4;
+	auto blockLength = GetBlockLength(format);
+	std::atomic<bool> decoded = true;
+
+	auto decodeRow = [&](std::size_t blockY) {
+		Block block;
+		for (uint32_t blockX = 0; blockX < blocksX; blockX++) {
+			auto input = &data[(blockY * blocksX + blockX) * blockLength];
+
+			switch (format) {
+			case Format::Bc1:
+				DecodeBc1(input, block, false);
+				break;
+			case Format::Bc3:
+				DecodeBc1(input + 8, block, true);
+				DecodeBc4(input, block, 3);
+				break;
+			case Format::Bc5:
+				block.fill(0);
+				DecodeBc4(input, block, 0);
+				DecodeBc4(input + 8, block, 1);
+				for (uint32_t i = 0; i < 16; i++)
+					block[4 * i + 3] = 255;
+				break;
+			case Format::Bc7:
+				if (!DecodeBc7(input, block)) {
+					for (uint32_t i = 0; i < 16; i++) {
+						block[4 * i] = block[4 * i + 2] = block[4 * i + 3] = 255;
+						block[4 * i + 1] = 0;
+					}
+					decoded = false;
+				}
+				break;
+			default:
+				break;
+			}
+
+			StoreBlock(block, size, blockX, static_cast<uint32_t>(blockY), pixels);
+		}
+	};
+
+	auto blocksY = (size.m_y + 3) / 4;
+	if (pool) {
+		pool->ParallelFor(0, blocksY, decodeRow, 1);
+	} else {
+		for (uint32_t blockY = 0; blockY < blocksY; blockY++)
+			decodeRow(blockY);
+	}
+
+	return decoded;
+}
+}
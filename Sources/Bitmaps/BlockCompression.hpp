@@ -0,0 +1,71 @@
+#pragma once
+
+#include <vector>
+
+#include "Maths/Vector2.hpp"
+#include "Helpers/ThreadPool.hpp"
+
+namespace acid {
+/**
+ * @brief Class that encodes and decodes RGBA8 pixels to and from the 4x4 block compressed formats GPUs sample directly.
+ * Rows and columns of blocks that cross the edge of the image are padded with the edge pixels.
+ */
+class ACID_EXPORT BlockCompression {
+public:
+	enum class Format : uint32_t {
+		// Uncompressed 8 bit RGBA, stored as pixels instead of blocks.
+		Rgba8,
+		// RGB with 1 bit alpha, 8 bytes per block.
+		Bc1,
+		// RGB and interpolated alpha, 16 bytes per block.
+		Bc3,
+		// Two channels, for normal maps, 16 bytes per block. Decodes to red and green with blue at 0.
+		Bc5,
+		// High quality RGBA, 16 bytes per block. Only the single subset modes 4, 5 and 6 can be decoded, the encoder writes mode 6.
+		Bc7
+	};
+
+	/**
+	 * Gets if a format is stored as 4x4 blocks.
+	 * @param format The format.
+	 * @return If the format is block compressed.
+	 */
+	static bool IsCompressed(Format format) { return format != Format::Rgba8; }
+
+	/**
+	 * Gets the number of bytes in one block, or in one pixel for formats that are not block compressed.
+	 * @param format The format.
+	 * @return The block length.
+	 */
+	static uint32_t GetBlockLength(Format format);
+
+	/**
+	 * Gets the number of bytes an image takes in a format.
+	 * @param format The format.
+	 * @param size The size of the image in pixels.
+	 * @return The length.
+	 */
+	static std::size_t GetLength(Format format, const Vector2ui &size);
+
+	/**
+	 * Encodes RGBA8 pixels, rows of blocks are encoded across the pool.
+	 * @param format The format to encode to.
+	 * @param pixels The pixels, rows are tightly packed.
+	 * @param size The size of the image in pixels.
+	 * @param pool The pool to encode across, or nullptr to encode on this thread.
+	 * @return The encoded data.
+	 */
+	static std::vector<uint8_t> Encode(Format format, const uint8_t *pixels, const Vector2ui &size, ThreadPool *pool = nullptr);
+
+	/**
+	 * Decodes data to RGBA8 pixels, rows of blocks are decoded across the pool.
+	 * @param format The format to decode from.
+	 * @param data The encoded data, must be {@link BlockCompression#GetLength} bytes long.
+	 * @param size The size of the image in pixels.
+	 * @param pixels The pixels to decode into, rows are tightly packed.
+	 * @param pool The pool to decode across, or nullptr to decode on this thread.
+	 * @return If every block was decoded, blocks that could not be decoded are magenta.
+	 */
+	static bool Decode(Format format, const uint8_t *data, const Vector2ui &size, uint8_t *pixels, ThreadPool *pool = nullptr);
+};
+}
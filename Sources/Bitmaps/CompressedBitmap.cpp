@@ -0,0 +1,217 @@
+#include "CompressedBitmap.hpp"
+
+#include <cstring>
+
+#include "Engine/Log.hpp"
+#include "Files/Files.hpp"
+#include "Maths/Time.hpp"
+
+namespace acid {
+static constexpr std::string_view Ktx2Identifier = "\xABKTX 20\xBB\r\n\x1A\n";
+// The identifier, the header and the index, before the level index.
+static constexpr std::size_t Ktx2HeaderLength = 80;
+static constexpr std::size_t Ktx2LevelLength = 24;
+
+static void WriteValue(std::string &data, std::size_t offset, uint64_t value, std::size_t length) {
+	for (std::size_t i = 0; i < length; i++)
+		data[offset + i] = static_cast<char>(value >> 8 * i);
+}
+
+static uint64_t ReadValue(std::string_view data, std::size_t offset, std::size_t length) {
+	uint64_t value = 0;
+	for (std::size_t i = 0; i < length; i++)
+		value |= static_cast<uint64_t>(static_cast<uint8_t>(data[offset + i])) << 8 * i;
+	return value;
+}
+
+// Averages each 2x2 square of pixels, the last row or column is repeated for odd sizes.
+static std::vector<uint8_t> Downsample(const std::vector<uint8_t> &pixels, const Vector2ui &size, const Vector2ui &halfSize) {
+	std::vector<uint8_t> result(static_cast<std::size_t>(halfSize.m_x) * halfSize.m_y * 4);
+
+	for (uint32_t y = 0; y < halfSize.m_y; y++) {
+		auto y0 = std::min(2 * y, size.m_y - 1), y1 = std::min(2 * y + 1, size.m_y - 1);
+		for (uint32_t x = 0; x < halfSize.m_x; x++) {
+			auto x0 = std::min(2 * x, size.m_x - 1), x1 = std::min(2 * x + 1, size.m_x - 1);
+			for (uint32_t c = 0; c < 4; c++) {
+				auto sum = pixels[4 * (y0 * size.m_x + x0) + c] + pixels[4 * (y0 * size.m_x + x1) + c] + pixels[4 * (y1 * size.m_x + x0) + c] +
+					pixels[4 * (y1 * size.m_x + x1) + c];
+				result[4 * (y * halfSize.m_x + x) + c] = static_cast<uint8_t>((sum + 2) / 4);
+			}
+		}
+	}
+
+	return result;
+}
+
+CompressedBitmap::CompressedBitmap(const std::filesystem::path &filename) :
+	m_filename(filename) {
+	Load(m_filename);
+}
+
+CompressedBitmap::CompressedBitmap(const Bitmap &bitmap, Format format, bool mipmap, ThreadPool *pool) :
+	m_filename(bitmap.GetFilename()),
+	m_format(format),
+	m_size(bitmap.GetSize()) {
+	if (!bitmap || bitmap.GetBytesPerPixel() != 4 || m_size.m_x == 0 || m_size.m_y == 0) {
+		Log::Error("Bitmap could not be compressed, it must have 4 bytes per pixel: ", m_filename, '\n');
+		return;
+	}
+
+	std::vector<uint8_t> pixels(bitmap.GetData().get(), bitmap.GetData().get() + bitmap.GetLength());
+	auto size = m_size;
+
+	while (true) {
+		m_levels.emplace_back(BlockCompression::Encode(format, pixels.data(), size, pool));
+
+		if (!mipmap || (size.m_x == 1 && size.m_y == 1))
+			break;
+
+		Vector2ui halfSize(std::max(size.m_x / 2, 1u), std::max(size.m_y / 2, 1u));
+		pixels = Downsample(pixels, size, halfSize);
+		size = halfSize;
+	}
+}
+
+bool CompressedBitmap::IsKtx2(std::string_view data) {
+	return data.substr(0, Ktx2Identifier.size()) == Ktx2Identifier;
+}
+
+void CompressedBitmap::Load(const std::filesystem::path &filename) {
+#if defined(ACID_DEBUG)
+	auto debugStart = Time::Now();
+#endif
+
+	std::optional<std::string> fileLoaded;
+	auto fileView = Files::ReadView(filename);
+	if (!fileView && (fileLoaded = Files::Read(filename)))
+		fileView = *fileLoaded;
+
+	if (!fileView) {
+		Log::Error("Compressed image could not be loaded: ", filename, '\n');
+		return;
+	}
+
+	if (!LoadMemory(*fileView)) {
+		Log::Error("Compressed image could not be read: ", filename, '\n');
+		return;
+	}
+
+#if defined(ACID_DEBUG)
+	Log::Out("Compressed bitmap ", filename, " loaded in ", (Time::Now() - debugStart).AsMilliseconds<float>(), "ms\n");
+#endif
+}
+
+bool CompressedBitmap::LoadMemory(std::string_view data) {
+	m_levels.clear();
+
+	if (data.size() < Ktx2HeaderLength || !IsKtx2(data))
+		return false;
+
+	auto vkFormat = static_cast<uint32_t>(ReadValue(data, 12, 4));
+	Vector2ui size(static_cast<uint32_t>(ReadValue(data, 20, 4)), static_cast<uint32_t>(ReadValue(data, 24, 4)));
+	auto depth = ReadValue(data, 28, 4), layers = ReadValue(data, 32, 4), faces = ReadValue(data, 36, 4);
+	auto levelCount = std::max<uint64_t>(ReadValue(data, 40, 4), 1);
+	auto supercompression = ReadValue(data, 44, 4);
+
+	// Only single 2D images without supercompression are supported.
+	if (size.m_x == 0 || size.m_y == 0 || depth != 0 || layers != 0 || faces != 1 || supercompression != 0 || levelCount > 32)
+		return false;
+
+	std::optional<Format> format;
+	for (auto candidate : {Format::Rgba8, Format::Bc1, Format::Bc3, Format::Bc5, Format::Bc7}) {
+		if (GetVkFormat(candidate) == vkFormat)
+			format = candidate;
+	}
+
+	// VK_FORMAT_BC1_RGB_UNORM_BLOCK decodes the same as the RGBA variant for opaque blocks.
+	if (vkFormat == 131)
+		format = Format::Bc1;
+
+	if (!format || data.size() < Ktx2HeaderLength + levelCount * Ktx2LevelLength)
+		return false;
+
+	m_format = *format;
+	m_size = size;
+	std::vector<std::vector<uint8_t>> levels(levelCount);
+
+	for (uint32_t level = 0; level < levelCount; level++) {
+		auto entry = Ktx2HeaderLength + level * Ktx2LevelLength;
+		auto offset = ReadValue(data, entry, 8);
+		auto length = ReadValue(data, entry + 8, 8);
+
+		if (length != BlockCompression::GetLength(m_format, GetSize(level)) || offset > data.size() || length > data.size() - offset)
+			return false;
+
+		levels[level].assign(data.data() + offset, data.data() + offset + length);
+	}
+
+	m_levels = std::move(levels);
+	return true;
+}
+
+void CompressedBitmap::Write(const std::filesystem::path &filename) const {
+	if (auto parentPath = filename.parent_path(); !parentPath.empty())
+		std::filesystem::create_directories(parentPath);
+
+	auto data = WriteMemory();
+	std::ofstream os(filename, std::ios::binary | std::ios::out);
+	os.write(data.data(), data.size());
+}
+
+std::string CompressedBitmap::WriteMemory() const {
+	std::string data(Ktx2HeaderLength + m_levels.size() * Ktx2LevelLength, '\0');
+	std::memcpy(data.data(), Ktx2Identifier.data(), Ktx2Identifier.size());
+
+	WriteValue(data, 12, GetVkFormat(m_format), 4);
+	// The type size is 1 for block compressed and 8 bit formats.
+	WriteValue(data, 16, 1, 4);
+	WriteValue(data, 20, m_size.m_x, 4);
+	WriteValue(data, 24, m_size.m_y, 4);
+	WriteValue(data, 36, 1, 4);
+	WriteValue(data, 40, m_levels.size(), 4);
+
+	// Levels are stored from the smallest, each aligned to the largest block length.
+	for (auto level = m_levels.size(); level-- > 0;) {
+		data.resize((data.size() + 15) & ~std::size_t(15), '\0');
+
+		auto entry = Ktx2HeaderLength + level * Ktx2LevelLength;
+		WriteValue(data, entry, data.size(), 8);
+		WriteValue(data, entry + 8, m_levels[level].size(), 8);
+		WriteValue(data, entry + 16, m_levels[level].size(), 8);
+
+		data.append(reinterpret_cast<const char *>(m_levels[level].data()), m_levels[level].size());
+	}
+
+	return data;
+}
+
+std::unique_ptr<Bitmap> CompressedBitmap::Decompress(uint32_t level, ThreadPool *pool) const {
+	auto size = GetSize(level);
+	auto bitmap = std::make_unique<Bitmap>(size);
+	bitmap->SetFilename(m_filename);
+
+	if (!BlockCompression::Decode(m_format, m_levels[level].data(), size, bitmap->GetData().get(), pool))
+		Log::Warning("Compressed bitmap has blocks that could not be decoded: ", m_filename, '\n');
+
+	return bitmap;
+}
+
+uint32_t CompressedBitmap::GetVkFormat(Format format) {
+	switch (format) {
+	case Format::Bc1:
+		return 133; // VK_FORMAT_BC1_RGBA_UNORM_BLOCK
+	case Format::Bc3:
+		return 137; // VK_FORMAT_BC3_UNORM_BLOCK
+	case Format::Bc5:
+		return 141; // VK_FORMAT_BC5_UNORM_BLOCK
+	case Format::Bc7:
+		return 145; // VK_FORMAT_BC7_UNORM_BLOCK
+	default:
+		return 37; // VK_FORMAT_R8G8B8A8_UNORM
+	}
+}
+
+Vector2ui CompressedBitmap::GetSize(uint32_t level) const {
+	return {std::max(m_size.m_x >> level, 1u), std::max(m_size.m_y >> level, 1u)};
+}
+}
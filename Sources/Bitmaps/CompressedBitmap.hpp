@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Bitmap.hpp"
+#include "BlockCompression.hpp"
+
+namespace acid {
+/**
+ * @brief Class that holds a mip chain of block compressed levels, read from and written to KTX2 files.
+ * Files are KTX2-style: the identifier, header and level index follow the specification, no data format descriptor is written.
+ */
+class ACID_EXPORT CompressedBitmap {
+public:
+	using Format = BlockCompression::Format;
+
+	CompressedBitmap() = default;
+	explicit CompressedBitmap(const std::filesystem::path &filename);
+
+	/**
+	 * Creates a compressed bitmap by encoding a RGBA8 bitmap, mip levels are box filtered on the CPU before they are encoded.
+	 * @param bitmap The bitmap to encode, must have 4 bytes per pixel.
+	 * @param format The format to encode to.
+	 * @param mipmap If every mip level down to 1x1 is encoded, otherwise only the first level is.
+	 * @param pool The pool to encode across, or nullptr to encode on this thread.
+	 */
+	CompressedBitmap(const Bitmap &bitmap, Format format, bool mipmap = true, ThreadPool *pool = nullptr);
+
+	/**
+	 * Gets if data starts with the KTX2 identifier.
+	 * @param data The file contents.
+	 * @return If the data is a KTX2 file.
+	 */
+	static bool IsKtx2(std::string_view data);
+
+	void Load(const std::filesystem::path &filename);
+
+	/**
+	 * Reads a compressed bitmap from the contents of a KTX2 file.
+	 * @param data The file contents.
+	 * @return If the file was valid and has a supported format, otherwise the bitmap is left empty.
+	 */
+	bool LoadMemory(std::string_view data);
+
+	void Write(const std::filesystem::path &filename) const;
+
+	/**
+	 * Writes the compressed bitmap as a KTX2 file.
+	 * @return The file contents.
+	 */
+	std::string WriteMemory() const;
+
+	/**
+	 * Decodes a mip level to a RGBA8 bitmap, for devices that cannot sample the format.
+	 * @param level The mip level.
+	 * @param pool The pool to decode across, or nullptr to decode on this thread.
+	 * @return The bitmap.
+	 */
+	std::unique_ptr<Bitmap> Decompress(uint32_t level = 0, ThreadPool *pool = nullptr) const;
+
+	explicit operator bool() const noexcept { return !m_levels.empty(); }
+
+	/**
+	 * Gets the VkFormat value of the format, the sRGB variants are not used.
+	 * @param format The format.
+	 * @return The VkFormat value.
+	 */
+	static uint32_t GetVkFormat(Format format);
+
+	const std::filesystem::path &GetFilename() const { return m_filename; }
+	Format GetFormat() const { return m_format; }
+	const Vector2ui &GetSize() const { return m_size; }
+	Vector2ui GetSize(uint32_t level) const;
+	uint32_t GetMipLevels() const { return static_cast<uint32_t>(m_levels.size()); }
+	const std::vector<uint8_t> &GetLevel(uint32_t level) const { return m_levels[level]; }
+
+private:
+	std::filesystem::path m_filename;
+	Format m_format = Format::Rgba8;
+	Vector2ui m_size;
+	// The encoded data of each mip level, starting with the largest.
+	std::vector<std::vector<uint8_t>> m_levels;
+};
+}
@@ -5,7 +5,7 @@
 namespace acid {
 class ACID_EXPORT BitmapPng : public Bitmap::Registrar<BitmapPng> {
 public:
-	static void Load(Bitmap *bitmap, const std::filesystem::path &filename);
+	static void Load(Bitmap *bitmap, std::string_view data);
 	static void Write(const Bitmap *bitmap, const std::filesystem::path &filename);
 
 private:
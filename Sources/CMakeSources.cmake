@@ -2,25 +2,35 @@
 set(_temp_acid_headers
 		Animations/Animation/Animation.hpp
 		Animations/Animation/AnimationLoader.hpp
+		Animations/Animation/CompiledAnimation.hpp
 		Animations/Animation/JointTransform.hpp
 		Animations/Animation/Keyframe.hpp
 		Animations/Animator.hpp
 		Animations/Geometry/GeometryLoader.hpp
 		Animations/Geometry/VertexAnimated.hpp
 		Animations/MeshAnimated.hpp
+		Animations/SkeletalModel.hpp
 		Animations/Skeleton/Joint.hpp
+		Animations/Skeleton/Skeleton.hpp
 		Animations/Skeleton/SkeletonLoader.hpp
 		Animations/Skin/SkinLoader.hpp
 		Animations/Skin/VertexWeights.hpp
 		Audio/Audio.hpp
 		Audio/Flac/SoundBufferFlac.hpp
 		Audio/Mp3/SoundBufferMp3.hpp
+		Audio/Mp3/SoundDecoderMp3.hpp
 		Audio/Ogg/SoundBufferOgg.hpp
+		Audio/Ogg/SoundDecoderOgg.hpp
 		Audio/Opus/SoundBufferOpus.hpp
 		Audio/Sound.hpp
 		Audio/SoundBuffer.hpp
+		Audio/SoundDecoder.hpp
+		Audio/SoundStream.hpp
 		Audio/Wave/SoundBufferWave.hpp
+		Audio/Wave/SoundDecoderWave.hpp
 		Bitmaps/Bitmap.hpp
+		Bitmaps/BlockCompression.hpp
+		Bitmaps/CompressedBitmap.hpp
 		Bitmaps/Png/BitmapPng.hpp
 		Devices/Instance.hpp
 		Devices/Joysticks.hpp
@@ -37,23 +47,30 @@ set(_temp_acid_headers
 		Engine/Module.hpp
 		Files/File.hpp
 		Files/FileObserver.hpp
+		Files/FileQueue.hpp
 		Files/Files.hpp
 		Files/Json/Json.hpp
 		Files/Node.hpp
 		Files/Node.inl
 		Files/NodeConstView.hpp
 		Files/NodeConstView.inl
+		Files/NodeDocument.hpp
+		Files/NodeDocument.inl
 		Files/NodeView.hpp
 		Files/NodeView.inl
+		Files/Pack/PackArchive.hpp
 		Files/Xml/Xml.hpp
+		Files/Xml/XmlReader.hpp
 		Files/Zip/miniz.h
 		Files/Zip/ZipArchive.hpp
 		Files/Zip/ZipEntry.hpp
 		Files/Zip/ZipException.hpp
 		Fonts/FontType.hpp
+		Fonts/GlyphAtlas.hpp
 		Fonts/msdf.h
 		Fonts/SubrenderFonts.hpp
 		Fonts/Text.hpp
+		Fonts/TextLayout.hpp
 		Gizmos/Gizmo.hpp
 		Gizmos/Gizmos.hpp
 		Gizmos/GizmoType.hpp
@@ -80,6 +97,7 @@ set(_temp_acid_headers
 		Graphics/Pipelines/PipelineCompute.hpp
 		Graphics/Pipelines/PipelineGraphics.hpp
 		Graphics/Pipelines/Shader.hpp
+		Graphics/Pipelines/ShaderCache.hpp
 		Graphics/Renderer.hpp
 		Graphics/Renderpass/Framebuffers.hpp
 		Graphics/Renderpass/Renderpass.hpp
@@ -95,12 +113,14 @@ set(_temp_acid_headers
 		Helpers/Enumerate.hpp
 		Helpers/Factory.hpp
 		Helpers/Future.hpp
+		Helpers/Hash.hpp
 		Helpers/NonCopyable.hpp
 		Helpers/RingBuffer.hpp
 		Helpers/StreamFactory.hpp
 		Helpers/String.hpp
 		Helpers/ThreadPool.hpp
 		Helpers/TypeInfo.hpp
+		Helpers/WorkStealingQueue.hpp
 		Inputs/Axes/Axis.hpp
 		Inputs/Axes/AxisButton.hpp
 		Inputs/Axes/AxisCompound.hpp
@@ -129,15 +149,18 @@ set(_temp_acid_headers
 		Maths/Matrix4.hpp
 		Maths/Noise/Noise.hpp
 		Maths/Quaternion.hpp
+		Maths/Simd.hpp
 		Maths/Time.hpp
 		Maths/Time.inl
 		Maths/Transform.hpp
+		Maths/TransformHierarchy.hpp
 		Maths/Vector2.hpp
 		Maths/Vector2.inl
 		Maths/Vector3.hpp
 		Maths/Vector3.inl
 		Maths/Vector4.hpp
 		Maths/Vector4.inl
+		Meshes/DrawList.hpp
 		Meshes/Mesh.hpp
 		Meshes/SubrenderMeshes.hpp
 		Models/Gltf/ModelGltf.hpp
@@ -175,6 +198,7 @@ set(_temp_acid_headers
 		Particles/Emitters/EmitterSphere.hpp
 		Particles/Particle.hpp
 		Particles/Particles.hpp
+		Particles/ParticleStore.hpp
 		Particles/ParticleSystem.hpp
 		Particles/ParticleType.hpp
 		Particles/SubrenderParticles.hpp
@@ -230,7 +254,9 @@ set(_temp_acid_headers
 		Shadows/Shadows.hpp
 		Shadows/SubrenderShadows.hpp
 		Skyboxes/MaterialSkybox.hpp
+		Timers/Timer.hpp
 		Timers/Timers.hpp
+		Timers/TimerWheel.hpp
 		Uis/Drivers/UiDriver.hpp
 		Uis/Drivers/BounceDriver.hpp
 		Uis/Drivers/ConstantDriver.hpp
@@ -256,24 +282,34 @@ set(_temp_acid_headers
 set(_temp_acid_sources
 		Animations/Animation/Animation.cpp
 		Animations/Animation/AnimationLoader.cpp
+		Animations/Animation/CompiledAnimation.cpp
 		Animations/Animation/JointTransform.cpp
 		Animations/Animation/Keyframe.cpp
 		Animations/Animator.cpp
 		Animations/Geometry/GeometryLoader.cpp
 		Animations/MeshAnimated.cpp
+		Animations/SkeletalModel.cpp
 		Animations/Skeleton/Joint.cpp
+		Animations/Skeleton/Skeleton.cpp
 		Animations/Skeleton/SkeletonLoader.cpp
 		Animations/Skin/SkinLoader.cpp
 		Animations/Skin/VertexWeights.cpp
 		Audio/Audio.cpp
 		Audio/Flac/SoundBufferFlac.cpp
 		Audio/Mp3/SoundBufferMp3.cpp
+		Audio/Mp3/SoundDecoderMp3.cpp
 		Audio/Ogg/SoundBufferOgg.cpp
+		Audio/Ogg/SoundDecoderOgg.cpp
 		Audio/Opus/SoundBufferOpus.cpp
 		Audio/Sound.cpp
 		Audio/SoundBuffer.cpp
+		Audio/SoundDecoder.cpp
+		Audio/SoundStream.cpp
 		Audio/Wave/SoundBufferWave.cpp
+		Audio/Wave/SoundDecoderWave.cpp
 		Bitmaps/Bitmap.cpp
+		Bitmaps/BlockCompression.cpp
+		Bitmaps/CompressedBitmap.cpp
 		Bitmaps/Png/BitmapPng.cpp
 		Devices/Instance.cpp
 		Devices/Joysticks.cpp
@@ -288,19 +324,25 @@ set(_temp_acid_sources
 		Engine/Log.cpp
 		Files/File.cpp
 		Files/FileObserver.cpp
+		Files/FileQueue.cpp
 		Files/Files.cpp
 		Files/Json/Json.cpp
 		Files/Node.cpp
 		Files/NodeConstView.cpp
+		Files/NodeDocument.cpp
 		Files/NodeView.cpp
+		Files/Pack/PackArchive.cpp
 		Files/Xml/Xml.cpp
+		Files/Xml/XmlReader.cpp
 		Files/Zip/miniz.c
 		Files/Zip/ZipArchive.cpp
 		Files/Zip/ZipEntry.cpp
 		Fonts/FontType.cpp
+		Fonts/GlyphAtlas.cpp
 		Fonts/msdf.c
 		Fonts/SubrenderFonts.cpp
 		Fonts/Text.cpp
+		Fonts/TextLayout.cpp
 		Gizmos/Gizmo.cpp
 		Gizmos/Gizmos.cpp
 		Gizmos/GizmoType.cpp
@@ -325,6 +367,7 @@ set(_temp_acid_sources
 		Graphics/Pipelines/PipelineCompute.cpp
 		Graphics/Pipelines/PipelineGraphics.cpp
 		Graphics/Pipelines/Shader.cpp
+		Graphics/Pipelines/ShaderCache.cpp
 		Graphics/Renderpass/Framebuffers.cpp
 		Graphics/Renderpass/Renderpass.cpp
 		Graphics/Renderpass/Swapchain.cpp
@@ -360,9 +403,11 @@ set(_temp_acid_sources
 		Maths/Noise/Noise.cpp
 		Maths/Quaternion.cpp
 		Maths/Transform.cpp
+		Maths/TransformHierarchy.cpp
 		Maths/Vector2.cpp
 		Maths/Vector3.cpp
 		Maths/Vector4.cpp
+		Meshes/DrawList.cpp
 		Meshes/Mesh.cpp
 		Meshes/SubrenderMeshes.cpp
 		Models/Gltf/ModelGltf.cpp
@@ -396,6 +441,7 @@ set(_temp_acid_sources
 		Particles/Emitters/EmitterSphere.cpp
 		Particles/Particle.cpp
 		Particles/Particles.cpp
+		Particles/ParticleStore.cpp
 		Particles/ParticleSystem.cpp
 		Particles/ParticleType.cpp
 		Particles/SubrenderParticles.cpp
@@ -436,6 +482,7 @@ set(_temp_acid_sources
 		Post/Pipelines/PipelineBlur.cpp
 		Post/PostFilter.cpp
 		Resources/Resources.cpp
+		Scenes/Component.cpp
 		Scenes/Entity.cpp
 		Scenes/EntityPrefab.cpp
 		Scenes/ScenePhysics.cpp
@@ -447,6 +494,7 @@ set(_temp_acid_sources
 		Shadows/SubrenderShadows.cpp
 		Skyboxes/MaterialSkybox.cpp
 		Timers/Timers.cpp
+		Timers/TimerWheel.cpp
 		Uis/Inputs/UiInputBoolean.cpp
 		Uis/Inputs/UiInputButton.cpp
 		Uis/Inputs/UiInputDropdown.cpp
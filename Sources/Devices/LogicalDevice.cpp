@@ -1,5 +1,7 @@
 #include "LogicalDevice.hpp"
 
+#include <cstring>
+
 #include "Graphics/Graphics.hpp"
 #include "Instance.hpp"
 #include "PhysicalDevice.hpp"
@@ -188,6 +190,24 @@ void LogicalDevice::CreateLogicalDevice() {
 		Log::Warning("Selected GPU does not support multi viewports!\n");
 	}
 
+	auto enabledExtensions = DeviceExtensions;
+
+#if defined(VK_EXT_pipeline_creation_feedback)
+	// Optional, used to count pipelines found in the pipeline cache.
+	uint32_t extensionPropertyCount;
+	vkEnumerateDeviceExtensionProperties(*m_physicalDevice, nullptr, &extensionPropertyCount, nullptr);
+	std::vector<VkExtensionProperties> extensionProperties(extensionPropertyCount);
+	vkEnumerateDeviceExtensionProperties(*m_physicalDevice, nullptr, &extensionPropertyCount, extensionProperties.data());
+
+	for (const auto &extension : extensionProperties) {
+		if (std::strcmp(extension.extensionName, VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME) == 0) {
+			enabledExtensions.emplace_back(VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME);
+			m_pipelineCreationFeedback = true;
+			break;
+		}
+	}
+#endif
+
 	VkDeviceCreateInfo deviceCreateInfo = {};
 	deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
 	deviceCreateInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
@@ -196,8 +216,8 @@ void LogicalDevice::CreateLogicalDevice() {
 		deviceCreateInfo.enabledLayerCount = static_cast<uint32_t>(Instance::ValidationLayers.size());
 		deviceCreateInfo.ppEnabledLayerNames = Instance::ValidationLayers.data();
 	}
-	deviceCreateInfo.enabledExtensionCount = static_cast<uint32_t>(DeviceExtensions.size());
-	deviceCreateInfo.ppEnabledExtensionNames = DeviceExtensions.data();
+	deviceCreateInfo.enabledExtensionCount = static_cast<uint32_t>(enabledExtensions.size());
+	deviceCreateInfo.ppEnabledExtensionNames = enabledExtensions.data();
 	deviceCreateInfo.pEnabledFeatures = &enabledFeatures;
 	Graphics::CheckVk(vkCreateDevice(*m_physicalDevice, &deviceCreateInfo, nullptr, &m_logicalDevice));
 
@@ -31,6 +31,7 @@ public:
 	uint32_t GetPresentFamily() const { return m_presentFamily; }
 	uint32_t GetComputeFamily() const { return m_computeFamily; }
 	uint32_t GetTransferFamily() const { return m_transferFamily; }
+	bool IsPipelineCreationFeedback() const { return m_pipelineCreationFeedback; }
 
 private:
 	void CreateQueueIndices();
@@ -42,6 +43,8 @@ private:
 
 	VkDevice m_logicalDevice = VK_NULL_HANDLE;
 	VkPhysicalDeviceFeatures m_enabledFeatures = {};
+	// If pipelines can report pipeline cache hits.
+	bool m_pipelineCreationFeedback = false;
 
 	VkQueueFlags m_supportedQueues = {};
 	uint32_t m_graphicsFamily = 0;
@@ -21,13 +21,140 @@
 namespace acid {
 Engine *Engine::Instance = nullptr;
 
+/**
+ * @brief The order modules in a stage must update in. Exclusive modules split the stage into segments,
+ * inside a segment a module waits only for earlier modules it conflicts with.
+ */
+class StageGraph {
+public:
+	class Node {
+	public:
+		Module *module;
+		bool exclusive;
+		std::vector<uint32_t> predecessors;
+		std::vector<uint32_t> successors;
+		Time elapsed;
+		Time finish;
+	};
+
+	explicit StageGraph(std::vector<Module *> modules) :
+		m_modules(std::move(modules)),
+		m_remaining(std::make_unique<std::atomic<uint32_t>[]>(m_modules.size())) {
+		std::vector<uint32_t> segment;
+
+		for (uint32_t i = 0; i < m_modules.size(); i++) {
+			auto &node = m_nodes.emplace_back(Node{m_modules[i], m_modules[i]->GetDependencies().exclusive, {}, {}, {}, {}});
+
+			if (node.exclusive) {
+				if (!segment.empty())
+					m_segments.emplace_back(std::move(segment));
+				segment.clear();
+				m_segments.push_back({i});
+				continue;
+			}
+
+			for (auto j : segment) {
+				if (m_modules[j]->GetDependencies().ConflictsWith(m_modules[i]->GetDependencies())) {
+					m_nodes[j].successors.emplace_back(i);
+					node.predecessors.emplace_back(j);
+				}
+			}
+
+			segment.emplace_back(i);
+		}
+
+		if (!segment.empty())
+			m_segments.emplace_back(std::move(segment));
+	}
+
+	void Run(ThreadPool &pool) {
+		for (const auto &segment : m_segments) {
+			// Exclusive modules and single module segments update on this thread.
+			if (segment.size() == 1) {
+				RunNode(nullptr, nullptr, segment.front());
+				continue;
+			}
+
+			JobCounter counter;
+
+			for (auto i : segment) {
+				m_remaining[i] = static_cast<uint32_t>(m_nodes[i].predecessors.size());
+			}
+
+			for (auto i : segment) {
+				if (m_nodes[i].predecessors.empty()) {
+					pool.Submit([this, &pool, &counter, i]() {
+						RunNode(&pool, &counter, i);
+					}, &counter);
+				}
+			}
+
+			pool.Wait(counter);
+		}
+	}
+
+	void Report(StageReport &report) {
+		report.m_serial = {};
+		report.m_criticalPath = {};
+		report.m_modules.clear();
+
+		for (const auto &segment : m_segments) {
+			Time segmentPath;
+
+			// Segments are in registry order, so predecessors always finish before their successors are visited.
+			for (auto i : segment) {
+				auto &node = m_nodes[i];
+				Time start;
+
+				for (auto predecessor : node.predecessors)
+					start = std::max(start, m_nodes[predecessor].finish);
+
+				node.finish = start + node.elapsed;
+				segmentPath = std::max(segmentPath, node.finish);
+				report.m_serial += node.elapsed;
+				report.m_modules.emplace_back(typeid(*node.module).name(), node.elapsed);
+			}
+
+			report.m_criticalPath += segmentPath;
+		}
+	}
+
+	const std::vector<Module *> &GetModules() const { return m_modules; }
+
+private:
+	void RunNode(ThreadPool *pool, JobCounter *counter, uint32_t index) {
+		auto &node = m_nodes[index];
+		auto start = Time::Now();
+		node.module->Update();
+		node.elapsed = Time::Now() - start;
+
+		if (!pool)
+			return;
+
+		for (auto successor : node.successors) {
+			if (m_remaining[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+				pool->Submit([this, pool, counter, successor]() {
+					RunNode(pool, counter, successor);
+				}, counter);
+			}
+		}
+	}
+
+	std::vector<Module *> m_modules;
+	std::vector<Node> m_nodes;
+	std::vector<std::vector<uint32_t>> m_segments;
+	std::unique_ptr<std::atomic<uint32_t>[]> m_remaining;
+};
+
 Engine::Engine(std::string argv0, bool emptyRegister) :
 	m_argv0(std::move(argv0)),
 	m_version{ACID_VERSION_MAJOR, ACID_VERSION_MINOR, ACID_VERSION_PATCH},
 	m_fpsLimit(-1.0f),
 	m_running(true),
 	m_elapsedUpdate(15.77ms),
-	m_elapsedRender(-1s) {
+	m_elapsedRender(-1s),
+	m_parallelUpdates(true),
+	m_updatePool(GetUpdateThreadCount()) {
 	Instance = this;
 	Log::OpenLog(Time::GetDateTime("Logs/%Y%m%d%H%M%S.txt"));
 
@@ -62,6 +189,16 @@ Engine::~Engine() {
 	Log::CloseLog();
 }
 
+uint32_t Engine::GetUpdateThreadCount() {
+	// The main thread also runs module updates while it waits, the loader threads take the rest of the cores.
+	auto cores = std::max(std::thread::hardware_concurrency(), 2u);
+	return std::max(cores - 1 - GetLoaderThreadCount(), 1u);
+}
+
+uint32_t Engine::GetLoaderThreadCount() {
+	return std::max(std::thread::hardware_concurrency() / 4, 1u);
+}
+
 int32_t Engine::Run() {
 	while (m_running) {
 		if (m_app) {
@@ -117,9 +254,42 @@ int32_t Engine::Run() {
 }
 
 void Engine::UpdateStage(Module::Stage stage) {
+	auto start = Time::Now();
+	auto &report = m_stageReports[stage];
+
+	if (!m_parallelUpdates) {
+		report.m_serial = {};
+		report.m_modules.clear();
+
+		for (auto &[stageIndex, module] : Module::Registry()) {
+			if (stageIndex.first != stage)
+				continue;
+
+			auto moduleStart = Time::Now();
+			module->Update();
+			auto elapsed = Time::Now() - moduleStart;
+			report.m_modules.emplace_back(typeid(*module).name(), elapsed);
+			report.m_serial += elapsed;
+		}
+
+		report.m_elapsed = Time::Now() - start;
+		report.m_criticalPath = report.m_serial;
+		return;
+	}
+
+	std::vector<Module *> modules;
 	for (auto &[stageIndex, module] : Module::Registry()) {
 		if (stageIndex.first == stage)
-			module->Update();
+			modules.emplace_back(module.get());
 	}
+
+	// The graph is only rebuilt when modules are registered or deregistered.
+	auto &graph = m_stageGraphs[stage];
+	if (!graph || graph->GetModules() != modules)
+		graph = std::make_unique<StageGraph>(std::move(modules));
+
+	graph->Run(m_updatePool);
+	report.m_elapsed = Time::Now() - start;
+	graph->Report(report);
 }
 }
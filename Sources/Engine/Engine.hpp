@@ -3,6 +3,7 @@
 #include <cmath>
 
 #include "Helpers/NonCopyable.hpp"
+#include "Helpers/ThreadPool.hpp"
 #include "Maths/ElapsedTime.hpp"
 #include "Maths/Time.hpp"
 #include "Module.hpp"
@@ -40,6 +41,23 @@ public:
 	Time m_valueTime;
 };
 
+/**
+ * @brief Timings from the last update of a module stage.
+ */
+class ACID_EXPORT StageReport {
+public:
+	// Time from the start to the end of the stage.
+	Time m_elapsed;
+	// Sum of every module update, what the stage takes when updated serially.
+	Time m_serial;
+	// Longest chain of module updates that had to run in order, the lower bound for the stage.
+	Time m_criticalPath;
+	// Update time of every module in the stage, by module type name.
+	std::vector<std::pair<std::string, Time>> m_modules;
+};
+
+class StageGraph;
+
 /**
  * @brief Main class for Acid, manages modules and updates. After creating your Engine object call {@link Engine#Run} to start.
  */
@@ -137,6 +155,43 @@ public:
 	 */
 	void RequestClose() { m_running = false; }
 
+	/**
+	 * Gets if concurrent modules with non-conflicting dependencies update in parallel.
+	 * @return If parallel updates are enabled.
+	 */
+	bool IsParallelUpdates() const { return m_parallelUpdates; }
+
+	/**
+	 * Sets if concurrent modules with non-conflicting dependencies update in parallel.
+	 * @param parallelUpdates If parallel updates are enabled.
+	 */
+	void SetParallelUpdates(bool parallelUpdates) { m_parallelUpdates = parallelUpdates; }
+
+	/**
+	 * Gets the timings from the last update of a stage.
+	 * @param stage The module stage.
+	 * @return The stage timings.
+	 */
+	const StageReport &GetStageReport(Module::Stage stage) { return m_stageReports[stage]; }
+
+	/**
+	 * Gets the pool modules are updated on, modules may split their own work across it.
+	 * @return The update thread pool.
+	 */
+	ThreadPool &GetUpdatePool() { return m_updatePool; }
+
+	/**
+	 * Gets how many workers the update pool is created with, sized together with the resource loader pool so both fit the cores.
+	 * @return The update thread count.
+	 */
+	static uint32_t GetUpdateThreadCount();
+
+	/**
+	 * Gets how many workers the resource loader pool is created with.
+	 * @return The resource loader thread count.
+	 */
+	static uint32_t GetLoaderThreadCount();
+
 private:
 	void UpdateStage(Module::Stage stage);
 	
@@ -156,5 +211,10 @@ private:
 	ElapsedTime m_elapsedRender;
 
 	ChangePerSecond m_ups, m_fps;
+
+	bool m_parallelUpdates;
+	ThreadPool m_updatePool;
+	std::map<Module::Stage, std::unique_ptr<StageGraph>> m_stageGraphs;
+	std::map<Module::Stage, StageReport> m_stageReports;
 };
 }
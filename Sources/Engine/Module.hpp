@@ -1,7 +1,10 @@
 #pragma once
 
+#include <algorithm>
 #include <map>
 #include <memory>
+#include <typeindex>
+#include <vector>
 
 #include "Helpers/NonCopyable.hpp"
 
@@ -17,6 +20,72 @@ public:
 	using StageIndex = std::pair<Stage, std::size_t>;
 	using TRegistryMap = std::multimap<StageIndex, std::unique_ptr<Base>>;
 
+	/**
+	 * @brief The modules a module reads and writes in <seealso cref="Module#Update()"/>,
+	 * concurrent modules in the same stage that do not conflict may update in parallel.
+	 */
+	class Dependencies {
+	public:
+		/**
+		 * Gets if updating these modules at the same time as another set is unsafe.
+		 * @param other The other modules dependencies.
+		 * @return If the dependencies conflict.
+		 */
+		bool ConflictsWith(const Dependencies &other) const {
+			if (exclusive || other.exclusive)
+				return true;
+
+			auto intersects = [](const std::vector<std::type_index> &a, const std::vector<std::type_index> &b) {
+				return std::any_of(a.begin(), a.end(), [&b](const std::type_index &type) {
+					return std::find(b.begin(), b.end(), type) != b.end();
+				});
+			};
+			return intersects(writes, other.writes) || intersects(writes, other.reads) || intersects(reads, other.writes);
+		}
+
+		// Modules that are not marked concurrent update alone on the main thread.
+		bool exclusive = true;
+		std::vector<std::type_index> reads;
+		std::vector<std::type_index> writes;
+	};
+
+	/**
+	 * @brief Marks a module as safe to update on a worker thread, used as a <seealso cref="Registrar"/> argument.
+	 * Only add it once the update has been checked to touch nothing but the module itself and the modules it declares,
+	 * and to run no callbacks that expect the main thread.
+	 */
+	class Concurrent {
+	public:
+		static void Append(Dependencies &dependencies) {
+			dependencies.exclusive = false;
+		}
+	};
+
+	/**
+	 * @brief Declares modules that are read from during update, used as a <seealso cref="Registrar"/> argument.
+	 * @tparam Ts The module types.
+	 */
+	template<typename... Ts>
+	class Reads {
+	public:
+		static void Append(Dependencies &dependencies) {
+			(dependencies.reads.emplace_back(typeid(Ts)), ...);
+		}
+	};
+
+	/**
+	 * @brief Declares modules that are written to during update, used as a <seealso cref="Registrar"/> argument.
+	 * A module always writes to itself.
+	 * @tparam Ts The module types.
+	 */
+	template<typename... Ts>
+	class Writes {
+	public:
+		static void Append(Dependencies &dependencies) {
+			(dependencies.writes.emplace_back(typeid(Ts)), ...);
+		}
+	};
+
 	virtual ~ModuleFactory() = default;
 
 	static TRegistryMap &Registry() {
@@ -29,7 +98,23 @@ public:
 		return ++id;
 	}
 
-	template<typename T, Stage S>
+	/**
+	 * Gets the modules this module reads and writes during update.
+	 * @return The module dependencies.
+	 */
+	virtual const Dependencies &GetDependencies() const {
+		static const Dependencies exclusive;
+		return exclusive;
+	}
+
+	/**
+	 * @brief Registers a module type into a stage.
+	 * @tparam T The module type.
+	 * @tparam S The stage the module updates in.
+	 * @tparam Access Any number of <seealso cref="Reads"/> and <seealso cref="Writes"/> declarations,
+	 * and <seealso cref="Concurrent"/>, without it the module updates alone on the main thread.
+	 */
+	template<typename T, Stage S, typename... Access>
 	class Registrar : public Base {
 	public:
 		/**
@@ -63,7 +148,17 @@ public:
 			ModuleInstance = nullptr;
 			return true;
 		}
-		
+
+		const Dependencies &GetDependencies() const override {
+			static const Dependencies dependencies = [] {
+				Dependencies dependencies;
+				dependencies.writes.emplace_back(typeid(T));
+				(Access::Append(dependencies), ...);
+				return dependencies;
+			}();
+			return dependencies;
+		}
+
 	private:
 		// Named ModuleInstance instead of Instance to avoid name collisions.
 		inline static T *ModuleInstance = nullptr;
@@ -1,21 +1,81 @@
 #include "FileObserver.hpp"
 
+#include <cstring>
+
+#if defined(ACID_BUILD_LINUX)
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "Engine/Log.hpp"
+
 namespace acid {
-FileObserver::FileObserver(std::filesystem::path path, const Time &delay) :
+// A batch is delivered once this many debounce times have passed since its first change, even if changes keep coming.
+static constexpr int64_t MaxDebounces = 10;
+
+#if defined(ACID_BUILD_LINUX)
+static constexpr uint32_t WatchMask = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF;
+#endif
+
+void FileObserver::Batch::Add(const std::filesystem::path &path, Status status) {
+	auto [it, added] = m_indices.try_emplace(path.string(), m_changes.size());
+
+	if (added) {
+		m_changes.emplace_back(Change{path, status});
+		return;
+	}
+
+	auto &change = m_changes[it->second];
+
+	if (!change) {
+		change = Change{path, status};
+		return;
+	}
+
+	switch (change->status) {
+	case Status::Created:
+		// A file created and erased in the same batch never existed.
+		if (status == Status::Erased)
+			change = std::nullopt;
+		break;
+	case Status::Modified:
+		if (status == Status::Erased)
+			change->status = Status::Erased;
+		break;
+	case Status::Erased:
+		// A file erased and created again, like editors that save by replacing the file, was modified.
+		if (status != Status::Erased)
+			change->status = Status::Modified;
+		break;
+	}
+}
+
+std::vector<FileObserver::Change> FileObserver::Batch::Take() {
+	std::vector<Change> changes;
+	changes.reserve(m_changes.size());
+
+	for (auto &change : m_changes) {
+		if (change)
+			changes.emplace_back(std::move(*change));
+	}
+
+	m_changes.clear();
+	m_indices.clear();
+	return changes;
+}
+
+FileObserver::FileObserver(std::filesystem::path path, const Time &delay, Backend backend, const Time &debounce) :
 	m_path(std::move(path)),
 	m_delay(delay),
-	m_running(true),
-	m_thread(&FileObserver::QueueLoop, this) {
-	DoWithFilesInPath([this](const std::filesystem::path &file) {
-		m_paths[file.string()] = std::filesystem::last_write_time(file);
-	});
+	m_debounce(debounce),
+	m_backend(backend) {
+	Start();
 }
 
 FileObserver::~FileObserver() {
-	if (m_thread.joinable()) {
-		m_running = false;
-		m_thread.join();
-	}
+	Stop();
 }
 
 void FileObserver::DoWithFilesInPath(const std::function<void(std::filesystem::path)> &f) const {
@@ -23,49 +83,301 @@ void FileObserver::DoWithFilesInPath(const std::function<void(std::filesystem::p
 		f(m_path);
 		return;
 	}
-	for (auto &file : std::filesystem::recursive_directory_iterator(m_path)) {
-		f(file.path());
+
+	// Files can be erased while they are iterated, those are skipped.
+	std::error_code error;
+	for (std::filesystem::recursive_directory_iterator it(m_path, std::filesystem::directory_options::skip_permission_denied, error), end;
+		it != end; it.increment(error)) {
+		f(it->path());
 	}
 }
 
-void FileObserver::QueueLoop() {
-	while (m_running) {
-		// Wait for "delay" milliseconds
-		std::this_thread::sleep_for(std::chrono::microseconds(m_delay));
+void FileObserver::SetPath(const std::filesystem::path &path) {
+	Stop();
+	m_path = path;
+	Start();
+}
+
+void FileObserver::SetDelay(const Time &delay) {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_delay = delay;
+	m_condition.notify_all();
+}
+
+void FileObserver::SetDebounce(const Time &debounce) {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_debounce = debounce;
+}
+
+void FileObserver::Start() {
+	m_running = true;
+
+#if defined(ACID_BUILD_LINUX)
+	if (m_backend == Backend::Inotify) {
+		m_inotify = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+		m_stopEvent = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+		if (m_inotify >= 0 && m_stopEvent >= 0 && AddWatches(m_path, nullptr)) {
+			m_thread = std::thread(&FileObserver::InotifyLoop, this);
+			return;
+		}
+
+		Log::Warning("Failed to watch ", m_path, " with inotify, it will be polled\n");
+
+		if (m_inotify >= 0)
+			close(m_inotify);
+		if (m_stopEvent >= 0)
+			close(m_stopEvent);
+		m_inotify = m_stopEvent = -1;
+		m_watches.clear();
+	}
+#endif
+
+	m_backend = Backend::Polling;
+
+	// The write times are recorded before the first poll, so existing files are not reported as created.
+	m_paths.clear();
+	DoWithFilesInPath([this](const std::filesystem::path &file) {
+		std::error_code error;
+		m_paths[file.string()] = std::filesystem::last_write_time(file, error);
+	});
+
+	m_thread = std::thread(&FileObserver::PollLoop, this);
+}
+
+void FileObserver::Stop() {
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_running = false;
+	}
+
+	m_condition.notify_all();
+
+#if defined(ACID_BUILD_LINUX)
+	if (m_stopEvent >= 0) {
+		uint64_t value = 1;
+		[[maybe_unused]] auto result = write(m_stopEvent, &value, sizeof(value));
+	}
+#endif
+
+	if (m_thread.joinable())
+		m_thread.join();
+
+#if defined(ACID_BUILD_LINUX)
+	if (m_inotify >= 0)
+		close(m_inotify);
+	if (m_stopEvent >= 0)
+		close(m_stopEvent);
+	m_inotify = m_stopEvent = -1;
+	m_watches.clear();
+#endif
+}
+
+bool FileObserver::AddWatches(const std::filesystem::path &path, Batch *batch) {
+#if defined(ACID_BUILD_LINUX)
+	auto addWatch = [this](const std::filesystem::path &directory) {
+		auto watch = inotify_add_watch(m_inotify, directory.c_str(), WatchMask);
+
+		if (watch < 0) {
+			Log::Warning("Failed to watch ", directory, ", ", std::strerror(errno), '\n');
+			return false;
+		}
+
+		m_watches[watch] = directory;
+		return true;
+	};
 
-		// Check if one of the old files was erased
+	if (!addWatch(path))
+		return false;
+
+	std::error_code error;
+	if (!std::filesystem::is_directory(path, error))
+		return true;
+
+	// Every directory is watched, inotify does not watch recursively.
+	for (std::filesystem::recursive_directory_iterator it(path, std::filesystem::directory_options::skip_permission_denied, error), end;
+		it != end; it.increment(error)) {
+		// Files created in a new directory before it was watched are found here.
+		if (batch)
+			batch->Add(it->path(), Status::Created);
+
+		if (it->is_directory(error) && !addWatch(it->path()))
+			return false;
+	}
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+void FileObserver::Deliver(Batch &batch) {
+	if (batch.IsEmpty())
+		return;
+
+	auto changes = batch.Take();
+
+	if (changes.empty())
+		return;
+
+	m_onChanges(changes);
+
+	for (const auto &change : changes)
+		m_onChange(change.path, change.status);
+}
+
+void FileObserver::PollLoop() {
+	Batch batch;
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	while (!m_condition.wait_for(lock, std::chrono::microseconds(m_delay), [this]() {
+		return !m_running;
+	})) {
+		lock.unlock();
+
+		// Check if one of the old files was erased.
 		for (auto it = m_paths.begin(); it != m_paths.end();) {
-			if (!std::filesystem::exists(it->first)) {
-				m_onChange(std::filesystem::path(it->first), Status::Erased);
+			std::error_code error;
+
+			if (!std::filesystem::exists(it->first, error)) {
+				batch.Add(it->first, Status::Erased);
 				it = m_paths.erase(it);
 				continue;
 			}
 
 			++it;
 		}
-		
-		// Check if a file was created or modified
+
+		// Check if a file was created or modified.
 		DoWithFilesInPath([&](const std::filesystem::path &file) {
-			auto lastWriteTime = std::filesystem::last_write_time(file);
-
-			// File creation
-			if (!Contains(file.string())) {
-				// File modification
-				m_paths[file.string()] = lastWriteTime;
-				m_onChange(file.string(), Status::Created);
-			} else {
-				if (m_paths[file.string()] != lastWriteTime) {
-					m_paths[file.string()] = lastWriteTime;
-					m_onChange(file.string(), Status::Modified);
-				}
+			std::error_code error;
+			auto lastWriteTime = std::filesystem::last_write_time(file, error);
+			auto [it, created] = m_paths.try_emplace(file.string(), lastWriteTime);
+
+			if (created) {
+				batch.Add(file, Status::Created);
+			} else if (it->second != lastWriteTime) {
+				it->second = lastWriteTime;
+				batch.Add(file, Status::Modified);
 			}
 		});
+
+		Deliver(batch);
+		lock.lock();
 	}
 }
 
-bool FileObserver::Contains(const std::string &key) const {
-	// TODO C++20: Remove method
-	auto el = m_paths.find(key);
-	return el != m_paths.end();
+void FileObserver::InotifyLoop() {
+#if defined(ACID_BUILD_LINUX)
+	alignas(inotify_event) char buffer[16384];
+	Batch batch;
+	std::chrono::steady_clock::time_point firstChange, lastChange;
+
+	while (true) {
+		// Waits for events, or until the pending batch is due.
+		auto timeout = -1;
+
+		if (!batch.IsEmpty()) {
+			std::chrono::microseconds debounce;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				debounce = m_debounce;
+			}
+
+			auto due = std::min(lastChange + debounce, firstChange + MaxDebounces * debounce);
+			auto now = std::chrono::steady_clock::now();
+
+			if (now >= due) {
+				Deliver(batch);
+				continue;
+			}
+
+			timeout = static_cast<int>(std::chrono::ceil<std::chrono::milliseconds>(due - now).count());
+		}
+
+		pollfd fds[] = {{m_inotify, POLLIN, 0}, {m_stopEvent, POLLIN, 0}};
+
+		if (poll(fds, 2, timeout) < 0 && errno != EINTR) {
+			Log::Error("Failed to wait for changes in ", m_path, ", ", std::strerror(errno), '\n');
+			return;
+		}
+
+		if (fds[1].revents & POLLIN)
+			return;
+
+		if (!(fds[0].revents & POLLIN))
+			continue;
+
+		auto empty = batch.IsEmpty();
+		ssize_t length;
+
+		while ((length = read(m_inotify, buffer, sizeof(buffer))) > 0) {
+			for (auto data = buffer; data < buffer + length;) {
+				auto event = reinterpret_cast<const inotify_event *>(data);
+				data += sizeof(inotify_event) + event->len;
+
+				// The kernel queue filled up and events were lost, so every file is reported.
+				if (event->mask & IN_Q_OVERFLOW) {
+					Log::Warning("File changes in ", m_path, " were lost, every file is reported as modified\n");
+					DoWithFilesInPath([&batch](const std::filesystem::path &file) {
+						batch.Add(file, Status::Modified);
+					});
+					continue;
+				}
+
+				auto watch = m_watches.find(event->wd);
+
+				if (watch == m_watches.end())
+					continue;
+
+				if (event->mask & IN_IGNORED) {
+					m_watches.erase(watch);
+					continue;
+				}
+
+				auto path = event->len > 0 ? watch->second / event->name : watch->second;
+
+				if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+					batch.Add(path, Status::Created);
+
+					if (event->mask & IN_ISDIR)
+						AddWatches(path, &batch);
+				} else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+					batch.Add(path, Status::Erased);
+
+					// Watches in a directory moved out keep reporting with the old path, so they are removed.
+					if ((event->mask & (IN_MOVED_FROM | IN_ISDIR)) == (IN_MOVED_FROM | IN_ISDIR)) {
+						auto prefix = path.string();
+
+						for (auto it = m_watches.begin(); it != m_watches.end();) {
+							auto name = it->second.string();
+
+							if (name.compare(0, prefix.size(), prefix) == 0 && (name.size() == prefix.size() || name[prefix.size()] == '/')) {
+								inotify_rm_watch(m_inotify, it->first);
+								it = m_watches.erase(it);
+								continue;
+							}
+
+							++it;
+						}
+					}
+				} else if (event->mask & IN_DELETE_SELF) {
+					// Only the watched path is reported, erased directories inside it are reported by their parent.
+					if (watch->second == m_path)
+						batch.Add(path, Status::Erased);
+				} else {
+					batch.Add(path, Status::Modified);
+				}
+			}
+		}
+
+		auto now = std::chrono::steady_clock::now();
+
+		if (empty)
+			firstChange = now;
+
+		lastChange = now;
+	}
+#endif
 }
 }
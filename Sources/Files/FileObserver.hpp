@@ -1,7 +1,10 @@
 #pragma once
 
+#include <condition_variable>
 #include <filesystem>
+#include <optional>
 #include <thread>
+#include <unordered_map>
 
 #include "Maths/Time.hpp"
 #include "Helpers/Delegate.hpp"
@@ -9,45 +12,97 @@
 namespace acid {
 /**
  * @brief Class that can listen to file changes on a path recursively.
+ * On Linux changes are read from inotify, otherwise or if inotify is not available the path is polled.
+ * Changes are collected until the path has been quiet for the debounce time, and are then delivered together.
  */
-class ACID_EXPORT FileObserver {
+class ACID_EXPORT FileObserver : NonCopyable {
 public:
 	enum class Status { Created, Modified, Erased };
 
+	enum class Backend { Polling, Inotify };
+
+	class Change {
+	public:
+		std::filesystem::path path;
+		Status status;
+	};
+
 	/**
 	 * Creates a new file watcher.
 	 * @param path The path to watch recursively.
-	 * @param delay How frequently to check for changes.
+	 * @param delay How frequently to check for changes when polling.
+	 * @param backend The backend to use, inotify falls back to polling if it is not available.
+	 * @param debounce How long the path must be quiet for before changes are delivered.
 	 */
-	explicit FileObserver(std::filesystem::path path, const Time &delay = 5s);
+	explicit FileObserver(std::filesystem::path path, const Time &delay = 5s, Backend backend = Backend::Inotify, const Time &debounce = 100ms);
 
 	~FileObserver();
 
 	void DoWithFilesInPath(const std::function<void(std::filesystem::path)> &f) const;
 
 	const std::filesystem::path &GetPath() const { return m_path; }
-	void SetPath(const std::filesystem::path &path) { m_path = path; }
+	void SetPath(const std::filesystem::path &path);
 
 	const Time &GetDelay() const { return m_delay; }
-	void SetDelay(const Time &delay) { m_delay = delay; }
+	void SetDelay(const Time &delay);
+
+	const Time &GetDebounce() const { return m_debounce; }
+	void SetDebounce(const Time &debounce);
+
+	Backend GetBackend() const { return m_backend; }
 
 	/**
-	 * Called when a file or directory has changed.
+	 * Called when a file or directory has changed, after the batch it is in.
 	 * @return The delegate.
 	 */
 	Delegate<void(std::filesystem::path, Status)> &OnChange() { return m_onChange; }
 
+	/**
+	 * Called with a batch of changes, each path changes at most once in a batch.
+	 * @return The delegate.
+	 */
+	Delegate<void(const std::vector<Change> &)> &OnChanges() { return m_onChanges; }
+
 private:
-	void QueueLoop();
+	/**
+	 * @brief Coalesces repeated changes to a path, a file created and then modified is only created.
+	 */
+	class Batch {
+	public:
+		void Add(const std::filesystem::path &path, Status status);
+		std::vector<Change> Take();
+		bool IsEmpty() const { return m_changes.empty(); }
+
+	private:
+		std::vector<std::optional<Change>> m_changes;
+		std::unordered_map<std::string, std::size_t> m_indices;
+	};
 
-	bool Contains(const std::string &key) const;
+	void Start();
+	void Stop();
+	bool AddWatches(const std::filesystem::path &path, Batch *batch);
+	void Deliver(Batch &batch);
+	void PollLoop();
+	void InotifyLoop();
 
 	std::filesystem::path m_path;
 	Time m_delay;
+	Time m_debounce;
+	Backend m_backend;
 	Delegate<void(std::filesystem::path, Status)> m_onChange;
+	Delegate<void(const std::vector<Change> &)> m_onChanges;
 
-	bool m_running;
+	bool m_running = false;
 	std::thread m_thread;
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	int m_inotify = -1;
+	// Written to wake the inotify loop when stopping.
+	int m_stopEvent = -1;
+	// Watched directories by watch descriptor.
+	std::unordered_map<int, std::filesystem::path> m_watches;
+
+	// Write times of every polled path.
 	std::unordered_map<std::string, std::filesystem::file_time_type> m_paths;
 };
 }
@@ -0,0 +1,546 @@
+#include "FileQueue.hpp"
+
+#include <cstring>
+#include <fstream>
+
+#if defined(ACID_BUILD_LINUX)
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#include "Engine/Log.hpp"
+#include "Files.hpp"
+
+namespace acid {
+#if defined(ACID_BUILD_LINUX)
+/**
+ * @brief A io_uring instance set up with system calls, so there is no dependency on liburing.
+ */
+class FileQueue::Ring : NonCopyable {
+public:
+	explicit Ring(uint32_t entries) {
+		io_uring_params params = {};
+		m_fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+		m_event = eventfd(0, EFD_CLOEXEC);
+
+		if (m_fd < 0 || m_event < 0)
+			return;
+
+		m_sqLength = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+		m_cqLength = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+		auto singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+
+		// Kernels with a single mmap share one mapping between both rings.
+		if (singleMmap)
+			m_sqLength = m_cqLength = std::max(m_sqLength, m_cqLength);
+
+		if (!Map(m_sq, m_sqLength, IORING_OFF_SQ_RING))
+			return;
+
+		if (singleMmap)
+			m_cq = m_sq;
+		else if (!Map(m_cq, m_cqLength, IORING_OFF_CQ_RING))
+			return;
+
+		m_sqesLength = params.sq_entries * sizeof(io_uring_sqe);
+		void *sqes = nullptr;
+		if (!Map(sqes, m_sqesLength, IORING_OFF_SQES))
+			return;
+
+		auto sq = static_cast<uint8_t *>(m_sq);
+		auto cq = static_cast<uint8_t *>(m_cq);
+		m_sqes = static_cast<io_uring_sqe *>(sqes);
+		m_sqHead = reinterpret_cast<uint32_t *>(sq + params.sq_off.head);
+		m_sqTail = reinterpret_cast<uint32_t *>(sq + params.sq_off.tail);
+		m_sqArray = reinterpret_cast<uint32_t *>(sq + params.sq_off.array);
+		m_sqMask = *reinterpret_cast<uint32_t *>(sq + params.sq_off.ring_mask);
+		m_sqEntries = params.sq_entries;
+		m_cqHead = reinterpret_cast<uint32_t *>(cq + params.cq_off.head);
+		m_cqTail = reinterpret_cast<uint32_t *>(cq + params.cq_off.tail);
+		m_cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+		m_cqMask = *reinterpret_cast<uint32_t *>(cq + params.cq_off.ring_mask);
+		m_tail = *m_sqTail;
+		m_valid = true;
+	}
+
+	~Ring() {
+		if (m_sqes)
+			munmap(m_sqes, m_sqesLength);
+		if (m_cq && m_cq != m_sq)
+			munmap(m_cq, m_cqLength);
+		if (m_sq)
+			munmap(m_sq, m_sqLength);
+		if (m_event >= 0)
+			close(m_event);
+		if (m_fd >= 0)
+			close(m_fd);
+	}
+
+	explicit operator bool() const noexcept { return m_valid; }
+
+	/**
+	 * Gets the next submission entry, cleared.
+	 * @return The entry, or nullptr if the submission ring is full.
+	 */
+	io_uring_sqe *GetEntry() {
+		if (m_tail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE) >= m_sqEntries)
+			return nullptr;
+
+		auto index = m_tail & m_sqMask;
+		auto entry = &m_sqes[index];
+		std::memset(entry, 0, sizeof(io_uring_sqe));
+		m_sqArray[index] = index;
+		m_tail++;
+		return entry;
+	}
+
+	/**
+	 * Submits the entries gotten since the last submit, and waits for completions.
+	 * @param waitCount The number of completions to wait for.
+	 * @return If the entries were submitted.
+	 */
+	bool Submit(uint32_t waitCount) {
+		__atomic_store_n(m_sqTail, m_tail, __ATOMIC_RELEASE);
+
+		while (true) {
+			// Entries the kernel has not consumed, after a interrupted wait this is none.
+			auto count = m_tail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+			if (syscall(__NR_io_uring_enter, m_fd, count, waitCount, waitCount > 0 ? IORING_ENTER_GETEVENTS : 0, nullptr, 0) >= 0)
+				return true;
+			if (errno != EINTR)
+				return false;
+		}
+	}
+
+	/**
+	 * Calls a function for every completion that has arrived.
+	 * @tparam F The function type, called with a completion.
+	 * @param f The function to call.
+	 */
+	template<typename F>
+	void Reap(F &&f) {
+		auto head = *m_cqHead;
+		auto tail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+
+		for (; head != tail; head++) {
+			auto completion = m_cqes[head & m_cqMask];
+			__atomic_store_n(m_cqHead, head + 1, __ATOMIC_RELEASE);
+			f(completion);
+		}
+	}
+
+	/**
+	 * Wakes the I/O thread from waiting on completions.
+	 */
+	void Wake() const {
+		uint64_t value = 1;
+		[[maybe_unused]] auto result = write(m_event, &value, sizeof(value));
+	}
+
+	int GetEvent() const { return m_event; }
+
+private:
+	bool Map(void *&pointer, std::size_t length, uint64_t offset) const {
+		pointer = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, static_cast<off_t>(offset));
+		if (pointer == MAP_FAILED)
+			pointer = nullptr;
+		return pointer;
+	}
+
+	int m_fd = -1;
+	// Written to by other threads to wake the I/O thread, it is polled through the ring.
+	int m_event = -1;
+	bool m_valid = false;
+
+	void *m_sq = nullptr;
+	void *m_cq = nullptr;
+	std::size_t m_sqLength = 0;
+	std::size_t m_cqLength = 0;
+	std::size_t m_sqesLength = 0;
+
+	io_uring_sqe *m_sqes = nullptr;
+	uint32_t *m_sqHead = nullptr;
+	uint32_t *m_sqTail = nullptr;
+	uint32_t *m_sqArray = nullptr;
+	uint32_t m_sqMask = 0;
+	uint32_t m_sqEntries = 0;
+	// The tail including entries that have not been submitted.
+	uint32_t m_tail = 0;
+
+	io_uring_cqe *m_cqes = nullptr;
+	uint32_t *m_cqHead = nullptr;
+	uint32_t *m_cqTail = nullptr;
+	uint32_t m_cqMask = 0;
+};
+#else
+class FileQueue::Ring {
+};
+#endif
+
+FileRequest::FileRequest(std::filesystem::path filename, Callback &&callback, Priority priority, uint64_t sequence) :
+	m_filename(std::move(filename)),
+	m_callback(std::move(callback)),
+	m_priority(priority),
+	m_sequence(sequence) {
+}
+
+FileQueue::FileQueue(ThreadPool *pool, Backend backend, uint32_t depth) :
+	m_pool(pool),
+	m_backend(backend),
+	m_depth(std::max(depth, 1u)) {
+#if defined(ACID_BUILD_LINUX)
+	if (m_backend == Backend::IoUring) {
+		// One more entry than the depth is used to wait for new requests.
+		m_ring = std::make_unique<Ring>(m_depth + 1);
+
+		if (*m_ring) {
+			m_threads.emplace_back([this]() {
+				RingLoop();
+			});
+			return;
+		}
+
+		Log::Warning("io_uring is not available, file reads will block on I/O threads\n");
+		m_ring = nullptr;
+	}
+#endif
+
+	m_backend = Backend::Threads;
+
+	for (uint32_t i = 0; i < std::min(m_depth, 4u); i++) {
+		m_threads.emplace_back([this]() {
+			ThreadLoop();
+		});
+	}
+}
+
+FileQueue::~FileQueue() {
+	std::vector<std::shared_ptr<FileRequest>> requests;
+
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_stop = true;
+
+		for (; !m_requests.empty(); m_requests.pop())
+			requests.emplace_back(m_requests.top());
+	}
+
+	// Queued requests are cancelled, reads in flight and their callbacks finish.
+	for (const auto &request : requests)
+		Cancel(*request);
+
+	m_condition.notify_all();
+#if defined(ACID_BUILD_LINUX)
+	if (m_ring)
+		m_ring->Wake();
+#endif
+
+	for (auto &thread : m_threads)
+		thread.join();
+
+	Wait();
+}
+
+std::shared_ptr<FileRequest> FileQueue::Read(const std::filesystem::path &filename, FileRequest::Callback callback, FileRequest::Priority priority) {
+	std::shared_ptr<FileRequest> request;
+
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		request = std::make_shared<FileRequest>(filename, std::move(callback), priority, m_sequence++);
+		m_requests.emplace(request);
+		m_unfinished++;
+	}
+
+#if defined(ACID_BUILD_LINUX)
+	if (m_ring)
+		m_ring->Wake();
+#endif
+
+	// The I/O thread waits on the condition once io_uring has failed, so it is always notified.
+	m_condition.notify_one();
+	return request;
+}
+
+bool FileQueue::Cancel(FileRequest &request) {
+	auto status = FileRequest::Status::Queued;
+
+	// Cancelled requests stay in the queue, and are skipped once they reach the top.
+	if (request.m_status.compare_exchange_strong(status, FileRequest::Status::Cancelled)) {
+		Finish(request);
+		return true;
+	}
+
+	// Reads in flight finish, and are discarded once they complete.
+	return status == FileRequest::Status::Reading && request.m_status.compare_exchange_strong(status, FileRequest::Status::Cancelled);
+}
+
+void FileQueue::Wait(const FileRequest &request) {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_doneCondition.wait(lock, [&request]() {
+		return request.m_done.load();
+	});
+}
+
+void FileQueue::Wait() {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_doneCondition.wait(lock, [this]() {
+		return m_unfinished == 0;
+	});
+}
+
+std::shared_ptr<FileRequest> FileQueue::PopRequest(bool wait) {
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	while (true) {
+		if (wait) {
+			m_condition.wait(lock, [this]() {
+				return m_stop || !m_requests.empty();
+			});
+		}
+
+		if (m_requests.empty())
+			return nullptr;
+
+		auto request = m_requests.top();
+		m_requests.pop();
+
+		auto status = FileRequest::Status::Queued;
+		if (request->m_status.compare_exchange_strong(status, FileRequest::Status::Reading))
+			return request;
+	}
+}
+
+bool FileQueue::ReadBlocking(FileRequest &request) const {
+	if (auto view = Files::ReadView(request.m_filename)) {
+		request.m_data = *view;
+		return true;
+	}
+
+	if (auto path = Files::FindPath(request.m_filename)) {
+		std::ifstream is(*path, std::ios::binary);
+		std::error_code error;
+		auto size = std::filesystem::file_size(*path, error);
+
+		if (is && !error) {
+			request.m_data.resize(static_cast<std::size_t>(size));
+			is.read(request.m_data.data(), static_cast<std::streamsize>(size));
+			request.m_data.resize(static_cast<std::size_t>(is.gcount()));
+			return true;
+		}
+	}
+
+	// Files inside mounted archives are read through Files.
+	if (auto data = Files::Read(request.m_filename)) {
+		request.m_data = std::move(*data);
+		return true;
+	}
+
+	return false;
+}
+
+void FileQueue::Complete(const std::shared_ptr<FileRequest> &request, bool success) {
+	auto status = FileRequest::Status::Reading;
+
+	if (!request->m_status.compare_exchange_strong(status, success ? FileRequest::Status::Completed : FileRequest::Status::Failed)) {
+		// The request was cancelled while it was read.
+		std::string().swap(request->m_data);
+		Finish(*request);
+		return;
+	}
+
+	if (!request->m_callback) {
+		Finish(*request);
+		return;
+	}
+
+	// Callbacks decode on the pool, so the I/O thread can keep reads in flight.
+	if (m_pool) {
+		m_pool->Submit([this, request]() {
+			request->m_callback(*request);
+			Finish(*request);
+		});
+		return;
+	}
+
+	request->m_callback(*request);
+	Finish(*request);
+}
+
+void FileQueue::Finish(FileRequest &request) {
+	request.m_callback = nullptr;
+
+	// The queue can be destroyed as soon as the lock is released.
+	std::unique_lock<std::mutex> lock(m_mutex);
+	request.m_done = true;
+	m_unfinished--;
+	m_doneCondition.notify_all();
+}
+
+void FileQueue::ThreadLoop() {
+	while (auto request = PopRequest(true))
+		Complete(request, ReadBlocking(*request));
+}
+
+void FileQueue::RingLoop() {
+#if defined(ACID_BUILD_LINUX)
+	// Reads are split so each is below the limit of a single read.
+	static constexpr std::size_t MaxReadLength = 1 << 30;
+
+	// A file being read, reads are submitted until the whole file is read.
+	class Reading {
+	public:
+		std::shared_ptr<FileRequest> request;
+		int fd;
+		std::size_t offset = 0;
+		iovec vector = {};
+	};
+
+	auto submitWake = [this]() {
+		auto entry = m_ring->GetEntry();
+		entry->opcode = IORING_OP_POLL_ADD;
+		entry->fd = m_ring->GetEvent();
+		entry->poll_events = POLLIN;
+		entry->user_data = 0;
+	};
+	auto submitRead = [this](Reading *reading) {
+		auto &data = reading->request->m_data;
+		reading->vector.iov_base = data.data() + reading->offset;
+		reading->vector.iov_len = std::min(data.size() - reading->offset, MaxReadLength);
+
+		// Readv is used over read, it is supported since io_uring was added.
+		auto entry = m_ring->GetEntry();
+		entry->opcode = IORING_OP_READV;
+		entry->fd = reading->fd;
+		entry->addr = reinterpret_cast<uint64_t>(&reading->vector);
+		entry->len = 1;
+		entry->off = reading->offset;
+		entry->user_data = reinterpret_cast<uint64_t>(reading);
+	};
+
+	submitWake();
+	std::vector<Reading *> inFlight;
+	std::vector<Reading *> resubmit;
+	// Buffers of reads in flight when io_uring failed, the kernel may still write to them so they are kept until the queue stops.
+	std::vector<std::string> abandoned;
+
+	while (true) {
+		// Requests are started while the ring has room, they are opened on this thread.
+		while (inFlight.size() < m_depth) {
+			auto request = PopRequest(false);
+
+			if (!request)
+				break;
+
+			std::optional<std::filesystem::path> path;
+			if (!Files::ReadView(request->m_filename))
+				path = Files::FindPath(request->m_filename);
+
+			if (!path) {
+				Complete(request, ReadBlocking(*request));
+				continue;
+			}
+
+			auto fd = open(path->c_str(), O_RDONLY | O_CLOEXEC);
+			struct stat info = {};
+
+			if (fd < 0 || fstat(fd, &info) != 0) {
+				Log::Error("Failed to open file ", *path, ", ", std::strerror(errno), '\n');
+				if (fd >= 0)
+					close(fd);
+				Complete(request, false);
+				continue;
+			}
+
+			if (info.st_size == 0) {
+				close(fd);
+				Complete(request, true);
+				continue;
+			}
+
+			request->m_data.resize(static_cast<std::size_t>(info.st_size));
+			auto reading = new Reading{request, fd};
+			submitRead(reading);
+			inFlight.emplace_back(reading);
+		}
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			if (m_stop && inFlight.empty())
+				return;
+		}
+
+		// When the kernel is out of resources or the completion ring is full, completions are reaped before the submit is retried.
+		if (!m_ring->Submit(1) && errno != EAGAIN && errno != EBUSY) {
+			auto error = std::strerror(errno);
+			Log::Error("Failed to submit file reads, ", error, ", file reads will block on the I/O thread\n");
+			m_backend = Backend::Threads;
+
+			for (auto reading : inFlight) {
+				Log::Error("Failed to read file ", reading->request->m_filename, ", ", error, '\n');
+				abandoned.emplace_back(std::move(reading->request->m_data));
+				reading->request->m_data.clear();
+				close(reading->fd);
+				Complete(reading->request, false);
+				delete reading;
+			}
+
+			// Queued requests and requests queued from now on are read on this thread.
+			ThreadLoop();
+			return;
+		}
+
+		auto wake = false;
+		m_ring->Reap([&](const io_uring_cqe &completion) {
+			if (completion.user_data == 0) {
+				uint64_t value;
+				[[maybe_unused]] auto result = read(m_ring->GetEvent(), &value, sizeof(value));
+				wake = true;
+				return;
+			}
+
+			auto reading = reinterpret_cast<Reading *>(completion.user_data);
+			auto &data = reading->request->m_data;
+
+			if (completion.res == -EINTR || completion.res == -EAGAIN) {
+				resubmit.emplace_back(reading);
+				return;
+			}
+
+			if (completion.res > 0) {
+				reading->offset += static_cast<std::size_t>(completion.res);
+
+				if (reading->offset < data.size()) {
+					resubmit.emplace_back(reading);
+					return;
+				}
+			} else if (completion.res == 0) {
+				// The file was shortened after it was opened.
+				data.resize(reading->offset);
+			} else {
+				Log::Error("Failed to read file ", reading->request->m_filename, ", ", std::strerror(-completion.res), '\n');
+			}
+
+			close(reading->fd);
+			inFlight.erase(std::find(inFlight.begin(), inFlight.end(), reading));
+			Complete(reading->request, completion.res >= 0);
+			delete reading;
+		});
+
+		if (wake)
+			submitWake();
+
+		for (auto reading : resubmit)
+			submitRead(reading);
+
+		resubmit.clear();
+	}
+#endif
+}
+}
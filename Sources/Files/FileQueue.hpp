@@ -0,0 +1,143 @@
+#pragma once
+
+#include <filesystem>
+#include <queue>
+
+#include "Helpers/ThreadPool.hpp"
+
+namespace acid {
+/**
+ * @brief A read queued on a {@link FileQueue}, the data can be used once the request has completed.
+ */
+class ACID_EXPORT FileRequest : NonCopyable {
+	friend class FileQueue;
+public:
+	enum class Priority {
+		Low,
+		Normal,
+		High
+	};
+
+	enum class Status {
+		Queued,
+		Reading,
+		Completed,
+		Failed,
+		Cancelled
+	};
+
+	using Callback = std::function<void(FileRequest &)>;
+
+	FileRequest(std::filesystem::path filename, Callback &&callback, Priority priority, uint64_t sequence);
+
+	const std::filesystem::path &GetFilename() const { return m_filename; }
+	Priority GetPriority() const { return m_priority; }
+	Status GetStatus() const { return m_status; }
+
+	/**
+	 * Gets if the request has finished, and its callback has returned.
+	 * @return If the request is done.
+	 */
+	bool IsDone() const { return m_done; }
+
+	const std::string &GetData() const { return m_data; }
+	std::string &GetData() { return m_data; }
+
+private:
+	std::filesystem::path m_filename;
+	Callback m_callback;
+	Priority m_priority;
+	// The order requests were queued in, requests with the same priority are read first in first out.
+	uint64_t m_sequence;
+	std::atomic<Status> m_status = Status::Queued;
+	std::atomic<bool> m_done = false;
+	std::string m_data;
+};
+
+/**
+ * @brief Class that reads files asynchronously, callbacks run on a thread pool as reads complete so decoding overlaps with I/O.
+ * On Linux reads are submitted through io_uring, otherwise or if io_uring is not available reads block on I/O threads.
+ * Files in mounted packs are copied from the mapping, files inside other mounted archives are read through {@link Files#Read}.
+ */
+class ACID_EXPORT FileQueue : NonCopyable {
+public:
+	enum class Backend {
+		Threads,
+		IoUring
+	};
+
+	/**
+	 * Creates a file queue.
+	 * @param pool The pool callbacks run on, or nullptr to run them on the I/O thread that read the file.
+	 * @param backend The backend to use, io_uring falls back to threads if it is not available.
+	 * @param depth The number of reads in flight at once, the thread backend uses up to 4 I/O threads.
+	 */
+	explicit FileQueue(ThreadPool *pool = nullptr, Backend backend = Backend::IoUring, uint32_t depth = 32);
+
+	~FileQueue();
+
+	/**
+	 * Queues a read of a whole file.
+	 * @param filename The file to read, found like {@link Files#Read} does.
+	 * @param callback The callback run once the file is read or has failed, not called if the request is cancelled.
+	 * @param priority Requests with a higher priority are started first.
+	 * @return The request.
+	 */
+	std::shared_ptr<FileRequest> Read(const std::filesystem::path &filename, FileRequest::Callback callback = nullptr,
+		FileRequest::Priority priority = FileRequest::Priority::Normal);
+
+	/**
+	 * Cancels a request that has not completed, its data is discarded and its callback is not called.
+	 * @param request The request.
+	 * @return If the request was cancelled.
+	 */
+	bool Cancel(FileRequest &request);
+
+	/**
+	 * Waits for a request to be done.
+	 * @param request The request.
+	 */
+	void Wait(const FileRequest &request);
+
+	/**
+	 * Waits for every request to be done.
+	 */
+	void Wait();
+
+	Backend GetBackend() const { return m_backend; }
+
+private:
+	class Ring;
+
+	class RequestCompare {
+	public:
+		bool operator()(const std::shared_ptr<FileRequest> &a, const std::shared_ptr<FileRequest> &b) const {
+			return a->m_priority != b->m_priority ? a->m_priority < b->m_priority : a->m_sequence > b->m_sequence;
+		}
+	};
+
+	std::shared_ptr<FileRequest> PopRequest(bool wait);
+	bool ReadBlocking(FileRequest &request) const;
+	void Complete(const std::shared_ptr<FileRequest> &request, bool success);
+	void Finish(FileRequest &request);
+	void ThreadLoop();
+	void RingLoop();
+
+	ThreadPool *m_pool;
+	// Changed to threads by the I/O thread if io_uring fails.
+	std::atomic<Backend> m_backend;
+	uint32_t m_depth;
+	std::unique_ptr<Ring> m_ring;
+	std::vector<std::thread> m_threads;
+
+	std::priority_queue<std::shared_ptr<FileRequest>, std::vector<std::shared_ptr<FileRequest>>, RequestCompare> m_requests;
+	uint64_t m_sequence = 0;
+	// Requests that are not done.
+	std::size_t m_unfinished = 0;
+	bool m_stop = false;
+
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::condition_variable m_doneCondition;
+};
+}
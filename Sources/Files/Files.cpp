@@ -194,6 +194,19 @@ void Files::AddSearchPath(const std::string &path) {
 		return;
 	}
 
+	if (std::filesystem::path(path).extension() == ".pak") {
+		auto pack = std::make_unique<PackArchive>(path);
+
+		if (!*pack) {
+			Log::Warning("Failed to mount pack ", path, '\n');
+			return;
+		}
+
+		m_packs.emplace_back(std::move(pack));
+		m_searchPaths.emplace_back(path);
+		return;
+	}
+
 	if (PHYSFS_mount(path.c_str(), nullptr, true) == 0) {
 		Log::Warning("Failed to mount path ", path, ", ", PHYSFS_getErrorByCode(PHYSFS_getLastErrorCode()), '\n');
 		return;
@@ -209,6 +222,12 @@ void Files::RemoveSearchPath(const std::string &path) {
 		return;
 	}
 
+	if (auto pack = std::find_if(m_packs.begin(), m_packs.end(), [&path](const auto &p) { return p->GetFilename() == path; }); pack != m_packs.end()) {
+		m_packs.erase(pack);
+		m_searchPaths.erase(it);
+		return;
+	}
+
 	if (PHYSFS_unmount(path.c_str()) == 0) {
 		Log::Warning("Failed to unmount path ", path, ", ", PHYSFS_getErrorByCode(PHYSFS_getLastErrorCode()), '\n');
 		return;
@@ -218,7 +237,13 @@ void Files::RemoveSearchPath(const std::string &path) {
 }
 
 void Files::ClearSearchPath() {
+	m_packs.clear();
+
 	for (const auto &searchPath : m_searchPaths) {
+		if (std::filesystem::path(searchPath).extension() == ".pak") {
+			continue;
+		}
+
 		if (PHYSFS_unmount(searchPath.c_str()) == 0) {
 			Log::Warning("Failed to unmount path ", searchPath, ", ", PHYSFS_getErrorByCode(PHYSFS_getLastErrorCode()), '\n');
 		}
@@ -228,6 +253,14 @@ void Files::ClearSearchPath() {
 }
 
 bool Files::ExistsInPath(const std::filesystem::path &path) {
+	if (auto files = Get()) {
+		for (const auto &pack : files->m_packs) {
+			if (pack->Exists(path.string())) {
+				return true;
+			}
+		}
+	}
+
 	if (PHYSFS_isInit() == 0) {
 		return false;
 	}
@@ -238,6 +271,15 @@ bool Files::ExistsInPath(const std::filesystem::path &path) {
 }
 
 std::optional<std::string> Files::Read(const std::filesystem::path &path) {
+	// Compressed pack entries are inflated straight into the returned string, rather than being kept by the pack and copied.
+	if (auto files = Get()) {
+		for (const auto &pack : files->m_packs) {
+			if (auto data = pack->Read(path.string())) {
+				return data;
+			}
+		}
+	}
+
 	auto pathStr = path.string();
 	std::replace(pathStr.begin(), pathStr.end(), '\\', '/');
 	auto fsFile = PHYSFS_openRead(pathStr.c_str());
@@ -248,21 +290,57 @@ std::optional<std::string> Files::Read(const std::filesystem::path &path) {
 			return std::nullopt;
 		}
 
-		std::ifstream is(path);
+		std::ifstream is(path, std::ios::binary);
 		std::stringstream buffer;
 		buffer << is.rdbuf();
 		return buffer.str();
 	}
 
+	// The file is read straight into the returned string.
 	auto size = PHYSFS_fileLength(fsFile);
-	std::vector<uint8_t> data(size);
+	std::string data(static_cast<std::size_t>(size), '\0');
 	PHYSFS_readBytes(fsFile, data.data(), static_cast<PHYSFS_uint64>(size));
 
 	if (PHYSFS_close(fsFile) == 0) {
 		Log::Error("Failed to close file ", path, ", ", PHYSFS_getErrorByCode(PHYSFS_getLastErrorCode()), '\n');
 	}
 
-	return std::string(data.begin(), data.end());
+	return data;
+}
+
+std::optional<std::string_view> Files::ReadView(const std::filesystem::path &path) {
+	auto files = Get();
+
+	if (!files) {
+		return std::nullopt;
+	}
+
+	// Packs are searched in the order they were added.
+	for (const auto &pack : files->m_packs) {
+		if (auto view = pack->ReadView(path.string())) {
+			return view;
+		}
+	}
+
+	return std::nullopt;
+}
+
+std::optional<std::filesystem::path> Files::FindPath(const std::filesystem::path &path) {
+	if (PHYSFS_isInit() != 0) {
+		auto pathStr = path.string();
+		std::replace(pathStr.begin(), pathStr.end(), '\\', '/');
+
+		// The real dir is the mounted directory or archive that has the file.
+		if (auto realDir = PHYSFS_getRealDir(pathStr.c_str()); realDir && std::filesystem::is_directory(realDir)) {
+			return std::filesystem::path(realDir) / pathStr;
+		}
+	}
+
+	if (std::filesystem::is_regular_file(path)) {
+		return path;
+	}
+
+	return std::nullopt;
 }
 
 std::vector<unsigned char> Files::ReadBytes(const std::filesystem::path &path) {
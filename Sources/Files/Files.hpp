@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Engine/Engine.hpp"
+#include "Pack/PackArchive.hpp"
 
 struct PHYSFS_File;
 
@@ -50,7 +51,7 @@ public:
 	void Update() override;
 
 	/**
-	 * Adds an file search path.
+	 * Adds an file search path, paths with the ".pak" extension are mapped as pack archives and searched before other paths.
 	 * @param path The path to add.
 	 */
 	void AddSearchPath(const std::string &path);
@@ -80,6 +81,20 @@ public:
 	 */
 	static std::optional<std::string> Read(const std::filesystem::path &path);
 
+	/**
+	 * Views a file in a mounted pack archive without copying it.
+	 * @param path The path to view.
+	 * @return The data of the file, valid until its pack is removed, or std::nullopt if no mounted pack has the file.
+	 */
+	static std::optional<std::string_view> ReadView(const std::filesystem::path &path);
+
+	/**
+	 * Finds where a file found by real or partial path is on disk, files inside mounted archives are not on disk.
+	 * @param path The path to find.
+	 * @return The path on disk, or std::nullopt if the file is not found or is inside an archive.
+	 */
+	static std::optional<std::filesystem::path> FindPath(const std::filesystem::path &path);
+
 	/**
 	 * Reads all bytes from file found by real or partial path.
 	 * @param path The path to read.
@@ -105,5 +120,6 @@ public:
 
 private:
 	std::vector<std::string> m_searchPaths;
+	std::vector<std::unique_ptr<PackArchive>> m_packs;
 };
 }
@@ -1,8 +1,501 @@
 #include "Json.hpp"
 
+#include <algorithm>
+#include <array>
+#include <deque>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ACID_JSON_SSE
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 #include "Helpers/String.hpp"
 
 namespace acid {
+// Characters are classified in blocks, with one bit per character in 64-bit masks.
+static constexpr std::size_t BlockSize = 64;
+// Bytes tokenized before the tokens are parsed, and read from a stream at once, must be a multiple of the block size.
+static constexpr std::size_t ChunkSize = 1024 * BlockSize;
+// Skipped when a document starts with it, it is not whitespace to the tokenizer.
+static constexpr std::string_view ByteOrderMark = "\xEF\xBB\xBF";
+
+static uint32_t CountTrailingZeros(uint64_t bits) {
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward64(&index, bits);
+	return static_cast<uint32_t>(index);
+#else
+	return static_cast<uint32_t>(__builtin_ctzll(bits));
+#endif
+}
+
+/**
+ * @brief Class that finds the tokens of json text a block at a time, in the style of simdjson's structural index.
+ * Quotes, backslashes, structural characters and whitespace are found as bit masks, the masks are combined
+ * to find where strings and values start and end without looking at each character again.
+ */
+class Json::Tokenizer {
+public:
+	/**
+	 * Starts a new buffer, tokens found in the previous buffer are no longer valid.
+	 */
+	void BeginBuffer() { m_finished.clear(); }
+
+	/**
+	 * Finds tokens in a range of whole blocks of the buffer.
+	 * @param data The buffer.
+	 * @param begin The start of the range, a multiple of the block size.
+	 * @param end The end of the range, a multiple of the block size.
+	 * @param tokens The tokens found, views point into the buffer or the tokenizer and are valid until the next buffer.
+	 */
+	void Tokenize(std::string_view data, std::size_t begin, std::size_t end, Tokens &tokens);
+
+	/**
+	 * Finds tokens after the last whole block of the buffer, a token that is not finished is continued by the next buffer.
+	 * @param data The buffer, its size must be a multiple of the block size unless this is the last buffer.
+	 * @param last If this is the last buffer.
+	 * @param tokens The tokens found.
+	 */
+	void EndBuffer(std::string_view data, bool last, Tokens &tokens);
+
+private:
+	class Masks {
+	public:
+		uint64_t m_quotes = 0;
+		uint64_t m_backslashes = 0;
+		uint64_t m_structurals = 0;
+		uint64_t m_whitespace = 0;
+	};
+
+	static Masks Classify(const char *block);
+	static uint64_t FindEscaped(uint64_t backslashes, uint64_t &prevEscaped);
+	static uint64_t PrefixXor(uint64_t bits);
+
+	void TokenizeBlock(std::string_view data, std::size_t offset, Tokens &tokens);
+	void StartToken(std::size_t start, Type type);
+	void EndToken(std::string_view data, std::size_t end, Tokens &tokens);
+
+	// If the last character of the previous block was escaped, in a string, or part of a value.
+	uint64_t m_prevEscaped = 0;
+	uint64_t m_prevInString = 0;
+	uint64_t m_prevInValue = 0;
+
+	// The token being read, only valid when the type is not Unknown.
+	Type m_tokenType = Type::Unknown;
+	std::size_t m_tokenStart = 0;
+	// The start of a token that began in a previous buffer.
+	std::string m_partial;
+	// Storage for tokens finished in this call that did not fit in one buffer.
+	std::deque<std::string> m_finished;
+	bool m_spanning = false;
+	// The last partial block, padded with whitespace.
+	std::array<char, BlockSize> m_padded;
+};
+
+/**
+ * @brief Class that builds a node tree or a document from tokens as they are found.
+ */
+class Json::Parser {
+public:
+	explicit Parser(Node &root) : m_root(&root) {}
+	explicit Parser(NodeDocument &document) : m_document(&document) {}
+
+	/**
+	 * Parses a buffer, the buffer may end in the middle of a value.
+	 * @param data The buffer, its size must be a multiple of the block size unless this is the last buffer.
+	 * @param last If this is the last buffer.
+	 */
+	void Parse(std::string_view data, bool last);
+
+private:
+	void AddTokens();
+	void AddToken(const Token &token);
+	void BeginValue(Type type);
+	void AddValue(const Token &token);
+	void EndValue(Type type);
+
+	// The token as it was written, for error messages.
+	static std::string DescribeToken(const Token &token);
+
+	Tokenizer m_tokenizer;
+	Tokens m_tokens;
+
+	Node *m_root = nullptr;
+	NodeDocument *m_document = nullptr;
+	// Open objects and arrays when building a node tree.
+	std::vector<Node *> m_nodes;
+
+	// The name of the next property in a object, copied when building nodes as the token will not outlive the buffer.
+	std::string_view m_key;
+	std::string m_keyStorage;
+	bool m_hasKey = false;
+	bool m_expectingColon = false;
+	// After a value in a object or array only a comma or the end may follow, after a comma only a value.
+	bool m_expectingComma = false;
+	bool m_afterComma = false;
+	bool m_started = false;
+	bool m_finished = false;
+};
+
+void Json::Tokenizer::Tokenize(std::string_view data, std::size_t begin, std::size_t end, Tokens &tokens) {
+	for (auto offset = begin; offset < end; offset += BlockSize)
+		TokenizeBlock(data, offset, tokens);
+}
+
+void Json::Tokenizer::EndBuffer(std::string_view data, bool last, Tokens &tokens) {
+	auto offset = data.size() - data.size() % BlockSize;
+
+	if (last && offset < data.size()) {
+		// The partial block is copied with whitespace after it, the token it is in is moved into the partial token first.
+		if (m_tokenType != Type::Unknown) {
+			m_partial.append(data.substr(m_spanning ? 0 : m_tokenStart, offset - (m_spanning ? 0 : m_tokenStart)));
+			m_spanning = true;
+		}
+
+		m_padded.fill(' ');
+		std::memcpy(m_padded.data(), data.data() + offset, data.size() - offset);
+		data = {m_padded.data(), m_padded.size()};
+		offset = 0;
+		TokenizeBlock(data, offset, tokens);
+		offset = BlockSize;
+	}
+
+	if (m_tokenType == Type::Unknown)
+		return;
+
+	if (last) {
+		if (m_tokenType == Type::String)
+			throw std::runtime_error("Missing end of string");
+		EndToken(data, data.size(), tokens);
+		return;
+	}
+
+	// Keeps the unfinished token for the next buffer.
+	m_partial.append(data.substr(m_spanning ? 0 : m_tokenStart));
+	m_spanning = true;
+}
+
+Json::Tokenizer::Masks Json::Tokenizer::Classify(const char *block) {
+	Masks masks;
+
+#if defined(ACID_JSON_SSE)
+	for (uint32_t i = 0; i < BlockSize; i += 16) {
+		auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + i));
+		auto equals = [chunk](char c) {
+			return _mm_cmpeq_epi8(chunk, _mm_set1_epi8(c));
+		};
+
+		auto structurals = _mm_or_si128(_mm_or_si128(_mm_or_si128(equals('{'), equals('}')), _mm_or_si128(equals('['), equals(']'))),
+			_mm_or_si128(equals(':'), equals(',')));
+		auto whitespace = _mm_or_si128(_mm_or_si128(equals(' '), equals('\n')), _mm_or_si128(equals('\r'), equals('\t')));
+
+		masks.m_quotes |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(equals('"')))) << i;
+		masks.m_backslashes |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(equals('\\')))) << i;
+		masks.m_structurals |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(structurals))) << i;
+		masks.m_whitespace |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(whitespace))) << i;
+	}
+#else
+	for (uint32_t i = 0; i < BlockSize; i++) {
+		auto bit = uint64_t(1) << i;
+
+		switch (block[i]) {
+		case '"':
+			masks.m_quotes |= bit;
+			break;
+		case '\\':
+			masks.m_backslashes |= bit;
+			break;
+		case '{':
+		case '}':
+		case '[':
+		case ']':
+		case ':':
+		case ',':
+			masks.m_structurals |= bit;
+			break;
+		case ' ':
+		case '\n':
+		case '\r':
+		case '\t':
+			masks.m_whitespace |= bit;
+			break;
+		default:
+			break;
+		}
+	}
+#endif
+
+	return masks;
+}
+
+uint64_t Json::Tokenizer::FindEscaped(uint64_t backslashes, uint64_t &prevEscaped) {
+	// A character is escaped when it follows a odd length run of backslashes, runs are found with a carrying add.
+	constexpr uint64_t EvenBits = 0x5555555555555555;
+
+	backslashes &= ~prevEscaped;
+	auto followsEscape = backslashes << 1 | prevEscaped;
+	auto oddSequenceStarts = backslashes & ~EvenBits & ~followsEscape;
+
+	auto sequencesStartingOnEvenBits = oddSequenceStarts + backslashes;
+	prevEscaped = sequencesStartingOnEvenBits < oddSequenceStarts ? 1 : 0;
+
+	auto invertMask = sequencesStartingOnEvenBits << 1;
+	return (EvenBits ^ invertMask) & followsEscape;
+}
+
+uint64_t Json::Tokenizer::PrefixXor(uint64_t bits) {
+	// Each bit becomes the xor of itself and every bit below it, so bits between pairs of quotes are set.
+	bits ^= bits << 1;
+	bits ^= bits << 2;
+	bits ^= bits << 4;
+	bits ^= bits << 8;
+	bits ^= bits << 16;
+	bits ^= bits << 32;
+	return bits;
+}
+
+void Json::Tokenizer::TokenizeBlock(std::string_view data, std::size_t offset, Tokens &tokens) {
+	auto masks = Classify(data.data() + offset);
+
+	auto quotes = masks.m_quotes & ~FindEscaped(masks.m_backslashes, m_prevEscaped);
+	// Set from a opening quote up to, but not including, the closing quote.
+	auto inString = PrefixXor(quotes) ^ m_prevInString;
+	m_prevInString = static_cast<uint64_t>(static_cast<int64_t>(inString) >> 63);
+
+	auto openQuotes = quotes & inString;
+	auto closeQuotes = quotes & ~inString;
+	auto outside = ~inString & ~closeQuotes;
+	auto structurals = masks.m_structurals & outside;
+
+	// Values are runs of characters outside strings that are not whitespace or structural.
+	auto values = outside & ~masks.m_whitespace & ~masks.m_structurals;
+	auto valuesShifted = values << 1 | m_prevInValue;
+	auto valueStarts = values & ~valuesShifted;
+	auto valueEnds = ~values & valuesShifted;
+	m_prevInValue = values >> 63;
+
+	auto ends = valueEnds | closeQuotes;
+	auto starts = structurals | openQuotes | valueStarts;
+
+	for (auto events = ends | starts; events != 0; events &= events - 1) {
+		auto bit = CountTrailingZeros(events);
+		auto mask = uint64_t(1) << bit;
+		auto index = offset + bit;
+
+		if (ends & mask)
+			EndToken(data, index, tokens);
+
+		if (structurals & mask)
+			tokens.emplace_back(Type::Token, data.substr(index, 1));
+		else if (openQuotes & mask)
+			StartToken(index + 1, Type::String);
+		else if (valueStarts & mask)
+			StartToken(index, Type::Unknown);
+	}
+}
+
+void Json::Tokenizer::StartToken(std::size_t start, Type type) {
+	// Values are typed when they end, Unknown would mean no token so Integer marks a value being read.
+	m_tokenType = type == Type::String ? Type::String : Type::Integer;
+	m_tokenStart = start;
+}
+
+void Json::Tokenizer::EndToken(std::string_view data, std::size_t end, Tokens &tokens) {
+	std::string_view view;
+
+	if (m_spanning) {
+		auto &finished = m_finished.emplace_back(std::move(m_partial));
+		finished.append(data.substr(0, end));
+		m_partial.clear();
+		m_spanning = false;
+		view = finished;
+	} else {
+		view = data.substr(m_tokenStart, end - m_tokenStart);
+	}
+
+	auto type = m_tokenType == Type::String ? Type::String : GetTokenType(view);
+	tokens.emplace_back(type, type == Type::Null ? std::string_view() : view);
+	m_tokenType = Type::Unknown;
+}
+
+void Json::Parser::Parse(std::string_view data, bool last) {
+	// Tokens are parsed a chunk at a time, so only a chunk of tokens is ever stored.
+	auto whole = data.size() - data.size() % BlockSize;
+	m_tokenizer.BeginBuffer();
+
+	for (std::size_t begin = 0; begin < whole; begin += ChunkSize) {
+		m_tokenizer.Tokenize(data, begin, std::min(begin + ChunkSize, whole), m_tokens);
+		AddTokens();
+	}
+
+	m_tokenizer.EndBuffer(data, last, m_tokens);
+	AddTokens();
+
+	// Keys are views into the buffer, so are kept until their value is found in a later buffer.
+	if (m_hasKey && !m_document && m_key.data() != m_keyStorage.data()) {
+		m_keyStorage = m_key;
+		m_key = m_keyStorage;
+	}
+
+	if (!last)
+		return;
+
+	if (!m_started)
+		throw std::runtime_error("No tokens found in document");
+	if (!m_finished)
+		throw std::runtime_error("Missing end of object or array");
+
+	if (m_document)
+		m_document->End();
+}
+
+void Json::Parser::AddTokens() {
+	for (const auto &token : m_tokens)
+		AddToken(token);
+
+	m_tokens.clear();
+}
+
+void Json::Parser::AddToken(const Token &token) {
+	// Only whitespace may follow the root value.
+	if (m_finished)
+		throw std::runtime_error("Unexpected " + DescribeToken(token) + " after the end of the document");
+
+	m_started = true;
+	auto openType = m_document ? (m_document->GetOpenCount() != 0 ? m_document->GetOpenType() : Type::Unknown) :
+		(!m_nodes.empty() ? m_nodes.back()->GetType() : Type::Unknown);
+
+	if (m_expectingColon) {
+		if (token.type != Type::Token || token.view.front() != ':')
+			throw std::runtime_error("Missing object colon before " + DescribeToken(token));
+		m_expectingColon = false;
+		return;
+	}
+
+	auto isToken = token.type == Type::Token;
+
+	if (m_expectingComma) {
+		if (!isToken || (token.view.front() != ',' && token.view.front() != '}' && token.view.front() != ']'))
+			throw std::runtime_error("Missing comma before " + DescribeToken(token));
+	} else if (isToken && token.view.front() == ',') {
+		throw std::runtime_error(m_afterComma ? "Unexpected , after a comma" : "Unexpected , before a value");
+	}
+
+	if (isToken) {
+		switch (token.view.front()) {
+		case '{':
+			BeginValue(Type::Object);
+			break;
+		case '[':
+			BeginValue(Type::Array);
+			break;
+		case '}':
+			EndValue(Type::Object);
+			break;
+		case ']':
+			EndValue(Type::Array);
+			break;
+		case ',':
+			m_expectingComma = false;
+			m_afterComma = true;
+			break;
+		default:
+			throw std::runtime_error("Unexpected " + std::string(token.view));
+		}
+
+		return;
+	}
+
+	// Inside a object every other token is a property name.
+	if (openType == Type::Object && !m_hasKey) {
+		if (token.type != Type::String)
+			throw std::runtime_error("Object key " + DescribeToken(token) + " is not a string");
+		m_afterComma = false;
+		m_key = token.view;
+		m_hasKey = true;
+		m_expectingColon = true;
+		return;
+	}
+
+	AddValue(token);
+}
+
+void Json::Parser::BeginValue(Type type) {
+	if (m_document) {
+		if (m_document->GetOpenCount() != 0 && m_document->GetOpenType() == Type::Object && !m_hasKey)
+			throw std::runtime_error("Missing object key");
+		m_document->BeginElement(m_hasKey ? m_key : std::string_view(), type);
+	} else if (m_nodes.empty()) {
+		m_root->SetType(type);
+		m_nodes.emplace_back(m_root);
+	} else {
+		if (m_nodes.back()->GetType() == Type::Object && !m_hasKey)
+			throw std::runtime_error("Missing object key");
+		auto &node = m_hasKey ? m_nodes.back()->AddProperty(m_key) : m_nodes.back()->AddProperty();
+		node.SetType(type);
+		m_nodes.emplace_back(&node);
+	}
+
+	m_hasKey = false;
+	m_afterComma = false;
+}
+
+void Json::Parser::AddValue(const Token &token) {
+	auto escaped = token.type == Type::String && token.view.find('\\') != std::string_view::npos;
+
+	if (m_document) {
+		m_document->AddElement(m_hasKey ? m_key : std::string_view(), token.view, token.type, escaped);
+
+		if (m_document->GetOpenCount() == 0)
+			m_finished = true;
+	} else {
+		auto &node = m_nodes.empty() ? *m_root : m_hasKey ? m_nodes.back()->AddProperty(m_key) : m_nodes.back()->AddProperty();
+		node.SetValue(escaped ? String::UnfixEscapedChars(std::string(token.view)) : std::string(token.view));
+		node.SetType(token.type);
+
+		if (m_nodes.empty())
+			m_finished = true;
+	}
+
+	m_hasKey = false;
+	m_afterComma = false;
+	m_expectingComma = !m_finished;
+}
+
+void Json::Parser::EndValue(Type type) {
+	auto openType = m_document ? (m_document->GetOpenCount() != 0 ? m_document->GetOpenType() : Type::Unknown) :
+		(!m_nodes.empty() ? m_nodes.back()->GetType() : Type::Unknown);
+
+	if (openType != type || m_hasKey)
+		throw std::runtime_error(type == Type::Object ? "Unexpected }" : "Unexpected ]");
+	if (m_afterComma)
+		throw std::runtime_error(type == Type::Object ? "Trailing comma before }" : "Trailing comma before ]");
+
+	if (m_document) {
+		m_document->EndElement();
+		m_finished = m_document->GetOpenCount() == 0;
+	} else {
+		m_nodes.pop_back();
+		m_finished = m_nodes.empty();
+	}
+
+	m_expectingComma = !m_finished;
+}
+
+std::string Json::Parser::DescribeToken(const Token &token) {
+	switch (token.type) {
+	case Type::String:
+		return '"' + std::string(token.view) + '"';
+	case Type::Null:
+		return "null";
+	default:
+		return std::string(token.view);
+	}
+}
+
 Json::Json(const Node &node) :
 	Node(node) {
 	SetType(Type::Object);
@@ -14,45 +507,51 @@ Json::Json(Node &&node) :
 }
 
 void Json::ParseString(std::string_view string) {
-	// Tokenizes the string view into small views that are used to build a Node tree.
-	Tokens tokens;
-
-	std::size_t tokenStart = 0;
-	enum class QuoteState : char {
-		None = '\0', Single = '\'', Double = '"'
-	} quoteState = QuoteState::None;
-
-	// Iterates over all the characters in the string view.
-	for (std::size_t index = 0; index < string.length(); ++index) {
-		auto c = string[index];
-		// If the previous character was a backslash the quote will not break the string.
-		if (c == '\'' && quoteState != QuoteState::Double && string[index - 1] != '\\')
-			quoteState = quoteState == QuoteState::None ? QuoteState::Single : QuoteState::None;
-		else if (c == '"' && quoteState != QuoteState::Single && string[index - 1] != '\\')
-			quoteState = quoteState == QuoteState::None ? QuoteState::Double : QuoteState::None;
-
-		// When not reading a string tokens can be found.
-		// While in a string whitespace and tokens are added to the strings view.
-		if (quoteState == QuoteState::None) {
-			if (String::IsWhitespace(c)) {
-				// On whitespace start save current token.
-				AddToken(std::string_view(string.data() + tokenStart, index - tokenStart), tokens);
-				tokenStart = index + 1;
-			} else if (c == ':' || c == '{' || c == '}' || c == ',' || c == '[' || c == ']') {
-				// Tokens used to read json nodes.
-				AddToken(std::string_view(string.data() + tokenStart, index - tokenStart), tokens);
-				tokens.emplace_back(Type::Token, std::string_view(string.data() + index, 1));
-				tokenStart = index + 1;
-			}
+	if (string.substr(0, ByteOrderMark.size()) == ByteOrderMark)
+		string.remove_prefix(ByteOrderMark.size());
+
+	Parser parser(*this);
+	parser.Parse(string, true);
+}
+
+void Json::ParseStream(std::istream &stream) {
+	Parser parser(*this);
+	std::string buffer(ChunkSize + BlockSize, '\0');
+	stream.read(buffer.data(), ByteOrderMark.size());
+	auto carried = static_cast<std::size_t>(stream.gcount());
+
+	if (std::string_view(buffer.data(), carried) == ByteOrderMark)
+		carried = 0;
+
+	while (true) {
+		stream.read(buffer.data() + carried, ChunkSize);
+		auto size = carried + static_cast<std::size_t>(stream.gcount());
+
+		if (!stream) {
+			parser.Parse({buffer.data(), size}, true);
+			return;
 		}
+
+		// Only whole blocks are parsed until the end of the stream, the rest is moved to the front of the buffer.
+		auto whole = size - size % BlockSize;
+		parser.Parse({buffer.data(), whole}, false);
+		carried = size - whole;
+		std::memmove(buffer.data(), buffer.data() + whole, carried);
 	}
+}
 
-	if (tokens.empty())
-		throw std::runtime_error("No tokens found in document");
+NodeDocument Json::ParseDocument(std::string string) {
+	NodeDocument document;
+	if (std::string_view(string).substr(0, ByteOrderMark.size()) == ByteOrderMark)
+		string.erase(0, ByteOrderMark.size());
 
-	// Converts the tokens into nodes.
-	int32_t k = 0;
-	Convert(*this, tokens, 0, k);
+	// Padded to whole blocks, so every token is a view into the document.
+	string.append(BlockSize - string.size() % BlockSize, ' ');
+	document.Begin(std::move(string));
+
+	Parser parser(document);
+	parser.Parse(document.m_source, true);
+	return document;
 }
 
 void Json::WriteStream(std::ostream &stream, const Format &format) const {
@@ -61,69 +560,25 @@ void Json::WriteStream(std::ostream &stream, const Format &format) const {
 	stream << (GetType() == Type::Array ? ']' : '}');
 }
 
-void Json::AddToken(std::string_view view, Tokens &tokens) {
-	if (view.length() != 0) {
-		// Finds the node value type of the string and adds it to the tokens vector.
-		if (view == "null") {
-			tokens.emplace_back(Type::Null, std::string_view());
-		} else if (view == "true" || view == "false") {
-			tokens.emplace_back(Type::Boolean, view);
-		} else if (String::IsNumber(view)) {
-			// This is a quick hack to get if the number is a decimal.
-			if (view.find('.') != std::string::npos) {
-				if (view.size() >= std::numeric_limits<long double>::digits)
-					throw std::runtime_error("Decimal number is too long");
-				tokens.emplace_back(Type::Decimal, view);
-			} else {
-				if (view.size() >= std::numeric_limits<uint64_t>::digits)
-					throw std::runtime_error("Integer number is too long");
-				tokens.emplace_back(Type::Integer, view);
-			}
-		} else { // if (view.front() == view.back() == '\"')
-			tokens.emplace_back(Type::String, view.substr(1, view.length() - 2));
-		}
-	}
-}
-
-void Json::Convert(Node &current, const Tokens &tokens, int32_t i, int32_t &r) {
-	if (tokens[i] == Token(Type::Token, "{")) {
-		auto k = i + 1;
-
-		while (tokens[k] != Token(Type::Token, "}")) {
-			auto key = tokens[k].view;
-			if (k + 2 >= tokens.size())
-				throw std::runtime_error("Missing end of {} array");
-			if (tokens[k + 1].view != ":")
-				throw std::runtime_error("Missing object colon");
-			k += 2;
-			Convert(current.AddProperty(key), tokens, k, k);
-			if (tokens[k].view == ",")
-				k++;
-		}
+Node::Type Json::GetTokenType(std::string_view view) {
+	if (view == "null")
+		return Type::Null;
+	if (view == "true" || view == "false")
+		return Type::Boolean;
+	// Strings are always quoted, so anything else is a misspelt literal or a broken number.
+	if (!String::IsNumber(view))
+		throw std::runtime_error("Unexpected " + std::string(view) + ", expected a number, true, false or null");
 
-		current.SetType(Type::Object);
-		r = k + 1;
-	} else if (tokens[i] == Token(Type::Token, "[")) {
-		auto k = i + 1;
-
-		while (tokens[k] != Token(Type::Token, "]")) {
-			if (k >= tokens.size())
-				throw std::runtime_error("Missing end of [] object");
-			Convert(current.AddProperty(), tokens, k, k);
-			if (tokens[k].view == ",")
-				k++;
-		}
-
-		current.SetType(Type::Array);
-		r = k + 1;
-	} else {
-		std::string str(tokens[i].view);
-		if (tokens[i].type == Type::String)
-			str = String::UnfixEscapedChars(str);
-		current.SetValue(str);
-		current.SetType(tokens[i].type);
-		r = i + 1;
+	// This is a quick hack to get if the number is a decimal.
+	if (view.find('.') != std::string::npos) {
+		if (view.size() >= std::numeric_limits<long double>::digits)
+			throw std::runtime_error("Decimal number is too long");
+		return Type::Decimal;
 	}
+
+	if (view.size() >= std::numeric_limits<uint64_t>::digits)
+		throw std::runtime_error("Integer number is too long");
+	return Type::Integer;
 }
 
 void Json::AppendData(const Node &source, std::ostream &stream, const Format &format, int32_t indent) {
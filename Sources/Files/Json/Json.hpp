@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Files/Node.hpp"
+#include "Files/NodeDocument.hpp"
 
 namespace acid {
 class Json : public Node {
@@ -9,9 +10,19 @@ public:
 	explicit Json(const Node &node);
 	explicit Json(Node &&node);
 
+	using Node::ParseStream;
+
 	void ParseString(std::string_view string) override;
+	void ParseStream(std::istream &stream) override;
 	void WriteStream(std::ostream &stream, const Format &format = Format::Minified) const override;
 
+	/**
+	 * Parses a string into a read-only document without creating a node per value.
+	 * @param string The string to parse, the document keeps it and its views point into it.
+	 * @return The parsed document.
+	 */
+	static NodeDocument ParseDocument(std::string string);
+
 	Json& operator=(const Json& node) = default;
 	Json& operator=(Json && node) = default;
 	template<typename T>
@@ -21,8 +32,10 @@ public:
 	}
 
 private:
-	static void AddToken(std::string_view view, Tokens &tokens);
-	static void Convert(Node &current, const Tokens &tokens, int32_t i, int32_t &r);
+	class Tokenizer;
+	class Parser;
+
+	static Type GetTokenType(std::string_view view);
 
 	static void AppendData(const Node &source, std::ostream &stream, const Format &format, int32_t indent);
 };
@@ -2,6 +2,8 @@
 
 #include <algorithm>
 
+#include "Helpers/Hash.hpp"
+
 namespace acid {
 const Node::Format Node::Format::Beautified = Format(2, '\n', ' ', true);
 const Node::Format Node::Format::Minified = Format(0, '\0', '\0', false);
@@ -21,6 +23,12 @@ Node::Node(std::string value, std::vector<Node> &&properties) :
 void Node::ParseString(std::string_view string) {
 }
 
+void Node::ParseStream(std::istream &stream) {
+	// Reading into a string before iterating is much faster.
+	std::string s(std::istreambuf_iterator<char>(stream), {});
+	ParseString(s);
+}
+
 void Node::WriteStream(std::ostream &stream, const Format &format) const {
 }
 
@@ -225,6 +233,17 @@ bool Node::operator!=(const Node &other) const {
 	return !operator==(other);
 }
 
+uint64_t Node::GetHash() const {
+	auto hash = HashString(m_value);
+	hash = HashValue(static_cast<uint64_t>(m_properties.size()), hash);
+
+	for (const auto &property : m_properties) {
+		hash = HashValue(property.GetHash(), hash);
+	}
+
+	return hash;
+}
+
 bool Node::operator<(const Node &other) const {
 	if (m_name < other.m_name) return true;
 	if (other.m_name < m_name) return false;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <istream>
 #include <ostream>
 
 #include "NodeView.hpp"
@@ -69,6 +70,11 @@ public:
 	virtual ~Node() = default;
 
 	virtual void ParseString(std::string_view string);
+	/**
+	 * Parses a char stream, by default the stream is read into a string and parsed with {@link Node#ParseString}.
+	 * @param stream The stream to read from.
+	 */
+	virtual void ParseStream(std::istream &stream);
 	virtual void WriteStream(std::ostream &stream, const Format &format = Format::Minified) const;
 
 	template<typename _Elem = char>
@@ -142,6 +148,13 @@ public:
 	bool operator!=(const Node &other) const;
 	bool operator<(const Node &other) const;
 
+	/**
+	 * Computes a stable 64-bit structural hash of this node, nodes that compare equal always have the same hash.
+	 * Like {@link Node#operator==} this covers values and properties, but not names.
+	 * @return The structural hash.
+	 */
+	uint64_t GetHash() const;
+
 	const std::vector<Node> &GetProperties() const { return m_properties; }
 	std::vector<Node> &GetProperties() { return m_properties; }
 
@@ -188,6 +201,15 @@ protected:
 };
 }
 
+namespace std {
+template<>
+struct hash<acid::Node> {
+	size_t operator()(const acid::Node &node) const noexcept {
+		return static_cast<size_t>(node.GetHash());
+	}
+};
+}
+
 #include "Node.inl"
 #include "NodeConstView.inl"
 #include "NodeView.inl"
@@ -0,0 +1,226 @@
+#include "NodeDocument.hpp"
+
+#include <cstdlib>
+
+namespace acid {
+NodeDocumentView::NodeDocumentView(const NodeDocument *document, uint32_t index) :
+	m_document(document),
+	m_index(index) {
+}
+
+bool NodeDocumentView::IsValid() const {
+	if (!has_value())
+		return false;
+
+	const auto &element = m_document->m_elements[m_index];
+
+	switch (element.m_type) {
+	case Type::Token:
+	case Type::Unknown:
+		return false;
+	case Type::Object:
+	case Type::Array:
+		return element.m_propertyCount != 0;
+	case Type::Null:
+		return true;
+	default:
+		return !element.m_value.empty();
+	}
+}
+
+bool NodeDocumentView::HasProperty(std::string_view name) const {
+	return static_cast<bool>(operator[](name));
+}
+
+std::vector<NodeDocumentView> NodeDocumentView::GetProperties(std::string_view name) const {
+	std::vector<NodeDocumentView> properties;
+
+	for (const auto &property : GetProperties()) {
+		if (property.GetNameView() == name)
+			properties.emplace_back(property);
+	}
+
+	return properties;
+}
+
+NodeDocumentView NodeDocumentView::GetPropertyWithBackup(std::string_view name, std::string_view backupName) const {
+	if (auto p1 = operator[](name))
+		return p1;
+	return operator[](backupName);
+}
+
+NodeDocumentView NodeDocumentView::GetPropertyWithValue(std::string_view propertyName, std::string_view propertyValue) const {
+	for (const auto &property : GetProperties()) {
+		auto properties1 = property.GetProperties(propertyName);
+		if (properties1.empty())
+			return {};
+
+		for (const auto &property1 : properties1) {
+			if (property1.GetValue() == propertyValue)
+				return property;
+		}
+	}
+
+	return {};
+}
+
+NodeDocumentView NodeDocumentView::operator[](std::string_view key) const {
+	if (!has_value())
+		return {};
+
+	const auto &element = m_document->m_elements[m_index];
+
+	for (auto i = element.m_firstProperty; i < element.m_firstProperty + element.m_propertyCount; i++) {
+		if (m_document->m_elements[i].m_name == key)
+			return {m_document, i};
+	}
+
+	return {};
+}
+
+NodeDocumentView NodeDocumentView::operator[](uint32_t index) const {
+	if (!has_value())
+		return {};
+
+	const auto &element = m_document->m_elements[m_index];
+
+	if (index < element.m_propertyCount)
+		return {m_document, element.m_firstProperty + index};
+
+	return {};
+}
+
+std::vector<NodeDocumentView> NodeDocumentView::GetProperties() const {
+	if (!has_value())
+		return {};
+
+	const auto &element = m_document->m_elements[m_index];
+	std::vector<NodeDocumentView> properties;
+	properties.reserve(element.m_propertyCount);
+
+	for (auto i = element.m_firstProperty; i < element.m_firstProperty + element.m_propertyCount; i++)
+		properties.emplace_back(NodeDocumentView(m_document, i));
+
+	return properties;
+}
+
+uint32_t NodeDocumentView::GetPropertyCount() const {
+	if (!has_value())
+		return 0;
+	return m_document->m_elements[m_index].m_propertyCount;
+}
+
+std::string NodeDocumentView::GetName() const {
+	return std::string(GetNameView());
+}
+
+std::string_view NodeDocumentView::GetNameView() const {
+	if (!has_value())
+		return {};
+	return m_document->m_elements[m_index].m_name;
+}
+
+std::string NodeDocumentView::GetValue() const {
+	if (!has_value())
+		return {};
+
+	const auto &element = m_document->m_elements[m_index];
+
+	if (element.m_escaped)
+		return String::UnfixEscapedChars(std::string(element.m_value));
+	return std::string(element.m_value);
+}
+
+std::string_view NodeDocumentView::GetValueView() const {
+	if (!has_value())
+		return {};
+	return m_document->m_elements[m_index].m_value;
+}
+
+NodeDocumentView::Type NodeDocumentView::GetType() const {
+	if (!has_value())
+		return Type::Unknown;
+	return m_document->m_elements[m_index].m_type;
+}
+
+Node NodeDocumentView::ToNode() const {
+	if (!has_value())
+		return {};
+
+	Node node(GetValue(), GetType());
+	node.SetName(GetName());
+	node.GetProperties().reserve(GetPropertyCount());
+
+	for (const auto &property : GetProperties())
+		node.GetProperties().emplace_back(property.ToNode());
+
+	return node;
+}
+
+long double NodeDocumentView::ReadNumber(std::string_view value) {
+	// Values are not null terminated inside the source, short numbers are copied to the stack.
+	char buffer[64];
+
+	if (value.size() < sizeof(buffer)) {
+		std::memcpy(buffer, value.data(), value.size());
+		buffer[value.size()] = '\0';
+		return std::strtold(buffer, nullptr);
+	}
+
+	return std::strtold(std::string(value).c_str(), nullptr);
+}
+
+NodeDocumentView NodeDocument::GetRoot() const {
+	if (m_elements.empty())
+		return {};
+	return {this, static_cast<uint32_t>(m_elements.size() - 1)};
+}
+
+void NodeDocument::Begin(std::string source) {
+	m_source = std::move(source);
+	m_elements.clear();
+	m_pending.clear();
+	m_openElements.clear();
+}
+
+void NodeDocument::BeginElement(std::string_view name, Type type) {
+	auto &element = m_pending.emplace_back();
+	element.m_name = name;
+	element.m_type = type;
+	m_openElements.emplace_back(m_pending.size() - 1);
+}
+
+void NodeDocument::EndElement() {
+	if (m_openElements.empty())
+		throw std::runtime_error("Element ended that was never started");
+
+	auto open = m_openElements.back();
+	m_openElements.pop_back();
+
+	auto &element = m_pending[open];
+	element.m_firstProperty = static_cast<uint32_t>(m_elements.size());
+	element.m_propertyCount = static_cast<uint32_t>(m_pending.size() - open - 1);
+	m_elements.insert(m_elements.end(), m_pending.begin() + open + 1, m_pending.end());
+	m_pending.resize(open + 1);
+}
+
+void NodeDocument::AddElement(std::string_view name, std::string_view value, Type type, bool escaped) {
+	auto &element = m_pending.emplace_back();
+	element.m_name = name;
+	element.m_value = value;
+	element.m_type = type;
+	element.m_escaped = escaped;
+}
+
+void NodeDocument::End() {
+	if (!m_openElements.empty())
+		throw std::runtime_error("Document ended before all elements ended");
+	if (m_pending.size() != 1)
+		throw std::runtime_error("Document must have a single root");
+
+	// The root is always the last element.
+	m_elements.emplace_back(m_pending.front());
+	m_pending = {};
+	m_openElements = {};
+}
+}
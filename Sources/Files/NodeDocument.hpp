@@ -0,0 +1,152 @@
+#pragma once
+
+#include "Node.hpp"
+
+namespace acid {
+class NodeDocument;
+
+/**
+ * @brief Class that is returned from a {@link NodeDocument} when reading properties, with the same reading interface as {@link NodeConstView}.
+ * A view is a document and a element index, a missing property gives a view with no value so lookups can be chained.
+ */
+class ACID_EXPORT NodeDocumentView {
+	friend class NodeDocument;
+public:
+	using Type = NodeConstView::Type;
+
+	NodeDocumentView() = default;
+
+	bool has_value() const noexcept { return m_document != nullptr; }
+	explicit operator bool() const noexcept { return has_value(); }
+
+	template<typename T>
+	T GetName() const;
+
+	template<typename T>
+	T Get() const;
+	template<typename T>
+	T Get(const T &fallback) const;
+	template<typename T>
+	bool Get(T &dest) const;
+	template<typename T, typename K>
+	bool Get(T &dest, const K &fallback) const;
+
+	/**
+	 * Gets if the view has a value, or has properties, following the rules of {@link Node#IsValid}.
+	 * @return If the view is valid.
+	 */
+	bool IsValid() const;
+
+	bool HasProperty(std::string_view name) const;
+
+	std::vector<NodeDocumentView> GetProperties(std::string_view name) const;
+	NodeDocumentView GetPropertyWithBackup(std::string_view name, std::string_view backupName) const;
+	NodeDocumentView GetPropertyWithValue(std::string_view propertyName, std::string_view propertyValue) const;
+
+	NodeDocumentView operator[](std::string_view key) const;
+	NodeDocumentView operator[](uint32_t index) const;
+
+	std::vector<NodeDocumentView> GetProperties() const;
+	uint32_t GetPropertyCount() const;
+
+	std::string GetName() const;
+	std::string_view GetNameView() const;
+
+	/**
+	 * Gets the value with escaped characters decoded, only values that contain a escape are copied and decoded.
+	 * @return The value.
+	 */
+	std::string GetValue() const;
+
+	/**
+	 * Gets the value as it is written in the source, without decoding escaped characters.
+	 * @return The view into the documents source.
+	 */
+	std::string_view GetValueView() const;
+
+	Type GetType() const;
+
+	/**
+	 * Copies this view and all its properties into a new node, for types that can only be read from a {@link Node}.
+	 * @return The copied node.
+	 */
+	Node ToNode() const;
+
+private:
+	NodeDocumentView(const NodeDocument *document, uint32_t index);
+
+	template<typename T>
+	void Read(T &dest) const;
+	static long double ReadNumber(std::string_view value);
+
+	const NodeDocument *m_document = nullptr;
+	uint32_t m_index = 0;
+};
+
+/**
+ * @brief Class that holds a read-only tree parsed from a source string in a single arena.
+ * Names and values are views into the documents own copy of the source, and the properties of a element are stored contiguously.
+ * This avoids allocating a {@link Node} and its strings for every value when a file is only read.
+ */
+class ACID_EXPORT NodeDocument {
+	friend class NodeDocumentView;
+	friend class Json;
+	friend class Xml;
+public:
+	using Type = NodeConstView::Type;
+
+	NodeDocument() = default;
+	NodeDocument(const NodeDocument &) = delete;
+	NodeDocument(NodeDocument &&) noexcept = default;
+
+	NodeDocument &operator=(const NodeDocument &) = delete;
+	NodeDocument &operator=(NodeDocument &&) noexcept = default;
+
+	/**
+	 * Gets the root element, if the document has not been parsed the view has no value.
+	 * @return The root view.
+	 */
+	NodeDocumentView GetRoot() const;
+
+	NodeDocumentView operator[](std::string_view key) const { return GetRoot()[key]; }
+	NodeDocumentView operator[](uint32_t index) const { return GetRoot()[index]; }
+
+	/**
+	 * Gets the number of elements in the document, including the root.
+	 * @return The element count.
+	 */
+	std::size_t GetSize() const { return m_elements.size(); }
+
+	const std::string &GetSource() const { return m_source; }
+
+private:
+	class Element {
+	public:
+		std::string_view m_name;
+		std::string_view m_value;
+		uint32_t m_firstProperty = 0;
+		uint32_t m_propertyCount = 0;
+		Type m_type = Type::Object;
+		// If the value contains escaped characters that must be decoded when read.
+		bool m_escaped = false;
+	};
+
+	// Used by parsers to build the document in one pass. Properties of a open element are kept on a stack
+	// and moved into the arena together when the element ends, so they end up contiguous.
+	void Begin(std::string source);
+	void BeginElement(std::string_view name, Type type);
+	void EndElement();
+	void AddElement(std::string_view name, std::string_view value, Type type, bool escaped);
+	void End();
+
+	std::size_t GetOpenCount() const { return m_openElements.size(); }
+	Type GetOpenType() const { return m_pending[m_openElements.back()].m_type; }
+
+	std::string m_source;
+	std::vector<Element> m_elements;
+	std::vector<Element> m_pending;
+	std::vector<std::size_t> m_openElements;
+};
+}
+
+#include "NodeDocument.inl"
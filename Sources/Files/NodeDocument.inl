@@ -0,0 +1,73 @@
+#pragma once
+
+#include "NodeDocument.hpp"
+
+namespace acid {
+template<typename T>
+T NodeDocumentView::GetName() const {
+	if (!has_value())
+		return {};
+	return String::From<T>(GetName());
+}
+
+template<typename T>
+T NodeDocumentView::Get() const {
+	T value = {};
+	if (has_value())
+		Read(value);
+	return value;
+}
+
+template<typename T>
+T NodeDocumentView::Get(const T &fallback) const {
+	if (!IsValid())
+		return fallback;
+
+	return Get<T>();
+}
+
+template<typename T>
+bool NodeDocumentView::Get(T &dest) const {
+	if (!IsValid())
+		return false;
+
+	Read(dest);
+	return true;
+}
+
+template<typename T, typename K>
+bool NodeDocumentView::Get(T &dest, const K &fallback) const {
+	if (!IsValid()) {
+		dest = fallback;
+		return false;
+	}
+
+	Read(dest);
+	return true;
+}
+
+template<typename T>
+void NodeDocumentView::Read(T &dest) const {
+	// Common value types are read straight from the source, anything else is read through a node copy of this view.
+	if constexpr (std::is_same_v<T, std::string>) {
+		dest = GetValue();
+	} else if constexpr (std::is_same_v<T, bool>) {
+		dest = String::From<bool>(GetValue());
+	} else if constexpr (std::is_enum_v<T>) {
+		dest = static_cast<T>(static_cast<std::underlying_type_t<T>>(ReadNumber(GetValueView())));
+	} else if constexpr (std::is_arithmetic_v<T>) {
+		dest = static_cast<T>(ReadNumber(GetValueView()));
+	} else if constexpr (is_vector_v<T>) {
+		dest.clear();
+		dest.reserve(GetPropertyCount());
+
+		for (const auto &property : GetProperties()) {
+			typename T::value_type x;
+			property.Read(x);
+			dest.emplace_back(std::move(x));
+		}
+	} else {
+		ToNode() >> dest;
+	}
+}
+}
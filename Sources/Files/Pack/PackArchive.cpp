@@ -0,0 +1,340 @@
+#include "PackArchive.hpp"
+
+#include <algorithm>
+#include <cstring>
+#if defined(ACID_BUILD_WINDOWS)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Engine/Log.hpp"
+#include "Files/Zip/miniz.h"
+#include "Helpers/Hash.hpp"
+
+namespace acid {
+static char NormalizeSeparator(char c) {
+	return c == '\\' ? '/' : c;
+}
+
+PackArchive::PackArchive(std::filesystem::path filename) :
+	m_filename(std::move(filename)) {
+	if (!Map()) {
+		Log::Error("Pack archive could not be mapped: ", m_filename, '\n');
+		return;
+	}
+
+	if (!Validate()) {
+		Log::Error("Pack archive is not valid: ", m_filename, '\n');
+		Unmap();
+	}
+}
+
+PackArchive::~PackArchive() {
+	Unmap();
+}
+
+uint64_t PackArchive::Hash(std::string_view name) {
+	auto hash = HashOffset;
+	for (auto c : name) {
+		hash = HashByte(static_cast<uint8_t>(NormalizeSeparator(c)), hash);
+	}
+	return hash;
+}
+
+const PackArchive::Entry *PackArchive::Find(std::string_view name) const {
+	if (!m_data)
+		return nullptr;
+
+	auto hash = Hash(name);
+
+	for (auto slot = static_cast<uint32_t>(hash) & m_slotMask;; slot = (slot + 1) & m_slotMask) {
+		if (m_slots[slot] == 0)
+			return nullptr;
+
+		const auto &entry = m_entries[m_slots[slot] - 1];
+		if (entry.m_hash == hash && entry.m_nameLength == name.size() &&
+			std::equal(name.begin(), name.end(), m_names + entry.m_nameOffset, [](char a, char b) { return NormalizeSeparator(a) == b; })) {
+			return &entry;
+		}
+	}
+}
+
+std::optional<std::string_view> PackArchive::ReadView(std::string_view name) {
+	auto entry = Find(name);
+	if (!entry)
+		return std::nullopt;
+
+	if (entry->m_compression == Compression::None)
+		return std::string_view(m_data + entry->m_offset, entry->m_length);
+
+	std::lock_guard<std::mutex> lock(m_inflatedMutex);
+	auto index = static_cast<std::size_t>(entry - m_entries);
+
+	if (auto it = m_inflated.find(index); it != m_inflated.end())
+		return std::string_view(it->second.get(), entry->m_length);
+
+	auto data = std::make_unique<char[]>(entry->m_length);
+	if (!Inflate({m_data + entry->m_offset, entry->m_storedLength}, data.get(), entry->m_length)) {
+		Log::Error("Pack archive entry could not be inflated: ", name, '\n');
+		return std::nullopt;
+	}
+
+	return std::string_view(m_inflated.emplace(index, std::move(data)).first->second.get(), entry->m_length);
+}
+
+std::optional<std::string> PackArchive::Read(std::string_view name) const {
+	auto entry = Find(name);
+	if (!entry)
+		return std::nullopt;
+
+	if (entry->m_compression == Compression::None)
+		return std::string(m_data + entry->m_offset, entry->m_length);
+
+	std::string data(entry->m_length, '\0');
+	if (!Inflate({m_data + entry->m_offset, entry->m_storedLength}, data.data(), entry->m_length)) {
+		Log::Error("Pack archive entry could not be inflated: ", name, '\n');
+		return std::nullopt;
+	}
+
+	return data;
+}
+
+std::vector<std::string_view> PackArchive::GetEntryNames() const {
+	std::vector<std::string_view> names;
+	names.reserve(m_entryCount);
+	for (std::size_t i = 0; i < m_entryCount; i++)
+		names.emplace_back(GetName(m_entries[i]));
+	return names;
+}
+
+bool PackArchive::Map() {
+#if defined(ACID_BUILD_WINDOWS)
+	m_file = CreateFileW(m_filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (m_file == INVALID_HANDLE_VALUE) {
+		m_file = nullptr;
+		return false;
+	}
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0)
+		return false;
+	m_size = static_cast<std::size_t>(size.QuadPart);
+
+	m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!m_mapping)
+		return false;
+
+	m_data = static_cast<const char *>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+	return m_data != nullptr;
+#else
+	auto file = open(m_filename.c_str(), O_RDONLY);
+	if (file == -1)
+		return false;
+
+	struct stat status = {};
+	if (fstat(file, &status) != 0 || status.st_size == 0) {
+		close(file);
+		return false;
+	}
+	m_size = static_cast<std::size_t>(status.st_size);
+
+	// The mapping keeps its own reference to the file.
+	auto data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+
+	if (data == MAP_FAILED)
+		return false;
+
+	m_data = static_cast<const char *>(data);
+	return true;
+#endif
+}
+
+bool PackArchive::Validate() {
+	if (m_size < sizeof(Header))
+		return false;
+
+	Header header;
+	std::memcpy(&header, m_data, sizeof(Header));
+
+	if (std::string_view(header.m_magic, Magic.size()) != Magic || header.m_version != Version)
+		return false;
+
+	// Every table has to fit in the file, offsets are checked against the size so they cannot overflow.
+	auto fits = [this](uint64_t offset, uint64_t length) {
+		return offset <= m_size && length <= m_size - offset;
+	};
+
+	if (header.m_slotCount == 0 || (header.m_slotCount & (header.m_slotCount - 1)) != 0 || header.m_entryCount >= header.m_slotCount ||
+		header.m_entriesOffset % alignof(Entry) != 0 || header.m_slotsOffset % alignof(uint32_t) != 0 ||
+		!fits(header.m_entriesOffset, uint64_t(header.m_entryCount) * sizeof(Entry)) || !fits(header.m_slotsOffset, uint64_t(header.m_slotCount) * sizeof(uint32_t)) ||
+		!fits(header.m_namesOffset, header.m_namesLength)) {
+		return false;
+	}
+
+	m_entries = reinterpret_cast<const Entry *>(m_data + header.m_entriesOffset);
+	m_entryCount = header.m_entryCount;
+	m_slots = reinterpret_cast<const uint32_t *>(m_data + header.m_slotsOffset);
+	m_slotMask = header.m_slotCount - 1;
+	m_names = m_data + header.m_namesOffset;
+
+	for (std::size_t i = 0; i < m_entryCount; i++) {
+		const auto &entry = m_entries[i];
+		if (!fits(entry.m_offset, entry.m_storedLength) || uint64_t(entry.m_nameOffset) + entry.m_nameLength > header.m_namesLength)
+			return false;
+		if (entry.m_compression == Compression::None ? entry.m_storedLength != entry.m_length : entry.m_compression != Compression::Deflate)
+			return false;
+	}
+
+	// There are more slots than entries and only as many slots are used as there are entries, so probing always ends at an empty slot.
+	std::size_t usedSlots = 0;
+	for (uint32_t i = 0; i < header.m_slotCount; i++) {
+		if (m_slots[i] > m_entryCount)
+			return false;
+		if (m_slots[i] != 0)
+			usedSlots++;
+	}
+
+	if (usedSlots != m_entryCount)
+		return false;
+
+	return true;
+}
+
+void PackArchive::Unmap() {
+#if defined(ACID_BUILD_WINDOWS)
+	if (m_data)
+		UnmapViewOfFile(m_data);
+	if (m_mapping)
+		CloseHandle(m_mapping);
+	if (m_file)
+		CloseHandle(m_file);
+	m_file = nullptr;
+	m_mapping = nullptr;
+#else
+	if (m_data)
+		munmap(const_cast<char *>(m_data), m_size);
+#endif
+
+	m_data = nullptr;
+	m_size = 0;
+	m_entries = nullptr;
+	m_entryCount = 0;
+	m_slots = nullptr;
+	m_names = nullptr;
+}
+
+bool PackArchive::Inflate(std::string_view stored, char *data, uint64_t length) {
+	auto inflatedLength = static_cast<mz_ulong>(length);
+	return mz_uncompress(reinterpret_cast<unsigned char *>(data), &inflatedLength, reinterpret_cast<const unsigned char *>(stored.data()),
+		static_cast<mz_ulong>(stored.size())) == MZ_OK && inflatedLength == length;
+}
+
+PackWriter::PackWriter(const std::filesystem::path &filename) {
+	if (auto parentPath = filename.parent_path(); !parentPath.empty())
+		std::filesystem::create_directories(parentPath);
+
+	m_stream.open(filename, std::ios::binary | std::ios::out | std::ios::trunc);
+
+	// The header is written over this space when the archive is finished.
+	m_stream.write(std::string(PackArchive::Alignment, '\0').data(), PackArchive::Alignment);
+	m_offset = PackArchive::Alignment;
+}
+
+PackWriter::~PackWriter() {
+	if (!m_finished)
+		Finish();
+}
+
+bool PackWriter::AddEntry(std::string_view name, std::string_view data, PackArchive::Compression compression) {
+	std::string normalized(name);
+	std::transform(normalized.begin(), normalized.end(), normalized.begin(), NormalizeSeparator);
+
+	if (m_finished || m_entryIndices.find(normalized) != m_entryIndices.end())
+		return false;
+
+	PackArchive::Entry entry = {};
+	entry.m_hash = PackArchive::Hash(normalized);
+	entry.m_length = data.size();
+	entry.m_nameOffset = static_cast<uint32_t>(m_names.size());
+	entry.m_nameLength = static_cast<uint32_t>(normalized.size());
+
+	std::vector<unsigned char> compressed;
+	if (compression == PackArchive::Compression::Deflate) {
+		auto compressedLength = mz_compressBound(static_cast<mz_ulong>(data.size()));
+		compressed.resize(compressedLength);
+
+		if (mz_compress2(compressed.data(), &compressedLength, reinterpret_cast<const unsigned char *>(data.data()), static_cast<mz_ulong>(data.size()),
+			MZ_DEFAULT_COMPRESSION) == MZ_OK && compressedLength < data.size()) {
+			compressed.resize(compressedLength);
+			data = {reinterpret_cast<const char *>(compressed.data()), compressed.size()};
+			entry.m_compression = compression;
+		}
+	}
+
+	Align(PackArchive::Alignment);
+	entry.m_offset = m_offset;
+	entry.m_storedLength = data.size();
+	m_stream.write(data.data(), data.size());
+	m_offset += data.size();
+
+	m_entryIndices.emplace(normalized, m_entries.size());
+	m_entries.emplace_back(entry);
+	m_names += normalized;
+	return m_stream.good();
+}
+
+bool PackWriter::Finish() {
+	if (m_finished)
+		return false;
+	m_finished = true;
+
+	// The table has at least twice as many slots as entries, so probes stay short.
+	uint32_t slotCount = 1;
+	while (slotCount <= 2 * m_entries.size())
+		slotCount <<= 1;
+
+	std::vector<uint32_t> slots(slotCount);
+	for (std::size_t i = 0; i < m_entries.size(); i++) {
+		auto slot = static_cast<uint32_t>(m_entries[i].m_hash) & (slotCount - 1);
+		while (slots[slot] != 0)
+			slot = (slot + 1) & (slotCount - 1);
+		slots[slot] = static_cast<uint32_t>(i + 1);
+	}
+
+	PackArchive::Header header = {};
+	std::memcpy(header.m_magic, PackArchive::Magic.data(), PackArchive::Magic.size());
+	header.m_version = PackArchive::Version;
+	header.m_entryCount = static_cast<uint32_t>(m_entries.size());
+	header.m_slotCount = slotCount;
+
+	Align(alignof(PackArchive::Entry));
+	header.m_entriesOffset = m_offset;
+	m_stream.write(reinterpret_cast<const char *>(m_entries.data()), m_entries.size() * sizeof(PackArchive::Entry));
+	m_offset += m_entries.size() * sizeof(PackArchive::Entry);
+
+	header.m_slotsOffset = m_offset;
+	m_stream.write(reinterpret_cast<const char *>(slots.data()), slots.size() * sizeof(uint32_t));
+	m_offset += slots.size() * sizeof(uint32_t);
+
+	header.m_namesOffset = m_offset;
+	header.m_namesLength = m_names.size();
+	m_stream.write(m_names.data(), m_names.size());
+
+	m_stream.seekp(0);
+	m_stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	m_stream.close();
+	return !m_stream.fail();
+}
+
+void PackWriter::Align(uint64_t alignment) {
+	static constexpr char Padding[PackArchive::Alignment] = {};
+	auto padding = (alignment - m_offset % alignment) % alignment;
+	m_stream.write(Padding, padding);
+	m_offset += padding;
+}
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Helpers/NonCopyable.hpp"
+
+namespace acid {
+/**
+ * @brief Class that reads a packed archive, the file is memory mapped once and entries are found through a hashed path table.
+ * Stored entries are viewed straight from the mapping, compressed entries are inflated the first time they are viewed.
+ */
+class ACID_EXPORT PackArchive : NonCopyable {
+public:
+	enum class Compression : uint32_t {
+		None,
+		// Zlib deflate through miniz.
+		Deflate
+	};
+
+	class Entry {
+	public:
+		uint64_t m_hash;
+		// The offset of the entry data from the start of the archive, always a multiple of 64.
+		uint64_t m_offset;
+		// The length of the entry data in the archive.
+		uint64_t m_storedLength;
+		// The length of the entry after it is decompressed.
+		uint64_t m_length;
+		uint32_t m_nameOffset;
+		uint32_t m_nameLength;
+		Compression m_compression;
+		uint32_t m_padding;
+	};
+
+	/**
+	 * Opens and maps a packed archive.
+	 * @param filename The archive file.
+	 */
+	explicit PackArchive(std::filesystem::path filename);
+
+	~PackArchive();
+
+	/**
+	 * Gets the hash entry names are looked up by, backslashes are hashed as forward slashes.
+	 * @param name The entry name.
+	 * @return The hash.
+	 */
+	static uint64_t Hash(std::string_view name);
+
+	/**
+	 * Finds an entry by name.
+	 * @param name The entry name, backslashes are treated as forward slashes.
+	 * @return The entry, or nullptr if there is no entry with the name.
+	 */
+	const Entry *Find(std::string_view name) const;
+
+	bool Exists(std::string_view name) const { return Find(name) != nullptr; }
+
+	/**
+	 * Views the contents of an entry without copying it.
+	 * @param name The entry name.
+	 * @return The contents, valid until the archive is destroyed, or std::nullopt if there is no entry with the name or it could not be inflated.
+	 */
+	std::optional<std::string_view> ReadView(std::string_view name);
+
+	/**
+	 * Copies the contents of an entry, compressed entries are inflated without being kept.
+	 * @param name The entry name.
+	 * @return The contents, or std::nullopt if there is no entry with the name or it could not be inflated.
+	 */
+	std::optional<std::string> Read(std::string_view name) const;
+
+	std::string_view GetName(const Entry &entry) const { return {m_names + entry.m_nameOffset, entry.m_nameLength}; }
+	std::vector<std::string_view> GetEntryNames() const;
+
+	const std::filesystem::path &GetFilename() const { return m_filename; }
+	std::size_t GetEntryCount() const { return m_entryCount; }
+
+	explicit operator bool() const noexcept { return m_data != nullptr; }
+
+private:
+	friend class PackWriter;
+
+	class Header {
+	public:
+		char m_magic[8];
+		uint32_t m_version;
+		uint32_t m_entryCount;
+		// The number of slots in the path table, a power of two.
+		uint32_t m_slotCount;
+		uint32_t m_padding;
+		uint64_t m_entriesOffset;
+		uint64_t m_slotsOffset;
+		uint64_t m_namesOffset;
+		uint64_t m_namesLength;
+	};
+
+	static constexpr std::string_view Magic = {"ACIDPAK", 8};
+	static constexpr uint32_t Version = 1;
+	static constexpr uint64_t Alignment = 64;
+
+	bool Map();
+	bool Validate();
+	void Unmap();
+
+	static bool Inflate(std::string_view stored, char *data, uint64_t length);
+
+	std::filesystem::path m_filename;
+
+	const char *m_data = nullptr;
+	std::size_t m_size = 0;
+#if defined(ACID_BUILD_WINDOWS)
+	void *m_file = nullptr;
+	void *m_mapping = nullptr;
+#endif
+
+	const Entry *m_entries = nullptr;
+	std::size_t m_entryCount = 0;
+	// Each slot holds one plus the index of an entry, or zero if it is empty. Slots are probed linearly from the hash.
+	const uint32_t *m_slots = nullptr;
+	uint32_t m_slotMask = 0;
+	const char *m_names = nullptr;
+
+	// Entries that have been inflated by a view, by entry index.
+	std::unordered_map<std::size_t, std::unique_ptr<char[]>> m_inflated;
+	std::mutex m_inflatedMutex;
+};
+
+/**
+ * @brief Class that writes a packed archive, entry data is written as it is added and the path table is written when finished.
+ */
+class ACID_EXPORT PackWriter : NonCopyable {
+public:
+	/**
+	 * Creates a packed archive file.
+	 * @param filename The archive file, any existing file is replaced.
+	 */
+	explicit PackWriter(const std::filesystem::path &filename);
+
+	~PackWriter();
+
+	/**
+	 * Writes an entry into the archive.
+	 * @param name The entry name, backslashes are stored as forward slashes.
+	 * @param data The contents.
+	 * @param compression The compression to use, the entry is stored uncompressed if compressing it does not make it smaller.
+	 * @return If the entry was added, entries with a name that was already added are not.
+	 */
+	bool AddEntry(std::string_view name, std::string_view data, PackArchive::Compression compression = PackArchive::Compression::None);
+
+	/**
+	 * Writes the path table and header, no entries can be added after this. Called by the destructor if it has not been.
+	 * @return If the archive was written.
+	 */
+	bool Finish();
+
+	explicit operator bool() const noexcept { return m_stream.good(); }
+
+private:
+	void Align(uint64_t alignment);
+
+	std::ofstream m_stream;
+	uint64_t m_offset = 0;
+	std::vector<PackArchive::Entry> m_entries;
+	std::string m_names;
+	std::unordered_map<std::string, std::size_t> m_entryIndices;
+	bool m_finished = false;
+};
+}
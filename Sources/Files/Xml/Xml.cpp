@@ -1,6 +1,7 @@
 #include "Xml.hpp"
 
 #include "Helpers/String.hpp"
+#include "XmlReader.hpp"
 
 namespace acid {
 Xml::Xml(const std::string &rootName) {
@@ -17,7 +18,44 @@ Xml::Xml(const std::string &rootName, Node &&node) :
 	SetName(rootName);
 }
 
+static void WriteEscaped(std::ostream &stream, std::string_view string) {
+	if (string.find_first_of("&<>\"") == std::string_view::npos) {
+		stream << string;
+		return;
+	}
+
+	for (auto c : string) {
+		switch (c) {
+		case '&':
+			stream << "&amp;";
+			break;
+		case '<':
+			stream << "&lt;";
+			break;
+		case '>':
+			stream << "&gt;";
+			break;
+		case '"':
+			stream << "&quot;";
+			break;
+		default:
+			stream << c;
+			break;
+		}
+	}
+}
+
 void Xml::ParseString(std::string_view string) {
+	XmlReader reader(string);
+	Parse(reader);
+	// Only comments and processing instructions may follow the root element, anything else throws.
+	reader.Next();
+}
+
+void Xml::ParseStream(std::istream &stream) {
+	XmlReader reader(stream);
+	Parse(reader);
+	reader.Next();
 }
 
 void Xml::WriteStream(std::ostream &stream, const Format &format) const {
@@ -25,10 +63,48 @@ void Xml::WriteStream(std::ostream &stream, const Format &format) const {
 	AppendData(*this, stream, format, 0);
 }
 
-void Xml::AddToken(std::string_view view, std::vector<Token> &tokens) {
-}
-
-void Xml::Convert(Node &current, const std::vector<Token> &tokens, int32_t i, int32_t &r) {
+void Xml::Parse(XmlReader &reader) {
+	std::vector<Node *> nodes;
+	std::string attributeName;
+
+	while (true) {
+		switch (reader.Next()) {
+		case XmlReader::Event::StartElement: {
+			auto &node = nodes.empty() ? static_cast<Node &>(*this) : nodes.back()->AddProperty(reader.GetName());
+			if (nodes.empty())
+				SetName(std::string(reader.GetName()));
+
+			for (const auto &attribute : reader.GetAttributes()) {
+				attributeName.assign(1, '_');
+				attributeName.append(attribute.m_name);
+				auto &property = node.AddProperty(attributeName);
+				property.SetValue(std::string(reader.GetAttribute(attribute.m_name)));
+				property.SetType(Type::String);
+			}
+
+			nodes.emplace_back(&node);
+			break;
+		}
+		case XmlReader::Event::Text: {
+			auto &value = nodes.back()->GetValue();
+			auto text = reader.GetDecodedText();
+			// Text split by child elements is joined with a space.
+			nodes.back()->SetValue(value.empty() ? std::string(text) : value + ' ' + std::string(text));
+			break;
+		}
+		case XmlReader::Event::EndElement: {
+			auto &node = *nodes.back();
+			node.SetType(!node.GetProperties().empty() ? Type::Object : !node.GetValue().empty() ? Type::String : Type::Null);
+			nodes.pop_back();
+
+			if (nodes.empty())
+				return;
+			break;
+		}
+		case XmlReader::Event::EndDocument:
+			return;
+		}
+	}
 }
 
 void Xml::AppendData(const Node &source, std::ostream &stream, const Format &format, int32_t indent) {
@@ -42,7 +118,9 @@ void Xml::AppendData(const Node &source, std::ostream &stream, const Format &for
 
 	for (const auto &property : source.GetProperties()) {
 		if (property.GetName().rfind('_', 0) != 0) continue;
-		nameAttributes << " " << property.GetName().substr(1) << "=\"" << property.GetValue() << "\"";
+		nameAttributes << " " << property.GetName().substr(1) << "=\"";
+		WriteEscaped(nameAttributes, property.GetValue());
+		nameAttributes << "\"";
 		attributeCount++;
 	}
 
@@ -69,7 +147,7 @@ void Xml::AppendData(const Node &source, std::ostream &stream, const Format &for
 	stream << "<" << nameAndAttribs << ">";
 	if (!source.GetValue().empty()) {
 		stream << format.m_newLine << format.GetIndents(indent + 1);
-		stream << source.GetValue();
+		WriteEscaped(stream, source.GetValue());
 	}
 
 	if (!source.GetProperties().empty()) {
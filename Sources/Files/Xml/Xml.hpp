@@ -3,15 +3,27 @@
 #include "Files/Node.hpp"
 
 namespace acid {
+class XmlReader;
+
 class Xml : public Node {
 public:
 	explicit Xml(const std::string &rootName);
 	Xml(const std::string &rootName, const Node &node);
 	Xml(const std::string &rootName, Node &&node);
 
+	using Node::ParseStream;
+
 	void ParseString(std::string_view string) override;
+	void ParseStream(std::istream &stream) override;
 	void WriteStream(std::ostream &stream, const Format &format = Format::Minified) const override;
 
+	/**
+	 * Builds this node from the events of a reader, the next element read becomes this node and reading stops when it ends.
+	 * Attributes become properties with names starting with a underscore, and text becomes the value.
+	 * @param reader The reader to read events from.
+	 */
+	void Parse(XmlReader &reader);
+
 	Xml &operator=(const Xml &node) = default;
 	Xml &operator=(Xml && node) = default;
 	template<typename T>
@@ -21,9 +33,6 @@ public:
 	}
 
 private:
-	static void AddToken(std::string_view view, std::vector<Token> &tokens);
-	static void Convert(Node &current, const std::vector<Token> &tokens, int32_t i, int32_t &r);
-
 	static void AppendData(const Node &source, std::ostream &stream, const Format &format, int32_t indent);
 };
 }
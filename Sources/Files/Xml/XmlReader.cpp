@@ -0,0 +1,383 @@
+#include "XmlReader.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace acid {
+static bool IsWhitespace(char c) {
+	return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+static bool IsNameEnd(char c) {
+	return IsWhitespace(c) || c == '>' || c == '/' || c == '=' || c == '<' || c == '"' || c == '\'';
+}
+
+static void AppendUtf8(std::string &string, uint32_t codepoint) {
+	if (codepoint < 0x80) {
+		string += static_cast<char>(codepoint);
+	} else if (codepoint < 0x800) {
+		string += static_cast<char>(0xc0 | codepoint >> 6);
+		string += static_cast<char>(0x80 | (codepoint & 0x3f));
+	} else if (codepoint < 0x10000) {
+		string += static_cast<char>(0xe0 | codepoint >> 12);
+		string += static_cast<char>(0x80 | (codepoint >> 6 & 0x3f));
+		string += static_cast<char>(0x80 | (codepoint & 0x3f));
+	} else {
+		string += static_cast<char>(0xf0 | codepoint >> 18);
+		string += static_cast<char>(0x80 | (codepoint >> 12 & 0x3f));
+		string += static_cast<char>(0x80 | (codepoint >> 6 & 0x3f));
+		string += static_cast<char>(0x80 | (codepoint & 0x3f));
+	}
+}
+
+static bool DecodeEntity(std::string_view entity, std::string &string) {
+	if (entity == "lt") {
+		string += '<';
+	} else if (entity == "gt") {
+		string += '>';
+	} else if (entity == "amp") {
+		string += '&';
+	} else if (entity == "quot") {
+		string += '"';
+	} else if (entity == "apos") {
+		string += '\'';
+	} else if (entity.size() > 1 && entity[0] == '#') {
+		auto hex = entity[1] == 'x' || entity[1] == 'X';
+		auto digits = entity.substr(hex ? 2 : 1);
+		uint32_t codepoint = 0;
+
+		if (digits.empty() || digits.size() > 8)
+			return false;
+
+		for (auto c : digits) {
+			uint32_t digit;
+			if (c >= '0' && c <= '9')
+				digit = c - '0';
+			else if (hex && c >= 'a' && c <= 'f')
+				digit = c - 'a' + 10;
+			else if (hex && c >= 'A' && c <= 'F')
+				digit = c - 'A' + 10;
+			else
+				return false;
+			codepoint = codepoint * (hex ? 16 : 10) + digit;
+		}
+
+		if (codepoint > 0x10ffff)
+			return false;
+		AppendUtf8(string, codepoint);
+	} else {
+		return false;
+	}
+
+	return true;
+}
+
+XmlReader::XmlReader(std::string_view string) :
+	m_data(string) {
+}
+
+XmlReader::XmlReader(std::istream &stream, std::size_t chunkSize) :
+	m_stream(&stream),
+	m_chunkSize(chunkSize) {
+}
+
+XmlReader::Event XmlReader::Next() {
+	m_attributes.clear();
+	m_text = {};
+
+	if (m_pendingEnd) {
+		// The name of a empty element tag is still in the buffer.
+		m_pendingEnd = false;
+		m_openNames.resize(m_openNames.size() - m_openLengths.back());
+		m_openLengths.pop_back();
+		return m_event = Event::EndElement;
+	}
+
+	m_name = {};
+
+	// Events that have been read are dropped from the stream buffer.
+	if (m_stream && m_position >= m_chunkSize) {
+		m_buffer.erase(0, m_position);
+		m_data = m_buffer;
+		m_position = 0;
+	}
+
+	while (true) {
+		if (!IsAvailable(m_position)) {
+			if (!m_openLengths.empty())
+				throw std::runtime_error("Missing end tag for <" + m_openNames.substr(m_openNames.size() - m_openLengths.back()) + ">");
+			if (!m_started)
+				throw std::runtime_error("No root element found");
+			return m_event = Event::EndDocument;
+		}
+
+		if (m_data[m_position] == '<') {
+			if (ReadMarkup())
+				return m_event;
+		} else if (ReadText()) {
+			return m_event = Event::Text;
+		}
+	}
+}
+
+std::string_view XmlReader::GetDecodedText() {
+	return m_textRaw ? m_text : DecodeEntities(m_text, m_decoded);
+}
+
+std::string_view XmlReader::GetAttribute(std::string_view name, std::string_view fallback) {
+	for (const auto &attribute : m_attributes) {
+		if (attribute.m_name == name)
+			return DecodeEntities(attribute.m_value, m_decoded);
+	}
+
+	return fallback;
+}
+
+std::string_view XmlReader::DecodeEntities(std::string_view string, std::string &storage) {
+	auto ampersand = string.find('&');
+	if (ampersand == std::string_view::npos)
+		return string;
+
+	storage.assign(string.substr(0, ampersand));
+
+	while (ampersand != std::string_view::npos) {
+		auto semicolon = string.find(';', ampersand + 1);
+		// Unknown or unfinished entities are kept as they are.
+		if (semicolon == std::string_view::npos || !DecodeEntity(string.substr(ampersand + 1, semicolon - ampersand - 1), storage)) {
+			storage += '&';
+			semicolon = ampersand;
+		}
+
+		auto next = string.find('&', semicolon + 1);
+		storage.append(string.substr(semicolon + 1, next == std::string_view::npos ? std::string_view::npos : next - semicolon - 1));
+		ampersand = next;
+	}
+
+	return storage;
+}
+
+bool XmlReader::Refill() {
+	if (!m_stream || !*m_stream)
+		return false;
+
+	auto size = m_buffer.size();
+	m_buffer.resize(size + m_chunkSize);
+	m_stream->read(m_buffer.data() + size, static_cast<std::streamsize>(m_chunkSize));
+	m_buffer.resize(size + static_cast<std::size_t>(m_stream->gcount()));
+	m_data = m_buffer;
+	return m_buffer.size() != size;
+}
+
+bool XmlReader::IsAvailable(std::size_t index) {
+	while (index >= m_data.size()) {
+		if (!Refill())
+			return false;
+	}
+
+	return true;
+}
+
+std::size_t XmlReader::Find(char c, std::size_t from) {
+	while (true) {
+		auto index = m_data.find(c, from);
+		if (index != std::string_view::npos)
+			return index;
+
+		from = std::max(from, m_data.size());
+		if (!Refill())
+			return std::string_view::npos;
+	}
+}
+
+std::size_t XmlReader::Find(std::string_view string, std::size_t from) {
+	while (true) {
+		auto index = m_data.find(string, from);
+		if (index != std::string_view::npos)
+			return index;
+
+		// The string may start in the data already read and end in the refill.
+		if (m_data.size() >= string.size())
+			from = std::max(from, m_data.size() - string.size() + 1);
+		if (!Refill())
+			return std::string_view::npos;
+	}
+}
+
+bool XmlReader::StartsWith(std::size_t index, std::string_view prefix) {
+	return IsAvailable(index + prefix.size() - 1) && m_data.compare(index, prefix.size(), prefix) == 0;
+}
+
+std::size_t XmlReader::SkipWhitespace(std::size_t index) {
+	while (IsAvailable(index) && IsWhitespace(m_data[index]))
+		index++;
+	return index;
+}
+
+std::size_t XmlReader::SkipName(std::size_t index) {
+	while (IsAvailable(index) && !IsNameEnd(m_data[index]))
+		index++;
+	return index;
+}
+
+bool XmlReader::ReadMarkup() {
+	if (!IsAvailable(m_position + 1))
+		throw std::runtime_error("Missing end of tag");
+
+	switch (m_data[m_position + 1]) {
+	case '/':
+		ReadEndElement();
+		return true;
+	case '?': {
+		auto end = Find("?>", m_position + 2);
+		if (end == std::string_view::npos)
+			throw std::runtime_error("Missing end of processing instruction");
+		m_position = end + 2;
+		return false;
+	}
+	case '!': {
+		if (StartsWith(m_position, "<!--")) {
+			auto end = Find("-->", m_position + 4);
+			if (end == std::string_view::npos)
+				throw std::runtime_error("Missing end of comment");
+			m_position = end + 3;
+			return false;
+		}
+
+		if (StartsWith(m_position, "<![CDATA[")) {
+			auto end = Find("]]>", m_position + 9);
+			if (end == std::string_view::npos)
+				throw std::runtime_error("Missing end of CDATA section");
+			if (m_openLengths.empty())
+				throw std::runtime_error("Text outside of the root element");
+
+			m_text = m_data.substr(m_position + 9, end - m_position - 9);
+			m_textRaw = true;
+			m_position = end + 3;
+			m_event = Event::Text;
+			return true;
+		}
+
+		// A doctype, with a internal subset in brackets that may contain '>'.
+		auto end = Find('>', m_position + 2);
+		auto bracket = m_data.find('[', m_position + 2);
+		if (end != std::string_view::npos && bracket < end) {
+			auto bracketEnd = Find(']', bracket + 1);
+			end = bracketEnd == std::string_view::npos ? bracketEnd : Find('>', bracketEnd + 1);
+		}
+
+		if (end == std::string_view::npos)
+			throw std::runtime_error("Missing end of doctype");
+		m_position = end + 1;
+		return false;
+	}
+	default:
+		ReadStartElement();
+		return true;
+	}
+}
+
+void XmlReader::ReadStartElement() {
+	if (m_started && m_openLengths.empty())
+		throw std::runtime_error("Document must have a single root element");
+
+	auto nameStart = m_position + 1;
+	auto nameEnd = SkipName(nameStart);
+	if (nameEnd == nameStart)
+		throw std::runtime_error("Missing element name");
+
+	m_attributeOffsets.clear();
+	auto index = nameEnd;
+
+	while (true) {
+		index = SkipWhitespace(index);
+		if (!IsAvailable(index))
+			throw std::runtime_error("Missing end of tag");
+
+		if (m_data[index] == '>') {
+			index++;
+			break;
+		}
+
+		if (m_data[index] == '/') {
+			if (!IsAvailable(index + 1) || m_data[index + 1] != '>')
+				throw std::runtime_error("Missing end of tag");
+			m_pendingEnd = true;
+			index += 2;
+			break;
+		}
+
+		auto attributeEnd = SkipName(index);
+		if (attributeEnd == index)
+			throw std::runtime_error("Unexpected character in tag");
+
+		auto equals = SkipWhitespace(attributeEnd);
+		if (!IsAvailable(equals) || m_data[equals] != '=')
+			throw std::runtime_error("Missing attribute value");
+
+		auto quote = SkipWhitespace(equals + 1);
+		if (!IsAvailable(quote) || (m_data[quote] != '"' && m_data[quote] != '\''))
+			throw std::runtime_error("Missing attribute value");
+
+		auto valueEnd = Find(m_data[quote], quote + 1);
+		if (valueEnd == std::string_view::npos)
+			throw std::runtime_error("Missing end of attribute value");
+
+		m_attributeOffsets.insert(m_attributeOffsets.end(), {index, attributeEnd, quote + 1, valueEnd});
+		index = valueEnd + 1;
+	}
+
+	// Views are only taken once the whole tag is in the buffer.
+	m_name = m_data.substr(nameStart, nameEnd - nameStart);
+
+	for (std::size_t i = 0; i < m_attributeOffsets.size(); i += 4) {
+		m_attributes.push_back({m_data.substr(m_attributeOffsets[i], m_attributeOffsets[i + 1] - m_attributeOffsets[i]),
+			m_data.substr(m_attributeOffsets[i + 2], m_attributeOffsets[i + 3] - m_attributeOffsets[i + 2])});
+	}
+
+	m_openNames.append(m_name);
+	m_openLengths.emplace_back(m_name.size());
+	m_started = true;
+	m_position = index;
+	m_event = Event::StartElement;
+}
+
+void XmlReader::ReadEndElement() {
+	auto nameStart = m_position + 2;
+	auto nameEnd = SkipName(nameStart);
+	auto end = SkipWhitespace(nameEnd);
+	if (!IsAvailable(end) || m_data[end] != '>')
+		throw std::runtime_error("Missing end of tag");
+
+	m_name = m_data.substr(nameStart, nameEnd - nameStart);
+
+	if (m_openLengths.empty() || std::string_view(m_openNames).substr(m_openNames.size() - m_openLengths.back()) != m_name)
+		throw std::runtime_error("Unexpected end tag </" + std::string(m_name) + ">");
+
+	m_openNames.resize(m_openNames.size() - m_openLengths.back());
+	m_openLengths.pop_back();
+	m_position = end + 1;
+	m_event = Event::EndElement;
+}
+
+bool XmlReader::ReadText() {
+	auto start = m_position;
+	auto end = Find('<', start);
+	if (end == std::string_view::npos)
+		end = m_data.size();
+	m_position = end;
+
+	while (start < end && IsWhitespace(m_data[start]))
+		start++;
+	while (end > start && IsWhitespace(m_data[end - 1]))
+		end--;
+
+	if (start == end)
+		return false;
+	if (m_openLengths.empty())
+		throw std::runtime_error("Text outside of the root element");
+
+	m_text = m_data.substr(start, end - start);
+	m_textRaw = false;
+	return true;
+}
+}
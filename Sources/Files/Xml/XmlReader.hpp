@@ -0,0 +1,139 @@
+#pragma once
+
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Export.hpp"
+
+namespace acid {
+/**
+ * @brief Class that reads xml as a sequence of events without building a tree, so large documents can be processed in one pass.
+ * Names, attributes and text are views into the buffer, entities are only decoded when a decoded value is asked for.
+ * Comments, processing instructions and doctypes are skipped, whitespace only text is skipped and other text is trimmed.
+ */
+class ACID_EXPORT XmlReader {
+public:
+	enum class Event {
+		StartElement, EndElement, Text, EndDocument
+	};
+
+	/**
+	 * @brief A attribute of the current start element.
+	 */
+	class Attribute {
+	public:
+		std::string_view m_name;
+		// The value with entities not yet decoded.
+		std::string_view m_value;
+	};
+
+	/**
+	 * Creates a reader over a buffer, the buffer must outlive the reader.
+	 * @param string The xml text.
+	 */
+	explicit XmlReader(std::string_view string);
+
+	/**
+	 * Creates a reader that reads a stream in chunks, only the event being read is kept in memory.
+	 * @param stream The stream to read from, must outlive the reader.
+	 * @param chunkSize The number of bytes to read from the stream at once.
+	 */
+	explicit XmlReader(std::istream &stream, std::size_t chunkSize = 65536);
+
+	/**
+	 * Reads the next event, views from the previous event are no longer valid.
+	 * A empty element tag gives a start element followed by a end element.
+	 * @return The event read, EndDocument once the root element has ended and the rest of the document was read.
+	 */
+	Event Next();
+
+	Event GetEvent() const { return m_event; }
+
+	/**
+	 * Gets the name of the current start or end element.
+	 * @return The element name.
+	 */
+	std::string_view GetName() const { return m_name; }
+
+	/**
+	 * Gets the text of the current text event, as it is in the document.
+	 * @return The text, with entities not decoded.
+	 */
+	std::string_view GetText() const { return m_text; }
+
+	/**
+	 * Gets the text of the current text event with entities decoded, text without entities is not copied.
+	 * @return The decoded text, valid until the next event or value decoded.
+	 */
+	std::string_view GetDecodedText();
+
+	/**
+	 * Gets the attributes of the current start element.
+	 * @return The attributes, in document order.
+	 */
+	const std::vector<Attribute> &GetAttributes() const { return m_attributes; }
+
+	/**
+	 * Gets the decoded value of a attribute of the current start element.
+	 * @param name The attribute name.
+	 * @param fallback The value if the element has no attribute with the name.
+	 * @return The decoded value, valid until the next event or value decoded.
+	 */
+	std::string_view GetAttribute(std::string_view name, std::string_view fallback = {});
+
+	/**
+	 * Gets the number of elements that are open, a start element is counted once it has been read.
+	 * @return The element depth.
+	 */
+	std::size_t GetDepth() const { return m_openLengths.size(); }
+
+	/**
+	 * Decodes the predefined and numeric character entities in text.
+	 * @param string The text to decode.
+	 * @param storage Storage for the decoded text, only used if the text contains a entity.
+	 * @return The decoded text, a view into the text or the storage.
+	 */
+	static std::string_view DecodeEntities(std::string_view string, std::string &storage);
+
+private:
+	bool Refill();
+	bool IsAvailable(std::size_t index);
+	std::size_t Find(char c, std::size_t from);
+	std::size_t Find(std::string_view string, std::size_t from);
+	bool StartsWith(std::size_t index, std::string_view prefix);
+	std::size_t SkipWhitespace(std::size_t index);
+	std::size_t SkipName(std::size_t index);
+
+	bool ReadMarkup();
+	void ReadStartElement();
+	void ReadEndElement();
+	bool ReadText();
+
+	// The buffer being read, either the string given or the stream buffer.
+	std::string_view m_data;
+	std::size_t m_position = 0;
+
+	std::istream *m_stream = nullptr;
+	std::size_t m_chunkSize = 0;
+	std::string m_buffer;
+
+	Event m_event = Event::EndDocument;
+	std::string_view m_name;
+	std::string_view m_text;
+	// If the text is from a CDATA section, which is never decoded.
+	bool m_textRaw = false;
+	std::vector<Attribute> m_attributes;
+	// Offsets into the buffer while a start element is read, as a refill may move the buffer.
+	std::vector<std::size_t> m_attributeOffsets;
+
+	// The names of open elements, so end elements can be checked after the buffer has moved.
+	std::string m_openNames;
+	std::vector<std::size_t> m_openLengths;
+	bool m_pendingEnd = false;
+	bool m_started = false;
+
+	std::string m_decoded;
+};
+}
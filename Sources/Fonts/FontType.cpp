@@ -3,11 +3,10 @@
 #include "Files/Files.hpp"
 #include "Resources/Resources.hpp"
 #include "Graphics/Graphics.hpp"
-#include "msdf.h"
-#define STB_TRUETYPE_IMPLEMENTATION
-#include "stb_truetype.h"
 
 namespace acid {
+std::filesystem::path FontType::CacheDirectory = "Cache/Fonts";
+
 static constexpr std::wstring_view NEHE = L"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz1234567890 \"!`?'.,;:()[]{}<>|/@\\^$-%+=#_&~*\t\r\n";
 
 std::shared_ptr<FontType> FontType::Create(const Node &node) {
@@ -36,6 +35,12 @@ FontType::FontType(std::filesystem::path filename, std::size_t size, bool load)
 	}
 }
 
+FontType::~FontType() {
+	if (m_cacheDirty) {
+		m_atlas->WriteCache(GetCachePath());
+	}
+}
+
 const Node &operator>>(const Node &node, FontType &fontType) {
 	node["filename"].Get(fontType.m_filename);
 	node["size"].Get(fontType.m_size);
@@ -57,63 +62,93 @@ void FontType::Load() {
 #endif
 
 	auto bytes = Files::ReadBytes(m_filename);
-	stbtt_fontinfo fontinfo;
-	stbtt_InitFont(&fontinfo, bytes.data(), stbtt_GetFontOffsetForIndex(bytes.data(), 0));
-
-	auto glyphSize = 3 * m_size * m_size;
-	auto layerCount = NEHE.size();
-	auto bitmapData = std::make_unique<uint8_t[]>(glyphSize * layerCount);
-
-	//m_image = std::make_unique<Image2dArray>(Vector2ui(m_size, m_size), layerCount, VK_FORMAT_R32G32B32_SFLOAT);
-
-	std::size_t arrayLayer = 0;
-	for (auto c : NEHE) {
-		ex_metrics_t metrics = {};
-		auto bitmap = ex_msdf_glyph(&fontinfo, c, m_size, m_size, &metrics);
-		if (bitmap) {
-			auto bitmapSdfData = std::make_unique<uint8_t[]>(glyphSize);
-			for (std::size_t y = 0; y < m_size; y++) {
-				for (std::size_t x = 0; x < m_size; x++) {
-					auto index = 3 * ((y * m_size) + x);
-					bitmapSdfData[index + 0] = (uint8_t)(255 * (bitmap[index + 0] + m_size) / m_size);
-					bitmapSdfData[index + 1] = (uint8_t)(255 * (bitmap[index + 1] + m_size) / m_size);
-					bitmapSdfData[index + 2] = (uint8_t)(255 * (bitmap[index + 2] + m_size) / m_size);
-				}
-			}
-			std::memcpy(&bitmapData[glyphSize * arrayLayer], bitmapSdfData.get(), glyphSize);
-#if 0
-			Bitmap bitmapSdf(std::move(bitmapSdfData), {m_size, m_size}, 3);
-			bitmapSdf.Write("Fonts" / m_filename.stem() / (std::to_string(index) + ".png"));
+	m_atlas = std::make_unique<GlyphAtlas>(std::vector<uint8_t>(bytes.begin(), bytes.end()), static_cast<uint32_t>(m_size));
+	m_layouts.Clear();
+
+	// A cache written with an older preset only needs the new preset glyphs generated.
+	auto cached = m_atlas->ReadCache(GetCachePath());
+	if (m_atlas->AddGlyphs(NEHE, Engine::Get() ? &Engine::Get()->GetUpdatePool() : nullptr) != 0) {
+		m_atlas->WriteCache(GetCachePath());
+	}
+	m_cacheDirty = false;
+
+	CreateImage();
+
+#if defined(ACID_DEBUG)
+	Log::Out("Font Type ", m_filename, " loaded ", m_atlas->GetGlyphCount(), " glyphs ", cached ? "from cache " : "", "in ",
+		(Time::Now() - debugStart).AsMilliseconds<float>(), "ms\n");
 #endif
+}
 
-			//m_image->SetPixels(bitmap, arrayLayer);
+void FontType::AddGlyphs(std::wstring_view characters) {
+	if (!m_atlas) {
+		return;
+	}
 
-			free(bitmap);
-		}
+	if (m_atlas->AddGlyphs(characters, Engine::Get() ? &Engine::Get()->GetUpdatePool() : nullptr) != 0) {
+		m_cacheDirty = true;
+	}
+}
 
-		m_glyphs.emplace_back(Glyph(metrics.left_bearing, metrics.advance, {metrics.ix0, metrics.iy0}, {metrics.ix1, metrics.iy1}));
-		m_indices[c] = arrayLayer++;
+void FontType::UploadGlyphs() {
+	if (!m_atlas) {
+		return;
 	}
 
-	auto bitmap = std::make_unique<Bitmap>(std::move(bitmapData), Vector2ui(m_size, m_size), 3);
-	m_image = std::make_unique<Image2dArray>(std::move(bitmap), layerCount, VK_FORMAT_R8G8B8_UNORM);
-#if 1
-	for (uint32_t layer = 0; layer < layerCount; layer++) {
-		auto bitmapSdf = m_image->GetBitmap(0, layer);
-		bitmapSdf->Write("Fonts" / m_filename.stem() / (std::to_string(layer) + ".png"));
+	auto glyphCount = static_cast<uint32_t>(m_atlas->GetGlyphCount());
+	if (glyphCount == m_uploadedGlyphs) {
+		return;
 	}
-#endif
 
-#if defined(ACID_DEBUG)
-	Log::Out("Font Type ", m_filename, " loaded ", m_glyphs.size(), " glyphs in ", (Time::Now() - debugStart).AsMilliseconds<float>(), "ms\n");
-#endif
+	if (glyphCount > m_layerCapacity) {
+		CreateImage();
+		return;
+	}
+
+	// Only layers no frame has sampled yet are written, the transfer barriers wait for earlier frames on the graphics queue.
+	m_image->SetPixels(&m_atlas->GetPixels()[m_uploadedGlyphs * m_atlas->GetLayerLength()], glyphCount - m_uploadedGlyphs, m_uploadedGlyphs);
+	m_uploadedGlyphs = glyphCount;
+}
+
+void FontType::CreateImage() {
+	m_uploadedGlyphs = static_cast<uint32_t>(m_atlas->GetGlyphCount());
+	m_layerCapacity = (m_uploadedGlyphs / LayerStep + 1) * LayerStep;
+
+	// Layers past the last glyph are left empty for glyphs added later.
+	auto layerLength = m_atlas->GetLayerLength();
+	auto bitmapData = std::make_unique<uint8_t[]>(layerLength * m_layerCapacity);
+	std::memcpy(bitmapData.get(), m_atlas->GetPixels().data(), m_atlas->GetPixels().size());
+
+	auto bitmap = std::make_unique<Bitmap>(std::move(bitmapData), Vector2ui(m_size, m_size), GlyphAtlas::Components);
+
+	// Frames in flight may still sample the old image.
+	if (m_image) {
+		Graphics::Get()->Retire(std::move(m_image));
+	}
+
+	m_image = std::make_unique<Image2dArray>(std::move(bitmap), m_layerCapacity, VK_FORMAT_R8G8B8_UNORM);
+}
+
+std::filesystem::path FontType::GetCachePath() const {
+	return CacheDirectory / (m_filename.stem().string() + "_" + std::to_string(m_size) + ".glyphs");
+}
+
+std::shared_ptr<const TextLayout> FontType::GetLayout(std::wstring_view string, const TextLayout::Style &style,
+	const std::shared_ptr<const TextLayout> &previous) {
+	if (!m_atlas) {
+		return nullptr;
+	}
+
+	return m_layouts.Get(*m_atlas, string, style, previous);
 }
 
 std::optional<FontType::Glyph> FontType::GetGlyph(wchar_t ascii) const {
-	auto it = m_indices.find(ascii);
+	if (!m_atlas) {
+		return std::nullopt;
+	}
 
-	if (it != m_indices.end()) {
-		return m_glyphs[it->second];
+	if (auto layer = m_atlas->GetLayer(ascii)) {
+		return m_atlas->GetGlyph(*layer);
 	}
 
 	return std::nullopt;
@@ -3,29 +3,20 @@
 #include "Resources/Resource.hpp"
 #include "Graphics/Images/Image2dArray.hpp"
 #include "Graphics/Pipelines/PipelineGraphics.hpp"
+#include "GlyphAtlas.hpp"
+#include "TextLayout.hpp"
 
 namespace acid {
 class Text;
 
 /**
  * @brief Resource that is used when creating a font mesh.
+ * Glyphs are kept in a {@link GlyphAtlas} that is cached in the cache directory, so only the first load of a font and size generates glyphs.
  */
 class ACID_EXPORT FontType : public Resource {
 public:
-	class Glyph {
-	public:
-		Glyph(int32_t leftBearing, int32_t advance, const Vector2i &i0, const Vector2i &i1) :
-			m_leftBearing(leftBearing),
-			m_advance(advance),
-			m_i0(i0),
-			m_i1(i1) {
-		}
-
-		int32_t m_leftBearing;
-		int32_t m_advance;
-		Vector2i m_i0, m_i1;
-	};
-	
+	using Glyph = GlyphAtlas::Glyph;
+
 	/**
 	 * Creates a new font type, or finds one with the same values.
 	 * @param node The node to decode values from.
@@ -41,6 +32,13 @@ public:
 	 */
 	static std::shared_ptr<FontType> Create(const std::filesystem::path &filename, std::size_t size = 24);
 
+	/**
+	 * Gets the directory glyph atlases are cached in.
+	 * @return The cache directory.
+	 */
+	static const std::filesystem::path &GetCacheDirectory() { return CacheDirectory; }
+	static void SetCacheDirectory(const std::filesystem::path &cacheDirectory) { CacheDirectory = cacheDirectory; }
+
 	/**
 	 * Creates a new font type.
 	 * @param filename The font file to load glyphs for this type from.
@@ -49,8 +47,34 @@ public:
 	 */
 	FontType(std::filesystem::path filename, std::size_t size = 24, bool load = true);
 
+	~FontType();
+
 	std::optional<Glyph> GetGlyph(wchar_t ascii) const;
-	
+
+	/**
+	 * Generates glyphs for characters outside of the preset characters, they are added to the image by the next {@link FontType#UploadGlyphs}.
+	 * The cache is written once when the font type is destroyed, not for every added glyph.
+	 * @param characters The characters to add, characters that already have a glyph are skipped.
+	 */
+	void AddGlyphs(std::wstring_view characters);
+
+	/**
+	 * Uploads the glyphs added since the last upload to the image, recreating the image when it has no free layers.
+	 * Called by the renderer before a frame is recorded, so the image is not changed from a update thread. A replaced image is retired
+	 * until frames in flight are done with it, and uploads are submitted to the graphics queue behind the frames already submitted.
+	 */
+	void UploadGlyphs();
+
+	/**
+	 * Gets the layout of a string in this font, layouts are shared between texts with the same string and style.
+	 * @param string The string to lay out.
+	 * @param style The style to lay out with.
+	 * @param previous The layout the text held before, the new layout is updated from it where the strings first differ.
+	 * @return The layout, or nullptr if the font is not loaded.
+	 */
+	std::shared_ptr<const TextLayout> GetLayout(std::wstring_view string, const TextLayout::Style &style,
+		const std::shared_ptr<const TextLayout> &previous = nullptr);
+
 	std::type_index GetTypeIndex() const override { return typeid(FontType); }
 
 	const std::filesystem::path &GetFilename() const { return m_filename; }
@@ -64,14 +88,25 @@ public:
 	friend Node &operator<<(Node &node, const FontType &fontType);
 
 private:
+	// Layers are allocated in steps, so glyphs added later can be uploaded without recreating the image.
+	static constexpr uint32_t LayerStep = 64;
+
+	static std::filesystem::path CacheDirectory;
+
 	void Load();
+	void CreateImage();
+	std::filesystem::path GetCachePath() const;
 
 	std::filesystem::path m_filename;
+	std::unique_ptr<GlyphAtlas> m_atlas;
 	std::unique_ptr<Image2dArray> m_image;
+	uint32_t m_layerCapacity = 0;
+	// The number of glyphs in the image.
+	uint32_t m_uploadedGlyphs = 0;
+	// If glyphs were added since the cache was written.
+	bool m_cacheDirty = false;
+	TextLayoutCache m_layouts;
 
-	/// Char to glyphs index.
-	std::map<wchar_t, std::size_t> m_indices;
-	std::vector<Glyph> m_glyphs;
 	/// Glyph size in pixels.
 	std::size_t m_size;
 	
@@ -0,0 +1,153 @@
+#include "GlyphAtlas.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include "Helpers/Hash.hpp"
+#include "msdf.h"
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "stb_truetype.h"
+
+namespace acid {
+// Increment when the cache layout or the glyph generation changes.
+static constexpr uint32_t CacheVersion = 2;
+static constexpr uint32_t CacheMagic = 0x41544c47; // GLTA
+
+class CacheHeader {
+public:
+	uint32_t m_magic;
+	uint32_t m_version;
+	uint64_t m_key;
+	uint32_t m_size;
+	uint32_t m_glyphCount;
+};
+
+class CacheGlyph {
+public:
+	uint32_t m_character;
+	GlyphAtlas::Glyph m_glyph;
+};
+
+GlyphAtlas::GlyphAtlas(std::vector<uint8_t> fontData, uint32_t size) :
+	m_fontData(std::move(fontData)),
+	m_fontInfo(std::make_unique<stbtt_fontinfo>()),
+	m_size(size) {
+	m_key = HashValue(CacheVersion);
+	m_key = HashBytes(m_fontData.data(), m_fontData.size(), m_key);
+	m_key = HashValue(m_size, m_key);
+
+	if (m_fontData.empty() || !stbtt_InitFont(m_fontInfo.get(), m_fontData.data(), stbtt_GetFontOffsetForIndex(m_fontData.data(), 0)))
+		throw std::runtime_error("Failed to read font data");
+
+	int ascent, descent, lineGap;
+	stbtt_GetFontVMetrics(m_fontInfo.get(), &ascent, &descent, &lineGap);
+	auto scale = stbtt_ScaleForMappingEmToPixels(m_fontInfo.get(), static_cast<float>(m_size));
+	m_ascent = scale * ascent;
+	m_descent = scale * descent;
+	m_lineGap = scale * lineGap;
+}
+
+GlyphAtlas::~GlyphAtlas() = default;
+
+std::size_t GlyphAtlas::AddGlyphs(std::wstring_view characters, ThreadPool *pool) {
+	auto first = m_glyphs.size();
+
+	for (auto c : characters) {
+		if (m_layers.emplace(c, m_characters.size()).second)
+			m_characters.emplace_back(c);
+	}
+
+	auto count = m_characters.size() - first;
+	if (count == 0)
+		return 0;
+
+	m_glyphs.resize(first + count);
+	m_pixels.resize((first + count) * GetLayerLength());
+
+	auto generate = [this](std::size_t layer) {
+		ex_metrics_t metrics = {};
+		auto bitmap = ex_msdf_glyph(m_fontInfo.get(), m_characters[layer], m_size, m_size, &metrics);
+
+		if (bitmap) {
+			// Distances are in pixels offset by 0.5 so the edge is at 0.5, distances over half a pixel from the edge are clamped.
+			auto pixels = &m_pixels[layer * GetLayerLength()];
+			for (std::size_t i = 0; i < GetLayerLength(); i++)
+				pixels[i] = static_cast<uint8_t>(std::clamp(255.0f * bitmap[i] + 0.5f, 0.0f, 255.0f));
+
+			free(bitmap);
+		}
+
+		m_glyphs[layer] = {metrics.left_bearing, metrics.advance, {metrics.ix0, metrics.iy0}, {metrics.ix1, metrics.iy1}};
+	};
+
+	if (pool) {
+		pool->ParallelFor(first, first + count, generate, 1);
+	} else {
+		for (auto layer = first; layer < first + count; layer++)
+			generate(layer);
+	}
+
+	return count;
+}
+
+bool GlyphAtlas::ReadCache(const std::filesystem::path &filename) {
+	std::ifstream stream(filename, std::ios::binary | std::ios::ate);
+	if (!stream)
+		return false;
+
+	std::vector<uint8_t> data(static_cast<std::size_t>(stream.tellg()));
+	stream.seekg(0);
+	if (!stream.read(reinterpret_cast<char *>(data.data()), data.size()) || data.size() < sizeof(CacheHeader))
+		return false;
+
+	CacheHeader header;
+	std::memcpy(&header, data.data(), sizeof(CacheHeader));
+	if (header.m_magic != CacheMagic || header.m_version != CacheVersion || header.m_key != m_key || header.m_size != m_size ||
+		data.size() != sizeof(CacheHeader) + header.m_glyphCount * (sizeof(CacheGlyph) + GetLayerLength()))
+		return false;
+
+	m_layers.clear();
+	m_characters.resize(header.m_glyphCount);
+	m_glyphs.resize(header.m_glyphCount);
+
+	auto glyphs = data.data() + sizeof(CacheHeader);
+	for (std::size_t layer = 0; layer < header.m_glyphCount; layer++) {
+		CacheGlyph glyph;
+		std::memcpy(&glyph, glyphs + layer * sizeof(CacheGlyph), sizeof(CacheGlyph));
+		m_characters[layer] = static_cast<wchar_t>(glyph.m_character);
+		m_glyphs[layer] = glyph.m_glyph;
+		m_layers[m_characters[layer]] = layer;
+	}
+
+	auto pixels = glyphs + header.m_glyphCount * sizeof(CacheGlyph);
+	m_pixels.assign(pixels, data.data() + data.size());
+	return true;
+}
+
+bool GlyphAtlas::WriteCache(const std::filesystem::path &filename) const {
+	std::error_code error;
+	if (filename.has_parent_path())
+		std::filesystem::create_directories(filename.parent_path(), error);
+
+	std::ofstream stream(filename, std::ios::binary);
+	if (!stream)
+		return false;
+
+	CacheHeader header = {CacheMagic, CacheVersion, m_key, m_size, static_cast<uint32_t>(m_glyphs.size())};
+	std::vector<CacheGlyph> glyphs(m_glyphs.size());
+	for (std::size_t layer = 0; layer < m_glyphs.size(); layer++)
+		glyphs[layer] = {static_cast<uint32_t>(m_characters[layer]), m_glyphs[layer]};
+
+	stream.write(reinterpret_cast<const char *>(&header), sizeof(CacheHeader));
+	stream.write(reinterpret_cast<const char *>(glyphs.data()), glyphs.size() * sizeof(CacheGlyph));
+	stream.write(reinterpret_cast<const char *>(m_pixels.data()), m_pixels.size());
+	return static_cast<bool>(stream);
+}
+
+std::optional<std::size_t> GlyphAtlas::GetLayer(wchar_t c) const {
+	if (auto it = m_layers.find(c); it != m_layers.end())
+		return it->second;
+	return std::nullopt;
+}
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "Maths/Vector2.hpp"
+#include "Helpers/ThreadPool.hpp"
+
+struct stbtt_fontinfo;
+
+namespace acid {
+/**
+ * @brief Class that holds the multi-channel signed distance field glyphs of a font at one size, with one glyph per layer.
+ * Glyphs are generated across a thread pool and can be added at any time, layers of glyphs already added never move.
+ * The atlas can be written to a binary cache file that is read back with a single read.
+ */
+class ACID_EXPORT GlyphAtlas {
+public:
+	class Glyph {
+	public:
+		Glyph() = default;
+		Glyph(int32_t leftBearing, int32_t advance, const Vector2i &i0, const Vector2i &i1) :
+			m_leftBearing(leftBearing),
+			m_advance(advance),
+			m_i0(i0),
+			m_i1(i1) {
+		}
+
+		int32_t m_leftBearing = 0;
+		int32_t m_advance = 0;
+		Vector2i m_i0, m_i1;
+	};
+
+	// Bytes per pixel of a layer, the glyph distance field is stored as RGB.
+	static constexpr uint32_t Components = 3;
+
+	/**
+	 * Creates a new empty glyph atlas.
+	 * @param fontData The contents of a ttf font file.
+	 * @param size The size of each glyph in pixels.
+	 */
+	GlyphAtlas(std::vector<uint8_t> fontData, uint32_t size);
+	~GlyphAtlas();
+
+	/**
+	 * Generates glyphs for characters that are not in the atlas, new glyphs are added to the end of the atlas.
+	 * @param characters The characters to add, duplicates and characters already in the atlas are skipped.
+	 * @param pool The pool to generate glyphs across, or nullptr to generate on this thread.
+	 * @return The number of glyphs added.
+	 */
+	std::size_t AddGlyphs(std::wstring_view characters, ThreadPool *pool = nullptr);
+
+	/**
+	 * Replaces the glyphs in the atlas with the glyphs in a cache file, if the file was written for the same font and size.
+	 * @param filename The cache file.
+	 * @return If the cache was read.
+	 */
+	bool ReadCache(const std::filesystem::path &filename);
+
+	/**
+	 * Writes every glyph in the atlas to a cache file.
+	 * @param filename The cache file.
+	 * @return If the cache was written.
+	 */
+	bool WriteCache(const std::filesystem::path &filename) const;
+
+	/**
+	 * Gets the layer of a character.
+	 * @param c The character.
+	 * @return The layer, or nullopt if the character is not in the atlas.
+	 */
+	std::optional<std::size_t> GetLayer(wchar_t c) const;
+
+	const Glyph &GetGlyph(std::size_t layer) const { return m_glyphs[layer]; }
+	std::size_t GetGlyphCount() const { return m_glyphs.size(); }
+
+	/**
+	 * Gets the pixels of every layer, layers are stored one after another.
+	 * @return The pixels.
+	 */
+	const std::vector<uint8_t> &GetPixels() const { return m_pixels; }
+	std::size_t GetLayerLength() const { return Components * m_size * m_size; }
+
+	uint32_t GetSize() const { return m_size; }
+	uint64_t GetKey() const { return m_key; }
+
+	/**
+	 * Gets the distance from the baseline to the top of the highest glyph in the font, in pixels at the atlas size.
+	 * @return The ascent.
+	 */
+	float GetAscent() const { return m_ascent; }
+
+	/**
+	 * Gets the distance from the baseline to the bottom of the lowest glyph in the font, this is negative when below the baseline.
+	 * @return The descent.
+	 */
+	float GetDescent() const { return m_descent; }
+	float GetLineGap() const { return m_lineGap; }
+
+private:
+	std::vector<uint8_t> m_fontData;
+	std::unique_ptr<stbtt_fontinfo> m_fontInfo;
+	uint32_t m_size;
+	// Hash of the font data and glyph size, a cache file is only read if it has the same key.
+	uint64_t m_key;
+	float m_ascent = 0.0f;
+	float m_descent = 0.0f;
+	float m_lineGap = 0.0f;
+
+	std::map<wchar_t, std::size_t> m_layers;
+	std::vector<wchar_t> m_characters;
+	std::vector<Glyph> m_glyphs;
+	std::vector<uint8_t> m_pixels;
+};
+}
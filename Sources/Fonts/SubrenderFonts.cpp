@@ -1,17 +1,34 @@
 #include "SubrenderFonts.hpp"
 
+#include "Devices/Window.hpp"
+#include "Graphics/Graphics.hpp"
 #include "Models/Vertex2d.hpp"
 #include "Uis/Uis.hpp"
 #include "Text.hpp"
 
 namespace acid {
+static const uint32_t INSTANCE_STEPS = 1024;
+
+static const std::vector<Vertex2d> VERTICES = {
+	{{0.0f, 0.0f}, {0.0f, 0.0f}},
+	{{1.0f, 0.0f}, {1.0f, 0.0f}},
+	{{1.0f, 1.0f}, {1.0f, 1.0f}},
+	{{0.0f, 1.0f}, {0.0f, 1.0f}}
+};
+static const std::vector<uint32_t> INDICES = {
+	0, 1, 2,
+	2, 3, 0
+};
+
 SubrenderFonts::SubrenderFonts(const Pipeline::Stage &pipelineStage) :
 	Subrender(pipelineStage),
-	m_pipeline(pipelineStage, {"Shaders/Fonts/Font.vert", "Shaders/Fonts/Font.frag"}, {VertexText::GetVertexInput()}) {
+	m_pipeline(pipelineStage, {"Shaders/Fonts/Font.vert", "Shaders/Fonts/Font.frag"}, {Vertex2d::GetVertexInput(0), Instance::GetVertexInput(1)}),
+	m_model(std::make_unique<Model>(VERTICES, INDICES)) {
 }
 
 void SubrenderFonts::Render(const CommandBuffer &commandBuffer) {
-	m_pipeline.BindPipeline(commandBuffer);
+	m_instances.clear();
+	m_draws.clear();
 
 	for (const auto &screenObject : Uis::Get()->GetObjects()) {
 		if (!screenObject->IsEnabled()) {
@@ -19,8 +36,111 @@ void SubrenderFonts::Render(const CommandBuffer &commandBuffer) {
 		}
 
 		if (auto object = dynamic_cast<Text *>(screenObject)) {
-			object->CmdRender(commandBuffer, m_pipeline);
+			AddText(*object);
 		}
 	}
+
+	if (m_instances.empty()) {
+		return;
+	}
+
+	// Grows the instance buffer in steps, it is never shrunk. Frames in flight may still read the old buffer.
+	auto instanceCount = static_cast<uint32_t>(m_instances.size());
+	if (instanceCount > m_maxInstances) {
+		m_maxInstances = INSTANCE_STEPS * ((std::max(instanceCount, 2 * m_maxInstances) + INSTANCE_STEPS - 1) / INSTANCE_STEPS);
+		Graphics::Get()->Retire(std::move(m_instanceBuffer));
+		m_instanceBuffer = std::make_unique<InstanceBuffer>(sizeof(Instance) * m_maxInstances);
+	}
+
+	void *instances;
+	m_instanceBuffer->MapMemory(&instances);
+	std::memcpy(instances, m_instances.data(), sizeof(Instance) * m_instances.size());
+	m_instanceBuffer->UnmapMemory();
+
+	m_pipeline.BindPipeline(commandBuffer);
+
+	VkBuffer vertexBuffers[2] = {m_model->GetVertexBuffer()->GetBuffer(), m_instanceBuffer->GetBuffer()};
+	VkDeviceSize offsets[2] = {0, 0};
+	vkCmdBindVertexBuffers(commandBuffer, 0, 2, vertexBuffers, offsets);
+	vkCmdBindIndexBuffer(commandBuffer, m_model->GetIndexBuffer()->GetBuffer(), 0, m_model->GetIndexType());
+
+	for (const auto &draw : m_draws) {
+		auto &descriptors = m_descriptorSets[draw.m_fontType];
+
+		// A set is never rewritten while frames in flight may use it, a font with a new atlas image gets a new set.
+		if (descriptors.m_image != draw.m_fontType->GetImage()) {
+			Graphics::Get()->Retire(std::move(descriptors.m_descriptorSet));
+			descriptors.m_image = draw.m_fontType->GetImage();
+			descriptors.m_descriptorSet = std::make_unique<DescriptorsHandler>(m_pipeline);
+		}
+
+		descriptors.m_descriptorSet->Push("samplerMsdf", descriptors.m_image);
+
+		if (!descriptors.m_descriptorSet->Update(m_pipeline)) {
+			continue;
+		}
+
+		descriptors.m_descriptorSet->BindDescriptor(commandBuffer, m_pipeline);
+		vkCmdSetScissor(commandBuffer, 0, 1, &draw.m_scissor);
+		vkCmdDrawIndexed(commandBuffer, m_model->GetIndexCount(), draw.m_instanceCount, 0, 0, draw.m_firstInstance);
+	}
+
+	// Drops the descriptors of fonts that were not drawn, a font that is destroyed could have its address reused.
+	// The sets are retired rather than freed, since frames in flight may still have them bound.
+	for (auto it = m_descriptorSets.begin(); it != m_descriptorSets.end();) {
+		if (std::none_of(m_draws.begin(), m_draws.end(), [&](const Draw &draw) { return draw.m_fontType == it->first; })) {
+			Graphics::Get()->Retire(std::move(it->second.m_descriptorSet));
+			it = m_descriptorSets.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+void SubrenderFonts::AddText(const Text &text) {
+	const auto &layout = text.GetLayout();
+	const auto &fontType = text.GetFontType();
+	auto size = text.GetScreenTransform().GetSize();
+
+	// Glyphs added by texts this frame are uploaded before any draw of the frame is recorded.
+	if (fontType) {
+		fontType->UploadGlyphs();
+	}
+
+	if (!layout || layout->GetGlyphs().empty() || !fontType || !fontType->GetImage() || size.m_x <= 0.0f || size.m_y <= 0.0f) {
+		return;
+	}
+
+	auto scissor = text.GetScissor();
+	VkRect2D scissorRect = {};
+	scissorRect.offset.x = scissor ? static_cast<int32_t>(scissor->m_x) : 0;
+	scissorRect.offset.y = scissor ? static_cast<int32_t>(scissor->m_y) : 0;
+	scissorRect.extent.width = scissor ? static_cast<int32_t>(scissor->m_z) : Window::Get()->GetSize().m_x;
+	scissorRect.extent.height = scissor ? static_cast<int32_t>(scissor->m_w) : Window::Get()->GetSize().m_y;
+
+	// Texts are batched until the font or scissor changes, so texts keep their draw order.
+	if (m_draws.empty() || m_draws.back().m_fontType != fontType.get() || m_draws.back().m_scissor.offset.x != scissorRect.offset.x ||
+		m_draws.back().m_scissor.offset.y != scissorRect.offset.y || m_draws.back().m_scissor.extent.width != scissorRect.extent.width ||
+		m_draws.back().m_scissor.extent.height != scissorRect.extent.height) {
+		m_draws.emplace_back(Draw{fontType.get(), scissorRect, static_cast<uint32_t>(m_instances.size()), 0});
+	}
+
+	// The model view maps the texts rectangle from 0 to 1 into clip space, glyphs are positioned in pixels from the top left of the rectangle.
+	const auto &modelView = text.GetModelView();
+	auto origin = modelView.Transform(Vector4f(0.0f, 0.0f, 0.0f, 1.0f));
+	auto axisX = modelView.Transform(Vector4f(1.0f, 0.0f, 0.0f, 0.0f)) / size.m_x;
+	auto axisY = modelView.Transform(Vector4f(0.0f, 1.0f, 0.0f, 0.0f)) / size.m_y;
+
+	auto colour = text.GetTextColour();
+	colour.m_a *= text.GetScreenAlpha();
+	auto scale = layout->GetStyle().m_fontSize / static_cast<float>(fontType->GetSize());
+
+	for (const auto &glyph : layout->GetGlyphs()) {
+		auto position = origin + axisX * glyph.m_position.m_x + axisY * glyph.m_position.m_y;
+		m_instances.emplace_back(Instance{{position.m_x, position.m_y, axisX.m_x * glyph.m_size.m_x, axisY.m_y * glyph.m_size.m_y},
+			{static_cast<float>(glyph.m_layer), position.m_z, scale}, colour});
+	}
+
+	m_draws.back().m_instanceCount += static_cast<uint32_t>(layout->GetGlyphs().size());
 }
 }
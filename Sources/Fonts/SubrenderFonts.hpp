@@ -1,16 +1,78 @@
 #pragma once
 
 #include "Graphics/Subrender.hpp"
+#include "Graphics/Buffers/InstanceBuffer.hpp"
+#include "Graphics/Descriptors/DescriptorsHandler.hpp"
 #include "Graphics/Pipelines/PipelineGraphics.hpp"
+#include "Maths/Colour.hpp"
+#include "Models/Model.hpp"
 
 namespace acid {
+class FontType;
+class Image2dArray;
+class Text;
+
+/**
+ * @brief Subrender that draws the glyphs of every text from one instance buffer, with a instanced draw for each run of texts with the same font and scissor.
+ */
 class ACID_EXPORT SubrenderFonts : public Subrender {
 public:
+	class Instance {
+	public:
+		static Shader::VertexInput GetVertexInput(uint32_t baseBinding = 0) {
+			std::vector<VkVertexInputBindingDescription> bindingDescriptions = {
+				{baseBinding, sizeof(Instance), VK_VERTEX_INPUT_RATE_INSTANCE}
+			};
+			std::vector<VkVertexInputAttributeDescription> attributeDescriptions = {
+				{2, baseBinding, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(Instance, m_rectangle)},
+				{3, baseBinding, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Instance, m_glyph)},
+				{4, baseBinding, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(Instance, m_colour)}
+			};
+			return {bindingDescriptions, attributeDescriptions};
+		}
+
+		// The top left and size of the glyph quad in clip space.
+		Vector4f m_rectangle;
+		// The atlas layer, the depth, and the screen pixels per atlas pixel.
+		Vector3f m_glyph;
+		Colour m_colour;
+	};
+
 	explicit SubrenderFonts(const Pipeline::Stage &pipelineStage);
 
 	void Render(const CommandBuffer &commandBuffer) override;
 
 private:
+	/**
+	 * @brief A run of instances drawn with one font and scissor.
+	 */
+	class Draw {
+	public:
+		const FontType *m_fontType;
+		VkRect2D m_scissor;
+		uint32_t m_firstInstance;
+		uint32_t m_instanceCount;
+	};
+
+	/**
+	 * @brief The descriptor set of a font, written once for the atlas image it was created with.
+	 */
+	class FontDescriptors {
+	public:
+		const Image2dArray *m_image = nullptr;
+		std::unique_ptr<DescriptorsHandler> m_descriptorSet;
+	};
+
+	void AddText(const Text &text);
+
 	PipelineGraphics m_pipeline;
+	std::unique_ptr<Model> m_model;
+
+	std::vector<Instance> m_instances;
+	std::vector<Draw> m_draws;
+	// The number of instances the instance buffer has space for.
+	uint32_t m_maxInstances = 0;
+	std::unique_ptr<InstanceBuffer> m_instanceBuffer;
+	std::map<const FontType *, FontDescriptors> m_descriptorSets;
 };
 }
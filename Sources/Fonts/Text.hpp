@@ -3,61 +3,18 @@
 #include "Maths/Colour.hpp"
 #include "Maths/Vector2.hpp"
 #include "Uis/Drivers/UiDriver.hpp"
-#include "Models/Model.hpp"
-#include "Models/Vertex2d.hpp"
-#include "Graphics/Descriptors/DescriptorsHandler.hpp"
-#include "Graphics/Buffers/UniformHandler.hpp"
-#include "Graphics/Pipelines/PipelineGraphics.hpp"
 #include "Uis/UiObject.hpp"
 #include "FontType.hpp"
 
 namespace acid {
-class VertexText {
-public:
-	VertexText() = default;
-	VertexText(const Vector2f &position, const Vector3f &uv) :
-		m_position(position),
-		m_uv(uv) {
-	}
-
-	static Shader::VertexInput GetVertexInput(uint32_t baseBinding = 0) {
-		std::vector<VkVertexInputBindingDescription> bindingDescriptions = {
-			{baseBinding, sizeof(VertexText), VK_VERTEX_INPUT_RATE_VERTEX}
-		};
-		std::vector<VkVertexInputAttributeDescription> attributeDescriptions = {
-			{0, baseBinding, VK_FORMAT_R32G32_SFLOAT, offsetof(VertexText, m_position)},
-			{1, baseBinding, VK_FORMAT_R32G32B32_SFLOAT, offsetof(VertexText, m_uv)}
-		};
-		return {bindingDescriptions, attributeDescriptions};
-	}
-
-	bool operator==(const VertexText &other) const {
-		return m_position == other.m_position && m_uv == other.m_uv;
-	}
-
-	bool operator!=(const VertexText &other) const {
-		return !operator==(other);
-	}
-
-	Vector2f m_position;
-	Vector3f m_uv;
-};
-
 /**
  * @brief Class that represents a text in a GUI.
+ * The text is laid out into glyphs that are drawn by {@link SubrenderFonts} in batches with other texts, layouts are shared between texts with the same string.
  */
 class ACID_EXPORT Text : public UiObject {
 	friend class FontType;
 public:
-	/**
-	 * @brief A enum that represents how the text will be justified.
-	 */
-	enum class Justify {
-		Left,
-		Centre,
-		Right,
-		Fully
-	};
+	using Justify = TextLayout::Justify;
 
 	/**
 	 * Creates a new text object.
@@ -77,13 +34,11 @@ public:
 
 	void UpdateObject() override;
 
-	bool CmdRender(const CommandBuffer &commandBuffer, const PipelineGraphics &pipeline);
-
 	/**
-	 * Gets the text model, which contains all the vertex data for the quads on which the text will be rendered.
-	 * @return The model of the text.
+	 * Gets the layout of the text, the glyphs are positioned in pixels from the top left of the text.
+	 * @return The layout of the text, or nullptr if the text is empty.
 	 */
-	const Model *GetModel() const { return m_model.get(); }
+	const std::shared_ptr<const TextLayout> &GetLayout() const { return m_layout; }
 
 	/**
 	 * Gets the font size.
@@ -101,7 +56,7 @@ public:
 	 * Gets the number of lines in this text.
 	 * @return The number of lines.
 	 */
-	uint32_t GetNumberLines() const { return m_numberLines; }
+	uint32_t GetNumberLines() const { return m_layout ? m_layout->GetLineCount() : 0; }
 
 	/**
 	 * Gets the string of text represented.
@@ -170,95 +125,18 @@ public:
 	void SetTextColour(const Colour &textColour) { m_textColour = textColour; }
 
 	/**
-	 * Gets if the text has been loaded to a model.
-	 * @return If the text has been loaded to a model.
+	 * Gets if the text has been laid out.
+	 * @return If the text has been laid out.
 	 */
 	bool IsLoaded() const;
 
 private:
 	/**
-	 * During the loading of a text this represents one word in the text.
-	 */
-	class Word {
-	public:
-		/**
-		 * Creates a new text word.
-		 */
-		Word() = default;
-
-		/**
-		 * Adds a glyph to the end of the current word and increases the screen-space width of the word.
-		 * @param glyph The glyph to be added.
-		 * @param kerning The glyph kerning.
-		 */
-		void AddCharacter(const FontType::Glyph &glyph, float kerning) {
-			m_glyphs.emplace_back(glyph);
-			m_width += kerning + glyph.m_advance;
-		}
-
-		std::vector<FontType::Glyph> m_glyphs;
-		float m_width = 0.0f;
-	};
-
-	/**
-	 * Represents a line of text during the loading of a text.
-	 */
-	class Line {
-	public:
-		/**
-		 * Creates a new text line.
-		 * @param spaceWidth The screen-space width of a space character.
-		 * @param maxLength The screen-space maximum length of a line.
-		 */
-		Line(float spaceWidth, float maxLength) :
-			m_maxLength(maxLength),
-			m_spaceSize(spaceWidth) {
-		}
-
-		/**
-		 * Attempt to add a word to the line. If the line can fit the word in without reaching the maximum line length then the word is added and the line length increased.
-		 * @param word The word to try to add.
-		 * @return {@code true} if the word has successfully been added to the line.
-		 */
-		bool AddWord(const Word &word) {
-			auto additionalLength = word.m_width;
-			additionalLength += !m_words.empty() ? m_spaceSize : 0.0f;
-
-			if (m_currentLineLength + additionalLength <= m_maxLength) {
-				m_words.emplace_back(word);
-				m_currentWordsLength += word.m_width;
-				m_currentLineLength += additionalLength;
-				return true;
-			}
-
-			return false;
-		}
-
-		float m_maxLength;
-		float m_spaceSize;
-
-		std::vector<Word> m_words;
-		float m_currentWordsLength = 0.0f;
-		float m_currentLineLength = 0.0f;
-	};
-
-	/**
-	 * Takes in an unloaded text and calculate all of the vertices for the quads on which this text will be rendered.
-	 * The vertex positions and texture coords and calculated based on the information from the font file.
-	 * Then takes the information about the vertices of all the quads and stores it in a model.
+	 * Lays out the string, the layout is found in the fonts layouts or updated from the last layout of this text.
 	 */
 	void LoadText();
-	std::vector<Line> CreateStructure() const;
-	void CompleteStructure(std::vector<Line> &lines, Line &currentLine, const Word &currentWord, float maxLength) const;
-	std::vector<VertexText> CreateQuad(const std::vector<Line> &lines) const;
-	static void AddVerticesForGlyph(float cursorX, float cursorY, const FontType::Glyph &glyph, std::vector<VertexText> &vertices);
-	static void AddVertex(float vx, float vy, float tx, float ty, std::vector<VertexText> &vertices);
-
-	DescriptorsHandler m_descriptorSet;
-	UniformHandler m_uniformObject;
 
-	std::unique_ptr<Model> m_model;
-	uint32_t m_numberLines = 0;
+	std::shared_ptr<const TextLayout> m_layout;
 	Vector2f m_lastSize;
 
 	float m_fontSize;
@@ -0,0 +1,182 @@
+#include "TextLayout.hpp"
+
+#include <algorithm>
+
+namespace acid {
+std::size_t TextLayout::Update(const GlyphAtlas &atlas, std::wstring_view string, const Style &style) {
+	std::size_t line = 0;
+
+	if (&atlas == m_atlas && atlas.GetGlyphCount() == m_atlasGlyphs && style == m_style) {
+		auto changed = static_cast<std::size_t>(std::mismatch(m_string.begin(), m_string.end(), string.begin(), string.end()).first - m_string.begin());
+		if (changed == m_string.size() && changed == string.size())
+			return m_glyphs.size();
+
+		// The first word of the changed line may now fit on the line before it, so that line is laid out again too.
+		while (line + 1 < m_lines.size() && m_lines[line + 1].m_character <= changed)
+			line++;
+		if (line > 0)
+			line--;
+	}
+
+	auto begin = line < m_lines.size() ? m_lines[line] : Line{0, 0, 0.0f};
+	m_lines.resize(line);
+	m_glyphs.resize(begin.m_glyph);
+
+	m_atlas = &atlas;
+	m_atlasGlyphs = atlas.GetGlyphCount();
+	m_string = string;
+	m_style = style;
+
+	auto scale = style.m_fontSize / static_cast<float>(atlas.GetSize());
+	auto kerning = style.m_kerning * style.m_fontSize;
+	auto space = atlas.GetLayer(L' ');
+	m_spaceWidth = space ? scale * atlas.GetGlyph(*space).m_advance + kerning : 0.25f * style.m_fontSize;
+	m_lineHeight = scale * (atlas.GetAscent() - atlas.GetDescent() + atlas.GetLineGap()) + style.m_leading * style.m_fontSize;
+
+	// Glyphs of the words on the current line, positioned from the start of their word.
+	std::vector<Glyph> glyphs;
+	std::vector<Word> words;
+	Word word = {begin.m_character, 0, 0, 0.0f};
+	auto wordsWidth = 0.0f;
+	auto lineStart = begin.m_character;
+
+	for (auto i = begin.m_character; i <= string.size(); i++) {
+		auto c = i < string.size() ? string[i] : L'\n';
+
+		if (c == L' ' || c == L'\t' || c == L'\n') {
+			if (word.m_character != i) {
+				word.m_glyphEnd = glyphs.size();
+
+				// A word that does not fit wraps to a new line, unless it is the only word on the line.
+				if (style.m_maxWidth > 0.0f && !words.empty() && wordsWidth + m_spaceWidth * words.size() + word.m_width > style.m_maxWidth) {
+					AddLine(lineStart, words, glyphs, true);
+					glyphs.erase(glyphs.begin(), glyphs.begin() + word.m_glyphBegin);
+					word.m_glyphEnd -= word.m_glyphBegin;
+					word.m_glyphBegin = 0;
+					words.clear();
+					wordsWidth = 0.0f;
+					lineStart = word.m_character;
+				}
+
+				words.emplace_back(word);
+				wordsWidth += word.m_width;
+			}
+
+			if (c == L'\n') {
+				AddLine(lineStart, words, glyphs, false);
+				glyphs.clear();
+				words.clear();
+				wordsWidth = 0.0f;
+				lineStart = i + 1;
+			}
+
+			word = {i + 1, glyphs.size(), glyphs.size(), 0.0f};
+			continue;
+		}
+
+		auto layer = atlas.GetLayer(c);
+		if (!layer)
+			continue;
+
+		// Glyphs are centred in their atlas layer, the layer is placed so the glyph box sits on the baseline.
+		const auto &glyph = atlas.GetGlyph(*layer);
+		auto size = static_cast<float>(atlas.GetSize());
+
+		if (glyph.m_i0 != glyph.m_i1) {
+			Vector2f position(glyph.m_leftBearing + 0.5f * (glyph.m_i1.m_x - glyph.m_i0.m_x - size), atlas.GetAscent() - 0.5f * (glyph.m_i0.m_y + glyph.m_i1.m_y + size));
+			glyphs.emplace_back(Glyph{{word.m_width + scale * position.m_x, scale * position.m_y}, {scale * size, scale * size}, static_cast<uint32_t>(*layer)});
+		}
+
+		word.m_width += scale * glyph.m_advance + kerning;
+	}
+
+	m_size = {0.0f, m_lineHeight * m_lines.size()};
+	for (const auto &l : m_lines)
+		m_size.m_x = std::max(m_size.m_x, l.m_width);
+
+	return begin.m_glyph;
+}
+
+void TextLayout::AddLine(std::size_t character, const std::vector<Word> &words, const std::vector<Glyph> &glyphs, bool wrapped) {
+	auto wordsWidth = 0.0f;
+	for (const auto &word : words)
+		wordsWidth += word.m_width;
+
+	auto width = words.empty() ? 0.0f : wordsWidth + m_spaceWidth * (words.size() - 1);
+	auto x = 0.0f;
+	auto gap = m_spaceWidth;
+
+	if (m_style.m_maxWidth > 0.0f) {
+		switch (m_style.m_justify) {
+		case Justify::Left:
+			break;
+		case Justify::Centre:
+			x = 0.5f * (m_style.m_maxWidth - width);
+			break;
+		case Justify::Right:
+			x = m_style.m_maxWidth - width;
+			break;
+		case Justify::Fully:
+			// Only lines that were wrapped are stretched, the last line of a paragraph keeps its spacing.
+			if (wrapped && words.size() > 1) {
+				gap = (m_style.m_maxWidth - wordsWidth) / (words.size() - 1);
+				width = m_style.m_maxWidth;
+			}
+			break;
+		}
+	}
+
+	auto y = m_lineHeight * m_lines.size();
+	m_lines.emplace_back(Line{character, m_glyphs.size(), width});
+
+	for (const auto &word : words) {
+		for (auto i = word.m_glyphBegin; i < word.m_glyphEnd; i++)
+			m_glyphs.emplace_back(Glyph{glyphs[i].m_position + Vector2f(x, y), glyphs[i].m_size, glyphs[i].m_layer});
+
+		x += word.m_width + gap;
+	}
+}
+
+TextLayoutCache::TextLayoutCache(std::size_t capacity) :
+	m_capacity(capacity),
+	m_trimSize(capacity) {
+}
+
+std::shared_ptr<const TextLayout> TextLayoutCache::Get(const GlyphAtlas &atlas, std::wstring_view string, const TextLayout::Style &style,
+	const std::shared_ptr<const TextLayout> &previous) {
+	if (auto it = m_layouts.find(KeyView(string, style)); it != m_layouts.end()) {
+		// Glyphs may have been added to the atlas since the layout was cached.
+		it->second->Update(atlas, string, style);
+		return it->second;
+	}
+
+	if (previous && previous.use_count() <= 2) {
+		// The previous layout is only held by the text and this cache, so it is moved to its new key and updated in place.
+		if (auto it = m_layouts.find(KeyView(previous->GetString(), previous->GetStyle())); it != m_layouts.end() && it->second == previous) {
+			auto node = m_layouts.extract(it);
+			node.key().first = string;
+			node.key().second = style;
+			node.mapped()->Update(atlas, string, style);
+			return m_layouts.insert(std::move(node)).position->second;
+		}
+	}
+
+	auto layout = previous ? std::make_shared<TextLayout>(*previous) : std::make_shared<TextLayout>();
+	layout->Update(atlas, string, style);
+	m_layouts.emplace(Key(string, style), layout);
+
+	// Layouts that are only held by the cache are removed, the next trim waits until the cache has doubled so trims stay amortized constant.
+	if (m_layouts.size() > m_trimSize) {
+		for (auto it = m_layouts.begin(); it != m_layouts.end();) {
+			if (it->second.use_count() == 1)
+				it = m_layouts.erase(it);
+			else
+				++it;
+		}
+
+		m_trimSize = std::max(m_capacity, 2 * m_layouts.size());
+	}
+
+	return layout;
+}
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <tuple>
+
+#include "GlyphAtlas.hpp"
+
+namespace acid {
+/**
+ * @brief Class that lays out a string into glyph quads, lines are wrapped between words to fit a maximum width.
+ * A layout can be updated with a new string, lines before the line with the first changed character are kept.
+ */
+class ACID_EXPORT TextLayout {
+public:
+	/**
+	 * @brief A enum that represents how the text will be justified.
+	 */
+	enum class Justify {
+		Left,
+		Centre,
+		Right,
+		Fully
+	};
+
+	class Style {
+	public:
+		bool operator==(const Style &other) const {
+			return m_fontSize == other.m_fontSize && m_maxWidth == other.m_maxWidth && m_justify == other.m_justify && m_kerning == other.m_kerning &&
+				m_leading == other.m_leading;
+		}
+
+		bool operator!=(const Style &other) const {
+			return !operator==(other);
+		}
+
+		bool operator<(const Style &other) const {
+			return std::tie(m_fontSize, m_maxWidth, m_justify, m_kerning, m_leading) <
+				std::tie(other.m_fontSize, other.m_maxWidth, other.m_justify, other.m_kerning, other.m_leading);
+		}
+
+		// The size of the font in pixels.
+		float m_fontSize = 12.0f;
+		// The width in pixels lines are wrapped at and justified in, lines are not wrapped and are left justified if this is zero.
+		float m_maxWidth = 0.0f;
+		Justify m_justify = Justify::Left;
+		// Space added after each character, as a multiplier of the font size.
+		float m_kerning = 0.0f;
+		// Space added between lines, as a multiplier of the font size.
+		float m_leading = 0.0f;
+	};
+
+	class Glyph {
+	public:
+		// The top left of the glyph quad in pixels from the top left of the text, y is down.
+		Vector2f m_position;
+		Vector2f m_size;
+		uint32_t m_layer = 0;
+	};
+
+	/**
+	 * Lays out a string, lines of the last layout that are before the line with the first changed character are kept.
+	 * @param atlas The atlas to get glyphs from, characters without a glyph are skipped.
+	 * @param string The string, lines are also broken at newlines.
+	 * @param style The style to lay out with, if the style or atlas changed the whole string is laid out.
+	 * @return The index of the first glyph that was laid out, glyphs before it are unchanged.
+	 */
+	std::size_t Update(const GlyphAtlas &atlas, std::wstring_view string, const Style &style);
+
+	const std::wstring &GetString() const { return m_string; }
+	const Style &GetStyle() const { return m_style; }
+	const std::vector<Glyph> &GetGlyphs() const { return m_glyphs; }
+	uint32_t GetLineCount() const { return static_cast<uint32_t>(m_lines.size()); }
+
+	/**
+	 * Gets the size of the text in pixels, the width of the widest line and the height of every line.
+	 * @return The size.
+	 */
+	const Vector2f &GetSize() const { return m_size; }
+
+private:
+	class Line {
+	public:
+		// The first character and glyph of the line.
+		std::size_t m_character;
+		std::size_t m_glyph;
+		float m_width;
+	};
+
+	class Word {
+	public:
+		// The first character of the word, and the range of the words glyphs in the line glyphs.
+		std::size_t m_character;
+		std::size_t m_glyphBegin;
+		std::size_t m_glyphEnd;
+		float m_width;
+	};
+
+	void AddLine(std::size_t character, const std::vector<Word> &words, const std::vector<Glyph> &glyphs, bool wrapped);
+
+	const GlyphAtlas *m_atlas = nullptr;
+	// Glyphs in the atlas when laid out, characters skipped before may have a glyph now.
+	std::size_t m_atlasGlyphs = 0;
+	std::wstring m_string;
+	Style m_style;
+
+	std::vector<Glyph> m_glyphs;
+	std::vector<Line> m_lines;
+	float m_spaceWidth = 0.0f;
+	float m_lineHeight = 0.0f;
+	Vector2f m_size;
+};
+
+/**
+ * @brief Class that shares the layouts of texts with the same string and style.
+ */
+class ACID_EXPORT TextLayoutCache {
+public:
+	/**
+	 * Creates a new layout cache.
+	 * @param capacity The number of layouts kept before layouts no longer used by a text are removed.
+	 */
+	explicit TextLayoutCache(std::size_t capacity = 256);
+
+	/**
+	 * Gets the layout of a string, a layout that is not cached is updated from the previous layout of the text.
+	 * @param atlas The atlas to get glyphs from.
+	 * @param string The string.
+	 * @param style The style to lay out with.
+	 * @param previous The layout held by the text, if no other text holds it it is updated in place, otherwise a copy is updated.
+	 * @return The layout.
+	 */
+	std::shared_ptr<const TextLayout> Get(const GlyphAtlas &atlas, std::wstring_view string, const TextLayout::Style &style,
+		const std::shared_ptr<const TextLayout> &previous = nullptr);
+
+	void Clear() { m_layouts.clear(); }
+	std::size_t GetSize() const { return m_layouts.size(); }
+
+private:
+	using Key = std::pair<std::wstring, TextLayout::Style>;
+	using KeyView = std::pair<std::wstring_view, const TextLayout::Style &>;
+
+	// Compares keys with key views, so finding a layout does not copy its string.
+	class KeyLess {
+	public:
+		using is_transparent = void;
+
+		template<typename A, typename B>
+		bool operator()(const A &a, const B &b) const {
+			return std::tie(a.first, a.second) < std::tie(b.first, b.second);
+		}
+	};
+
+	std::map<Key, std::shared_ptr<TextLayout>, KeyLess> m_layouts;
+	std::size_t m_capacity;
+	// The size the cache is trimmed at.
+	std::size_t m_trimSize;
+};
+}
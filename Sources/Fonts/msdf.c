@@ -861,9 +861,8 @@ float* ex_msdf_glyph(stbtt_fontinfo *font, uint32_t c, size_t w, size_t h, ex_me
       corner_count++;
 
   int *corners = malloc(sizeof(int) * corner_count);
-  int corner_index = 0;
   for (int i=0; i<contour_count; ++i) {
-      
+    int corner_index = 0;
     if (contour_data[i].edge_count > 0) {
       vec2 prev_dir, dir;
       direction(prev_dir, &contour_data[i].edges[contour_data[i].edge_count-1], 1);
@@ -925,10 +924,10 @@ float* ex_msdf_glyph(stbtt_fontinfo *font, uint32_t c, size_t w, size_t h, ex_me
       edge_color_t initial_color = color;
       for (int j=0; j<m; ++j) {
         int index = (start+j)%m;
-        if (spline+1 < corner_count && corners[spline+1] == index) {
+        if (spline+1 < corner_index && corners[spline+1] == index) {
           ++spline;
 
-          edge_color_t s = (edge_color_t)((spline == corner_count-1)*initial_color);
+          edge_color_t s = (edge_color_t)((spline == corner_index-1)*initial_color);
           switch_color(&color, &seed, s);
         }
         contour_data[i].edges[index].color = color;
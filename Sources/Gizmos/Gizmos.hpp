@@ -1,13 +1,14 @@
 #pragma once
 
 #include "Engine/Engine.hpp"
+#include "Scenes/Scenes.hpp"
 #include "Gizmo.hpp"
 
 namespace acid {
 /**
  * @brief Module used for that manages debug gizmos.
  */
-class ACID_EXPORT Gizmos : public Module::Registrar<Gizmos, Module::Stage::Normal> {
+class ACID_EXPORT Gizmos : public Module::Registrar<Gizmos, Module::Stage::Normal, Module::Concurrent, Module::Reads<Scenes>> {
 public:
 	using GizmosContainer = std::map<std::shared_ptr<GizmoType>, std::vector<std::unique_ptr<Gizmo>>>;
 
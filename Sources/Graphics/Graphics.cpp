@@ -1,14 +1,20 @@
 #include "Graphics.hpp"
 
 #include <cstring>
+#include <fstream>
 #include <SPIRV/GlslangToSpv.h>
 
 #include "Devices/Window.hpp"
+#include "Files/Files.hpp"
+#include "Files/Json/Json.hpp"
+#include "Pipelines/PipelineGraphics.hpp"
 #include "Subrender.hpp"
 
 namespace acid {
 Graphics::Graphics() :
 	m_elapsedPurge(5s),
+	m_elapsedPipelineSave(30s),
+	m_shaderCache(std::make_unique<ShaderCache>()),
 	m_instance(std::make_unique<Instance>()),
 	m_physicalDevice(std::make_unique<PhysicalDevice>(m_instance.get())),
 	m_surface(std::make_unique<Surface>(m_instance.get(), m_physicalDevice.get())),
@@ -21,10 +27,13 @@ Graphics::Graphics() :
 Graphics::~Graphics() {
 	auto graphicsQueue = m_logicalDevice->GetGraphicsQueue();
 
+	WaitPipelinePrecreate();
 	CheckVk(vkQueueWaitIdle(graphicsQueue));
+	ReleaseRetired(true);
 
 	glslang::FinalizeProcess();
 
+	SavePipelineCache();
 	vkDestroyPipelineCache(*m_logicalDevice, m_pipelineCache, nullptr);
 
 	for (std::size_t i = 0; i < m_flightFences.size(); i++) {
@@ -45,6 +54,11 @@ void Graphics::Update() {
 		m_renderer->m_started = true;
 	}
 
+	// Pipelines need the render stages, so a manifest is only created once the renderer has started.
+	if (!m_pipelineManifest.empty()) {
+		StartPipelinePrecreate();
+	}
+
 	m_renderer->Update();
 
 	auto acquireResult = m_swapchain->AcquireNextImage(m_presentCompletes[m_currentFrame], m_flightFences[m_currentFrame]);
@@ -59,6 +73,9 @@ void Graphics::Update() {
 		return;
 	}
 
+	// The fence of the frame a swapchain length ago has been waited on.
+	ReleaseRetired(false);
+
 	Pipeline::Stage stage;
 
 	for (auto &renderStage : m_renderer->m_renderStages) {
@@ -85,6 +102,11 @@ void Graphics::Update() {
 		stage.first++;
 	}
 
+	// Saves newly created pipelines, in case the application does not shut down cleanly.
+	if (m_elapsedPipelineSave.GetElapsed() != 0 && m_unsavedPipelines != 0 && !IsPrecreatingPipelines()) {
+		SavePipelineCache();
+	}
+
 	// Purges unused command pools.
 	if (m_elapsedPurge.GetElapsed() != 0) {
 		for (auto it = m_commandPools.begin(); it != m_commandPools.end();) {
@@ -230,13 +252,205 @@ const std::shared_ptr<CommandPool> &Graphics::GetCommandPool(const std::thread::
 	return m_commandPools.emplace(threadId, std::make_shared<CommandPool>(threadId)).first->second;
 }
 
+void Graphics::CreatePipeline(VkGraphicsPipelineCreateInfo pipelineCreateInfo, VkPipeline &pipeline) {
+#if defined(VK_EXT_pipeline_creation_feedback)
+	VkPipelineCreationFeedbackEXT pipelineFeedback = {};
+	// Feedback must be given for every stage.
+	std::vector<VkPipelineCreationFeedbackEXT> stageFeedbacks(pipelineCreateInfo.stageCount);
+	VkPipelineCreationFeedbackCreateInfoEXT feedbackCreateInfo = {};
+
+	if (m_logicalDevice->IsPipelineCreationFeedback()) {
+		feedbackCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO_EXT;
+		feedbackCreateInfo.pNext = pipelineCreateInfo.pNext;
+		feedbackCreateInfo.pPipelineCreationFeedback = &pipelineFeedback;
+		feedbackCreateInfo.pipelineStageCreationFeedbackCount = static_cast<uint32_t>(stageFeedbacks.size());
+		feedbackCreateInfo.pPipelineStageCreationFeedbacks = stageFeedbacks.data();
+		pipelineCreateInfo.pNext = &feedbackCreateInfo;
+	}
+#endif
+
+	CheckVk(vkCreateGraphicsPipelines(*m_logicalDevice, m_pipelineCache, 1, &pipelineCreateInfo, nullptr, &pipeline));
+
+#if defined(VK_EXT_pipeline_creation_feedback)
+	CountPipeline(pipelineFeedback.flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT_EXT,
+		pipelineFeedback.flags & VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT_EXT);
+#else
+	CountPipeline(false, false);
+#endif
+}
+
+void Graphics::CreatePipeline(VkComputePipelineCreateInfo pipelineCreateInfo, VkPipeline &pipeline) {
+#if defined(VK_EXT_pipeline_creation_feedback)
+	VkPipelineCreationFeedbackEXT pipelineFeedback = {};
+	VkPipelineCreationFeedbackEXT stageFeedback = {};
+	VkPipelineCreationFeedbackCreateInfoEXT feedbackCreateInfo = {};
+
+	if (m_logicalDevice->IsPipelineCreationFeedback()) {
+		feedbackCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO_EXT;
+		feedbackCreateInfo.pNext = pipelineCreateInfo.pNext;
+		feedbackCreateInfo.pPipelineCreationFeedback = &pipelineFeedback;
+		feedbackCreateInfo.pipelineStageCreationFeedbackCount = 1;
+		feedbackCreateInfo.pPipelineStageCreationFeedbacks = &stageFeedback;
+		pipelineCreateInfo.pNext = &feedbackCreateInfo;
+	}
+#endif
+
+	CheckVk(vkCreateComputePipelines(*m_logicalDevice, m_pipelineCache, 1, &pipelineCreateInfo, nullptr, &pipeline));
+
+#if defined(VK_EXT_pipeline_creation_feedback)
+	CountPipeline(pipelineFeedback.flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT_EXT,
+		pipelineFeedback.flags & VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT_EXT);
+#else
+	CountPipeline(false, false);
+#endif
+}
+
+void Graphics::SavePipelineCache() {
+	// Taken before reading the data, pipelines created while saving are saved next time.
+	auto unsavedPipelines = m_unsavedPipelines.exchange(0);
+
+	std::size_t dataSize;
+	CheckVk(vkGetPipelineCacheData(*m_logicalDevice, m_pipelineCache, &dataSize, nullptr));
+	std::vector<uint8_t> data(dataSize);
+	CheckVk(vkGetPipelineCacheData(*m_logicalDevice, m_pipelineCache, &dataSize, data.data()));
+
+	if (auto parentPath = m_pipelineCachePath.parent_path(); !parentPath.empty()) {
+		std::filesystem::create_directories(parentPath);
+	}
+
+	std::ofstream os(m_pipelineCachePath, std::ios::binary | std::ios::out);
+
+	if (!os) {
+		Log::Warning("Pipeline cache could not be written to ", m_pipelineCachePath, '\n');
+		m_unsavedPipelines += unsavedPipelines;
+		return;
+	}
+
+	os.write(reinterpret_cast<const char *>(data.data()), dataSize);
+	m_pipelineCacheSavedSize = dataSize;
+
+#if defined(ACID_DEBUG)
+	Log::Out("Pipeline cache saved ", dataSize, " bytes, ", m_pipelineCacheHits, " of ", m_createdPipelines, " pipelines were found in the cache\n");
+#endif
+}
+
+void Graphics::PrecreatePipelines(const std::filesystem::path &manifest) {
+	m_pipelineManifest = manifest;
+}
+
+bool Graphics::IsPrecreatingPipelines() const {
+	return !m_pipelineManifest.empty() ||
+		(m_pipelinePrecreate.valid() && m_pipelinePrecreate.wait_for(std::chrono::seconds(0)) != std::future_status::ready);
+}
+
+PipelineCacheStats Graphics::GetPipelineCacheStats() const {
+	PipelineCacheStats stats;
+	stats.m_pipelines = m_createdPipelines;
+	stats.m_cacheHits = m_pipelineCacheHits;
+	stats.m_feedback = m_logicalDevice->IsPipelineCreationFeedback();
+	stats.m_loadedSize = m_pipelineCacheLoadedSize;
+	stats.m_savedSize = m_pipelineCacheSavedSize;
+	return stats;
+}
+
 void Graphics::CreatePipelineCache() {
+	std::vector<uint8_t> data;
+
+	if (std::ifstream is(m_pipelineCachePath, std::ios::binary | std::ios::ate); is) {
+		data.resize(static_cast<std::size_t>(is.tellg()));
+		is.seekg(0);
+		is.read(reinterpret_cast<char *>(data.data()), data.size());
+	}
+
+	// A cache from another driver or device is ignored by most drivers, but not all, so the header is checked here.
+	if (!data.empty()) {
+		auto &properties = m_physicalDevice->GetProperties();
+		// Header length, header version, vendor ID, device ID, and the cache UUID.
+		uint32_t header[4] = {};
+
+		if (data.size() < sizeof(header) + VK_UUID_SIZE) {
+			data.clear();
+		} else {
+			std::memcpy(header, data.data(), sizeof(header));
+
+			if (header[0] < sizeof(header) + VK_UUID_SIZE || header[1] != VK_PIPELINE_CACHE_HEADER_VERSION_ONE || header[2] != properties.vendorID ||
+				header[3] != properties.deviceID || std::memcmp(data.data() + sizeof(header), properties.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+				Log::Warning("Pipeline cache ", m_pipelineCachePath, " was created by a different device or driver, it will be rebuilt\n");
+				data.clear();
+			}
+		}
+	}
+
 	VkPipelineCacheCreateInfo pipelineCacheCreateInfo = {};
 	pipelineCacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+	pipelineCacheCreateInfo.initialDataSize = data.size();
+	pipelineCacheCreateInfo.pInitialData = data.empty() ? nullptr : data.data();
 	CheckVk(vkCreatePipelineCache(*m_logicalDevice, &pipelineCacheCreateInfo, nullptr, &m_pipelineCache));
+	m_pipelineCacheLoadedSize = data.size();
+}
+
+void Graphics::CountPipeline(bool feedback, bool cacheHit) {
+	++m_createdPipelines;
+	++m_unsavedPipelines;
+
+	if (feedback && cacheHit) {
+		++m_pipelineCacheHits;
+	}
+}
+
+void Graphics::StartPipelinePrecreate() {
+	if (m_pipelinePrecreate.valid()) {
+		return;
+	}
+
+	auto manifest = std::move(m_pipelineManifest);
+	m_pipelineManifest.clear();
+
+	m_pipelinePrecreate = std::async(std::launch::async, [this, manifest]() {
+		auto debugStart = Time::Now();
+
+		auto fileLoaded = Files::Read(manifest);
+
+		if (!fileLoaded) {
+			Log::Error("Pipeline manifest could not be loaded: ", manifest, '\n');
+			return;
+		}
+
+		Json json;
+		json.ParseString(*fileLoaded);
+
+		uint32_t created = 0;
+
+		for (const auto &pipelineNode : json["pipelines"].Get<std::vector<Node>>()) {
+			Pipeline::Stage stage(pipelineNode["renderStage"].Get<uint32_t>(), pipelineNode["subpass"].Get<uint32_t>());
+
+			if (!GetRenderStage(stage.first)) {
+				Log::Warning("Pipeline manifest ", manifest, " references missing render stage ", stage.first, '\n');
+				continue;
+			}
+
+			try {
+				// Only the driver's compiled pipeline is wanted, it stays in the pipeline cache.
+				std::unique_ptr<PipelineGraphics> pipeline(pipelineNode["pipeline"].Get<PipelineGraphicsCreate>().Create(stage));
+				created++;
+			} catch (const std::exception &e) {
+				Log::Error("Pipeline from manifest ", manifest, " could not be created: ", e.what(), '\n');
+			}
+		}
+
+		Log::Out("Pipeline manifest ", manifest, " created ", created, " pipelines in ", (Time::Now() - debugStart).AsMilliseconds<float>(), "ms\n");
+	});
+}
+
+void Graphics::WaitPipelinePrecreate() {
+	if (m_pipelinePrecreate.valid()) {
+		m_pipelinePrecreate.wait();
+	}
 }
 
 void Graphics::ResetRenderStages() {
+	// Pipelines from a manifest reference the render stages being rebuilt.
+	WaitPipelinePrecreate();
 	RecreateSwapchain();
 
 	if (m_flightFences.size() != m_swapchain->GetImageCount()) {
@@ -295,6 +509,8 @@ void Graphics::RecreateCommandBuffers() {
 void Graphics::RecreatePass(RenderStage &renderStage) {
 	auto graphicsQueue = m_logicalDevice->GetGraphicsQueue();
 
+	WaitPipelinePrecreate();
+
 	VkExtent2D displayExtent = {Window::Get()->GetSize().m_x, Window::Get()->GetSize().m_y};
 
 	CheckVk(vkQueueWaitIdle(graphicsQueue));
@@ -380,5 +596,34 @@ void Graphics::EndRenderpass(RenderStage &renderStage) {
 	}
 
 	m_currentFrame = (m_currentFrame + 1) % m_swapchain->GetImageCount();
+	m_frameCount++;
+}
+
+void Graphics::Retire(std::shared_ptr<void> resource) {
+	if (!resource)
+		return;
+
+	std::unique_lock<std::mutex> lock(m_retiredMutex);
+	m_retired.emplace_back(m_frameCount, std::move(resource));
+}
+
+void Graphics::ReleaseRetired(bool all) {
+	std::vector<std::shared_ptr<void>> released;
+
+	{
+		std::unique_lock<std::mutex> lock(m_retiredMutex);
+		auto frameCount = m_swapchain ? m_swapchain->GetImageCount() : 0;
+
+		// A resource retired during a frame may be recorded into that frame, which is done once a full swapchain of frames has been waited on since.
+		auto it = std::partition(m_retired.begin(), m_retired.end(), [&](const auto &retired) {
+			return !all && retired.first + frameCount > m_frameCount;
+		});
+
+		for (auto it1 = it; it1 != m_retired.end(); ++it1)
+			released.emplace_back(std::move(it1->second));
+		m_retired.erase(it, m_retired.end());
+	}
+
+	// Destroyed outside of the lock, destructors may retire more resources.
 }
 }
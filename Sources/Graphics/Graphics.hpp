@@ -7,9 +7,27 @@
 #include "Devices/LogicalDevice.hpp"
 #include "Devices/PhysicalDevice.hpp"
 #include "Devices/Surface.hpp"
+#include "Pipelines/ShaderCache.hpp"
 #include "Renderer.hpp"
 
 namespace acid {
+/**
+ * @brief Statistics of the pipeline cache since startup.
+ */
+class ACID_EXPORT PipelineCacheStats {
+public:
+	// Pipelines created.
+	uint32_t m_pipelines = 0;
+	// Pipelines the driver found in the pipeline cache, only counted when creation feedback is supported.
+	uint32_t m_cacheHits = 0;
+	// If the device reports pipeline cache hits.
+	bool m_feedback = false;
+	// The size of the cache loaded from disk at startup, 0 if there was none or it was rejected.
+	std::size_t m_loadedSize = 0;
+	// The size of the cache when it was last saved.
+	std::size_t m_savedSize = 0;
+};
+
 /**
  * @brief Module that manages the Vulkan instance, Surface, Window and the renderpass structure.
  */
@@ -32,6 +50,44 @@ public:
 
 	const std::shared_ptr<CommandPool> &GetCommandPool(const std::thread::id &threadId = std::this_thread::get_id());
 
+	/**
+	 * Creates a graphics pipeline using the pipeline cache.
+	 * @param pipelineCreateInfo The pipeline create info.
+	 * @param pipeline The created pipeline.
+	 */
+	void CreatePipeline(VkGraphicsPipelineCreateInfo pipelineCreateInfo, VkPipeline &pipeline);
+
+	/**
+	 * Creates a compute pipeline using the pipeline cache.
+	 * @param pipelineCreateInfo The pipeline create info.
+	 * @param pipeline The created pipeline.
+	 */
+	void CreatePipeline(VkComputePipelineCreateInfo pipelineCreateInfo, VkPipeline &pipeline);
+
+	/**
+	 * Writes the pipeline cache to disk so the next run can skip compiling pipelines that were already created.
+	 */
+	void SavePipelineCache();
+
+	/**
+	 * Keeps a buffer, image or descriptor set that is being replaced alive until every frame that may have recorded it has finished on the GPU.
+	 * @param resource The resource to destroy once it is no longer in flight.
+	 */
+	void Retire(std::shared_ptr<void> resource);
+
+	/**
+	 * Creates every graphics pipeline listed in a manifest on a background thread, so the driver compiles them into
+	 * the pipeline cache while a loading screen is shown. Pipelines are created once the renderer has started and are destroyed right after.
+	 * @param manifest The manifest file, a "pipelines" array of objects with a "renderStage", "subpass" and a "pipeline" written by PipelineGraphicsCreate.
+	 */
+	void PrecreatePipelines(const std::filesystem::path &manifest);
+
+	/**
+	 * Gets if pipelines from a manifest are still being created.
+	 * @return If pipelines are being created.
+	 */
+	bool IsPrecreatingPipelines() const;
+
 	/**
 	 * Gets the current renderer.
 	 * @return The renderer.
@@ -49,6 +105,10 @@ public:
 	const Descriptor *GetAttachment(const std::string &name) const;
 	const Swapchain *GetSwapchain() const { return m_swapchain.get(); }
 	const VkPipelineCache &GetPipelineCache() const { return m_pipelineCache; }
+	ShaderCache *GetShaderCache() const { return m_shaderCache.get(); }
+	PipelineCacheStats GetPipelineCacheStats() const;
+	const std::filesystem::path &GetPipelineCachePath() const { return m_pipelineCachePath; }
+	void SetPipelineCachePath(const std::filesystem::path &pipelineCachePath) { m_pipelineCachePath = pipelineCachePath; }
 	void SetFramebufferResized() { m_framebufferResized = true; }
 	const PhysicalDevice *GetPhysicalDevice() const { return m_physicalDevice.get(); }
 	const Surface *GetSurface() const { return m_surface.get(); }
@@ -56,6 +116,10 @@ public:
 
 private:
 	void CreatePipelineCache();
+	void CountPipeline(bool feedback, bool cacheHit);
+	void ReleaseRetired(bool all);
+	void StartPipelinePrecreate();
+	void WaitPipelinePrecreate();
 	void ResetRenderStages();
 	void RecreateSwapchain();
 	void RecreateCommandBuffers();
@@ -72,10 +136,25 @@ private:
 	ElapsedTime m_elapsedPurge;
 
 	VkPipelineCache m_pipelineCache = VK_NULL_HANDLE;
+	std::filesystem::path m_pipelineCachePath = "Cache/PipelineCache.bin";
+	ElapsedTime m_elapsedPipelineSave;
+	// Pipelines created since the cache was last saved.
+	std::atomic<uint32_t> m_unsavedPipelines = 0;
+	std::atomic<uint32_t> m_createdPipelines = 0;
+	std::atomic<uint32_t> m_pipelineCacheHits = 0;
+	std::size_t m_pipelineCacheLoadedSize = 0;
+	std::size_t m_pipelineCacheSavedSize = 0;
+	std::filesystem::path m_pipelineManifest;
+	std::future<void> m_pipelinePrecreate;
+	std::unique_ptr<ShaderCache> m_shaderCache;
 	std::vector<VkSemaphore> m_presentCompletes;
 	std::vector<VkSemaphore> m_renderCompletes;
 	std::vector<VkFence> m_flightFences;
 	std::size_t m_currentFrame = 0;
+	// Frames submitted since startup, resources are retired with the count they were retired at.
+	uint64_t m_frameCount = 0;
+	std::vector<std::pair<uint64_t, std::shared_ptr<void>>> m_retired;
+	std::mutex m_retiredMutex;
 	bool m_framebufferResized = false;
 
 	std::vector<std::unique_ptr<CommandBuffer>> m_commandBuffers;
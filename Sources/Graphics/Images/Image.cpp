@@ -390,6 +390,25 @@ void Image::CopyBufferToImage(const VkBuffer &buffer, const VkImage &image, cons
 	commandBuffer.SubmitIdle();
 }
 
+void Image::CopyBufferToImage(const VkBuffer &buffer, const VkImage &image, const VkExtent3D &extent, const std::vector<VkDeviceSize> &mipOffsets,
+	uint32_t layerCount, uint32_t baseArrayLayer) {
+	CommandBuffer commandBuffer;
+
+	std::vector<VkBufferImageCopy> regions(mipOffsets.size());
+	for (uint32_t i = 0; i < regions.size(); i++) {
+		regions[i].bufferOffset = mipOffsets[i];
+		regions[i].imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		regions[i].imageSubresource.mipLevel = i;
+		regions[i].imageSubresource.baseArrayLayer = baseArrayLayer;
+		regions[i].imageSubresource.layerCount = layerCount;
+		regions[i].imageExtent = {std::max(extent.width >> i, 1u), std::max(extent.height >> i, 1u), std::max(extent.depth >> i, 1u)};
+	}
+
+	vkCmdCopyBufferToImage(commandBuffer, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(regions.size()), regions.data());
+
+	commandBuffer.SubmitIdle();
+}
+
 bool Image::CopyImage(const VkImage &srcImage, VkImage &dstImage, VkDeviceMemory &dstImageMemory, VkFormat srcFormat, const VkExtent3D &extent,
 	VkImageLayout srcImageLayout, uint32_t mipLevel, uint32_t arrayLayer) {
 	auto physicalDevice = Graphics::Get()->GetPhysicalDevice();
@@ -95,6 +95,17 @@ public:
 		VkImageLayout oldImageLayout, VkImageLayout newImageLayout, VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask,
 		VkImageAspectFlags imageAspect, uint32_t mipLevels, uint32_t baseMipLevel, uint32_t layerCount, uint32_t baseArrayLayer);
 	static void CopyBufferToImage(const VkBuffer &buffer, const VkImage &image, const VkExtent3D &extent, uint32_t layerCount, uint32_t baseArrayLayer);
+	/**
+	 * Copies every mip level of an image from a buffer in one command buffer.
+	 * @param buffer The buffer to copy from.
+	 * @param image The image to copy into, must be in the transfer destination layout.
+	 * @param extent The extent of the first mip level.
+	 * @param mipOffsets The offset of each mip level in the buffer.
+	 * @param layerCount The amount of layers to copy.
+	 * @param baseArrayLayer The first layer to copy into.
+	 */
+	static void CopyBufferToImage(const VkBuffer &buffer, const VkImage &image, const VkExtent3D &extent, const std::vector<VkDeviceSize> &mipOffsets,
+		uint32_t layerCount, uint32_t baseArrayLayer);
 	static bool CopyImage(const VkImage &srcImage, VkImage &dstImage, VkDeviceMemory &dstImageMemory, VkFormat srcFormat, const VkExtent3D &extent,
 		VkImageLayout srcImageLayout, uint32_t mipLevel, uint32_t arrayLayer);
 
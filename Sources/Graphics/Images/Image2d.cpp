@@ -28,6 +28,57 @@ std::shared_ptr<Image2d> Image2d::Create(const std::filesystem::path &filename,
 	return Create(node);
 }
 
+std::vector<std::shared_ptr<Image2d>> Image2d::Create(const std::vector<std::filesystem::path> &filenames, VkFilter filter, VkSamplerAddressMode addressMode,
+	bool anisotropic, bool mipmap) {
+	std::vector<std::shared_ptr<Image2d>> results(filenames.size());
+	std::vector<Node> nodes(filenames.size());
+	std::vector<std::filesystem::path> loadFilenames;
+	std::vector<std::size_t> loadIndices;
+
+	for (std::size_t i = 0; i < filenames.size(); i++) {
+		Image2d temp(filenames[i], filter, addressMode, anisotropic, mipmap, false);
+		nodes[i] << temp;
+
+		if (auto resource = Resources::Get()->Find<Image2d>(nodes[i])) {
+			results[i] = resource;
+		} else {
+			loadFilenames.emplace_back(filenames[i]);
+			loadIndices.emplace_back(i);
+		}
+	}
+
+	// Files are read and decoded in parallel, images are created on this thread as they record graphics commands.
+	std::vector<std::unique_ptr<Bitmap>> bitmaps(loadFilenames.size());
+	std::vector<std::unique_ptr<CompressedBitmap>> compressed(loadFilenames.size());
+	Resources::Get()->GetThreadPool().ParallelFor(0, loadFilenames.size(), [&](std::size_t i) {
+		if (loadFilenames[i].extension() == ".ktx2")
+			compressed[i] = std::make_unique<CompressedBitmap>(loadFilenames[i]);
+		else
+			bitmaps[i] = std::make_unique<Bitmap>(loadFilenames[i]);
+	}, 1);
+
+	for (std::size_t i = 0; i < loadIndices.size(); i++) {
+		auto index = loadIndices[i];
+
+		// A file can be listed more than once.
+		if (auto resource = Resources::Get()->Find<Image2d>(nodes[index])) {
+			results[index] = resource;
+			continue;
+		}
+
+		auto result = std::make_shared<Image2d>("");
+		Resources::Get()->Add(nodes[index], std::dynamic_pointer_cast<Resource>(result));
+		nodes[index] >> *result;
+		if (compressed[i])
+			result->LoadCompressed(*compressed[i]);
+		else
+			result->Load(std::move(bitmaps[i]));
+		results[index] = result;
+	}
+
+	return results;
+}
+
 Image2d::Image2d(std::filesystem::path filename, VkFilter filter, VkSamplerAddressMode addressMode, bool anisotropic, bool mipmap, bool load) :
 	Image(filter, addressMode, VK_SAMPLE_COUNT_1_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
 		VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
@@ -94,8 +145,16 @@ Node &operator<<(Node &node, const Image2d &image) {
 
 void Image2d::Load(std::unique_ptr<Bitmap> loadBitmap) {
 	if (!m_filename.empty() && !loadBitmap) {
+		if (m_filename.extension() == ".ktx2") {
+			LoadCompressed(CompressedBitmap(m_filename));
+			return;
+		}
+
 		loadBitmap = std::make_unique<Bitmap>(m_filename);
-		m_extent = {loadBitmap->GetSize().m_y, loadBitmap->GetSize().m_y, 1};
+	}
+
+	if (loadBitmap) {
+		m_extent = {loadBitmap->GetSize().m_x, loadBitmap->GetSize().m_y, 1};
 		m_components = loadBitmap->GetBytesPerPixel();
 	}
 		
@@ -134,4 +193,59 @@ void Image2d::Load(std::unique_ptr<Bitmap> loadBitmap) {
 		TransitionImageLayout(m_image, m_format, VK_IMAGE_LAYOUT_UNDEFINED, m_layout, VK_IMAGE_ASPECT_COLOR_BIT, m_mipLevels, 0, m_arrayLayers, 0);
 	}
 }
+
+void Image2d::LoadCompressed(const CompressedBitmap &compressed) {
+	if (!compressed) {
+		return;
+	}
+
+	m_extent = {compressed.GetSize().m_x, compressed.GetSize().m_y, 1};
+	m_components = 4;
+	// Mip levels come from the file, they are not blitted as compressed formats cannot be blit destinations.
+	m_mipLevels = m_mipmap ? compressed.GetMipLevels() : 1;
+
+	auto format = static_cast<VkFormat>(CompressedBitmap::GetVkFormat(compressed.GetFormat()));
+	auto supported = !BlockCompression::IsCompressed(compressed.GetFormat()) || (Graphics::Get()->GetLogicalDevice()->GetEnabledFeatures().textureCompressionBC &&
+		FindSupportedFormat({format}, VK_IMAGE_TILING_OPTIMAL, VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) == format);
+	m_format = supported ? format : VK_FORMAT_R8G8B8A8_UNORM;
+
+	if (!supported) {
+		Log::Warning("Device cannot sample ", compressed.GetFilename(), " compressed, it will be decoded\n");
+	}
+
+	std::vector<VkDeviceSize> mipOffsets(m_mipLevels);
+	VkDeviceSize length = 0;
+
+	for (uint32_t level = 0; level < m_mipLevels; level++) {
+		mipOffsets[level] = length;
+		length += supported ? compressed.GetLevel(level).size() : BlockCompression::GetLength(BlockCompression::Format::Rgba8, compressed.GetSize(level));
+	}
+
+	Buffer bufferStaging(length, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+	uint8_t *data;
+	bufferStaging.MapMemory(reinterpret_cast<void **>(&data));
+
+	for (uint32_t level = 0; level < m_mipLevels; level++) {
+		const auto &levelData = compressed.GetLevel(level);
+
+		if (supported) {
+			std::memcpy(data + mipOffsets[level], levelData.data(), levelData.size());
+		} else {
+			if (!BlockCompression::Decode(compressed.GetFormat(), levelData.data(), compressed.GetSize(level), data + mipOffsets[level], &Resources::Get()->GetThreadPool()))
+				Log::Error("Image ", compressed.GetFilename(), " level ", level, " has reserved blocks, they are uploaded as magenta\n");
+		}
+	}
+
+	bufferStaging.UnmapMemory();
+
+	CreateImage(m_image, m_memory, m_extent, m_format, m_samples, VK_IMAGE_TILING_OPTIMAL, m_usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+		m_mipLevels, m_arrayLayers, VK_IMAGE_TYPE_2D);
+	CreateImageSampler(m_sampler, m_filter, m_addressMode, m_anisotropic, m_mipLevels);
+	CreateImageView(m_image, m_view, VK_IMAGE_VIEW_TYPE_2D, m_format, VK_IMAGE_ASPECT_COLOR_BIT, m_mipLevels, 0, m_arrayLayers, 0);
+
+	TransitionImageLayout(m_image, m_format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_ASPECT_COLOR_BIT, m_mipLevels, 0, m_arrayLayers, 0);
+	CopyBufferToImage(bufferStaging.GetBuffer(), m_image, m_extent, mipOffsets, m_arrayLayers, 0);
+	TransitionImageLayout(m_image, m_format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, m_layout, VK_IMAGE_ASPECT_COLOR_BIT, m_mipLevels, 0, m_arrayLayers, 0);
+}
 }
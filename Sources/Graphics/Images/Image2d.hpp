@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Bitmaps/Bitmap.hpp"
+#include "Bitmaps/CompressedBitmap.hpp"
 #include "Resources/Resource.hpp"
 #include "Image.hpp"
 
@@ -19,7 +20,7 @@ public:
 
 	/**
 	 * Creates a new 2D image, or finds one with the same values.
-	 * @param filename The file to load the image from.
+	 * @param filename The file to load the image from, ".ktx2" files are uploaded block compressed with the mip levels they contain.
 	 * @param filter The magnification/minification filter to apply to lookups.
 	 * @param addressMode The addressing mode for outside [0..1] range.
 	 * @param anisotropic If anisotropic filtering is enabled.
@@ -29,6 +30,18 @@ public:
 	static std::shared_ptr<Image2d> Create(const std::filesystem::path &filename, VkFilter filter = VK_FILTER_LINEAR,
 		VkSamplerAddressMode addressMode = VK_SAMPLER_ADDRESS_MODE_REPEAT, bool anisotropic = true, bool mipmap = true);
 
+	/**
+	 * Creates new 2D images, or finds ones with the same values. Images that are not found are read and decoded across the resource thread pool.
+	 * @param filenames The files to load the images from.
+	 * @param filter The magnification/minification filter to apply to lookups.
+	 * @param addressMode The addressing mode for outside [0..1] range.
+	 * @param anisotropic If anisotropic filtering is enabled.
+	 * @param mipmap If mapmaps will be generated.
+	 * @return The 2D images in the order of their filenames.
+	 */
+	static std::vector<std::shared_ptr<Image2d>> Create(const std::vector<std::filesystem::path> &filenames, VkFilter filter = VK_FILTER_LINEAR,
+		VkSamplerAddressMode addressMode = VK_SAMPLER_ADDRESS_MODE_REPEAT, bool anisotropic = true, bool mipmap = true);
+
 	/**
 	 * Creates a new 2D image.
 	 * @param filename The file to load the image from.
@@ -98,6 +111,12 @@ public:
 private:
 	void Load(std::unique_ptr<Bitmap> loadBitmap = nullptr);
 
+	/**
+	 * Uploads the mip levels of a compressed bitmap, levels are decoded on the CPU if the device cannot sample the format.
+	 * @param compressed The compressed bitmap.
+	 */
+	void LoadCompressed(const CompressedBitmap &compressed);
+
 	std::filesystem::path m_filename;
 
 	bool m_anisotropic;
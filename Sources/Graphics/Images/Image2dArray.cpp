@@ -74,8 +74,8 @@ Image2dArray::Image2dArray(std::unique_ptr<Bitmap> &&bitmap, uint32_t arrayLayer
 	TransitionImageLayout(m_image, m_format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, m_layout, VK_IMAGE_ASPECT_COLOR_BIT, m_mipLevels, 0, m_arrayLayers, 0);
 }
 
-void Image2dArray::SetPixels(const float *pixels, uint32_t arrayLayer) {
-	Buffer bufferStaging(m_extent.width * m_extent.height * 3, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+void Image2dArray::SetPixels(const uint8_t *pixels, uint32_t layerCount, uint32_t baseArrayLayer) {
+	Buffer bufferStaging(3 * m_extent.width * m_extent.height * layerCount, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
 		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
 
 	void *data;
@@ -83,6 +83,8 @@ void Image2dArray::SetPixels(const float *pixels, uint32_t arrayLayer) {
 	std::memcpy(data, pixels, bufferStaging.GetSize());
 	bufferStaging.UnmapMemory();
 
-	CopyBufferToImage(bufferStaging.GetBuffer(), m_image, m_extent, 1, arrayLayer);
+	TransitionImageLayout(m_image, m_format, m_layout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_ASPECT_COLOR_BIT, m_mipLevels, 0, layerCount, baseArrayLayer);
+	CopyBufferToImage(bufferStaging.GetBuffer(), m_image, m_extent, layerCount, baseArrayLayer);
+	TransitionImageLayout(m_image, m_format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, m_layout, VK_IMAGE_ASPECT_COLOR_BIT, m_mipLevels, 0, layerCount, baseArrayLayer);
 }
 }
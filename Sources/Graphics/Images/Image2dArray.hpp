@@ -43,11 +43,12 @@ public:
 		bool anisotropic = false, bool mipmap = false);
 
 	/**
-	 * Sets the pixels of this image.
-	 * @param pixels The pixels to copy from.
-	 * @param arrayLayer The layer to copy into.
+	 * Sets the pixels of layers of this image.
+	 * @param pixels The pixels to copy from, with the layers one after another.
+	 * @param layerCount The number of layers to copy.
+	 * @param baseArrayLayer The first layer to copy into.
 	 */
-	void SetPixels(const float *pixels, uint32_t arrayLayer);
+	void SetPixels(const uint8_t *pixels, uint32_t layerCount, uint32_t baseArrayLayer);
 
 	bool IsAnisotropic() const { return m_anisotropic; }
 	bool IsMipmap() const { return m_mipmap; }
@@ -108,15 +108,12 @@ void PipelineCompute::CreatePipelineLayout() {
 }
 
 void PipelineCompute::CreatePipelineCompute() {
-	auto logicalDevice = Graphics::Get()->GetLogicalDevice();
-	auto pipelineCache = Graphics::Get()->GetPipelineCache();
-
 	VkComputePipelineCreateInfo pipelineCreateInfo = {};
 	pipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
 	pipelineCreateInfo.stage = m_shaderStageCreateInfo;
 	pipelineCreateInfo.layout = m_pipelineLayout;
 	pipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
 	pipelineCreateInfo.basePipelineIndex = -1;
-	vkCreateComputePipelines(*logicalDevice, pipelineCache, 1, &pipelineCreateInfo, nullptr, &m_pipeline);
+	Graphics::Get()->CreatePipeline(pipelineCreateInfo, m_pipeline);
 }
 }
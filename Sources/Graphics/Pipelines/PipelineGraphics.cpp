@@ -232,8 +232,6 @@ void PipelineGraphics::CreateAttributes() {
 }
 
 void PipelineGraphics::CreatePipeline() {
-	auto logicalDevice = Graphics::Get()->GetLogicalDevice();
-	auto pipelineCache = Graphics::Get()->GetPipelineCache();
 	auto renderStage = Graphics::Get()->GetRenderStage(m_stage.first);
 
 	std::vector<VkVertexInputBindingDescription> bindingDescriptions;
@@ -294,7 +292,7 @@ void PipelineGraphics::CreatePipeline() {
 	pipelineCreateInfo.subpass = m_stage.second;
 	pipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
 	pipelineCreateInfo.basePipelineIndex = -1;
-	Graphics::CheckVk(vkCreateGraphicsPipelines(*logicalDevice, pipelineCache, 1, &pipelineCreateInfo, nullptr, &m_pipeline));
+	Graphics::Get()->CreatePipeline(pipelineCreateInfo, m_pipeline);
 }
 
 void PipelineGraphics::CreatePipelinePolygon() {
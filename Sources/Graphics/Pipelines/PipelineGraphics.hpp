@@ -169,6 +169,7 @@ public:
 		node["defines"].Get(pipelineCreate.m_defines);
 		node["mode"].Get(pipelineCreate.m_mode);
 		node["depth"].Get(pipelineCreate.m_depth);
+		node["topology"].Get(pipelineCreate.m_topology);
 		node["polygonMode"].Get(pipelineCreate.m_polygonMode);
 		node["cullMode"].Get(pipelineCreate.m_cullMode);
 		node["frontFace"].Get(pipelineCreate.m_frontFace);
@@ -182,6 +183,7 @@ public:
 		node["defines"].Set(pipelineCreate.m_defines);
 		node["mode"].Set(pipelineCreate.m_mode);
 		node["depth"].Set(pipelineCreate.m_depth);
+		node["topology"].Set(pipelineCreate.m_topology);
 		node["polygonMode"].Set(pipelineCreate.m_polygonMode);
 		node["cullMode"].Set(pipelineCreate.m_cullMode);
 		node["frontFace"].Set(pipelineCreate.m_frontFace);
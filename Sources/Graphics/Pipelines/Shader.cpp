@@ -12,6 +12,7 @@
 #include "Graphics/Buffers/UniformBuffer.hpp"
 #include "Graphics/Images/Image2d.hpp"
 #include "Graphics/Images/ImageCube.hpp"
+#include "ShaderCache.hpp"
 
 namespace acid {
 class ShaderIncluder :
@@ -19,13 +20,16 @@ class ShaderIncluder :
 public:
 	IncludeResult *includeLocal(const char *headerName, const char *includerName, size_t inclusionDepth) override {
 		auto directory = std::filesystem::path(includerName).parent_path();
-		auto fileLoaded = Files::Read(directory / headerName);
+		auto includePath = directory / headerName;
+		auto fileLoaded = Files::Read(includePath);
 
 		if (!fileLoaded) {
 			Log::Error("Shader Include could not be loaded: ", std::quoted(headerName), '\n');
 			return nullptr;
 		}
 
+		m_includes[includePath.string()] = ShaderCache::HashContents(*fileLoaded);
+
 		auto content = new char[fileLoaded->size()];
 		std::memcpy(content, fileLoaded->c_str(), fileLoaded->size());
 		return new IncludeResult(headerName, content, fileLoaded->size(), content);
@@ -39,6 +43,8 @@ public:
 			return nullptr;
 		}
 
+		m_includes[headerName] = ShaderCache::HashContents(*fileLoaded);
+
 		auto content = new char[fileLoaded->size()];
 		std::memcpy(content, fileLoaded->c_str(), fileLoaded->size());
 		return new IncludeResult(headerName, content, fileLoaded->size(), content);
@@ -50,8 +56,23 @@ public:
 			delete result;
 		}
 	}
+
+	const std::map<std::string, std::string> &GetIncludes() const { return m_includes; }
+
+private:
+	// Every file included, used to invalidate cached stages when a include changes.
+	std::map<std::string, std::string> m_includes;
 };
 
+Shader::Compiler::Compiler() {
+	// The compiler counts how many times it was initialized, so this may overlap with Graphics.
+	glslang::InitializeProcess();
+}
+
+Shader::Compiler::~Compiler() {
+	glslang::FinalizeProcess();
+}
+
 Shader::Shader() {
 }
 
@@ -316,8 +337,41 @@ TBuiltInResource GetResources() {
 VkShaderModule Shader::CreateShaderModule(const std::filesystem::path &moduleName, const std::string &moduleCode, const std::string &preamble, VkShaderStageFlags moduleFlag) {
 	auto logicalDevice = Graphics::Get()->GetLogicalDevice();
 
+	auto spirv = CompileModule(moduleName, moduleCode, preamble, moduleFlag, Graphics::Get()->GetShaderCache());
+
+	VkShaderModuleCreateInfo shaderModuleCreateInfo = {};
+	shaderModuleCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+	shaderModuleCreateInfo.codeSize = spirv.size() * sizeof(uint32_t);
+	shaderModuleCreateInfo.pCode = spirv.data();
+
+	VkShaderModule shaderModule;
+	Graphics::CheckVk(vkCreateShaderModule(*logicalDevice, &shaderModuleCreateInfo, nullptr, &shaderModule));
+	return shaderModule;
+}
+
+std::vector<uint32_t> Shader::CompileModule(const std::filesystem::path &moduleName, const std::string &moduleCode, const std::string &preamble, VkShaderStageFlags moduleFlag,
+	ShaderCache *cache) {
+#if defined(ACID_DEBUG)
+	auto debugStart = Time::Now();
+#endif
+
 	m_stages.emplace_back(moduleName);
 
+	auto cacheKey = ShaderCache::GetKey(moduleCode, preamble, moduleFlag);
+
+	if (cache) {
+		if (auto entry = cache->Load(cacheKey)) {
+			// A cache hit skips glslang entirely.
+			Shader stage;
+			entry->m_reflection >> stage;
+			MergeStage(stage);
+#if defined(ACID_DEBUG)
+			Log::Out("Shader ", moduleName, " loaded from cache in ", (Time::Now() - debugStart).AsMilliseconds<float>(), "ms\n");
+#endif
+			return std::move(entry->m_spirv);
+		}
+	}
+
 	// Starts converting GLSL to SPIR-V.
 	auto language = GetEshLanguage(moduleFlag);
 	glslang::TProgram program;
@@ -345,48 +399,58 @@ VkShaderModule Shader::CreateShaderModule(const std::filesystem::path &moduleNam
 	auto defaultVersion = glslang::EShTargetVulkan_1_1;
 
 	std::string str;
+	// Failed stages are never cached.
+	auto compiled = true;
 
 	if (!shader.preprocess(&resources, defaultVersion, ENoProfile, false, false, messages, &str, includer)) {
 		Log::Out(shader.getInfoLog(), '\n');
 		Log::Out(shader.getInfoDebugLog(), '\n');
 		Log::Error("SPRIV shader preprocess failed!\n");
+		compiled = false;
 	}
 
 	if (!shader.parse(&resources, defaultVersion, true, messages, includer)) {
 		Log::Out(shader.getInfoLog(), '\n');
 		Log::Out(shader.getInfoDebugLog(), '\n');
 		Log::Error("SPRIV shader parse failed!\n");
+		compiled = false;
 	}
 
 	program.addShader(&shader);
 
 	if (!program.link(messages) || !program.mapIO()) {
 		Log::Error("Error while linking shader program.\n");
+		compiled = false;
 	}
 
 	program.buildReflection();
 	//program.dumpReflection();
 
+	// The reflection of this stage is kept separate so it can be cached on its own.
+	Shader stage;
+
 	for (uint32_t dim = 0; dim < 3; ++dim) {
 		auto localSize = program.getLocalSize(dim);
 
 		if (localSize > 1) {
-			m_localSizes[dim] = localSize;
+			stage.m_localSizes[dim] = localSize;
 		}
 	}
 
 	for (int32_t i = program.getNumLiveUniformBlocks() - 1; i >= 0; i--) {
-		LoadUniformBlock(program, moduleFlag, i);
+		stage.LoadUniformBlock(program, moduleFlag, i);
 	}
 
 	for (int32_t i = 0; i < program.getNumLiveUniformVariables(); i++) {
-		LoadUniform(program, moduleFlag, i);
+		stage.LoadUniform(program, moduleFlag, i);
 	}
 
 	for (int32_t i = 0; i < program.getNumLiveAttributes(); i++) {
-		LoadAttribute(program, moduleFlag, i);
+		stage.LoadAttribute(program, moduleFlag, i);
 	}
 
+	MergeStage(stage);
+
 	glslang::SpvOptions spvOptions;
 #if defined(ACID_DEBUG)
 	spvOptions.generateDebugInfo = true;
@@ -402,14 +466,18 @@ VkShaderModule Shader::CreateShaderModule(const std::filesystem::path &moduleNam
 	std::vector<uint32_t> spirv;
 	GlslangToSpv(*program.getIntermediate(static_cast<EShLanguage>(language)), spirv, &logger, &spvOptions);
 
-	VkShaderModuleCreateInfo shaderModuleCreateInfo = {};
-	shaderModuleCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-	shaderModuleCreateInfo.codeSize = spirv.size() * sizeof(uint32_t);
-	shaderModuleCreateInfo.pCode = spirv.data();
+	if (cache && compiled && !spirv.empty()) {
+		ShaderCache::Entry entry;
+		entry.m_spirv = spirv;
+		entry.m_reflection << stage;
+		entry.m_includes = includer.GetIncludes();
+		cache->Store(cacheKey, entry);
+	}
 
-	VkShaderModule shaderModule;
-	Graphics::CheckVk(vkCreateShaderModule(*logicalDevice, &shaderModuleCreateInfo, nullptr, &shaderModule));
-	return shaderModule;
+#if defined(ACID_DEBUG)
+	Log::Out("Shader ", moduleName, " compiled in ", (Time::Now() - debugStart).AsMilliseconds<float>(), "ms\n");
+#endif
+	return spirv;
 }
 
 void Shader::CreateReflection() {
@@ -524,7 +592,19 @@ const Node &operator>>(const Node &node, Shader &shader) {
 	node["uniformBlocks"].Get(shader.m_uniformBlocks);
 	node["attributes"].Get(shader.m_attributes);
 	node["constants"].Get(shader.m_constants);
-	//node["localSizes"].Get(shader.m_localSizes);
+
+	// Unset local sizes are stored as 0, set local sizes are always greater than 1.
+	std::vector<uint32_t> localSizes;
+	node["localSizes"].Get(localSizes);
+
+	for (std::size_t dim = 0; dim < std::min<std::size_t>(localSizes.size(), 3); dim++) {
+		if (localSizes[dim] != 0) {
+			shader.m_localSizes[dim] = localSizes[dim];
+		} else {
+			shader.m_localSizes[dim] = std::nullopt;
+		}
+	}
+
 	return node;
 }
 
@@ -532,8 +612,16 @@ Node &operator<<(Node &node, const Shader &shader) {
 	node["stages"].Set(shader.m_stages);
 	node["uniforms"].Set(shader.m_uniforms);
 	node["uniformBlocks"].Set(shader.m_uniformBlocks);
+	node["attributes"].Set(shader.m_attributes);
 	node["constants"].Set(shader.m_constants);
-	//node["localSizes"].Set(shader.m_localSizes);
+
+	std::vector<uint32_t> localSizes;
+
+	for (const auto &localSize : shader.m_localSizes) {
+		localSizes.emplace_back(localSize.value_or(0));
+	}
+
+	node["localSizes"].Set(localSizes);
 	return node;
 }
 
@@ -551,6 +639,39 @@ void Shader::IncrementDescriptorPool(std::map<VkDescriptorType, uint32_t> &descr
 	}
 }
 
+void Shader::MergeStage(const Shader &stage) {
+	for (const auto &[uniformBlockName, uniformBlock] : stage.m_uniformBlocks) {
+		auto it = m_uniformBlocks.find(uniformBlockName);
+
+		if (it == m_uniformBlocks.end()) {
+			m_uniformBlocks.emplace(uniformBlockName, uniformBlock);
+			continue;
+		}
+
+		it->second.m_stageFlags |= uniformBlock.m_stageFlags;
+		it->second.m_uniforms.insert(uniformBlock.m_uniforms.begin(), uniformBlock.m_uniforms.end());
+	}
+
+	for (const auto &[uniformName, uniform] : stage.m_uniforms) {
+		auto it = m_uniforms.find(uniformName);
+
+		if (it == m_uniforms.end()) {
+			m_uniforms.emplace(uniformName, uniform);
+			continue;
+		}
+
+		it->second.m_stageFlags |= uniform.m_stageFlags;
+	}
+
+	m_attributes.insert(stage.m_attributes.begin(), stage.m_attributes.end());
+
+	for (uint32_t dim = 0; dim < 3; ++dim) {
+		if (stage.m_localSizes[dim]) {
+			m_localSizes[dim] = stage.m_localSizes[dim];
+		}
+	}
+}
+
 void Shader::LoadUniformBlock(const glslang::TProgram &program, VkShaderStageFlags stageFlag, int32_t i) {
 	auto reflection = program.getUniformBlock(i);
 
@@ -11,6 +11,8 @@ class TType;
 }
 
 namespace acid {
+class ShaderCache;
+
 /**
  * @brief Class that loads and processes a shader, and provides a reflection.
  */
@@ -273,6 +275,18 @@ public:
 		int32_t m_glType;
 	};
 
+	/**
+	 * @brief Keeps the GLSL compiler initialized while it exists, {@link Graphics} initializes it so only stages compiled without graphics need one.
+	 */
+	class ACID_EXPORT Compiler {
+	public:
+		Compiler();
+		~Compiler();
+
+		Compiler(const Compiler &) = delete;
+		Compiler &operator=(const Compiler &) = delete;
+	};
+
 	Shader();
 
 	bool ReportedNotFound(const std::string &name, bool reportIfFound) const;
@@ -287,6 +301,18 @@ public:
 	std::optional<VkDescriptorType> GetDescriptorType(uint32_t location) const;
 	static VkShaderStageFlagBits GetShaderStage(const std::filesystem::path &filename);
 	VkShaderModule CreateShaderModule(const std::filesystem::path &moduleName, const std::string &moduleCode, const std::string &preamble, VkShaderStageFlags moduleFlag);
+
+	/**
+	 * Compiles a shader stage to SPIR-V and adds the stages reflection to this shader.
+	 * @param moduleName The stage filename, used to resolve includes.
+	 * @param moduleCode The stage source code.
+	 * @param preamble The defines added to the start of the source.
+	 * @param moduleFlag The stage to compile as.
+	 * @param cache The cache to load the stage from or store it in, may be nullptr.
+	 * @return The SPIR-V code.
+	 */
+	std::vector<uint32_t> CompileModule(const std::filesystem::path &moduleName, const std::string &moduleCode, const std::string &preamble, VkShaderStageFlags moduleFlag,
+		ShaderCache *cache = nullptr);
 	void CreateReflection();
 
 	const std::filesystem::path &GetName() const { return m_stages.back(); }
@@ -304,6 +330,7 @@ public:
 	friend Node &operator<<(Node &node, const Shader &shader);
 
 private:
+	void MergeStage(const Shader &stage);
 	static void IncrementDescriptorPool(std::map<VkDescriptorType, uint32_t> &descriptorPoolCounts, VkDescriptorType type);
 	void LoadUniformBlock(const glslang::TProgram &program, VkShaderStageFlags stageFlag, int32_t i);
 	void LoadUniform(const glslang::TProgram &program, VkShaderStageFlags stageFlag, int32_t i);
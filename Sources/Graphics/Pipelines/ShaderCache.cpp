@@ -0,0 +1,136 @@
+#include "ShaderCache.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <SPIRV/GlslangToSpv.h>
+#include <glslang/Public/ShaderLang.h>
+
+#include "Files/Files.hpp"
+#include "Files/Json/Json.hpp"
+#include "Helpers/Hash.hpp"
+
+namespace acid {
+// Increment when the entry layout or the reflection format changes.
+static constexpr uint32_t CacheVersion = 1;
+static constexpr uint32_t SpirvMagic = 0x07230203;
+
+ShaderCache::ShaderCache(std::filesystem::path directory) :
+	m_directory(std::move(directory)) {
+}
+
+uint64_t ShaderCache::GetKey(std::string_view source, std::string_view preamble, uint32_t stageFlag) {
+	auto hash = HashValue(CacheVersion);
+	hash = HashString(source, hash);
+	hash = HashString(preamble, hash);
+	hash = HashValue(stageFlag, hash);
+
+	// A new compiler may generate different SPIR-V from the same source.
+	hash = HashValue(glslang::GetSpirvGeneratorVersion(), hash);
+	hash = HashString(glslang::GetGlslVersionString(), hash);
+
+	// Debug builds keep debug info and skip the optimizer.
+#if defined(ACID_DEBUG)
+	constexpr bool debug = true;
+#else
+	constexpr bool debug = false;
+#endif
+	return HashValue(debug, hash);
+}
+
+std::string ShaderCache::HashContents(std::string_view string) {
+	std::stringstream stream;
+	stream << std::hex << std::setw(16) << std::setfill('0') << HashString(string);
+	return stream.str();
+}
+
+std::optional<ShaderCache::Entry> ShaderCache::Load(uint64_t key) const {
+	if (!m_enabled) {
+		return std::nullopt;
+	}
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	std::ifstream reflectionStream(GetPath(key, ".json"));
+	std::ifstream spirvStream(GetPath(key, ".spv"), std::ios::binary | std::ios::ate);
+
+	if (!reflectionStream || !spirvStream) {
+		return std::nullopt;
+	}
+
+	Entry entry;
+
+	try {
+		Json json;
+		json.ParseStream(reflectionStream);
+		json["reflection"].Get(entry.m_reflection);
+		json["includes"].Get(entry.m_includes);
+	} catch (const std::exception &e) {
+		Log::Warning("Shader cache entry ", GetPath(key, ".json"), " is corrupt: ", e.what(), '\n');
+		return std::nullopt;
+	}
+
+	// A include that changed since the entry was written would change the compiled code.
+	for (const auto &[includePath, includeHash] : entry.m_includes) {
+		auto fileLoaded = Files::Read(includePath);
+
+		if (!fileLoaded || HashContents(*fileLoaded) != includeHash) {
+			return std::nullopt;
+		}
+	}
+
+	auto size = static_cast<std::size_t>(spirvStream.tellg());
+
+	if (size == 0 || size % sizeof(uint32_t) != 0) {
+		return std::nullopt;
+	}
+
+	entry.m_spirv.resize(size / sizeof(uint32_t));
+	spirvStream.seekg(0);
+	spirvStream.read(reinterpret_cast<char *>(entry.m_spirv.data()), size);
+
+	if (!spirvStream || entry.m_spirv.front() != SpirvMagic) {
+		return std::nullopt;
+	}
+
+	return entry;
+}
+
+void ShaderCache::Store(uint64_t key, const Entry &entry) {
+	if (!m_enabled) {
+		return;
+	}
+
+	// Pipelines may be created on multiple threads.
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	std::error_code error;
+	std::filesystem::create_directories(m_directory, error);
+
+	if (error) {
+		Log::Warning("Shader cache directory ", m_directory, " could not be created: ", error.message(), '\n');
+		return;
+	}
+
+	Json json;
+	json.AddProperty("reflection", Node(entry.m_reflection));
+	json["includes"].Set(entry.m_includes);
+
+	// The SPIR-V is written last, a entry is only loaded if both files exist.
+	std::ofstream reflectionStream(GetPath(key, ".json"));
+	json.WriteStream(reflectionStream);
+
+	std::ofstream spirvStream(GetPath(key, ".spv"), std::ios::binary);
+	spirvStream.write(reinterpret_cast<const char *>(entry.m_spirv.data()), entry.m_spirv.size() * sizeof(uint32_t));
+}
+
+void ShaderCache::Clear() {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	std::error_code error;
+	std::filesystem::remove_all(m_directory, error);
+}
+
+std::filesystem::path ShaderCache::GetPath(uint64_t key, const std::string &extension) const {
+	std::stringstream filename;
+	filename << std::hex << std::setw(16) << std::setfill('0') << key << extension;
+	return m_directory / filename.str();
+}
+}
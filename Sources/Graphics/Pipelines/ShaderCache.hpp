@@ -0,0 +1,81 @@
+#pragma once
+
+#include <mutex>
+
+#include "Files/Node.hpp"
+
+namespace acid {
+/**
+ * @brief Class that persists compiled SPIR-V and the {@link Shader} reflection of a shader stage between runs.
+ * Entries are keyed by a hash of the stage source, defines, stage and compiler version,
+ * and remember the hash of every file included so a changed include invalidates the entry.
+ */
+class ACID_EXPORT ShaderCache {
+public:
+	/**
+	 * @brief A cached shader stage.
+	 */
+	class Entry {
+	public:
+		std::vector<uint32_t> m_spirv;
+		// The reflection of this stage only, in the format written by Shader::operator<<.
+		Node m_reflection;
+		// Every file included while compiling, and the hash of its contents.
+		std::map<std::string, std::string> m_includes;
+	};
+
+	/**
+	 * Creates a new shader cache.
+	 * @param directory The directory entries are stored in, created when the first entry is written.
+	 */
+	explicit ShaderCache(std::filesystem::path directory = "Cache/Shaders");
+
+	/**
+	 * Computes the key for a shader stage.
+	 * @param source The stage source code, before preprocessing.
+	 * @param preamble The preamble containing the stages defines.
+	 * @param stageFlag The stage the source is compiled as.
+	 * @return The key for the stage.
+	 */
+	static uint64_t GetKey(std::string_view source, std::string_view preamble, uint32_t stageFlag);
+
+	/**
+	 * Hashes a string with 64-bit FNV-1a, the result is stable between runs.
+	 * @param string The string to hash.
+	 * @return The hash of the string, formatted as hexadecimal.
+	 */
+	static std::string HashContents(std::string_view string);
+
+	/**
+	 * Loads a entry, entries with a changed include are not loaded.
+	 * @param key The stage key.
+	 * @return The entry, or nullopt if it is not cached or out of date.
+	 */
+	std::optional<Entry> Load(uint64_t key) const;
+
+	/**
+	 * Writes a entry to the cache directory, replacing any existing entry with the same key.
+	 * @param key The stage key.
+	 * @param entry The entry to write.
+	 */
+	void Store(uint64_t key, const Entry &entry);
+
+	/**
+	 * Removes every entry from the cache directory.
+	 */
+	void Clear();
+
+	const std::filesystem::path &GetDirectory() const { return m_directory; }
+	void SetDirectory(const std::filesystem::path &directory) { m_directory = directory; }
+
+	bool IsEnabled() const { return m_enabled; }
+	void SetEnabled(bool enabled) { m_enabled = enabled; }
+
+private:
+	std::filesystem::path GetPath(uint64_t key, const std::string &extension) const;
+
+	std::filesystem::path m_directory;
+	bool m_enabled = true;
+	mutable std::mutex m_mutex;
+};
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace acid {
+// 64-bit FNV-1a, unlike std::hash the result is stable between runs so it may be stored in files.
+static constexpr uint64_t HashOffset = 0xcbf29ce484222325;
+static constexpr uint64_t HashPrime = 0x100000001b3;
+
+/**
+ * Adds one byte to a hash.
+ * @param byte The byte to hash.
+ * @param hash The hash to continue from.
+ * @return The new hash.
+ */
+constexpr uint64_t HashByte(uint8_t byte, uint64_t hash = HashOffset) {
+	return (hash ^ byte) * HashPrime;
+}
+
+/**
+ * Adds bytes to a hash.
+ * @param data The bytes to hash.
+ * @param size The number of bytes.
+ * @param hash The hash to continue from.
+ * @return The new hash.
+ */
+inline uint64_t HashBytes(const void *data, std::size_t size, uint64_t hash = HashOffset) {
+	auto bytes = static_cast<const uint8_t *>(data);
+
+	for (std::size_t i = 0; i < size; i++) {
+		hash = HashByte(bytes[i], hash);
+	}
+
+	return hash;
+}
+
+/**
+ * Adds the bytes of a value to a hash.
+ * @tparam T The value type, it must not contain pointers or padding.
+ * @param value The value to hash.
+ * @param hash The hash to continue from.
+ * @return The new hash.
+ */
+template<typename T>
+uint64_t HashValue(const T &value, uint64_t hash = HashOffset) {
+	static_assert(std::is_trivially_copyable_v<T>, "Only values that are plain bytes can be hashed");
+	return HashBytes(&value, sizeof(T), hash);
+}
+
+/**
+ * Adds a string to a hash, the length is hashed first so concatenated strings can not collide.
+ * @param string The string to hash.
+ * @param hash The hash to continue from.
+ * @return The new hash.
+ */
+inline uint64_t HashString(std::string_view string, uint64_t hash = HashOffset) {
+	hash = HashValue(static_cast<uint64_t>(string.size()), hash);
+	return HashBytes(string.data(), string.size(), hash);
+}
+}
@@ -126,19 +126,38 @@ std::string String::FixEscapedChars(std::string str) {
 }
 
 std::string String::UnfixEscapedChars(std::string str) {
-	static const std::vector<std::pair<std::string_view, char>> replaces = {{"\\n", '\n'}, {"\\r", '\r'}, {"\\t", '\t'}, {"\\\"", '\"'}, {"\\\\", '\\'}};
+	// Decodes in a single pass so a escaped backslash is never read as the start of another escape.
+	auto write = str.begin();
 
-	for (const auto &[from, to] : replaces) {
-		auto pos = str.find(from);
-		while (pos != std::string::npos) {
-			if (pos != 0 && str[pos - 1] == '\\')
-				str.erase(str.begin() + --pos);
-			else
-				str.replace(pos, from.size(), 1, to);
-			pos = str.find(from, pos + 1 + from.size());
+	for (auto read = str.begin(); read != str.end(); ++read) {
+		if (*read != '\\' || read + 1 == str.end()) {
+			*write++ = *read;
+			continue;
+		}
+
+		switch (*++read) {
+		case 'n':
+			*write++ = '\n';
+			break;
+		case 'r':
+			*write++ = '\r';
+			break;
+		case 't':
+			*write++ = '\t';
+			break;
+		case '\"':
+		case '\\':
+			*write++ = *read;
+			break;
+		default:
+			// Unknown escapes are kept as written.
+			*write++ = '\\';
+			*write++ = *read;
+			break;
 		}
 	}
 
+	str.erase(write, str.end());
 	return str;
 }
 
@@ -1,36 +1,58 @@
 #include "ThreadPool.hpp"
 
 namespace acid {
-ThreadPool::ThreadPool(uint32_t threadCount) {
-	m_workers.reserve(threadCount);
+// The pool and worker index of the current thread, set for worker threads only.
+static thread_local ThreadPool *CurrentPool = nullptr;
+static thread_local uint32_t CurrentWorker = 0;
 
-	for (std::size_t i = 0; i < threadCount; ++i) {
-		m_workers.emplace_back([this] {
-			while (true) {
-				std::function<void()> task;
+// How many times an idle worker looks for work before going to sleep.
+static constexpr uint32_t IdleSpins = 64;
 
-				{
-					std::unique_lock<std::mutex> lock(m_queueMutex);
-					m_condition.wait(lock, [this] {
-						return m_stop || !m_tasks.empty();
-					});
+Job *ThreadPool::JobAllocator::Allocate(uint32_t index) {
+	if (!m_free)
+		m_free = m_returned.exchange(nullptr, std::memory_order_acquire);
 
-					if (m_stop && m_tasks.empty())
-						return;
+	if (!m_free) {
+		auto &chunk = m_chunks.emplace_back(std::make_unique<Job[]>(ChunkSize));
 
-					task = std::move(m_tasks.front());
-					m_tasks.pop();
-				}
+		for (std::size_t i = 0; i < ChunkSize; i++) {
+			chunk[i].m_allocator = index;
+			chunk[i].m_next = i + 1 < ChunkSize ? &chunk[i + 1] : nullptr;
+		}
 
-				task();
-			}
+		m_free = &chunk[0];
+	}
+
+	auto job = m_free;
+	m_free = job->m_next;
+	return job;
+}
+
+void ThreadPool::JobAllocator::Free(Job *job) {
+	auto head = m_returned.load(std::memory_order_relaxed);
+
+	do {
+		job->m_next = head;
+	} while (!m_returned.compare_exchange_weak(head, job, std::memory_order_release, std::memory_order_relaxed));
+}
+
+ThreadPool::ThreadPool(uint32_t threadCount) {
+	m_workers.reserve(threadCount);
+	m_workerStates.reserve(threadCount);
+
+	for (uint32_t i = 0; i < threadCount; ++i)
+		m_workerStates.emplace_back(std::make_unique<Worker>());
+
+	for (uint32_t i = 0; i < threadCount; ++i) {
+		m_workers.emplace_back([this, i] {
+			WorkerLoop(i);
 		});
 	}
 }
 
 ThreadPool::~ThreadPool() {
 	{
-		std::unique_lock<std::mutex> lock(m_queueMutex);
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
 		m_stop = true;
 	}
 
@@ -40,11 +62,190 @@ ThreadPool::~ThreadPool() {
 		worker.join();
 }
 
+void ThreadPool::Wait(const JobCounter &counter) {
+	while (!counter.IsDone()) {
+		if (auto job = FindJob()) {
+			Execute(job);
+			continue;
+		}
+
+		std::this_thread::yield();
+	}
+
+	if (counter.m_failed.load(std::memory_order_acquire))
+		std::rethrow_exception(counter.m_exception);
+}
+
 void ThreadPool::Wait() {
-	std::unique_lock<std::mutex> lock(m_queueMutex);
+	while (m_unfinished.load(std::memory_order_acquire) > 0) {
+		if (auto job = FindJob()) {
+			Execute(job);
+			continue;
+		}
+
+		// Nothing left to help with, sleep until running jobs finish or new jobs appear.
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+		m_finishedCondition.wait_for(lock, std::chrono::milliseconds(1), [this] {
+			return m_unfinished.load(std::memory_order_acquire) == 0;
+		});
+	}
+
+	std::exception_ptr exception;
+	{
+		std::unique_lock<std::mutex> lock(m_exceptionMutex);
+		std::swap(exception, m_exception);
+	}
+
+	if (exception)
+		std::rethrow_exception(exception);
+}
+
+std::size_t ThreadPool::GetGrainSize(std::size_t count, std::size_t grainSize) const {
+	if (grainSize != 0)
+		return grainSize;
+
+	// Several chunks per worker leaves room for stealing to balance uneven work.
+	auto chunks = 4 * std::max<std::size_t>(m_workers.size(), 1);
+	return std::max<std::size_t>((count + chunks - 1) / chunks, 1);
+}
+
+ThreadPool::JobAllocator &ThreadPool::GetAllocator(uint32_t index) {
+	if (index < m_workerStates.size())
+		return m_workerStates[index]->allocator;
+	return m_injectorAllocator;
+}
+
+Job *ThreadPool::AllocateJob() {
+	if (CurrentPool == this)
+		return m_workerStates[CurrentWorker]->allocator.Allocate(CurrentWorker);
+
+	if (m_stop)
+		throw std::runtime_error("Enqueue called on a stopped ThreadPool");
+
+	std::unique_lock<std::mutex> lock(m_injectorMutex);
+	return m_injectorAllocator.Allocate(static_cast<uint32_t>(m_workerStates.size()));
+}
+
+void ThreadPool::PushJob(Job *job) {
+	m_unfinished.fetch_add(1, std::memory_order_relaxed);
+	m_queued.fetch_add(1, std::memory_order_seq_cst);
 
-	m_condition.wait(lock, [this]() {
-		return m_tasks.empty();
-	});
+	if (CurrentPool != this || !m_workerStates[CurrentWorker]->queue.push(job)) {
+		std::unique_lock<std::mutex> lock(m_injectorMutex);
+		m_injector.emplace_back(job);
+		m_injectorSize.fetch_add(1, std::memory_order_release);
+	}
+
+	if (m_sleeping.load(std::memory_order_seq_cst) > 0) {
+		// Taking the lock orders this notify after a worker that is about to sleep has started waiting.
+		{
+			std::unique_lock<std::mutex> lock(m_sleepMutex);
+		}
+		m_condition.notify_one();
+	}
+}
+
+Job *ThreadPool::FindJob() {
+	Job *job = nullptr;
+	auto isWorker = CurrentPool == this;
+
+	if (isWorker) {
+		if (auto popped = m_workerStates[CurrentWorker]->queue.pop())
+			job = *popped;
+	}
+
+	if (!job && m_injectorSize.load(std::memory_order_acquire) > 0) {
+		std::unique_lock<std::mutex> lock(m_injectorMutex);
+
+		if (!m_injector.empty()) {
+			job = m_injector.front();
+			m_injector.pop_front();
+			m_injectorSize.fetch_sub(1, std::memory_order_release);
+		}
+	}
+
+	if (!job) {
+		auto workerCount = static_cast<uint32_t>(m_workerStates.size());
+		auto start = isWorker ? CurrentWorker + 1 : 0;
+
+		for (uint32_t i = 0; i < workerCount; i++) {
+			auto victim = (start + i) % workerCount;
+
+			if (isWorker && victim == CurrentWorker)
+				continue;
+
+			if (auto stolen = m_workerStates[victim]->queue.steal()) {
+				job = *stolen;
+				break;
+			}
+		}
+	}
+
+	if (job)
+		m_queued.fetch_sub(1, std::memory_order_relaxed);
+
+	return job;
+}
+
+void ThreadPool::Execute(Job *job) {
+	auto counter = job->m_counter;
+
+	// A throwing job still finishes, so waiters and workers are never left waiting on it.
+	try {
+		job->Run();
+	} catch (...) {
+		if (!counter) {
+			std::unique_lock<std::mutex> lock(m_exceptionMutex);
+			if (!m_exception)
+				m_exception = std::current_exception();
+		} else if (!counter->m_failed.exchange(true, std::memory_order_relaxed)) {
+			counter->m_exception = std::current_exception();
+		}
+	}
+
+	GetAllocator(job->m_allocator).Free(job);
+
+	// The counter may be destroyed by its waiter as soon as it reaches zero.
+	if (counter)
+		counter->m_count.fetch_sub(1, std::memory_order_acq_rel);
+
+	if (m_unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+		{
+			std::unique_lock<std::mutex> lock(m_sleepMutex);
+		}
+		m_finishedCondition.notify_all();
+	}
+}
+
+void ThreadPool::WorkerLoop(uint32_t index) {
+	CurrentPool = this;
+	CurrentWorker = index;
+
+	uint32_t spins = 0;
+
+	while (true) {
+		if (auto job = FindJob()) {
+			Execute(job);
+			spins = 0;
+			continue;
+		}
+
+		if (++spins < IdleSpins) {
+			std::this_thread::yield();
+			continue;
+		}
+
+		spins = 0;
+
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+		m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+		m_condition.wait(lock, [this] {
+			return m_stop || m_queued.load(std::memory_order_seq_cst) > 0;
+		});
+		m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+
+		if (m_stop && m_queued.load(std::memory_order_acquire) <= 0)
+			return;
+	}
 }
 }
@@ -1,59 +1,328 @@
 #pragma once
 
-#include <thread>
-#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
 #include <functional>
-#include <mutex>
-#include <queue>
 #include <future>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
 
-#include "Export.hpp"
+#include "NonCopyable.hpp"
+#include "WorkStealingQueue.hpp"
 
 namespace acid {
+class ThreadPool;
+
+/**
+ * @brief Counts unfinished jobs so a group of jobs can be waited on together, used for fork-join parallelism.
+ */
+class ACID_EXPORT JobCounter : NonCopyable {
+	friend class ThreadPool;
+public:
+	JobCounter() = default;
+
+	/**
+	 * Gets if every job submitted with this counter has finished.
+	 * @return If all jobs have finished.
+	 */
+	bool IsDone() const { return m_count.load(std::memory_order_acquire) == 0; }
+
+private:
+	std::atomic<uint32_t> m_count = 0;
+	// The first exception thrown by a job, written before the count is decremented and rethrown by the waiter.
+	std::atomic<bool> m_failed = false;
+	std::exception_ptr m_exception;
+};
+
+/**
+ * @brief A unit of work for a {@link ThreadPool}. Small callables are stored inline,
+ * and jobs are recycled by the worker that allocated them, so submitting a job does not allocate.
+ */
+class ACID_EXPORT Job : NonCopyable {
+	friend class ThreadPool;
+public:
+	// Callables up to this size are stored without allocating.
+	static constexpr std::size_t StorageSize = 64;
+
+	Job() = default;
+
+private:
+	template<typename F>
+	void Set(F &&f);
+
+	void Run() {
+		// The callable is destroyed even if it throws.
+		struct Destroy {
+			~Destroy() { job->m_destroy(&job->m_storage); }
+			Job *job;
+		} destroy{this};
+		m_invoke(&m_storage);
+	}
+
+	std::aligned_storage_t<StorageSize, alignof(std::max_align_t)> m_storage;
+	void (*m_invoke)(void *) = nullptr;
+	void (*m_destroy)(void *) = nullptr;
+	JobCounter *m_counter = nullptr;
+	Job *m_next = nullptr;
+	// Index of the allocator that owns this job, the worker index or the worker count for the injector.
+	uint32_t m_allocator = 0;
+};
+
 /**
- * @brief A fixed size pool of threads.
+ * @brief A fixed size pool of threads. Each worker owns a lock-free deque and idle workers steal from each other,
+ * jobs submitted from outside the pool go through a shared injection queue.
  */
-class ACID_EXPORT ThreadPool {
+class ACID_EXPORT ThreadPool : NonCopyable {
 public:
 	explicit ThreadPool(uint32_t threadCount = std::thread::hardware_concurrency());
-	
+
 	~ThreadPool();
 
+	/**
+	 * Runs a function on the pool and returns a future to its result.
+	 * @tparam F The function type.
+	 * @tparam Args The function argument types.
+	 * @param f The function to run.
+	 * @param args The arguments bound to the function.
+	 * @return A future to the functions return value.
+	 */
 	template<typename F, typename... Args>
 	decltype(auto) Enqueue(F &&f, Args &&... args);
 
+	/**
+	 * Submits a job to the pool.
+	 * @tparam F The callable type, called with no arguments.
+	 * @param f The callable to run.
+	 * @param counter The counter to increment until the job has finished, may be nullptr.
+	 */
+	template<typename F>
+	void Submit(F &&f, JobCounter *counter = nullptr);
+
+	/**
+	 * Waits for every job submitted with a counter to finish, running pending jobs on this thread while waiting.
+	 * Rethrows the first exception thrown by one of the counters jobs.
+	 * @param counter The counter to wait on.
+	 */
+	void Wait(const JobCounter &counter);
+
+	/**
+	 * Waits for every submitted job to finish, including jobs that are currently running.
+	 * Rethrows the first exception thrown by a job submitted without a counter since the last wait.
+	 */
 	void Wait();
 
+	/**
+	 * Calls a function for every index in a range, split into chunks across the pool. Returns once every index is done.
+	 * @tparam F The function type, called with a index.
+	 * @param begin The first index.
+	 * @param end One past the last index.
+	 * @param f The function to call.
+	 * @param grainSize The number of indices per job, 0 picks a size from the worker count.
+	 */
+	template<typename F>
+	void ParallelFor(std::size_t begin, std::size_t end, F &&f, std::size_t grainSize = 0);
+
+	/**
+	 * Calls a function for every chunk of a range across the pool. Returns once every chunk is done.
+	 * @tparam F The function type, called with the chunks begin and end index.
+	 * @param begin The first index.
+	 * @param end One past the last index.
+	 * @param f The function to call.
+	 * @param grainSize The number of indices per job, 0 picks a size from the worker count.
+	 */
+	template<typename F>
+	void ParallelForRange(std::size_t begin, std::size_t end, F &&f, std::size_t grainSize = 0);
+
+	/**
+	 * Maps every index in a range to a value and reduces the values across the pool.
+	 * @tparam T The value type.
+	 * @tparam Map The map function type, called with a index and returns a T.
+	 * @tparam Reduce The reduce function type, called with two T's and returns a T.
+	 * @param begin The first index.
+	 * @param end One past the last index.
+	 * @param identity The identity value for the reduction.
+	 * @param map The map function.
+	 * @param reduce The reduce function, must be associative.
+	 * @param grainSize The number of indices per job, 0 picks a size from the worker count.
+	 * @return The reduced value.
+	 */
+	template<typename T, typename Map, typename Reduce>
+	T ParallelReduce(std::size_t begin, std::size_t end, T identity, Map &&map, Reduce &&reduce, std::size_t grainSize = 0);
+
 	const std::vector<std::thread> &GetWorkers() const { return m_workers; }
 
 private:
+	/**
+	 * @brief Hands out recycled jobs, jobs can be returned from any thread.
+	 */
+	class JobAllocator {
+	public:
+		static constexpr std::size_t ChunkSize = 256;
+
+		Job *Allocate(uint32_t index);
+		void Free(Job *job);
+
+	private:
+		std::vector<std::unique_ptr<Job[]>> m_chunks;
+		Job *m_free = nullptr;
+		// Jobs returned by any thread, taken all at once by the owner so there is no ABA problem.
+		std::atomic<Job *> m_returned = nullptr;
+	};
+
+	class Worker {
+	public:
+		WorkStealingQueue<Job *> queue;
+		JobAllocator allocator;
+	};
+
+	JobAllocator &GetAllocator(uint32_t index);
+	Job *AllocateJob();
+	void PushJob(Job *job);
+	Job *FindJob();
+	void Execute(Job *job);
+	void WorkerLoop(uint32_t index);
+	std::size_t GetGrainSize(std::size_t count, std::size_t grainSize) const;
+
 	std::vector<std::thread> m_workers;
-	std::queue<std::function<void()>> m_tasks;
+	std::vector<std::unique_ptr<Worker>> m_workerStates;
+
+	// Jobs submitted from threads outside of the pool.
+	std::deque<Job *> m_injector;
+	std::atomic<std::size_t> m_injectorSize = 0;
+	std::mutex m_injectorMutex;
+	JobAllocator m_injectorAllocator;
 
-	std::mutex m_queueMutex;
+	// Jobs waiting in any queue, used to put idle workers to sleep.
+	std::atomic<int64_t> m_queued = 0;
+	// Jobs submitted and not yet finished.
+	std::atomic<int64_t> m_unfinished = 0;
+	// The first exception thrown by a job without a counter.
+	std::mutex m_exceptionMutex;
+	std::exception_ptr m_exception;
+	std::atomic<uint32_t> m_sleeping = 0;
+
+	std::mutex m_sleepMutex;
 	std::condition_variable m_condition;
-	bool m_stop = false;
+	std::condition_variable m_finishedCondition;
+	std::atomic<bool> m_stop = false;
 };
 
+template<typename F>
+void Job::Set(F &&f) {
+	using Callable = std::decay_t<F>;
+
+	if constexpr (sizeof(Callable) <= StorageSize && alignof(Callable) <= alignof(std::max_align_t)) {
+		new(&m_storage) Callable(std::forward<F>(f));
+		m_invoke = [](void *storage) {
+			(*std::launder(reinterpret_cast<Callable *>(storage)))();
+		};
+		m_destroy = [](void *storage) {
+			std::launder(reinterpret_cast<Callable *>(storage))->~Callable();
+		};
+	} else {
+		// Large callables fall back to the heap.
+		new(&m_storage) Callable *(new Callable(std::forward<F>(f)));
+		m_invoke = [](void *storage) {
+			(**std::launder(reinterpret_cast<Callable **>(storage)))();
+		};
+		m_destroy = [](void *storage) {
+			delete *std::launder(reinterpret_cast<Callable **>(storage));
+		};
+	}
+}
+
 template<typename F, typename ... Args>
 decltype(auto) ThreadPool::Enqueue(F &&f, Args &&... args) {
 	using return_type = typename std::result_of<F(Args ...)>::type;
 
-	auto task = std::make_shared<std::packaged_task<return_type()>>(std::bind(std::forward<F>(f), std::forward<Args>(args)...));
-	auto result = task->get_future();
+	std::packaged_task<return_type()> task(std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+	auto result = task.get_future();
+
+	Submit([task = std::move(task)]() mutable {
+		task();
+	});
+	return result;
+}
 
-	{
-		std::unique_lock<std::mutex> lock(m_queueMutex);
+template<typename F>
+void ThreadPool::Submit(F &&f, JobCounter *counter) {
+	auto job = AllocateJob();
+	job->Set(std::forward<F>(f));
+	job->m_counter = counter;
 
-		if (m_stop)
-			throw std::runtime_error("Enqueue called on a stopped ThreadPool");
+	if (counter)
+		counter->m_count.fetch_add(1, std::memory_order_relaxed);
+
+	PushJob(job);
+}
 
-		m_tasks.emplace([task]() {
-			(*task)();
-		});
+template<typename F>
+void ThreadPool::ParallelFor(std::size_t begin, std::size_t end, F &&f, std::size_t grainSize) {
+	ParallelForRange(begin, end, [&f](std::size_t rangeBegin, std::size_t rangeEnd) {
+		for (auto i = rangeBegin; i < rangeEnd; i++)
+			f(i);
+	}, grainSize);
+}
+
+template<typename F>
+void ThreadPool::ParallelForRange(std::size_t begin, std::size_t end, F &&f, std::size_t grainSize) {
+	if (begin >= end)
+		return;
+
+	grainSize = GetGrainSize(end - begin, grainSize);
+	JobCounter counter;
+
+	for (auto rangeBegin = begin + grainSize; rangeBegin < end; rangeBegin += grainSize) {
+		auto rangeEnd = std::min(rangeBegin + grainSize, end);
+		Submit([&f, rangeBegin, rangeEnd]() {
+			f(rangeBegin, rangeEnd);
+		}, &counter);
 	}
 
-	m_condition.notify_one();
+	// The first chunk runs on the calling thread, the other chunks reference the counter so they are waited on even if it throws.
+	std::exception_ptr exception;
+
+	try {
+		f(begin, std::min(begin + grainSize, end));
+	} catch (...) {
+		exception = std::current_exception();
+	}
+
+	Wait(counter);
+
+	if (exception)
+		std::rethrow_exception(exception);
+}
+
+template<typename T, typename Map, typename Reduce>
+T ThreadPool::ParallelReduce(std::size_t begin, std::size_t end, T identity, Map &&map, Reduce &&reduce, std::size_t grainSize) {
+	if (begin >= end)
+		return identity;
+
+	grainSize = GetGrainSize(end - begin, grainSize);
+	auto chunkCount = (end - begin + grainSize - 1) / grainSize;
+	std::vector<T> partials(chunkCount, identity);
+
+	ParallelFor(0, chunkCount, [&](std::size_t chunk) {
+		auto rangeBegin = begin + chunk * grainSize;
+		auto rangeEnd = std::min(rangeBegin + grainSize, end);
+		auto value = identity;
+
+		for (auto i = rangeBegin; i < rangeEnd; i++)
+			value = reduce(value, map(i));
+
+		partials[chunk] = value;
+	}, 1);
+
+	auto result = identity;
+	for (const auto &partial : partials)
+		result = reduce(result, partial);
 	return result;
 }
 }
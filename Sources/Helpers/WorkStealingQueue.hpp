@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+
+#include "NonCopyable.hpp"
+
+namespace acid {
+/**
+ * @brief A constant-sized lock-free Chase-Lev deque. The owning thread pushes and pops from the bottom,
+ * any other thread may steal from the top.
+ * @tparam T The trivially copyable type to hold.
+ */
+template<typename T>
+class WorkStealingQueue : NonCopyable {
+	static_assert(std::is_trivially_copyable_v<T>, "WorkStealingQueue values must be trivially copyable");
+public:
+	explicit WorkStealingQueue(std::size_t capacity = 4096) :
+		m_capacity(capacity),
+		m_mask(capacity - 1),
+		m_data(std::make_unique<std::atomic<T>[]>(capacity)) {
+		if (capacity == 0 || (capacity & m_mask) != 0) {
+			throw std::runtime_error("Capacity must be a non-zero power of two");
+		}
+	}
+
+	std::size_t capacity() const { return m_capacity; }
+
+	bool empty() const {
+		return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * Pushes a value onto the bottom, only called from the owning thread.
+	 * @param value The value to push.
+	 * @return If the value was pushed, false when the queue is full.
+	 */
+	bool push(T value) {
+		auto bottom = m_bottom.load(std::memory_order_relaxed);
+		auto top = m_top.load(std::memory_order_acquire);
+
+		if (bottom - top >= static_cast<int64_t>(m_capacity)) {
+			return false;
+		}
+
+		m_data[bottom & m_mask].store(value, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	/**
+	 * Pops the most recently pushed value, only called from the owning thread.
+	 * @return The value, or nullopt if the queue is empty or the last value was stolen.
+	 */
+	std::optional<T> pop() {
+		auto bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+		m_bottom.store(bottom, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		auto top = m_top.load(std::memory_order_relaxed);
+
+		if (top > bottom) {
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			return std::nullopt;
+		}
+
+		auto value = m_data[bottom & m_mask].load(std::memory_order_relaxed);
+
+		if (top == bottom) {
+			// Last value, race any thieves for it.
+			auto won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+
+			if (!won) {
+				return std::nullopt;
+			}
+		}
+
+		return value;
+	}
+
+	/**
+	 * Steals the oldest value, may be called from any thread.
+	 * @return The value, or nullopt if the queue is empty or another thread won the race.
+	 */
+	std::optional<T> steal() {
+		auto top = m_top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		auto bottom = m_bottom.load(std::memory_order_acquire);
+
+		if (top >= bottom) {
+			return std::nullopt;
+		}
+
+		auto value = m_data[top & m_mask].load(std::memory_order_relaxed);
+
+		if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			return std::nullopt;
+		}
+
+		return value;
+	}
+
+private:
+	std::size_t m_capacity;
+	std::size_t m_mask;
+	std::unique_ptr<std::atomic<T>[]> m_data;
+
+	// Top and bottom are kept on separate cache lines, thieves only write the top.
+	alignas(64) std::atomic<int64_t> m_top = 0;
+	alignas(64) std::atomic<int64_t> m_bottom = 0;
+};
+}
@@ -5,8 +5,46 @@
 
 #include "Matrix2.hpp"
 #include "Matrix3.hpp"
+#include "Simd.hpp"
 
 namespace acid {
+using namespace simd;
+
+static Float4 Load(const Vector4f &vector) {
+	return simd::Load(&vector.m_x);
+}
+
+static void Store(Vector4f &vector, Float4 value) {
+	simd::Store(&vector.m_x, value);
+}
+
+// Each row of the result is the rows of left weighted by the same row of right, left is loaded and each row of right is read before it is written, so result may be either matrix.
+static void MultiplyRows(const Vector4f *left, const Vector4f *right, Vector4f *result) {
+#if defined(ACID_SIMD_AVX)
+	// Two rows of the result at a time, the rows of left are repeated in both halves of a register.
+	auto left0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&left[0].m_x));
+	auto left1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&left[1].m_x));
+	auto left2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&left[2].m_x));
+	auto left3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&left[3].m_x));
+
+	for (uint32_t row = 0; row < 4; row += 2) {
+		auto weights = _mm256_loadu_ps(&right[row].m_x);
+		auto sum = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+			_mm256_mul_ps(left0, _mm256_shuffle_ps(weights, weights, _MM_SHUFFLE(0, 0, 0, 0))),
+			_mm256_mul_ps(left1, _mm256_shuffle_ps(weights, weights, _MM_SHUFFLE(1, 1, 1, 1)))),
+			_mm256_mul_ps(left2, _mm256_shuffle_ps(weights, weights, _MM_SHUFFLE(2, 2, 2, 2)))),
+			_mm256_mul_ps(left3, _mm256_shuffle_ps(weights, weights, _MM_SHUFFLE(3, 3, 3, 3))));
+		_mm256_storeu_ps(&result[row].m_x, sum);
+	}
+#else
+	auto left0 = Load(left[0]), left1 = Load(left[1]), left2 = Load(left[2]), left3 = Load(left[3]);
+
+	for (uint32_t row = 0; row < 4; row++) {
+		Store(result[row], Combine(left0, left1, left2, left3, right[row].m_x, right[row].m_y, right[row].m_z, right[row].m_w));
+	}
+#endif
+}
+
 Matrix4::Matrix4(float diagonal) {
 	std::memset(m_rows, 0, 4 * sizeof(Vector4f));
 	m_rows[0][0] = diagonal;
@@ -40,9 +78,7 @@ Matrix4 Matrix4::Add(const Matrix4 &other) const {
 	Matrix4 result;
 
 	for (uint32_t row = 0; row < 4; row++) {
-		for (uint32_t col = 0; col < 4; col++) {
-			result[row][col] = m_rows[row][col] + other[row][col];
-		}
+		Store(result[row], simd::Add(Load(m_rows[row]), Load(other[row])));
 	}
 
 	return result;
@@ -52,9 +88,7 @@ Matrix4 Matrix4::Subtract(const Matrix4 &other) const {
 	Matrix4 result;
 
 	for (uint32_t row = 0; row < 4; row++) {
-		for (uint32_t col = 0; col < 4; col++) {
-			result[row][col] = m_rows[row][col] - other[row][col];
-		}
+		Store(result[row], simd::Subtract(Load(m_rows[row]), Load(other[row])));
 	}
 
 	return result;
@@ -62,24 +96,18 @@ Matrix4 Matrix4::Subtract(const Matrix4 &other) const {
 
 Matrix4 Matrix4::Multiply(const Matrix4 &other) const {
 	Matrix4 result;
-
-	for (uint32_t row = 0; row < 4; row++) {
-		for (uint32_t col = 0; col < 4; col++) {
-			result[row][col] = m_rows[0][col] * other[row][0] + m_rows[1][col] * other[row][1] + m_rows[2][col] * other[row][2] + m_rows[3][col] * other[row][3];
-		}
-	}
-
+	MultiplyRows(m_rows, other.m_rows, result.m_rows);
 	return result;
 }
 
 Vector4f Matrix4::Multiply(const Vector4f &other) const {
-	Vector4f result;
+	return Transform(other);
+}
 
-	for (uint32_t row = 0; row < 4; row++) {
-		result[row] = m_rows[0][row] * other.m_x + m_rows[1][row] * other.m_y + m_rows[2][row] * other.m_z + m_rows[3][row] * other.m_w;
+void Matrix4::Multiply(const Matrix4 *left, const Matrix4 *right, Matrix4 *results, std::size_t count) {
+	for (std::size_t i = 0; i < count; i++) {
+		MultiplyRows(left[i].m_rows, right[i].m_rows, results[i].m_rows);
 	}
-
-	return result;
 }
 
 Matrix4 Matrix4::Divide(const Matrix4 &other) const {
@@ -96,12 +124,26 @@ Matrix4 Matrix4::Divide(const Matrix4 &other) const {
 
 Vector4f Matrix4::Transform(const Vector4f &other) const {
 	Vector4f result;
+	Store(result, Combine(Load(m_rows[0]), Load(m_rows[1]), Load(m_rows[2]), Load(m_rows[3]), other.m_x, other.m_y, other.m_z, other.m_w));
+	return result;
+}
 
-	for (uint32_t row = 0; row < 4; row++) {
-		result[row] = m_rows[0][row] * other.m_x + m_rows[1][row] * other.m_y + m_rows[2][row] * other.m_z + m_rows[3][row] * other.m_w;
+void Matrix4::Transform(const Vector4f *vectors, Vector4f *results, std::size_t count) const {
+	auto row0 = Load(m_rows[0]), row1 = Load(m_rows[1]), row2 = Load(m_rows[2]), row3 = Load(m_rows[3]);
+
+	for (std::size_t i = 0; i < count; i++) {
+		Store(results[i], Combine(row0, row1, row2, row3, vectors[i].m_x, vectors[i].m_y, vectors[i].m_z, vectors[i].m_w));
 	}
+}
 
-	return result;
+void Matrix4::TransformPoints(const Vector3f *points, Vector3f *results, std::size_t count) const {
+	auto row0 = Load(m_rows[0]), row1 = Load(m_rows[1]), row2 = Load(m_rows[2]), row3 = Load(m_rows[3]);
+	float result[4];
+
+	for (std::size_t i = 0; i < count; i++) {
+		simd::Store(result, Combine(row0, row1, row2, row3, points[i].m_x, points[i].m_y, points[i].m_z, 1.0f));
+		results[i] = {result[0], result[1], result[2]};
+	}
 }
 
 Matrix4 Matrix4::Translate(const Vector2f &other) const {
@@ -116,11 +158,9 @@ Matrix4 Matrix4::Translate(const Vector2f &other) const {
 
 Matrix4 Matrix4::Translate(const Vector3f &other) const {
 	Matrix4 result(*this);
-
-	for (uint32_t col = 0; col < 4; col++) {
-		result[3][col] += m_rows[0][col] * other.m_x + m_rows[1][col] * other.m_y + m_rows[2][col] * other.m_z;
-	}
-
+	auto offset = simd::Add(simd::Add(simd::Multiply(Load(m_rows[0]), Splat(other.m_x)), simd::Multiply(Load(m_rows[1]), Splat(other.m_y))),
+		simd::Multiply(Load(m_rows[2]), Splat(other.m_z)));
+	Store(result[3], simd::Add(Load(m_rows[3]), offset));
 	return result;
 }
 
@@ -128,9 +168,7 @@ Matrix4 Matrix4::Scale(const Vector3f &other) const {
 	Matrix4 result;
 
 	for (uint32_t row = 0; row < 3; row++) {
-		for (uint32_t col = 0; col < 4; col++) {
-			result[row][col] = m_rows[row][col] * other[row];
-		}
+		Store(result[row], simd::Multiply(Load(m_rows[row]), Splat(other[row])));
 	}
 
 	result[3] = m_rows[3];
@@ -138,12 +176,10 @@ Matrix4 Matrix4::Scale(const Vector3f &other) const {
 }
 
 Matrix4 Matrix4::Scale(const Vector4f &other) const {
-	Matrix4 result(*this);
+	Matrix4 result;
 
 	for (uint32_t row = 0; row < 4; row++) {
-		for (uint32_t col = 0; col < 4; col++) {
-			result[row][col] *= other[row];
-		}
+		Store(result[row], simd::Multiply(Load(m_rows[row]), Splat(other[row])));
 	}
 
 	return result;
@@ -173,10 +209,11 @@ Matrix4 Matrix4::Rotate(float angle, const Vector3f &axis) const {
 	f[2][1] = yz * o - xs;
 	f[2][2] = axis.m_z * axis.m_z * o + c;
 
+	auto row0 = Load(m_rows[0]), row1 = Load(m_rows[1]), row2 = Load(m_rows[2]);
+
 	for (uint32_t row = 0; row < 3; row++) {
-		for (uint32_t col = 0; col < 4; col++) {
-			result[row][col] = m_rows[0][col] * f[row][0] + m_rows[1][col] * f[row][1] + m_rows[2][col] * f[row][2];
-		}
+		Store(result[row], simd::Add(simd::Add(simd::Multiply(row0, Splat(f[row][0])), simd::Multiply(row1, Splat(f[row][1]))),
+			simd::Multiply(row2, Splat(f[row][2]))));
 	}
 
 	result[3] = m_rows[3];
@@ -186,68 +223,108 @@ Matrix4 Matrix4::Rotate(float angle, const Vector3f &axis) const {
 Matrix4 Matrix4::Negate() const {
 	Matrix4 result;
 
+	auto negative = Splat(-1.0f);
+
 	for (uint32_t row = 0; row < 4; row++) {
-		for (uint32_t col = 0; col < 4; col++) {
-			result[row][col] = -m_rows[row][col];
-		}
+		Store(result[row], simd::Multiply(Load(m_rows[row]), negative));
 	}
 
 	return result;
 }
 
 Matrix4 Matrix4::Inverse() const {
+	const auto &m = m_rows;
+
+	// The determinants of every 2x2 submatrix of the last three rows, each 3x3 minor is made from three of them.
+	auto coef00 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+	auto coef02 = m[1][2] * m[3][3] - m[3][2] * m[1][3];
+	auto coef03 = m[1][2] * m[2][3] - m[2][2] * m[1][3];
+	auto coef04 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+	auto coef06 = m[1][1] * m[3][3] - m[3][1] * m[1][3];
+	auto coef07 = m[1][1] * m[2][3] - m[2][1] * m[1][3];
+	auto coef08 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+	auto coef10 = m[1][1] * m[3][2] - m[3][1] * m[1][2];
+	auto coef11 = m[1][1] * m[2][2] - m[2][1] * m[1][2];
+	auto coef12 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+	auto coef14 = m[1][0] * m[3][3] - m[3][0] * m[1][3];
+	auto coef15 = m[1][0] * m[2][3] - m[2][0] * m[1][3];
+	auto coef16 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+	auto coef18 = m[1][0] * m[3][2] - m[3][0] * m[1][2];
+	auto coef19 = m[1][0] * m[2][2] - m[2][0] * m[1][2];
+	auto coef20 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+	auto coef22 = m[1][0] * m[3][1] - m[3][0] * m[1][1];
+	auto coef23 = m[1][0] * m[2][1] - m[2][0] * m[1][1];
+
+	auto factor0 = Set(coef00, coef00, coef02, coef03);
+	auto factor1 = Set(coef04, coef04, coef06, coef07);
+	auto factor2 = Set(coef08, coef08, coef10, coef11);
+	auto factor3 = Set(coef12, coef12, coef14, coef15);
+	auto factor4 = Set(coef16, coef16, coef18, coef19);
+	auto factor5 = Set(coef20, coef20, coef22, coef23);
+
+	auto column0 = Set(m[1][0], m[0][0], m[0][0], m[0][0]);
+	auto column1 = Set(m[1][1], m[0][1], m[0][1], m[0][1]);
+	auto column2 = Set(m[1][2], m[0][2], m[0][2], m[0][2]);
+	auto column3 = Set(m[1][3], m[0][3], m[0][3], m[0][3]);
+
+	// Each row of the cofactors transposed, with every other element negated.
+	auto signA = Set(1.0f, -1.0f, 1.0f, -1.0f);
+	auto signB = Set(-1.0f, 1.0f, -1.0f, 1.0f);
+	auto inverse0 = simd::Multiply(simd::Add(simd::Subtract(simd::Multiply(column1, factor0), simd::Multiply(column2, factor1)), simd::Multiply(column3, factor2)), signA);
+	auto inverse1 = simd::Multiply(simd::Add(simd::Subtract(simd::Multiply(column0, factor0), simd::Multiply(column2, factor3)), simd::Multiply(column3, factor4)), signB);
+	auto inverse2 = simd::Multiply(simd::Add(simd::Subtract(simd::Multiply(column0, factor1), simd::Multiply(column1, factor3)), simd::Multiply(column3, factor5)), signA);
+	auto inverse3 = simd::Multiply(simd::Add(simd::Subtract(simd::Multiply(column0, factor2), simd::Multiply(column1, factor4)), simd::Multiply(column2, factor5)), signB);
+
 	Matrix4 result;
+	Store(result[0], inverse0);
+	Store(result[1], inverse1);
+	Store(result[2], inverse2);
+	Store(result[3], inverse3);
 
-	auto det = Determinant();
+	// The first row dotted with the first column of the cofactors.
+	auto det = (m[0][0] * result[0][0] + m[0][1] * result[1][0]) + (m[0][2] * result[2][0] + m[0][3] * result[3][0]);
 
 	if (det == 0.0f) {
 		throw std::runtime_error("Can't invert a matrix with a determinant of zero");
 	}
 
-	for (uint32_t j = 0; j < 4; j++) {
-		for (uint32_t i = 0; i < 4; i++) {
-			// Get minor of element [j][i] - not [i][j], this is where the transpose happens.
-			auto minorSubmatrix = GetSubmatrix(j, i);
-			auto minor = minorSubmatrix.Determinant();
+	auto oneOverDet = Splat(1.0f / det);
 
-			// Multiply by (−1)^{i+j}.
-			auto factor = ((i + j) % 2 == 1) ? -1.0f : 1.0f;
-			auto cofactor = minor * factor;
-
-			result[i][j] = cofactor / det;
-		}
+	for (uint32_t row = 0; row < 4; row++) {
+		Store(result[row], simd::Multiply(Load(result[row]), oneOverDet));
 	}
 
 	return result;
 }
 
 Matrix4 Matrix4::Transpose() const {
-	Matrix4 result;
-
-	for (uint32_t row = 0; row < 4; row++) {
-		for (uint32_t col = 0; col < 4; col++) {
-			result[row][col] = m_rows[col][row];
-		}
-	}
+	auto row0 = Load(m_rows[0]), row1 = Load(m_rows[1]), row2 = Load(m_rows[2]), row3 = Load(m_rows[3]);
+	simd::Transpose(row0, row1, row2, row3);
 
+	Matrix4 result;
+	Store(result[0], row0);
+	Store(result[1], row1);
+	Store(result[2], row2);
+	Store(result[3], row3);
 	return result;
 }
 
 float Matrix4::Determinant() const {
-	float result = 0.0f;
+	const auto &m = m_rows;
 
-	for (uint32_t i = 0; i < 4; i++) {
-		// Get minor of element [0][i].
-		auto minorSubmatrix = GetSubmatrix(0, i);
-		auto minor = minorSubmatrix.Determinant();
+	// Expanded along the first row, with the minors made from 2x2 determinants of the last two rows.
+	auto coef00 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+	auto coef04 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+	auto coef08 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+	auto coef12 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+	auto coef16 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+	auto coef20 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
 
-		// If this is an odd-numbered row, negate the value.
-		auto factor = (i % 2 == 1) ? -1.0f : 1.0f;
-
-		result += factor * m_rows[0][i] * minor;
-	}
-
-	return result;
+	auto minor0 = m[1][1] * coef00 - m[1][2] * coef04 + m[1][3] * coef08;
+	auto minor1 = m[1][0] * coef00 - m[1][2] * coef12 + m[1][3] * coef16;
+	auto minor2 = m[1][0] * coef04 - m[1][1] * coef12 + m[1][3] * coef20;
+	auto minor3 = m[1][0] * coef08 - m[1][1] * coef16 + m[1][2] * coef20;
+	return (m[0][0] * minor0 - m[0][1] * minor1) + (m[0][2] * minor2 - m[0][3] * minor3);
 }
 
 Matrix3 Matrix4::GetSubmatrix(uint32_t row, uint32_t col) const {
@@ -274,12 +351,16 @@ Matrix3 Matrix4::GetSubmatrix(uint32_t row, uint32_t col) const {
 }
 
 Matrix4 Matrix4::TransformationMatrix(const Vector3f &translation, const Vector3f &rotation, const Vector3f &scale) {
+	// The same matrix as translating, rotating around x, y, and then z, and then scaling a identity matrix, built directly.
+	auto cx = std::cos(rotation.m_x), sx = std::sin(rotation.m_x);
+	auto cy = std::cos(rotation.m_y), sy = std::sin(rotation.m_y);
+	auto cz = std::cos(rotation.m_z), sz = std::sin(rotation.m_z);
+
 	Matrix4 result;
-	result = result.Translate(translation);
-	result = result.Rotate(rotation.m_x, Vector3f::Right);
-	result = result.Rotate(rotation.m_y, Vector3f::Up);
-	result = result.Rotate(rotation.m_z, Vector3f::Front);
-	result = result.Scale(scale);
+	result[0] = Vector4f(cz * cy, cz * sy * sx + sz * cx, sz * sx - cz * sy * cx, 0.0f) * scale.m_x;
+	result[1] = Vector4f(-sz * cy, cz * cx - sz * sy * sx, sz * sy * cx + cz * sx, 0.0f) * scale.m_y;
+	result[2] = Vector4f(sy, -cy * sx, cy * cx, 0.0f) * scale.m_z;
+	result[3] = Vector4f(translation, 1.0f);
 	return result;
 }
 
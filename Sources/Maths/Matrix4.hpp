@@ -71,6 +71,15 @@ public:
 	 */
 	Vector4f Multiply(const Vector4f &other) const;
 
+	/**
+	 * Multiplies a batch of matrices, each left matrix by the right matrix at the same index.
+	 * @param left The left matrices.
+	 * @param right The right matrices.
+	 * @param results Written with the resultant matrices, may be the same array as left or right.
+	 * @param count The number of matrices.
+	 */
+	static void Multiply(const Matrix4 *left, const Matrix4 *right, Matrix4 *results, std::size_t count);
+
 	/**
 	 * Divides this matrix by another matrix.
 	 * @param other The other matrix.
@@ -85,6 +94,22 @@ public:
 	 */
 	Vector4f Transform(const Vector4f &other) const;
 
+	/**
+	 * Transforms a batch of vectors by this matrix.
+	 * @param vectors The vectors to transform.
+	 * @param results Written with the resultant vectors, may be the same array as vectors.
+	 * @param count The number of vectors.
+	 */
+	void Transform(const Vector4f *vectors, Vector4f *results, std::size_t count) const;
+
+	/**
+	 * Transforms a batch of points by this matrix, each point is transformed as a vector with a w of 1.
+	 * @param points The points to transform.
+	 * @param results Written with the resultant points, may be the same array as points.
+	 * @param count The number of points.
+	 */
+	void TransformPoints(const Vector3f *points, Vector3f *results, std::size_t count) const;
+
 	/**
 	 * Translates this matrix by a vector.
 	 * @param other The vector.
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstring>
+
+// The instruction set maths kernels are compiled for is chosen from the compilers target, defining ACID_SIMD_SCALAR uses plain loops instead.
+#if !defined(ACID_SIMD_SCALAR)
+#if defined(__AVX__)
+#include <immintrin.h>
+#define ACID_SIMD_AVX
+#define ACID_SIMD_SSE
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ACID_SIMD_SSE
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define ACID_SIMD_NEON
+#endif
+#endif
+
+/**
+ * Four float operations used by the maths kernels, each backend does the same operations in the same order so results match the scalar loops.
+ * This header is only included by source files, so intrinsics do not leak into the public headers.
+ */
+namespace acid::simd {
+#if defined(ACID_SIMD_SSE)
+using Float4 = __m128;
+
+inline Float4 Load(const float *source) { return _mm_loadu_ps(source); }
+inline void Store(float *destination, Float4 value) { _mm_storeu_ps(destination, value); }
+inline Float4 Set(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+inline Float4 Splat(float value) { return _mm_set1_ps(value); }
+inline Float4 Add(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+inline Float4 Subtract(Float4 a, Float4 b) { return _mm_sub_ps(a, b); }
+inline Float4 Multiply(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+
+inline void Transpose(Float4 &a, Float4 &b, Float4 &c, Float4 &d) {
+	_MM_TRANSPOSE4_PS(a, b, c, d);
+}
+#elif defined(ACID_SIMD_NEON)
+using Float4 = float32x4_t;
+
+inline Float4 Load(const float *source) { return vld1q_f32(source); }
+inline void Store(float *destination, Float4 value) { vst1q_f32(destination, value); }
+inline Float4 Set(float x, float y, float z, float w) {
+	float values[4] = {x, y, z, w};
+	return vld1q_f32(values);
+}
+inline Float4 Splat(float value) { return vdupq_n_f32(value); }
+inline Float4 Add(Float4 a, Float4 b) { return vaddq_f32(a, b); }
+inline Float4 Subtract(Float4 a, Float4 b) { return vsubq_f32(a, b); }
+inline Float4 Multiply(Float4 a, Float4 b) { return vmulq_f32(a, b); }
+
+inline void Transpose(Float4 &a, Float4 &b, Float4 &c, Float4 &d) {
+	auto ac = vzipq_f32(a, c);
+	auto bd = vzipq_f32(b, d);
+	auto low = vzipq_f32(ac.val[0], bd.val[0]);
+	auto high = vzipq_f32(ac.val[1], bd.val[1]);
+	a = low.val[0];
+	b = low.val[1];
+	c = high.val[0];
+	d = high.val[1];
+}
+#else
+struct Float4 {
+	float m_values[4];
+};
+
+inline Float4 Load(const float *source) {
+	Float4 result;
+	std::memcpy(result.m_values, source, sizeof(result.m_values));
+	return result;
+}
+inline void Store(float *destination, Float4 value) { std::memcpy(destination, value.m_values, sizeof(value.m_values)); }
+inline Float4 Set(float x, float y, float z, float w) { return {{x, y, z, w}}; }
+inline Float4 Splat(float value) { return {{value, value, value, value}}; }
+inline Float4 Add(Float4 a, Float4 b) { return {{a.m_values[0] + b.m_values[0], a.m_values[1] + b.m_values[1], a.m_values[2] + b.m_values[2], a.m_values[3] + b.m_values[3]}}; }
+inline Float4 Subtract(Float4 a, Float4 b) { return {{a.m_values[0] - b.m_values[0], a.m_values[1] - b.m_values[1], a.m_values[2] - b.m_values[2], a.m_values[3] - b.m_values[3]}}; }
+inline Float4 Multiply(Float4 a, Float4 b) { return {{a.m_values[0] * b.m_values[0], a.m_values[1] * b.m_values[1], a.m_values[2] * b.m_values[2], a.m_values[3] * b.m_values[3]}}; }
+
+inline void Transpose(Float4 &a, Float4 &b, Float4 &c, Float4 &d) {
+	Float4 rows[4] = {a, b, c, d};
+	a = {{rows[0].m_values[0], rows[1].m_values[0], rows[2].m_values[0], rows[3].m_values[0]}};
+	b = {{rows[0].m_values[1], rows[1].m_values[1], rows[2].m_values[1], rows[3].m_values[1]}};
+	c = {{rows[0].m_values[2], rows[1].m_values[2], rows[2].m_values[2], rows[3].m_values[2]}};
+	d = {{rows[0].m_values[3], rows[1].m_values[3], rows[2].m_values[3], rows[3].m_values[3]}};
+}
+#endif
+
+/**
+ * Sums four rows weighted by four values, how a matrix transforms a vector.
+ * Added in the same order as the scalar expression a * x + b * y + c * z + d * w.
+ */
+inline Float4 Combine(Float4 a, Float4 b, Float4 c, Float4 d, float x, float y, float z, float w) {
+	return Add(Add(Add(Multiply(a, Splat(x)), Multiply(b, Splat(y))), Multiply(c, Splat(z))), Multiply(d, Splat(w)));
+}
+}
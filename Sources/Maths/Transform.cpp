@@ -4,6 +4,7 @@
 
 namespace acid {
 bool Transform::registered = Register("transform");
+std::atomic<uint64_t> Transform::hierarchyVersion = 0;
 
 Transform::Transform(const Vector3f &position, const Vector3f &rotation, const Vector3f &scale) :
 	m_position(position),
@@ -11,8 +12,15 @@ Transform::Transform(const Vector3f &position, const Vector3f &rotation, const V
 	m_scale(scale) {
 }
 
+Transform::Transform(const Transform &other) :
+	Transform(other.m_position, other.m_rotation, other.m_scale) {
+}
+
 Transform::~Transform() {
-	delete m_worldTransform;
+	// Temporaries are not in a hierarchy, so destroying them does not rebuild flattened hierarchies.
+	if (m_parent || !m_children.empty()) {
+		hierarchyVersion++;
+	}
 
 	if (m_parent) {
 		m_parent->RemoveChild(this);
@@ -20,40 +28,55 @@ Transform::~Transform() {
 
 	for (auto &child : m_children) {
 		child->m_parent = nullptr;
+		child->SetDirty();
 	}
 }
 
+Transform &Transform::operator=(const Transform &other) {
+	m_position = other.m_position;
+	m_rotation = other.m_rotation;
+	m_scale = other.m_scale;
+	SetDirty();
+	return *this;
+}
+
 Transform Transform::Multiply(const Transform &other) const {
 	return {Vector3f(GetWorldMatrix().Transform(Vector4f(other.m_position))), m_rotation + other.m_rotation, m_scale * other.m_scale};
 }
 
-Matrix4 Transform::GetWorldMatrix() const {
-	auto worldTransform = GetWorldTransform();
-	return Matrix4::TransformationMatrix(worldTransform->m_position, worldTransform->m_rotation, worldTransform->m_scale);
+const Matrix4 &Transform::GetWorldMatrix() const {
+	UpdateWorldTransform();
+	return m_worldMatrix;
 }
 
-Vector3f Transform::GetPosition() const {
-	return GetWorldTransform()->m_position;
+const Vector3f &Transform::GetPosition() const {
+	UpdateWorldTransform();
+	return m_worldPosition;
 }
 
-Vector3f Transform::GetRotation() const {
-	return GetWorldTransform()->m_rotation;
+const Vector3f &Transform::GetRotation() const {
+	UpdateWorldTransform();
+	return m_worldRotation;
 }
 
-Vector3f Transform::GetScale() const {
-	return GetWorldTransform()->m_scale;
+const Vector3f &Transform::GetScale() const {
+	UpdateWorldTransform();
+	return m_worldScale;
 }
 
 void Transform::SetLocalPosition(const Vector3f &localPosition) {
 	m_position = localPosition;
+	SetDirty();
 }
 
 void Transform::SetLocalRotation(const Vector3f &localRotation) {
 	m_rotation = localRotation;
+	SetDirty();
 }
 
 void Transform::SetLocalScale(const Vector3f &localScale) {
 	m_scale = localScale;
+	SetDirty();
 }
 
 void Transform::SetParent(Transform *parent) {
@@ -66,6 +89,10 @@ void Transform::SetParent(Transform *parent) {
 	if (m_parent) {
 		m_parent->AddChild(this);
 	}
+
+	hierarchyVersion++;
+
+	SetDirty();
 }
 
 void Transform::SetParent(Entity *parent) {
@@ -92,6 +119,7 @@ const Node &operator>>(const Node &node, Transform &transform) {
 	node["position"].Get(transform.m_position);
 	node["rotation"].Get(transform.m_rotation);
 	node["scale"].Get(transform.m_scale);
+	transform.SetDirty();
 	return node;
 }
 
@@ -106,22 +134,58 @@ std::ostream &operator<<(std::ostream &stream, const Transform &transform) {
 	return stream << transform.m_position << ", " << transform.m_rotation << ", " << transform.m_scale;
 }
 
-const Transform *Transform::GetWorldTransform() const {
-	if (!m_parent) {
-		if (m_worldTransform) {
-			delete m_worldTransform;
-			m_worldTransform = nullptr;
-		}
+void Transform::UpdateWorldTransform() const {
+	if (!m_dirty)
+		return;
 
-		return this;
-	}
+	// Finds the highest dirty parent, every transform between it and this is dirty too, and calculates down from there.
+	thread_local std::vector<const Transform *> dirty;
+	dirty.clear();
 
-	if (!m_worldTransform) {
-		m_worldTransform = new Transform();
+	for (auto transform = this; transform && transform->m_dirty; transform = transform->m_parent)
+		dirty.emplace_back(transform);
+
+	for (auto it = dirty.rbegin(); it != dirty.rend(); ++it)
+		(*it)->CalculateWorldTransform();
+}
+
+void Transform::CalculateWorldTransform() const {
+	auto worldRotation = m_parent ? m_parent->m_worldRotation + m_rotation : m_rotation;
+	auto worldScale = m_parent ? m_parent->m_worldScale * m_scale : m_scale;
+	m_worldPosition = m_parent ? Vector3f(m_parent->m_worldMatrix.Transform(Vector4f(m_position))) : m_position;
+
+	// Moving is the most common change, it only needs the new translation instead of the sines and cosines of the rotation.
+	if (m_calculated && worldRotation == m_worldRotation && worldScale == m_worldScale) {
+		m_worldMatrix[3] = Vector4f(m_worldPosition, 1.0f);
+	} else {
+		m_worldRotation = worldRotation;
+		m_worldScale = worldScale;
+		m_worldMatrix = Matrix4::TransformationMatrix(m_worldPosition, m_worldRotation, m_worldScale);
+		m_calculated = true;
 	}
 
-	*m_worldTransform = *m_parent->GetWorldTransform() * *this;
-	return m_worldTransform;
+	m_dirty = false;
+	// Every transform below this was dirty with it.
+	m_dirtyChildren = !m_children.empty();
+}
+
+void Transform::SetDirty() {
+	MarkDirty();
+
+	// Parents are flagged up to the root, so the update pass finds this transform.
+	for (auto parent = m_parent; parent && !parent->m_dirtyChildren; parent = parent->m_parent)
+		parent->m_dirtyChildren = true;
+}
+
+void Transform::MarkDirty() {
+	// Transforms below a dirty transform are already dirty.
+	if (m_dirty)
+		return;
+
+	m_dirty = true;
+
+	for (auto &child : m_children)
+		child->MarkDirty();
 }
 
 void Transform::AddChild(Transform *child) {
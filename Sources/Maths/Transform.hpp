@@ -1,5 +1,7 @@
 ﻿#pragma once
 
+#include <atomic>
+
 #include "Matrix4.hpp"
 #include "Vector3.hpp"
 #include "Scenes/Component.hpp"
@@ -7,8 +9,11 @@
 namespace acid {
 /**
  * @brief Holds position, rotation, and scale components.
+ * The world values are cached, and are recalculated when this transform or one of its parents changes.
+ * Transforms are calculated when first read after a change, or all at once by {@link TransformHierarchy#Update}.
  */
 class ACID_EXPORT Transform : public Component::Registrar<Transform> {
+	friend class TransformHierarchy;
 public:
 	/**
 	 * Creates a new transform.
@@ -18,8 +23,21 @@ public:
 	 */
 	Transform(const Vector3f &position = {}, const Vector3f &rotation = {}, const Vector3f &scale = Vector3f(1.0f));
 
+	/**
+	 * Creates a transform with the local values of another transform, it has no parent or children.
+	 * @param other The transform to copy.
+	 */
+	Transform(const Transform &other);
+
 	~Transform();
 
+	/**
+	 * Sets the local values to the local values of another transform, the parent and children of this transform are kept.
+	 * @param other The transform to copy.
+	 * @return This transform.
+	 */
+	Transform &operator=(const Transform &other);
+
 	/**
 	 * Multiplies this transform with another transform.
 	 * @param other The other transform.
@@ -27,10 +45,10 @@ public:
 	 */
 	Transform Multiply(const Transform &other) const;
 
-	Matrix4 GetWorldMatrix() const;
-	Vector3f GetPosition() const;
-	Vector3f GetRotation() const;
-	Vector3f GetScale() const;
+	const Matrix4 &GetWorldMatrix() const;
+	const Vector3f &GetPosition() const;
+	const Vector3f &GetRotation() const;
+	const Vector3f &GetScale() const;
 
 	const Vector3f &GetLocalPosition() const { return m_position; }
 	void SetLocalPosition(const Vector3f &localPosition);
@@ -59,12 +77,17 @@ public:
 	friend std::ostream &operator<<(std::ostream &stream, const Transform &transform);
 
 private:
-	const Transform *GetWorldTransform() const;
+	void UpdateWorldTransform() const;
+	void CalculateWorldTransform() const;
+	void SetDirty();
+	void MarkDirty();
 
 	void AddChild(Transform *child);
 	void RemoveChild(Transform *child);
 
 	static bool registered;
+	// Changed when any transform is reparented or destroyed while in a hierarchy, so flattened hierarchies know to rebuild.
+	static std::atomic<uint64_t> hierarchyVersion;
 
 	Vector3f m_position;
 	Vector3f m_rotation;
@@ -72,6 +95,16 @@ private:
 
 	Transform *m_parent = nullptr;
 	std::vector<Transform *> m_children;
-	mutable Transform *m_worldTransform = nullptr;
+
+	// If the world values are out of date, when set every transform below this is also dirty.
+	mutable bool m_dirty = true;
+	// If a transform below this may be dirty, so the update pass can skip hierarchies that have not changed.
+	mutable bool m_dirtyChildren = false;
+	// If the world matrix has been calculated, after that only its translation changes when the world rotation and scale are the same.
+	mutable bool m_calculated = false;
+	mutable Vector3f m_worldPosition;
+	mutable Vector3f m_worldRotation;
+	mutable Vector3f m_worldScale;
+	mutable Matrix4 m_worldMatrix;
 };
 }
@@ -0,0 +1,84 @@
+#include "TransformHierarchy.hpp"
+
+#include <limits>
+
+#include "Helpers/ThreadPool.hpp"
+#include "Transform.hpp"
+
+namespace acid {
+void TransformHierarchy::Update(const std::vector<Transform *> &transforms, ThreadPool *pool) {
+	if (m_version != Transform::hierarchyVersion || transforms != m_transforms)
+		Rebuild(transforms);
+
+	if (m_order.empty())
+		return;
+
+	auto hierarchyCount = m_roots.size() - 1;
+
+	// Hierarchies next to each other are next to each other in the order, so a chunk of them is one range.
+	if (pool) {
+		pool->ParallelForRange(0, hierarchyCount, [this](std::size_t begin, std::size_t end) {
+			UpdateRange(m_roots[begin], m_roots[end]);
+		});
+	} else {
+		UpdateRange(m_roots.front(), m_roots.back());
+	}
+}
+
+void TransformHierarchy::Rebuild(const std::vector<Transform *> &transforms) {
+	m_transforms = transforms;
+	m_version = Transform::hierarchyVersion;
+	m_order.clear();
+	m_ends.clear();
+	m_roots.clear();
+
+	// Each hierarchy is walked depth first from its root, the end of a transform is known once the walk leaves it.
+	constexpr auto Enter = std::numeric_limits<uint32_t>::max();
+	std::vector<std::pair<Transform *, uint32_t>> stack;
+
+	for (const auto &root : transforms) {
+		if (root->m_parent)
+			continue;
+
+		m_roots.emplace_back(static_cast<uint32_t>(m_order.size()));
+		stack.emplace_back(root, Enter);
+
+		while (!stack.empty()) {
+			auto [transform, index] = stack.back();
+			stack.pop_back();
+
+			if (index != Enter) {
+				m_ends[index] = static_cast<uint32_t>(m_order.size());
+				continue;
+			}
+
+			stack.emplace_back(transform, static_cast<uint32_t>(m_order.size()));
+			m_order.emplace_back(transform);
+			m_ends.emplace_back(0);
+
+			for (auto it = transform->m_children.rbegin(); it != transform->m_children.rend(); ++it)
+				stack.emplace_back(*it, Enter);
+		}
+	}
+
+	m_roots.emplace_back(static_cast<uint32_t>(m_order.size()));
+}
+
+void TransformHierarchy::UpdateRange(std::size_t begin, std::size_t end) {
+	for (auto i = begin; i < end;) {
+		auto transform = m_order[i];
+
+		if (transform->m_dirty)
+			transform->CalculateWorldTransform();
+
+		// A subtree without a dirty transform is skipped in one step.
+		if (!transform->m_dirtyChildren) {
+			i = m_ends[i];
+			continue;
+		}
+
+		transform->m_dirtyChildren = false;
+		i++;
+	}
+}
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Export.hpp"
+
+namespace acid {
+class ThreadPool;
+class Transform;
+
+/**
+ * @brief Transforms flattened into one array with every parent before its children, and each hierarchy in a contiguous range.
+ * The array is kept between frames and only rebuilt after transforms are added, removed or reparented, so a update is a linear pass
+ * that skips the range of every subtree that has not changed.
+ */
+class ACID_EXPORT TransformHierarchy {
+public:
+	/**
+	 * Calculates the world values of every changed transform, parents before their children. Each hierarchy is updated on one thread,
+	 * so after this transforms can be read from many threads at once until they are changed again.
+	 * @param transforms The transforms to update, along with every transform below them.
+	 * @param pool The pool to update hierarchies across, or nullptr to update them on this thread.
+	 */
+	void Update(const std::vector<Transform *> &transforms, ThreadPool *pool = nullptr);
+
+	/**
+	 * Gets the flattened transforms, in the order they were last updated.
+	 * @return The flattened transforms.
+	 */
+	const std::vector<Transform *> &GetOrder() const { return m_order; }
+
+private:
+	void Rebuild(const std::vector<Transform *> &transforms);
+	void UpdateRange(std::size_t begin, std::size_t end);
+
+	// The transforms given to the last rebuild, and the hierarchy version they were flattened at.
+	std::vector<Transform *> m_transforms;
+	uint64_t m_version = 0;
+
+	std::vector<Transform *> m_order;
+	// The index after the last transform below each transform in the order.
+	std::vector<uint32_t> m_ends;
+	// The index of the first transform of each hierarchy, and the end of the last.
+	std::vector<uint32_t> m_roots;
+};
+}
@@ -0,0 +1,121 @@
+#include "DrawList.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace acid {
+// Keys are radix sorted 11 bits at a time, six passes cover every bit.
+static constexpr uint32_t RadixBits = 11;
+static constexpr uint32_t RadixPasses = (64 + RadixBits - 1) / RadixBits;
+static constexpr uint64_t RadixMask = (1u << RadixBits) - 1;
+
+// Pipelines and models are grouped by a hash of their address, two that share a hash are drawn together but still in a valid order.
+static uint64_t PointerBits(const void *pointer) {
+	return (static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pointer)) * 0x9E3779B97F4A7C15ull) >> 48;
+}
+
+uint64_t DrawList::CreateKey(const void *pipeline, const void *model, float depth, Order order) {
+	auto state = PointerBits(pipeline) << 16 | PointerBits(model);
+
+	if (order == Order::None)
+		return state << 32;
+
+	// The bits of a non negative float are ordered the same as its value, so depth is kept exactly.
+	if (!(depth > 0.0f))
+		depth = 0.0f;
+
+	uint32_t depthBits;
+	std::memcpy(&depthBits, &depth, sizeof(float));
+
+	if (order == Order::FrontToBack)
+		return state << 32 | depthBits;
+	return static_cast<uint64_t>(~depthBits) << 32 | state;
+}
+
+void DrawList::Sort(const std::vector<uint64_t> &keys) {
+	m_draws.resize(keys.size());
+
+	for (uint32_t i = 0; i < keys.size(); i++) {
+		m_draws[i] = {keys[i], i};
+	}
+
+	RadixSort();
+}
+
+void DrawList::Resort(const std::vector<uint64_t> &keys) {
+	if (keys.size() != m_draws.size()) {
+		Sort(keys);
+		return;
+	}
+
+	std::size_t descents = 0;
+
+	for (std::size_t i = 0; i < m_draws.size(); i++) {
+		m_draws[i].m_key = keys[m_draws[i].m_index];
+		if (i > 0 && m_draws[i - 1].m_key > m_draws[i].m_key)
+			descents++;
+	}
+
+	// When many draws are out of order the last order does not help.
+	if (descents > m_draws.size() / 16) {
+		RadixSort();
+		return;
+	}
+
+	// An insertion sort only moves draws that changed places since the last frame, it gives up once it has moved more than a radix sort would.
+	auto budget = 4 * m_draws.size();
+
+	for (std::size_t i = 1; i < m_draws.size(); i++) {
+		auto draw = m_draws[i];
+		auto j = i;
+
+		for (; j > 0 && m_draws[j - 1].m_key > draw.m_key; j--) {
+			m_draws[j] = m_draws[j - 1];
+		}
+
+		m_draws[j] = draw;
+		budget -= std::min(budget, i - j);
+
+		if (budget == 0) {
+			RadixSort();
+			return;
+		}
+	}
+}
+
+void DrawList::RadixSort() {
+	// Counts every digit of every key in one pass, the counts are then turned into where each digit starts.
+	std::vector<std::array<uint32_t, RadixMask + 1>> offsets(RadixPasses);
+
+	for (const auto &draw : m_draws) {
+		for (uint32_t pass = 0; pass < RadixPasses; pass++) {
+			offsets[pass][(draw.m_key >> (RadixBits * pass)) & RadixMask]++;
+		}
+	}
+
+	m_buffer.resize(m_draws.size());
+
+	for (uint32_t pass = 0; pass < RadixPasses; pass++) {
+		auto shift = RadixBits * pass;
+
+		// When every key has the same digit the pass would not move anything, like the depth bits of unordered keys.
+		if (m_draws.empty() || offsets[pass][(m_draws.front().m_key >> shift) & RadixMask] == m_draws.size())
+			continue;
+
+		uint32_t offset = 0;
+
+		for (auto &bucket : offsets[pass]) {
+			auto count = bucket;
+			bucket = offset;
+			offset += count;
+		}
+
+		for (const auto &draw : m_draws) {
+			m_buffer[offsets[pass][(draw.m_key >> shift) & RadixMask]++] = draw;
+		}
+
+		std::swap(m_draws, m_buffer);
+	}
+}
+}
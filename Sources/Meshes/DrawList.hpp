@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Export.hpp"
+
+namespace acid {
+/**
+ * @brief A list of draws ordered by 64 bit sort keys, each key is built once for a draw every frame instead of in every comparison.
+ * The sorted list is kept between frames, when the same items are drawn the last order is the starting point so coherent frames sort in close to linear time.
+ */
+class ACID_EXPORT DrawList {
+public:
+	enum class Order {
+		None,
+		FrontToBack,
+		BackToFront
+	};
+
+	struct Draw {
+		uint64_t m_key;
+		// The index of the item in the keys given to {@link DrawList#Sort} or {@link DrawList#Resort}.
+		uint32_t m_index;
+	};
+
+	/**
+	 * Creates a sort key, front to back keys group draws by pipeline and then model before depth, back to front keys order by depth first.
+	 * @param pipeline The pipeline, draws with the same pipeline are drawn together.
+	 * @param model The model, draws with the same pipeline and model are drawn together.
+	 * @param depth The non negative distance, or squared distance, from the camera.
+	 * @param order How depth is ordered, with no order depth is ignored.
+	 * @return The sort key.
+	 */
+	static uint64_t CreateKey(const void *pipeline, const void *model, float depth, Order order);
+
+	/**
+	 * Sorts a new set of items, replacing the last list.
+	 * @param keys The key of each item.
+	 */
+	void Sort(const std::vector<uint64_t> &keys);
+
+	/**
+	 * Sorts the same items as the last call with new keys, starting from the last order.
+	 * @param keys The key of each item, in the same order as the last call.
+	 */
+	void Resort(const std::vector<uint64_t> &keys);
+
+	const std::vector<Draw> &GetDraws() const { return m_draws; }
+
+private:
+	void RadixSort();
+
+	std::vector<Draw> m_draws;
+	std::vector<Draw> m_buffer;
+};
+}
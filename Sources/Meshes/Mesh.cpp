@@ -64,22 +64,6 @@ void Mesh::SetMaterial(std::unique_ptr<Material> &&material) {
 	m_material->CreatePipeline(GetVertexInput(), false);
 }
 
-bool Mesh::operator<(const Mesh &other) const {
-	auto camera = Scenes::Get()->GetCamera();
-
-	auto transform0 = GetEntity()->GetComponent<Transform>();
-	auto transform1 = other.GetEntity()->GetComponent<Transform>();
-
-	auto thisDistance2 = (camera->GetPosition() - transform0->GetPosition()).LengthSquared();
-	auto otherDistance2 = (camera->GetPosition() - transform1->GetPosition()).LengthSquared();
-
-	return thisDistance2 > otherDistance2;
-}
-
-bool Mesh::operator>(const Mesh &other) const {
-	return !operator<(other);
-}
-
 const Node &operator>>(const Node &node, Mesh &mesh) {
 	node["model"].Get(mesh.m_model);
 	node["material"].Get(mesh.m_material);
@@ -31,9 +31,6 @@ public:
 	const Material *GetMaterial() const { return m_material.get(); }
 	void SetMaterial(std::unique_ptr<Material> &&material);
 
-	bool operator<(const Mesh &other) const;
-	bool operator>(const Mesh &other) const;
-
 	friend const Node &operator>>(const Node &node, Mesh &mesh);
 	friend Node &operator<<(Node &node, const Mesh &mesh);
 
@@ -1,6 +1,8 @@
 #include "SubrenderMeshes.hpp"
 
 #include "Animations/MeshAnimated.hpp"
+#include "Maths/Transform.hpp"
+#include "Scenes/Entity.hpp"
 #include "Scenes/Scenes.hpp"
 #include "Mesh.hpp"
 
@@ -17,18 +19,38 @@ void SubrenderMeshes::Render(const CommandBuffer &commandBuffer) {
 	m_uniformScene.Push("view", camera->GetViewMatrix());
 	m_uniformScene.Push("cameraPos", camera->GetPosition());
 
-	auto meshes = Scenes::Get()->GetStructure()->QueryComponents<Mesh>();
-	if (m_sort == Sort::Front)
-		std::sort(meshes.begin(), meshes.end(), std::greater<>());
-	else if (m_sort == Sort::Back)
-		std::sort(meshes.begin(), meshes.end(), std::less<>());
+	const auto &meshes = Scenes::Get()->GetStructure()->QueryComponents<Mesh>();
+	auto order = m_sort == Sort::Front ? DrawList::Order::FrontToBack : m_sort == Sort::Back ? DrawList::Order::BackToFront : DrawList::Order::None;
+	auto cameraPosition = camera->GetPosition();
 
-	for (const auto &mesh : meshes) {
-		mesh->CmdRender(commandBuffer, m_uniformScene, GetStage());
+	// Each mesh looks up its transform once a frame to build its key, instead of in every comparison.
+	m_keys.resize(meshes.size());
+
+	for (std::size_t i = 0; i < meshes.size(); i++) {
+		auto material = meshes[i]->GetMaterial();
+		auto depth = 0.0f;
+
+		if (order != DrawList::Order::None) {
+			if (auto transform = meshes[i]->GetEntity()->GetComponent<Transform>())
+				depth = (cameraPosition - transform->GetPosition()).LengthSquared();
+		}
+
+		m_keys[i] = DrawList::CreateKey(material ? material->GetPipelineMaterial().get() : nullptr, meshes[i]->GetModel(), depth, order);
+	}
+
+	if (meshes == m_meshes) {
+		m_drawList.Resort(m_keys);
+	} else {
+		m_drawList.Sort(m_keys);
+		m_meshes = std::move(meshes);
+	}
+
+	for (const auto &draw : m_drawList.GetDraws()) {
+		m_meshes[draw.m_index]->CmdRender(commandBuffer, m_uniformScene, GetStage());
 	}
 
 	// TODO: Split animated meshes into it's own subrender.
-	auto animatedMeshes = Scenes::Get()->GetStructure()->QueryComponents<MeshAnimated>();
+	const auto &animatedMeshes = Scenes::Get()->GetStructure()->QueryComponents<MeshAnimated>();
 	for (const auto &animatedMesh : animatedMeshes) {
 		animatedMesh->CmdRender(commandBuffer, m_uniformScene, GetStage());
 	}
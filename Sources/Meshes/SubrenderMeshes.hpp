@@ -3,8 +3,11 @@
 #include "Graphics/Subrender.hpp"
 #include "Graphics/Buffers/UniformHandler.hpp"
 #include "Graphics/Pipelines/PipelineGraphics.hpp"
+#include "DrawList.hpp"
 
 namespace acid {
+class Mesh;
+
 class ACID_EXPORT SubrenderMeshes : public Subrender {
 public:
 	enum class Sort {
@@ -20,5 +23,10 @@ public:
 private:
 	Sort m_sort;
 	UniformHandler m_uniformScene;
+
+	// The meshes drawn last frame, when they are the same the draw list resorts from its last order.
+	std::vector<Mesh *> m_meshes;
+	std::vector<uint64_t> m_keys;
+	DrawList m_drawList;
 };
 }
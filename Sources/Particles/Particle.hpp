@@ -6,10 +6,9 @@
 
 namespace acid {
 /**
- * @brief A instance of a particle type.
+ * @brief The spawn state of a particle, once added to {@link Particles} it is simulated in a {@link ParticleStore}.
  */
 class ACID_EXPORT Particle {
-	friend class ParticleType;
 public:
 	/**
 	 * Creates a new particle object.
@@ -25,47 +24,25 @@ public:
 	Particle(std::shared_ptr<ParticleType> particleType, const Vector3f &position, const Vector3f &velocity, float lifeLength, float stageCycles,
 		float rotation, float scale, float gravityEffect);
 
-	/**
-	 * Updates the particle.
-	 */
-	void Update();
-
-	bool operator<(const Particle &other) const;
-
-	bool IsAlive() const { return m_transparency > 0.0f; }
 	const std::shared_ptr<ParticleType> &GetParticleType() const { return m_particleType; }
 	const Vector3f &GetPosition() const { return m_position; }
 	const Vector3f &GetVelocity() const { return m_velocity; }
-	const Vector3f &GetChange() const { return m_change; }
 	float GetLifeLength() const { return m_lifeLength; }
+	float GetStageCycles() const { return m_stageCycles; }
 	float GetRotation() const { return m_rotation; }
 	float GetScale() const { return m_scale; }
 	float GetGravityEffect() const { return m_gravityEffect; }
-	float GetElapsedTime() const { return m_elapsedTime; }
-	float GetTransparency() const { return m_transparency; }
-	float DistanceToCamera() const { return m_distanceToCamera; }
 
 private:
-	Vector2f CalculateImageOffset(int32_t index) const;
-
 	std::shared_ptr<ParticleType> m_particleType;
 
 	Vector3f m_position;
 	Vector3f m_velocity;
-	Vector3f m_change;
-
-	Vector2f m_imageOffset1;
-	Vector2f m_imageOffset2;
 
 	float m_lifeLength;
 	float m_stageCycles;
 	float m_rotation;
 	float m_scale;
 	float m_gravityEffect;
-
-	float m_elapsedTime = 0.0f;
-	float m_transparency = 1.0f;
-	float m_imageBlendFactor = 0.0f;
-	float m_distanceToCamera = 0.0f;
 };
 }
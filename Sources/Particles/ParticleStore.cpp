@@ -0,0 +1,238 @@
+#include "ParticleStore.hpp"
+
+#include <array>
+#include <cstring>
+
+#include "Maths/Simd.hpp"
+
+namespace acid {
+static constexpr float Gravity = -10.0f;
+
+void ParticleStore::Add(const Vector3f &position, const Vector3f &velocity, float lifeLength, float stageCycles, float rotation, float scale, float gravityEffect) {
+	m_positionX.emplace_back(position.m_x);
+	m_positionY.emplace_back(position.m_y);
+	m_positionZ.emplace_back(position.m_z);
+	m_velocityX.emplace_back(velocity.m_x);
+	m_velocityY.emplace_back(velocity.m_y);
+	m_velocityZ.emplace_back(velocity.m_z);
+	m_lifeLength.emplace_back(lifeLength);
+	m_stageCycles.emplace_back(stageCycles);
+	m_rotation.emplace_back(rotation);
+	m_scale.emplace_back(scale);
+	m_gravityEffect.emplace_back(gravityEffect);
+	m_elapsedTime.emplace_back(0.0f);
+	m_transparency.emplace_back(1.0f);
+	m_distanceToCamera.emplace_back(0.0f);
+}
+
+void ParticleStore::Update(float delta, const Vector3f &cameraPosition, ThreadPool *pool) {
+	auto size = GetSize();
+	auto chunkCount = (size + GrainSize - 1) / GrainSize;
+	m_deadChunks.resize(chunkCount);
+
+	auto updateChunk = [this, size, delta, &cameraPosition](std::size_t chunk) {
+		m_deadChunks[chunk].clear();
+		UpdateRange(chunk * GrainSize, std::min(size, (chunk + 1) * GrainSize), delta, cameraPosition, m_deadChunks[chunk]);
+	};
+
+	if (pool && chunkCount > 1) {
+		pool->ParallelFor(0, chunkCount, updateChunk, 1);
+	} else {
+		for (std::size_t chunk = 0; chunk < chunkCount; chunk++)
+			updateChunk(chunk);
+	}
+
+	// Chunks are in order and each chunk finds its dead in order, so the combined list is sorted.
+	for (auto it = m_deadChunks.rbegin(); it != m_deadChunks.rend(); ++it) {
+		RemoveDead(*it);
+	}
+
+	SortDrawOrder();
+}
+
+void ParticleStore::Clear() {
+	for (auto stream : {&m_positionX, &m_positionY, &m_positionZ, &m_velocityX, &m_velocityY, &m_velocityZ, &m_lifeLength, &m_stageCycles, &m_rotation, &m_scale,
+		&m_gravityEffect, &m_elapsedTime, &m_transparency, &m_distanceToCamera}) {
+		stream->clear();
+	}
+
+	m_drawOrder.clear();
+}
+
+void ParticleStore::Reserve(std::size_t capacity) {
+	for (auto stream : {&m_positionX, &m_positionY, &m_positionZ, &m_velocityX, &m_velocityY, &m_velocityZ, &m_lifeLength, &m_stageCycles, &m_rotation, &m_scale,
+		&m_gravityEffect, &m_elapsedTime, &m_transparency, &m_distanceToCamera}) {
+		stream->reserve(capacity);
+	}
+
+	m_drawOrder.reserve(capacity);
+}
+
+void ParticleStore::UpdateRange(std::size_t begin, std::size_t end, float delta, const Vector3f &cameraPosition, std::vector<uint32_t> &dead) {
+	auto i = begin;
+
+#if defined(ACID_SIMD_AVX)
+	auto deltaV = _mm256_set1_ps(delta);
+	auto gravityV = _mm256_set1_ps(Gravity * delta);
+	auto fadeV = _mm256_set1_ps(delta / FadeTime);
+	auto fadeTimeV = _mm256_set1_ps(FadeTime);
+	auto cameraX = _mm256_set1_ps(cameraPosition.m_x);
+	auto cameraY = _mm256_set1_ps(cameraPosition.m_y);
+	auto cameraZ = _mm256_set1_ps(cameraPosition.m_z);
+	auto zero = _mm256_setzero_ps();
+
+	for (; i + 8 <= end; i += 8) {
+		auto velocityX = _mm256_loadu_ps(&m_velocityX[i]);
+		auto velocityY = _mm256_add_ps(_mm256_loadu_ps(&m_velocityY[i]), _mm256_mul_ps(gravityV, _mm256_loadu_ps(&m_gravityEffect[i])));
+		auto velocityZ = _mm256_loadu_ps(&m_velocityZ[i]);
+		_mm256_storeu_ps(&m_velocityY[i], velocityY);
+
+		auto positionX = _mm256_add_ps(_mm256_loadu_ps(&m_positionX[i]), _mm256_mul_ps(velocityX, deltaV));
+		auto positionY = _mm256_add_ps(_mm256_loadu_ps(&m_positionY[i]), _mm256_mul_ps(velocityY, deltaV));
+		auto positionZ = _mm256_add_ps(_mm256_loadu_ps(&m_positionZ[i]), _mm256_mul_ps(velocityZ, deltaV));
+		_mm256_storeu_ps(&m_positionX[i], positionX);
+		_mm256_storeu_ps(&m_positionY[i], positionY);
+		_mm256_storeu_ps(&m_positionZ[i], positionZ);
+
+		auto elapsed = _mm256_add_ps(_mm256_loadu_ps(&m_elapsedTime[i]), deltaV);
+		_mm256_storeu_ps(&m_elapsedTime[i], elapsed);
+
+		// Fades out particles at the end of their life.
+		auto fading = _mm256_cmp_ps(elapsed, _mm256_sub_ps(_mm256_loadu_ps(&m_lifeLength[i]), fadeTimeV), _CMP_GT_OQ);
+		auto transparency = _mm256_sub_ps(_mm256_loadu_ps(&m_transparency[i]), _mm256_and_ps(fading, fadeV));
+		_mm256_storeu_ps(&m_transparency[i], transparency);
+
+		auto toCameraX = _mm256_sub_ps(cameraX, positionX);
+		auto toCameraY = _mm256_sub_ps(cameraY, positionY);
+		auto toCameraZ = _mm256_sub_ps(cameraZ, positionZ);
+		auto distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(toCameraX, toCameraX), _mm256_mul_ps(toCameraY, toCameraY)), _mm256_mul_ps(toCameraZ, toCameraZ));
+		_mm256_storeu_ps(&m_distanceToCamera[i], distance);
+
+		auto mask = _mm256_movemask_ps(_mm256_cmp_ps(transparency, zero, _CMP_LE_OQ));
+
+		for (uint32_t lane = 0; mask != 0 && lane < 8; lane++) {
+			if (mask & (1 << lane))
+				dead.emplace_back(static_cast<uint32_t>(i + lane));
+		}
+	}
+#elif defined(ACID_SIMD_SSE)
+	auto deltaV = _mm_set1_ps(delta);
+	auto gravityV = _mm_set1_ps(Gravity * delta);
+	auto fadeV = _mm_set1_ps(delta / FadeTime);
+	auto fadeTimeV = _mm_set1_ps(FadeTime);
+	auto cameraX = _mm_set1_ps(cameraPosition.m_x);
+	auto cameraY = _mm_set1_ps(cameraPosition.m_y);
+	auto cameraZ = _mm_set1_ps(cameraPosition.m_z);
+	auto zero = _mm_setzero_ps();
+
+	for (; i + 4 <= end; i += 4) {
+		auto velocityX = _mm_loadu_ps(&m_velocityX[i]);
+		auto velocityY = _mm_add_ps(_mm_loadu_ps(&m_velocityY[i]), _mm_mul_ps(gravityV, _mm_loadu_ps(&m_gravityEffect[i])));
+		auto velocityZ = _mm_loadu_ps(&m_velocityZ[i]);
+		_mm_storeu_ps(&m_velocityY[i], velocityY);
+
+		auto positionX = _mm_add_ps(_mm_loadu_ps(&m_positionX[i]), _mm_mul_ps(velocityX, deltaV));
+		auto positionY = _mm_add_ps(_mm_loadu_ps(&m_positionY[i]), _mm_mul_ps(velocityY, deltaV));
+		auto positionZ = _mm_add_ps(_mm_loadu_ps(&m_positionZ[i]), _mm_mul_ps(velocityZ, deltaV));
+		_mm_storeu_ps(&m_positionX[i], positionX);
+		_mm_storeu_ps(&m_positionY[i], positionY);
+		_mm_storeu_ps(&m_positionZ[i], positionZ);
+
+		auto elapsed = _mm_add_ps(_mm_loadu_ps(&m_elapsedTime[i]), deltaV);
+		_mm_storeu_ps(&m_elapsedTime[i], elapsed);
+
+		// Fades out particles at the end of their life.
+		auto fading = _mm_cmpgt_ps(elapsed, _mm_sub_ps(_mm_loadu_ps(&m_lifeLength[i]), fadeTimeV));
+		auto transparency = _mm_sub_ps(_mm_loadu_ps(&m_transparency[i]), _mm_and_ps(fading, fadeV));
+		_mm_storeu_ps(&m_transparency[i], transparency);
+
+		auto toCameraX = _mm_sub_ps(cameraX, positionX);
+		auto toCameraY = _mm_sub_ps(cameraY, positionY);
+		auto toCameraZ = _mm_sub_ps(cameraZ, positionZ);
+		auto distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(toCameraX, toCameraX), _mm_mul_ps(toCameraY, toCameraY)), _mm_mul_ps(toCameraZ, toCameraZ));
+		_mm_storeu_ps(&m_distanceToCamera[i], distance);
+
+		auto mask = _mm_movemask_ps(_mm_cmple_ps(transparency, zero));
+
+		for (uint32_t lane = 0; lane < 4; lane++) {
+			if (mask & (1 << lane))
+				dead.emplace_back(static_cast<uint32_t>(i + lane));
+		}
+	}
+#endif
+
+	// Scalar fallback, and the remainder that does not fill a vector.
+	for (; i < end; i++) {
+		m_velocityY[i] += Gravity * m_gravityEffect[i] * delta;
+		m_positionX[i] += m_velocityX[i] * delta;
+		m_positionY[i] += m_velocityY[i] * delta;
+		m_positionZ[i] += m_velocityZ[i] * delta;
+		m_elapsedTime[i] += delta;
+
+		if (m_elapsedTime[i] > m_lifeLength[i] - FadeTime) {
+			m_transparency[i] -= delta / FadeTime;
+		}
+
+		auto toCameraX = cameraPosition.m_x - m_positionX[i];
+		auto toCameraY = cameraPosition.m_y - m_positionY[i];
+		auto toCameraZ = cameraPosition.m_z - m_positionZ[i];
+		m_distanceToCamera[i] = toCameraX * toCameraX + toCameraY * toCameraY + toCameraZ * toCameraZ;
+
+		if (m_transparency[i] <= 0.0f)
+			dead.emplace_back(static_cast<uint32_t>(i));
+	}
+}
+
+void ParticleStore::RemoveDead(const std::vector<uint32_t> &dead) {
+	// Removing from the highest index down means the last particle is never a dead particle that is still to be removed.
+	for (auto it = dead.rbegin(); it != dead.rend(); ++it) {
+		auto index = *it;
+
+		for (auto stream : {&m_positionX, &m_positionY, &m_positionZ, &m_velocityX, &m_velocityY, &m_velocityZ, &m_lifeLength, &m_stageCycles, &m_rotation, &m_scale,
+			&m_gravityEffect, &m_elapsedTime, &m_transparency, &m_distanceToCamera}) {
+			(*stream)[index] = stream->back();
+			stream->pop_back();
+		}
+	}
+}
+
+void ParticleStore::SortDrawOrder() {
+	auto size = GetSize();
+	m_sortKeys.resize(size);
+	m_sortScratch.resize(size);
+	m_drawOrder.resize(size);
+
+	// The bits of a positive float sort the same as the float, the top 16 bits are the exponent and 7 bits of mantissa.
+	// Keys are inverted so the furthest particle comes first, and carry the index so passes read memory in order.
+	for (std::size_t i = 0; i < size; i++) {
+		uint32_t bits;
+		std::memcpy(&bits, &m_distanceToCamera[i], sizeof(bits));
+		m_sortKeys[i] = static_cast<uint64_t>(0xFFFF - (bits >> 16)) << 32 | i;
+	}
+
+	// Two stable 8-bit passes, least significant byte first.
+	for (uint32_t shift = 32; shift < 48; shift += 8) {
+		std::array<uint32_t, 256> offsets = {};
+
+		for (auto key : m_sortKeys)
+			offsets[(key >> shift) & 0xFF]++;
+
+		uint32_t total = 0;
+
+		for (auto &offset : offsets) {
+			auto count = offset;
+			offset = total;
+			total += count;
+		}
+
+		for (auto key : m_sortKeys)
+			m_sortScratch[offsets[(key >> shift) & 0xFF]++] = key;
+
+		m_sortKeys.swap(m_sortScratch);
+	}
+
+	for (std::size_t i = 0; i < size; i++) {
+		m_drawOrder[i] = static_cast<uint32_t>(m_sortKeys[i]);
+	}
+}
+}
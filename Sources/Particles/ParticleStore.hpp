@@ -0,0 +1,100 @@
+#pragma once
+
+#include <vector>
+
+#include "Maths/Vector3.hpp"
+#include "Helpers/ThreadPool.hpp"
+
+namespace acid {
+/**
+ * @brief Holds the live particles of a particle type as a structure of arrays, so particles can be integrated with SIMD.
+ * Dead particles are swap-removed, and a back to front draw order is kept with a radix sort on the quantized camera distance.
+ */
+class ACID_EXPORT ParticleStore {
+public:
+	// Particles per job when updating across a thread pool.
+	static constexpr std::size_t GrainSize = 16384;
+	// The time a particle takes to fade out at the end of its life.
+	static constexpr float FadeTime = 1.0f;
+
+	ParticleStore() = default;
+
+	/**
+	 * Adds a particle to the store.
+	 * @param position The particles initial position.
+	 * @param velocity The particles initial velocity.
+	 * @param lifeLength The particles life length.
+	 * @param stageCycles The amount of times stages will be shown.
+	 * @param rotation The particles rotation.
+	 * @param scale The particles scale.
+	 * @param gravityEffect The particles gravity effect.
+	 */
+	void Add(const Vector3f &position, const Vector3f &velocity, float lifeLength, float stageCycles, float rotation, float scale, float gravityEffect);
+
+	/**
+	 * Integrates every particle, removes dead particles and sorts the draw order.
+	 * @param delta The time step in seconds.
+	 * @param cameraPosition The position particles are sorted relative to.
+	 * @param pool The pool to split the update across, or nullptr to update on this thread.
+	 */
+	void Update(float delta, const Vector3f &cameraPosition, ThreadPool *pool = nullptr);
+
+	/**
+	 * Removes every particle.
+	 */
+	void Clear();
+
+	/**
+	 * Reserves space for a number of particles in every stream.
+	 * @param capacity The number of particles.
+	 */
+	void Reserve(std::size_t capacity);
+
+	std::size_t GetSize() const { return m_positionX.size(); }
+	bool IsEmpty() const { return m_positionX.empty(); }
+
+	Vector3f GetPosition(std::size_t index) const { return {m_positionX[index], m_positionY[index], m_positionZ[index]}; }
+	Vector3f GetVelocity(std::size_t index) const { return {m_velocityX[index], m_velocityY[index], m_velocityZ[index]}; }
+	float GetLifeLength(std::size_t index) const { return m_lifeLength[index]; }
+	float GetStageCycles(std::size_t index) const { return m_stageCycles[index]; }
+	float GetRotation(std::size_t index) const { return m_rotation[index]; }
+	float GetScale(std::size_t index) const { return m_scale[index]; }
+	float GetElapsedTime(std::size_t index) const { return m_elapsedTime[index]; }
+	float GetTransparency(std::size_t index) const { return m_transparency[index]; }
+	float GetDistanceToCamera(std::size_t index) const { return m_distanceToCamera[index]; }
+
+	// The raw streams, for processing particles in batches.
+	const std::vector<float> &GetPositionsX() const { return m_positionX; }
+	const std::vector<float> &GetPositionsY() const { return m_positionY; }
+	const std::vector<float> &GetPositionsZ() const { return m_positionZ; }
+	const std::vector<float> &GetScales() const { return m_scale; }
+
+	/**
+	 * Gets the particle indices sorted from furthest to nearest the camera, as of the last update.
+	 * @return The sorted particle indices.
+	 */
+	const std::vector<uint32_t> &GetDrawOrder() const { return m_drawOrder; }
+
+private:
+	void UpdateRange(std::size_t begin, std::size_t end, float delta, const Vector3f &cameraPosition, std::vector<uint32_t> &dead);
+	void RemoveDead(const std::vector<uint32_t> &dead);
+	void SortDrawOrder();
+
+	std::vector<float> m_positionX, m_positionY, m_positionZ;
+	std::vector<float> m_velocityX, m_velocityY, m_velocityZ;
+	std::vector<float> m_lifeLength;
+	std::vector<float> m_stageCycles;
+	std::vector<float> m_rotation;
+	std::vector<float> m_scale;
+	std::vector<float> m_gravityEffect;
+	std::vector<float> m_elapsedTime;
+	std::vector<float> m_transparency;
+	std::vector<float> m_distanceToCamera;
+
+	std::vector<uint32_t> m_drawOrder;
+	// Scratch space for the radix sort, the key is in the high 32 bits and the particle index in the low 32 bits.
+	std::vector<uint64_t> m_sortKeys, m_sortScratch;
+	// Dead particles found by each job of the last update.
+	std::vector<std::vector<uint32_t>> m_deadChunks;
+};
+}
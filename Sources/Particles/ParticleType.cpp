@@ -1,15 +1,21 @@
 #include "ParticleType.hpp"
 
+#include <numeric>
+
+#include "Engine/Engine.hpp"
+#include "Graphics/Graphics.hpp"
 #include "Resources/Resources.hpp"
 #include "Maths/Maths.hpp"
 #include "Models/Shapes/ModelRectangle.hpp"
 #include "Scenes/Scenes.hpp"
-#include "Particle.hpp"
+#include "ParticleStore.hpp"
 
 namespace acid {
-static const uint32_t MAX_INSTANCES = 1024;
-//static const uint32_t INSTANCE_STEPS = 128;
+static const uint32_t INSTANCE_STEPS = 1024;
 static const float FRUSTUM_BUFFER = 1.4f;
+// Particles per job when culling, and per job when writing instances.
+static const std::size_t CULL_GRAIN = 8192;
+static const std::size_t INSTANCE_GRAIN = 2048;
 
 std::shared_ptr<ParticleType> ParticleType::Create(const Node &node) {
 	if (auto resource = Resources::Get()->Find<ParticleType>(node))
@@ -38,54 +44,104 @@ ParticleType::ParticleType(std::shared_ptr<Image2d> image, uint32_t numberOfRows
 	m_colourOffset(colourOffset),
 	m_lifeLength(lifeLength),
 	m_stageCycles(stageCycles),
-	m_scale(scale),
-	m_instanceBuffer(sizeof(Instance) * MAX_INSTANCES) {
+	m_scale(scale) {
 }
 
-void ParticleType::Update(const std::vector<Particle> &particles) {
-	// Calculates a max instance count over the time of the type. TODO: Allow decreasing max using a timer and average count over the delay.
-	//uint32_t instances = INSTANCE_STEPS * static_cast<uint32_t>(std::ceil(static_cast<float>(particles.size()) / static_cast<float>(INSTANCE_STEPS)));
-	//m_maxInstances = std::max(m_maxInstances, instances);
-	m_maxInstances = MAX_INSTANCES;
+void ParticleType::Update(const ParticleStore &particles) {
 	m_instances = 0;
 
-	if (particles.empty()) {
+	auto camera = Scenes::Get()->GetCamera();
+
+	if (particles.IsEmpty() || !camera) {
 		return;
 	}
 
-	Instance *instances;
-	m_instanceBuffer.MapMemory(reinterpret_cast<void **>(&instances));
+	auto &pool = Engine::Get()->GetUpdatePool();
+	const auto &viewFrustum = camera->GetViewFrustum();
+	const auto &drawOrder = particles.GetDrawOrder();
 
-	for (const auto &particle : particles) {
-		if (m_instances >= m_maxInstances) {
-			break;
-		}
+	// Culls in store order, where the position and scale streams are contiguous.
+	m_visible.resize(particles.GetSize());
+	pool.ParallelForRange(0, particles.GetSize(), [&](std::size_t begin, std::size_t end) {
+		viewFrustum.SpheresInFrustum(&particles.GetPositionsX()[begin], &particles.GetPositionsY()[begin], &particles.GetPositionsZ()[begin],
+			&particles.GetScales()[begin], end - begin, &m_visible[begin], FRUSTUM_BUFFER);
+	}, CULL_GRAIN);
 
-		if (!Scenes::Get()->GetCamera()->GetViewFrustum().SphereInFrustum(particle.GetPosition(), FRUSTUM_BUFFER * particle.GetScale())) {
-			continue;
-		}
+	// Each chunk of the draw order counts its visible particles, the prefix sum gives each chunk its range of the instance buffer.
+	auto chunkCount = (drawOrder.size() + INSTANCE_GRAIN - 1) / INSTANCE_GRAIN;
+	m_chunkOffsets.resize(chunkCount + 1);
+	pool.ParallelFor(0, chunkCount, [&](std::size_t chunk) {
+		auto begin = chunk * INSTANCE_GRAIN;
+		auto end = std::min(begin + INSTANCE_GRAIN, drawOrder.size());
+		uint32_t visible = 0;
 
-		auto viewMatrix = Scenes::Get()->GetCamera()->GetViewMatrix();
-		auto instance = &instances[m_instances];
-		instance->m_modelMatrix = Matrix4().Translate(particle.GetPosition());
+		for (auto i = begin; i < end; i++)
+			visible += m_visible[drawOrder[i]];
 
-		for (uint32_t row = 0; row < 3; row++) {
-			for (uint32_t col = 0; col < 3; col++) {
-				instance->m_modelMatrix[row][col] = viewMatrix[col][row];
-			}
-		}
+		m_chunkOffsets[chunk + 1] = visible;
+	}, 1);
+
+	m_chunkOffsets[0] = 0;
+	std::partial_sum(m_chunkOffsets.begin(), m_chunkOffsets.end(), m_chunkOffsets.begin());
+	m_instances = m_chunkOffsets.back();
 
-		instance->m_modelMatrix = instance->m_modelMatrix.Rotate(particle.GetRotation(), Vector3f::Front);
-		instance->m_modelMatrix = instance->m_modelMatrix.Scale(Vector3f(particle.GetScale()));
-		// TODO: Multiply MVP by View and Projection (And run update every frame?)
+	if (m_instances == 0) {
+		return;
+	}
 
-		instance->m_colourOffset = particle.GetParticleType()->m_colourOffset;
-		instance->m_offsets = {particle.m_imageOffset1, particle.m_imageOffset2};
-		instance->m_blend = {particle.m_imageBlendFactor, particle.m_transparency, static_cast<float>(particle.m_particleType->m_numberOfRows)};
-		m_instances++;
+	// Grows the instance buffer in steps, it is never shrunk. Frames in flight may still draw from the old buffer.
+	if (m_instances > m_maxInstances) {
+		m_maxInstances = INSTANCE_STEPS * ((std::max(m_instances, 2 * m_maxInstances) + INSTANCE_STEPS - 1) / INSTANCE_STEPS);
+		Graphics::Get()->Retire(std::move(m_instanceBuffer));
+		m_instanceBuffer = std::make_unique<InstanceBuffer>(sizeof(Instance) * m_maxInstances);
 	}
 
-	m_instanceBuffer.UnmapMemory();
+	// The billboard faces the camera by using the transposed view rotation, rotated around the view axis and scaled.
+	const auto &viewMatrix = camera->GetViewMatrix();
+	Vector4f viewRight(viewMatrix[0][0], viewMatrix[1][0], viewMatrix[2][0], 0.0f);
+	Vector4f viewUp(viewMatrix[0][1], viewMatrix[1][1], viewMatrix[2][1], 0.0f);
+	Vector4f viewForward(viewMatrix[0][2], viewMatrix[1][2], viewMatrix[2][2], 0.0f);
+	auto stageCount = static_cast<int32_t>(m_numberOfRows * m_numberOfRows);
+
+	Instance *instances;
+	m_instanceBuffer->MapMemory(reinterpret_cast<void **>(&instances));
+
+	pool.ParallelFor(0, chunkCount, [&](std::size_t chunk) {
+		auto begin = chunk * INSTANCE_GRAIN;
+		auto end = std::min(begin + INSTANCE_GRAIN, drawOrder.size());
+		auto instance = &instances[m_chunkOffsets[chunk]];
+
+		for (auto i = begin; i < end; i++) {
+			auto index = drawOrder[i];
+
+			if (!m_visible[index]) {
+				continue;
+			}
+
+			auto scale = particles.GetScale(index);
+			auto rotation = particles.GetRotation(index);
+			auto c = std::cos(rotation) * scale;
+			auto s = std::sin(rotation) * scale;
+
+			instance->m_modelMatrix[0] = viewRight * c + viewUp * s;
+			instance->m_modelMatrix[1] = viewUp * c - viewRight * s;
+			instance->m_modelMatrix[2] = viewForward * scale;
+			instance->m_modelMatrix[3] = Vector4f(particles.GetPosition(index), 1.0f);
+			// TODO: Multiply MVP by View and Projection (And run update every frame?)
+
+			// Blends between the two atlas stages the particle is between over its life.
+			auto atlasProgression = particles.GetStageCycles(index) * particles.GetElapsedTime(index) / particles.GetLifeLength(index) * stageCount;
+			auto index1 = static_cast<int32_t>(std::floor(atlasProgression));
+			auto index2 = index1 < stageCount - 1 ? index1 + 1 : index1;
+
+			instance->m_colourOffset = m_colourOffset;
+			instance->m_offsets = {CalculateImageOffset(index1), CalculateImageOffset(index2)};
+			instance->m_blend = {std::fmod(atlasProgression, 1.0f), particles.GetTransparency(index), static_cast<float>(m_numberOfRows)};
+			instance++;
+		}
+	}, 1);
+
+	m_instanceBuffer->UnmapMemory();
 }
 
 bool ParticleType::CmdRender(const CommandBuffer &commandBuffer, const PipelineGraphics &pipeline, UniformHandler &uniformScene) {
@@ -104,7 +160,7 @@ bool ParticleType::CmdRender(const CommandBuffer &commandBuffer, const PipelineG
 	// Draws the instanced objects.
 	m_descriptorSet.BindDescriptor(commandBuffer, pipeline);
 
-	VkBuffer vertexBuffers[2] = {m_model->GetVertexBuffer()->GetBuffer(), m_instanceBuffer.GetBuffer()};
+	VkBuffer vertexBuffers[2] = {m_model->GetVertexBuffer()->GetBuffer(), m_instanceBuffer->GetBuffer()};
 	VkDeviceSize offsets[2] = {0, 0};
 	vkCmdBindVertexBuffers(commandBuffer, 0, 2, vertexBuffers, offsets);
 	vkCmdBindIndexBuffer(commandBuffer, m_model->GetIndexBuffer()->GetBuffer(), 0, m_model->GetIndexType());
@@ -112,6 +168,12 @@ bool ParticleType::CmdRender(const CommandBuffer &commandBuffer, const PipelineG
 	return true;
 }
 
+Vector2f ParticleType::CalculateImageOffset(int32_t index) const {
+	auto column = index % m_numberOfRows;
+	auto row = index / m_numberOfRows;
+	return Vector2f(static_cast<float>(column), static_cast<float>(row)) / m_numberOfRows;
+}
+
 const Node &operator>>(const Node &node, ParticleType &particleType) {
 	node["image"].Get(particleType.m_image);
 	node["numberOfRows"].Get(particleType.m_numberOfRows);
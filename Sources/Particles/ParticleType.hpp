@@ -12,7 +12,7 @@
 #include "Resources/Resource.hpp"
 
 namespace acid {
-class Particle;
+class ParticleStore;
 
 /**
  * @brief Resource that represents a particle type.
@@ -75,7 +75,11 @@ public:
 	explicit ParticleType(std::shared_ptr<Image2d> image, uint32_t numberOfRows = 1, const Colour &colourOffset = Colour::Black, float lifeLength = 10.0f,
 		float stageCycles = 1.0f, float scale = 1.0f);
 
-	void Update(const std::vector<Particle> &particles);
+	/**
+	 * Writes the visible particles of this type into the instance buffer, in the stores draw order.
+	 * @param particles The particles of this type.
+	 */
+	void Update(const ParticleStore &particles);
 
 	bool CmdRender(const CommandBuffer &commandBuffer, const PipelineGraphics &pipeline, UniformHandler &uniformScene);
 
@@ -103,6 +107,8 @@ public:
 	friend Node &operator<<(Node &node, const ParticleType &particleType);
 
 private:
+	Vector2f CalculateImageOffset(int32_t index) const;
+
 	std::shared_ptr<Image2d> m_image;
 	std::shared_ptr<Model> m_model;
 	uint32_t m_numberOfRows;
@@ -111,10 +117,16 @@ private:
 	float m_stageCycles;
 	float m_scale;
 
+	// The number of instances the instance buffer has space for.
 	uint32_t m_maxInstances = 0;
 	uint32_t m_instances = 0;
 
+	// If each particle was in the frustum on the last update, indexed like the store.
+	std::vector<uint8_t> m_visible;
+	// The first instance written by each chunk of the draw order.
+	std::vector<uint32_t> m_chunkOffsets;
+
 	DescriptorsHandler m_descriptorSet;
-	InstanceBuffer m_instanceBuffer;
+	std::unique_ptr<InstanceBuffer> m_instanceBuffer;
 };
 }
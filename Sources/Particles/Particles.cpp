@@ -11,38 +11,30 @@ void Particles::Update() {
 		return;
 	}
 
-	for (auto it = m_particles.begin(); it != m_particles.end();) {
-		for (auto it1 = (*it).second.begin(); it1 != (*it).second.end();) {
-			(*it1).Update();
+	auto delta = Engine::Get()->GetDelta().AsSeconds();
+	Vector3f cameraPosition;
 
-			if (!(*it1).IsAlive()) {
-				it1 = (*it).second.erase(it1);
-				continue;
-			}
+	if (auto camera = Scenes::Get()->GetCamera()) {
+		cameraPosition = camera->GetPosition();
+	}
 
-			++it1;
-		}
+	for (auto it = m_particles.begin(); it != m_particles.end();) {
+		(*it).second.Update(delta, cameraPosition, &Engine::Get()->GetUpdatePool());
 
-		if (it->second.empty()) {
+		if ((*it).second.IsEmpty()) {
 			it = m_particles.erase(it);
 			continue;
 		}
 
-		std::sort((*it).second.begin(), (*it).second.end());
 		(*it).first->Update((*it).second);
 		++it;
 	}
 }
 
 void Particles::AddParticle(Particle &&particle) {
-	auto it = m_particles.find(particle.GetParticleType());
-
-	if (it == m_particles.end()) {
-		m_particles.emplace(particle.GetParticleType(), std::vector<Particle>());
-		it = m_particles.find(particle.GetParticleType());
-	}
-
-	(*it).second.emplace_back(std::move(particle));
+	auto &store = m_particles[particle.GetParticleType()];
+	store.Add(particle.GetPosition(), particle.GetVelocity(), particle.GetLifeLength(), particle.GetStageCycles(), particle.GetRotation(), particle.GetScale(),
+		particle.GetGravityEffect());
 }
 
 /*void Particles::RemoveParticle(const Particle &particle) {
@@ -1,15 +1,17 @@
 #pragma once
 
 #include "Engine/Engine.hpp"
+#include "Scenes/Scenes.hpp"
 #include "Particle.hpp"
+#include "ParticleStore.hpp"
 
 namespace acid {
 /**
  * @brief A manager that manages particles.
  */
-class ACID_EXPORT Particles : public Module::Registrar<Particles, Module::Stage::Normal> {
+class ACID_EXPORT Particles : public Module::Registrar<Particles, Module::Stage::Normal, Module::Concurrent, Module::Reads<Scenes>> {
 public:
-	using ParticlesContainer = std::map<std::shared_ptr<ParticleType>, std::vector<Particle>>;
+	using ParticlesContainer = std::map<std::shared_ptr<ParticleType>, ParticleStore>;
 
 	Particles();
 
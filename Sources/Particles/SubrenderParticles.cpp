@@ -19,7 +19,7 @@ void SubrenderParticles::Render(const CommandBuffer &commandBuffer) {
 
 	m_pipeline.BindPipeline(commandBuffer);
 
-	auto particles = Particles::Get()->GetParticles();
+	const auto &particles = Particles::Get()->GetParticles();
 
 	for (auto &[type, typeParticles] : particles) {
 		type->CmdRender(commandBuffer, m_pipeline, m_uniformScene);
@@ -1,76 +1,29 @@
 #include "Frustum.hpp"
 
+#include "Maths/Simd.hpp"
+
 namespace acid {
 void Frustum::Update(const Matrix4 &view, const Matrix4 &projection) {
-	std::array<float, 16> clip;
-
-	clip[0] = view[0][0] * projection[0][0] + view[0][1] * projection[1][0] + view[0][2] * projection[2][0] + view[0][3] * projection[3][0];
-	clip[1] = view[0][0] * projection[0][1] + view[0][1] * projection[1][1] + view[0][2] * projection[2][1] + view[0][3] * projection[3][1];
-	clip[2] = view[0][0] * projection[0][2] + view[0][1] * projection[1][2] + view[0][2] * projection[2][2] + view[0][3] * projection[3][2];
-	clip[3] = view[0][0] * projection[0][3] + view[0][1] * projection[1][3] + view[0][2] * projection[2][3] + view[0][3] * projection[3][3];
-
-	clip[4] = view[1][0] * projection[0][0] + view[1][1] * projection[1][0] + view[1][2] * projection[2][0] + view[1][3] * projection[3][0];
-	clip[5] = view[1][0] * projection[0][1] + view[1][1] * projection[1][1] + view[1][2] * projection[2][1] + view[1][3] * projection[3][1];
-	clip[6] = view[1][0] * projection[0][2] + view[1][1] * projection[1][2] + view[1][2] * projection[2][2] + view[1][3] * projection[3][2];
-	clip[7] = view[1][0] * projection[0][3] + view[1][1] * projection[1][3] + view[1][2] * projection[2][3] + view[1][3] * projection[3][3];
-
-	clip[8] = view[2][0] * projection[0][0] + view[2][1] * projection[1][0] + view[2][2] * projection[2][0] + view[2][3] * projection[3][0];
-	clip[9] = view[2][0] * projection[0][1] + view[2][1] * projection[1][1] + view[2][2] * projection[2][1] + view[2][3] * projection[3][1];
-	clip[10] = view[2][0] * projection[0][2] + view[2][1] * projection[1][2] + view[2][2] * projection[2][2] + view[2][3] * projection[3][2];
-	clip[11] = view[2][0] * projection[0][3] + view[2][1] * projection[1][3] + view[2][2] * projection[2][3] + view[2][3] * projection[3][3];
+	// The columns of the combined matrix, each plane is the last column plus or minus another column.
+	auto clip = projection.Multiply(view).Transpose();
 
-	clip[12] = view[3][0] * projection[0][0] + view[3][1] * projection[1][0] + view[3][2] * projection[2][0] + view[3][3] * projection[3][0];
-	clip[13] = view[3][0] * projection[0][1] + view[3][1] * projection[1][1] + view[3][2] * projection[2][1] + view[3][3] * projection[3][1];
-	clip[14] = view[3][0] * projection[0][2] + view[3][1] * projection[1][2] + view[3][2] * projection[2][2] + view[3][3] * projection[3][2];
-	clip[15] = view[3][0] * projection[0][3] + view[3][1] * projection[1][3] + view[3][2] * projection[2][3] + view[3][3] * projection[3][3];
+	auto setPlane = [this](int32_t side, const Vector4f &plane) {
+		m_frustum[side] = {plane.m_x, plane.m_y, plane.m_z, plane.m_w};
+		NormalizePlane(side);
+	};
 
 	// This will extract the LEFT side of the frustum.
-	m_frustum[1][0] = clip[3] - clip[0];
-	m_frustum[1][1] = clip[7] - clip[4];
-	m_frustum[1][2] = clip[11] - clip[8];
-	m_frustum[1][3] = clip[15] - clip[12];
-
-	NormalizePlane(1);
-
+	setPlane(1, clip[3] - clip[0]);
 	// This will extract the RIGHT side of the frustum.
-	m_frustum[0][0] = clip[3] + clip[0];
-	m_frustum[0][1] = clip[7] + clip[4];
-	m_frustum[0][2] = clip[11] + clip[8];
-	m_frustum[0][3] = clip[15] + clip[12];
-
-	NormalizePlane(0);
-
+	setPlane(0, clip[3] + clip[0]);
 	// This will extract the BOTTOM side of the frustum.
-	m_frustum[2][0] = clip[3] + clip[1];
-	m_frustum[2][1] = clip[7] + clip[5];
-	m_frustum[2][2] = clip[11] + clip[9];
-	m_frustum[2][3] = clip[15] + clip[13];
-
-	NormalizePlane(2);
-
+	setPlane(2, clip[3] + clip[1]);
 	// This will extract the TOP side of the frustum.
-	m_frustum[3][0] = clip[3] - clip[1];
-	m_frustum[3][1] = clip[7] - clip[5];
-	m_frustum[3][2] = clip[11] - clip[9];
-	m_frustum[3][3] = clip[15] - clip[13];
-
-	NormalizePlane(3);
-
+	setPlane(3, clip[3] - clip[1]);
 	// This will extract the BACK side of the frustum.
-	m_frustum[4][0] = clip[3] + clip[2];
-	m_frustum[4][1] = clip[7] + clip[6];
-	m_frustum[4][2] = clip[11] + clip[10];
-	m_frustum[4][3] = clip[15] + clip[14];
-
-	NormalizePlane(4);
-
+	setPlane(4, clip[3] + clip[2]);
 	// This will extract the FRONT side of the frustum.
-	m_frustum[5][0] = clip[3] - clip[2];
-	m_frustum[5][1] = clip[7] - clip[6];
-	m_frustum[5][2] = clip[11] - clip[10];
-	m_frustum[5][3] = clip[15] - clip[14];
-
-	NormalizePlane(5);
+	setPlane(5, clip[3] - clip[2]);
 }
 
 bool Frustum::PointInFrustum(const Vector3f &position) const {
@@ -93,6 +46,110 @@ bool Frustum::SphereInFrustum(const Vector3f &position, float radius) const {
 	return true;
 }
 
+void Frustum::SpheresInFrustum(const float *x, const float *y, const float *z, const float *radius, std::size_t count, uint8_t *visible,
+	float radiusScale) const {
+	std::size_t i = 0;
+
+#if defined(ACID_SIMD_AVX)
+	__m256 planes8[6][4];
+
+	for (uint32_t p = 0; p < 6; p++) {
+		for (uint32_t j = 0; j < 4; j++) {
+			planes8[p][j] = _mm256_set1_ps(m_frustum[p][j]);
+		}
+	}
+
+	auto negativeScale8 = _mm256_set1_ps(-radiusScale);
+
+	for (; i + 8 <= count; i += 8) {
+		auto positionX = _mm256_loadu_ps(x + i);
+		auto positionY = _mm256_loadu_ps(y + i);
+		auto positionZ = _mm256_loadu_ps(z + i);
+		auto negativeRadius = _mm256_mul_ps(_mm256_loadu_ps(radius + i), negativeScale8);
+		auto inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+		for (const auto &plane : planes8) {
+			auto distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(plane[0], positionX), _mm256_mul_ps(plane[1], positionY)),
+				_mm256_add_ps(_mm256_mul_ps(plane[2], positionZ), plane[3]));
+			inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, negativeRadius, _CMP_GT_OQ));
+		}
+
+		auto mask = _mm256_movemask_ps(inside);
+
+		for (uint32_t lane = 0; lane < 8; lane++) {
+			visible[i + lane] = (mask >> lane) & 1;
+		}
+	}
+#endif
+
+#if defined(ACID_SIMD_SSE)
+	__m128 planes[6][4];
+
+	for (uint32_t p = 0; p < 6; p++) {
+		for (uint32_t j = 0; j < 4; j++) {
+			planes[p][j] = _mm_set1_ps(m_frustum[p][j]);
+		}
+	}
+
+	auto negativeScale = _mm_set1_ps(-radiusScale);
+
+	for (; i + 4 <= count; i += 4) {
+		auto positionX = _mm_loadu_ps(x + i);
+		auto positionY = _mm_loadu_ps(y + i);
+		auto positionZ = _mm_loadu_ps(z + i);
+		auto negativeRadius = _mm_mul_ps(_mm_loadu_ps(radius + i), negativeScale);
+		auto inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+		for (const auto &plane : planes) {
+			auto distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(plane[0], positionX), _mm_mul_ps(plane[1], positionY)),
+				_mm_add_ps(_mm_mul_ps(plane[2], positionZ), plane[3]));
+			inside = _mm_and_ps(inside, _mm_cmpgt_ps(distance, negativeRadius));
+		}
+
+		auto mask = _mm_movemask_ps(inside);
+
+		for (uint32_t lane = 0; lane < 4; lane++) {
+			visible[i + lane] = (mask >> lane) & 1;
+		}
+	}
+#elif defined(ACID_SIMD_NEON)
+	float32x4_t planes[6][4];
+
+	for (uint32_t p = 0; p < 6; p++) {
+		for (uint32_t j = 0; j < 4; j++) {
+			planes[p][j] = vdupq_n_f32(m_frustum[p][j]);
+		}
+	}
+
+	auto negativeScale = vdupq_n_f32(-radiusScale);
+
+	for (; i + 4 <= count; i += 4) {
+		auto positionX = vld1q_f32(x + i);
+		auto positionY = vld1q_f32(y + i);
+		auto positionZ = vld1q_f32(z + i);
+		auto negativeRadius = vmulq_f32(vld1q_f32(radius + i), negativeScale);
+		auto inside = vdupq_n_u32(~0u);
+
+		for (const auto &plane : planes) {
+			auto distance = vaddq_f32(vaddq_f32(vmulq_f32(plane[0], positionX), vmulq_f32(plane[1], positionY)),
+				vaddq_f32(vmulq_f32(plane[2], positionZ), plane[3]));
+			inside = vandq_u32(inside, vcgtq_f32(distance, negativeRadius));
+		}
+
+		uint32_t lanes[4];
+		vst1q_u32(lanes, inside);
+
+		for (uint32_t lane = 0; lane < 4; lane++) {
+			visible[i + lane] = lanes[lane] & 1;
+		}
+	}
+#endif
+
+	for (; i < count; i++) {
+		visible[i] = SphereInFrustum({x[i], y[i], z[i]}, radius[i] * radiusScale);
+	}
+}
+
 bool Frustum::CubeInFrustum(const Vector3f &min, const Vector3f &max) const {
 	for (uint32_t i = 0; i < 6; i++) {
 		if (m_frustum[i][0] * min.m_x + m_frustum[i][1] * min.m_y + m_frustum[i][2] * min.m_z + m_frustum[i][3] <= 0.0f
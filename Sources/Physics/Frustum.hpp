@@ -34,6 +34,19 @@ public:
 	 */
 	bool SphereInFrustum(const Vector3f &position, float radius) const;
 
+	/**
+	 * Tests a batch of spheres stored as separate arrays against the frustum, several spheres at a time.
+	 * @param x The spheres x positions.
+	 * @param y The spheres y positions.
+	 * @param z The spheres z positions.
+	 * @param radius The spheres radii.
+	 * @param count The number of spheres.
+	 * @param visible Written with 1 for every sphere that is contained, and 0 otherwise.
+	 * @param radiusScale The amount every radius is multiplied by.
+	 */
+	void SpheresInFrustum(const float *x, const float *y, const float *z, const float *radius, std::size_t count, uint8_t *visible,
+		float radiusScale = 1.0f) const;
+
 	/**
 	 * Gets if a cube contained in the frustum.
 	 * @param min The cube min point.
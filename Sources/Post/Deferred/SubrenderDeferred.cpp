@@ -33,7 +33,7 @@ void SubrenderDeferred::Render(const CommandBuffer &commandBuffer) {
 
 	// TODO probably use a cubemap image directly instead of scene components.
 	std::shared_ptr<ImageCube> skybox = nullptr;
-	auto meshes = Scenes::Get()->GetStructure()->QueryComponents<Mesh>();
+	const auto &meshes = Scenes::Get()->GetStructure()->QueryComponents<Mesh>();
 	for (const auto &mesh : meshes) {
 		if (auto materialSkybox = dynamic_cast<const MaterialSkybox *>(mesh->GetMaterial())) {
 			skybox = materialSkybox->GetImage();
@@ -51,7 +51,7 @@ void SubrenderDeferred::Render(const CommandBuffer &commandBuffer) {
 	std::vector<DeferredLight> deferredLights(MAX_LIGHTS);
 	uint32_t lightCount = 0;
 
-	auto sceneLights = Scenes::Get()->GetStructure()->QueryComponents<Light>();
+	const auto &sceneLights = Scenes::Get()->GetStructure()->QueryComponents<Light>();
 
 	for (const auto &light : sceneLights) {
 		//auto position = *light->GetPosition();
@@ -2,14 +2,16 @@
 
 namespace acid {
 Resources::Resources() :
-	m_elapsedPurge(5s) {
+	m_elapsedPurge(5s),
+	m_threadPool(Engine::GetLoaderThreadCount()),
+	m_fileQueue(&m_threadPool) {
 }
 
 void Resources::Update() {
 	if (m_elapsedPurge.GetElapsed() != 0) {
 		for (auto it = m_resources.begin(); it != m_resources.end();) {
 			for (auto it1 = it->second.begin(); it1 != it->second.end();) {
-				if ((*it1).second.use_count() <= 1) {
+				if ((*it1).second.resource.use_count() <= 1) {
 					it1 = it->second.erase(it1);
 					continue;
 				}
@@ -28,31 +30,48 @@ void Resources::Update() {
 }
 
 std::shared_ptr<Resource> Resources::Find(const std::type_index &typeIndex, const Node &node) const {
-	if (m_resources.find(typeIndex) == m_resources.end())
+	auto it = m_resources.find(typeIndex);
+	if (it == m_resources.end())
 		return nullptr;
 
-	for (const auto &[key, resource] : m_resources.at(typeIndex)) {
-		if (key == node)
-			return resource;
+	auto [begin, end] = it->second.equal_range(node.GetHash());
+	for (auto it1 = begin; it1 != end; ++it1) {
+		if (it1->second.node == node)
+			return it1->second.resource;
 	}
 
 	return nullptr;
 }
 
 void Resources::Add(const Node &node, const std::shared_ptr<Resource> &resource) {
-	if (Find(resource->GetTypeIndex(), node))
-		return;
+	auto &resources = m_resources[resource->GetTypeIndex()];
+	auto hash = node.GetHash();
 
-	m_resources[resource->GetTypeIndex()].emplace(node, resource);
+	auto [begin, end] = resources.equal_range(hash);
+	for (auto it = begin; it != end; ++it) {
+		if (it->second.node == node)
+			return;
+	}
+
+	resources.emplace(hash, ResourceEntry{node, resource});
 }
 
 void Resources::Remove(const std::shared_ptr<Resource> &resource) {
-	auto &resources = m_resources[resource->GetTypeIndex()];
-	for (auto it = resources.begin(); it != resources.end(); ++it) { // TODO: Clean remove.
-		if ((*it).second == resource)
-			resources.erase(it);
+	auto it = m_resources.find(resource->GetTypeIndex());
+	if (it == m_resources.end())
+		return;
+
+	auto &resources = it->second;
+	for (auto it1 = resources.begin(); it1 != resources.end();) {
+		if (it1->second.resource == resource) {
+			it1 = resources.erase(it1);
+			continue;
+		}
+
+		++it1;
 	}
+
 	if (resources.empty())
-		m_resources.erase(resource->GetTypeIndex());
+		m_resources.erase(it);
 }
 }
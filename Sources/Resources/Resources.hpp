@@ -2,13 +2,15 @@
 
 #include "Engine/Engine.hpp"
 #include "Helpers/ThreadPool.hpp"
+#include "Files/FileQueue.hpp"
 #include "Files/Node.hpp"
 #include "Resource.hpp"
 
 namespace acid {
 /**
  * @brief Module used for managing resources. Resources are held alive as long as they are in use,
- * a existing resource is queried by node value.
+ * a existing resource is queried by node value. Nodes are indexed by their structural hash,
+ * so a lookup only compares nodes when hashes collide.
  */
 class ACID_EXPORT Resources : public Module::Registrar<Resources, Module::Stage::Post> {
 public:
@@ -20,17 +22,9 @@ public:
 
 	template<typename T>
 	std::shared_ptr<T> Find(const Node &node) const {
-		if (m_resources.find(typeid(T)) == m_resources.end())
-			return nullptr;
-		
-		for (const auto &[key, resource] : m_resources.at(typeid(T))) {
-			if (key == node)
-				return std::dynamic_pointer_cast<T>(resource);
-		}
-		
-		return nullptr;
+		return std::dynamic_pointer_cast<T>(Find(typeid(T), node));
 	}
-	
+
 	void Add(const Node &node, const std::shared_ptr<Resource> &resource);
 	void Remove(const std::shared_ptr<Resource> &resource);
 
@@ -40,10 +34,25 @@ public:
 	 */
 	ThreadPool &GetThreadPool() { return m_threadPool; }
 
+	/**
+	 * Gets the resource loader file queue, completion callbacks run on the resource loader thread pool.
+	 * @return The resource loader file queue.
+	 */
+	FileQueue &GetFileQueue() { return m_fileQueue; }
+
 private:
-	std::unordered_map<std::type_index, std::map<Node, std::shared_ptr<Resource>>> m_resources;
+	class ResourceEntry {
+	public:
+		Node node;
+		std::shared_ptr<Resource> resource;
+	};
+
+	// Resources by type, then by the structural hash of the node they were created from.
+	std::unordered_map<std::type_index, std::unordered_multimap<uint64_t, ResourceEntry>> m_resources;
 	ElapsedTime m_elapsedPurge;
 
 	ThreadPool m_threadPool;
+	// Destroyed before the pool, so callbacks in flight finish first.
+	FileQueue m_fileQueue;
 };
 }
@@ -0,0 +1,17 @@
+#include "Component.hpp"
+
+#include "Entity.hpp"
+#include "SceneStructure.hpp"
+
+namespace acid {
+void Component::SetEnabled(bool enable) {
+	if (m_enabled == enable)
+		return;
+
+	m_enabled = enable;
+
+	// Cached queries only list enabled components.
+	if (m_entity && m_entity->GetStructure())
+		m_entity->GetStructure()->InvalidateQueries(this);
+}
+}
@@ -1,11 +1,16 @@
 #pragma once
 
+#include <functional>
+#include <vector>
+
 #include "Engine/Log.hpp"
 #include "Helpers/Delegate.hpp"
 #include "Helpers/StreamFactory.hpp"
 
 namespace acid {
 class Entity;
+class SceneStructure;
+class ThreadPool;
 
 /**
  * @brief Class that represents a functional component attached to entity.
@@ -27,8 +32,19 @@ public:
 	virtual void Update() {
 	}
 
+	/**
+	 * Run once a frame after every entity has updated, with the structure to query components from and the pool to spread them across.
+	 */
+	using BatchUpdate = std::function<void(SceneStructure &structure, ThreadPool *pool)>;
+
+	/**
+	 * Gets the batch updates registered by component types, in the order they were registered.
+	 * @return The batch updates.
+	 */
+	static const std::vector<BatchUpdate> &GetBatchUpdates() { return BatchUpdateRegistry(); }
+
 	bool IsEnabled() const { return m_enabled; };
-	void SetEnabled(bool enable) { m_enabled = enable; }
+	void SetEnabled(bool enable);
 
 	bool IsRemoved() const { return m_removed; }
 	void SetRemoved(bool removed) { m_removed = removed; }
@@ -45,7 +61,23 @@ public:
 	 */
 	void SetEntity(Entity *entity) { m_entity = entity; }
 
+protected:
+	/**
+	 * Registers an update for every component of a type at once, for components that do their work together instead of in {@link Component#Update}.
+	 * @param update The batch update.
+	 * @return If the update was registered, so it can initialize a static.
+	 */
+	static bool RegisterBatchUpdate(BatchUpdate &&update) {
+		BatchUpdateRegistry().emplace_back(std::move(update));
+		return true;
+	}
+
 private:
+	static std::vector<BatchUpdate> &BatchUpdateRegistry() {
+		static std::vector<BatchUpdate> impl;
+		return impl;
+	}
+
 	bool m_started = false;
 	bool m_enabled = true;
 	bool m_removed = false;
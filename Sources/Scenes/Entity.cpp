@@ -2,6 +2,7 @@
 
 #include "Scenes.hpp"
 #include "EntityPrefab.hpp"
+#include "SceneStructure.hpp"
 
 namespace acid {
 Entity::Entity(const std::filesystem::path &filename) {
@@ -12,6 +13,7 @@ Entity::Entity(const std::filesystem::path &filename) {
 void Entity::Update() {
 	for (auto it = m_components.begin(); it != m_components.end();) {
 		if ((*it)->IsRemoved()) {
+			DetachComponent((*it).get());
 			it = m_components.erase(it);
 			continue;
 		}
@@ -39,18 +41,36 @@ Component *Entity::AddComponent(std::unique_ptr<Component> &&component) {
 	}
 
 	component->SetEntity(this);
-	return m_components.emplace_back(std::move(component)).get();
+	auto added = m_components.emplace_back(std::move(component)).get();
+
+	if (m_structure) {
+		m_structure->AttachComponent(added);
+	}
+
+	return added;
 }
 
 void Entity::RemoveComponent(Component *component) {
-	m_components.erase(std::remove_if(m_components.begin(), m_components.end(), [component](std::unique_ptr<Component> &c) {
-		return c.get() == component;
+	m_components.erase(std::remove_if(m_components.begin(), m_components.end(), [this, component](std::unique_ptr<Component> &c) {
+		if (c.get() != component)
+			return false;
+		DetachComponent(c.get());
+		return true;
 	}), m_components.end());
 }
 
 void Entity::RemoveComponent(const std::string &name) {
-	m_components.erase(std::remove_if(m_components.begin(), m_components.end(), [name](std::unique_ptr<Component> &c) {
-		return name == c->GetTypeName();
+	m_components.erase(std::remove_if(m_components.begin(), m_components.end(), [this, name](std::unique_ptr<Component> &c) {
+		if (name != c->GetTypeName())
+			return false;
+		DetachComponent(c.get());
+		return true;
 	}), m_components.end());
 }
+
+void Entity::DetachComponent(Component *component) {
+	if (m_structure) {
+		m_structure->DetachComponent(component);
+	}
+}
 }
@@ -4,10 +4,13 @@
 #include "Component.hpp"
 
 namespace acid {
+class SceneStructure;
+
 /**
  * @brief Class that represents a objects that acts as a component container.
  */
 class ACID_EXPORT Entity : NonCopyable {
+	friend class SceneStructure;
 public:
 	Entity() = default;
 
@@ -120,13 +123,17 @@ public:
 	 */
 	template<typename T>
 	void RemoveComponent() {
-		for (auto it = m_components.begin(); it != m_components.end(); ++it) {
+		for (auto it = m_components.begin(); it != m_components.end();) {
 			auto casted = dynamic_cast<T *>((*it).get());
 
 			if (casted) {
+				DetachComponent((*it).get());
 				(*it)->SetEntity(nullptr);
-				m_components.erase(it);
+				it = m_components.erase(it);
+				continue;
 			}
+
+			++it;
 		}
 	}
 
@@ -136,9 +143,22 @@ public:
 	bool IsRemoved() const { return m_removed; }
 	void SetRemoved(bool removed) { m_removed = removed; }
 
+	/**
+	 * Gets the structure this entity is stored in.
+	 * @return The structure, nullptr if the entity is not in a structure.
+	 */
+	SceneStructure *GetStructure() const { return m_structure; }
+
 private:
+	/**
+	 * Removes a component from the structures archetype pools before it is erased.
+	 * @param component The component being erased.
+	 */
+	void DetachComponent(Component *component);
+
 	std::string m_name;
 	std::vector<std::unique_ptr<Component>> m_components;
 	bool m_removed = false;
+	SceneStructure *m_structure = nullptr;
 };
 }
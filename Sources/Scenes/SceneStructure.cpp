@@ -3,7 +3,8 @@
 #include "Physics/Rigidbody.hpp"
 
 namespace acid {
-SceneStructure::SceneStructure() {
+SceneStructure::SceneStructure(bool archetypes) :
+	m_archetypes(archetypes) {
 }
 
 Entity *SceneStructure::GetEntity(const std::string &name) const {
@@ -17,24 +18,32 @@ Entity *SceneStructure::GetEntity(const std::string &name) const {
 }
 
 Entity *SceneStructure::CreateEntity() {
-	return m_objects.emplace_back(std::make_unique<Entity>()).get();
+	auto object = m_objects.emplace_back(std::make_unique<Entity>()).get();
+	AttachEntity(object);
+	return object;
 }
 
 Entity *SceneStructure::CreateEntity(const std::string &filename) {
-	return m_objects.emplace_back(std::make_unique<Entity>(filename)).get();
+	auto object = m_objects.emplace_back(std::make_unique<Entity>(filename)).get();
+	AttachEntity(object);
+	return object;
 }
 
 void SceneStructure::Add(Entity *object) {
 	m_objects.emplace_back(object);
+	AttachEntity(object);
 }
 
 void SceneStructure::Add(std::unique_ptr<Entity> object) {
-	m_objects.emplace_back(std::move(object));
+	AttachEntity(m_objects.emplace_back(std::move(object)).get());
 }
 
 void SceneStructure::Remove(Entity *object) {
-	m_objects.erase(std::remove_if(m_objects.begin(), m_objects.end(), [object](std::unique_ptr<Entity> &e) {
-		return e.get() == object;
+	m_objects.erase(std::remove_if(m_objects.begin(), m_objects.end(), [this, object](std::unique_ptr<Entity> &e) {
+		if (e.get() != object)
+			return false;
+		DetachEntity(e.get());
+		return true;
 	}), m_objects.end());
 }
 
@@ -44,18 +53,26 @@ void SceneStructure::Move(Entity *object, SceneStructure &structure) {
 			continue;
 		}
 
+		DetachEntity((*it).get());
 		structure.Add(std::move(*it));
 		m_objects.erase(it);
 	}
 }
 
 void SceneStructure::Clear() {
+	for (auto &object : m_objects) {
+		object->m_structure = nullptr;
+	}
+
 	m_objects.clear();
+	m_pools.clear();
+	InvalidateQueries();
 }
 
 void SceneStructure::Update() {
 	for (auto it = m_objects.begin(); it != m_objects.end();) {
 		if ((*it)->IsRemoved()) {
+			DetachEntity((*it).get());
 			it = m_objects.erase(it);
 			continue;
 		}
@@ -116,4 +133,77 @@ bool SceneStructure::Contains(Entity *object) {
 
 	return false;
 }
+
+void SceneStructure::SetArchetypes(bool archetypes) {
+	if (m_archetypes == archetypes)
+		return;
+
+	m_archetypes = archetypes;
+	m_pools.clear();
+	InvalidateQueries();
+
+	if (m_archetypes) {
+		for (const auto &object : m_objects) {
+			for (const auto &component : object->GetComponents()) {
+				AttachComponent(component.get());
+			}
+		}
+	}
+}
+
+void SceneStructure::AttachEntity(Entity *object) {
+	object->m_structure = this;
+
+	for (const auto &component : object->GetComponents()) {
+		AttachComponent(component.get());
+	}
+}
+
+void SceneStructure::DetachEntity(Entity *object) {
+	for (const auto &component : object->GetComponents()) {
+		DetachComponent(component.get());
+	}
+
+	object->m_structure = nullptr;
+}
+
+void SceneStructure::AttachComponent(Component *component) {
+	if (!m_archetypes)
+		return;
+
+	m_pools[component->GetTypeId()].emplace_back(component);
+	InvalidateQueries(component);
+}
+
+void SceneStructure::DetachComponent(Component *component) {
+	if (!m_archetypes)
+		return;
+
+	auto it = m_pools.find(component->GetTypeId());
+	if (it == m_pools.end())
+		return;
+
+	auto &pool = it->second;
+	if (auto it1 = std::find(pool.begin(), pool.end(), component); it1 != pool.end()) {
+		// Swap-remove, pool order is not meaningful.
+		*it1 = pool.back();
+		pool.pop_back();
+		InvalidateQueries(component);
+	}
+
+	if (pool.empty())
+		m_pools.erase(it);
+}
+
+void SceneStructure::InvalidateQueries(Component *component) {
+	for (auto &[typeIndex, query] : m_queries) {
+		if (!query->dirty && query->Matches(component))
+			query->dirty = true;
+	}
+}
+
+void SceneStructure::InvalidateQueries() {
+	for (auto &[typeIndex, query] : m_queries)
+		query->dirty = true;
+}
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <typeindex>
+
 #include "Physics/Rigidbody.hpp"
 #include "Entity.hpp"
 
@@ -8,8 +10,14 @@ namespace acid {
  * @brief Class that represents a  structure of spatial objects.
  */
 class ACID_EXPORT SceneStructure : NonCopyable {
+	friend class Entity;
+	friend class Component;
 public:
-	SceneStructure();
+	/**
+	 * Creates a new scene structure.
+	 * @param archetypes If components will be indexed into per-type pools and typed queries cached.
+	 */
+	explicit SceneStructure(bool archetypes = true);
 
 	Entity *GetEntity(const std::string &name) const;
 
@@ -86,23 +94,44 @@ public:
 
 	/**
 	 * Returns a set of all components of a type in the spatial structure.
+	 * With archetype storage enabled this is a cached list that is only rebuilt after a component of the type is added, removed, enabled or disabled,
+	 * the reference is invalidated by the next such change.
 	 * @tparam T The components type to get.
 	 * @param allowDisabled If disabled components will be included in this query.
 	 * @return The list specified by of all components that match the type.
 	 */
 	template<typename T>
-	std::vector<T *> QueryComponents(bool allowDisabled = false) {
-		std::vector<T *> components;
-
-		for (auto it = m_objects.begin(); it != m_objects.end(); ++it) {
-			for (const auto &component : (*it)->GetComponents<T>()) {
-				if (component && (component->IsEnabled() || allowDisabled)) {
-					components.emplace_back(component);
+	const std::vector<T *> &QueryComponents(bool allowDisabled = false) {
+		auto query = GetQuery<T>();
+
+		if (!m_archetypes) {
+			query->components.clear();
+			query->enabled.clear();
+
+			for (auto it = m_objects.begin(); it != m_objects.end(); ++it) {
+				for (const auto &component : (*it)->GetComponents<T>()) {
+					query->components.emplace_back(component);
+					if (component->IsEnabled())
+						query->enabled.emplace_back(component);
 				}
 			}
+		} else if (query->dirty) {
+			query->Rebuild(m_pools);
 		}
 
-		return components;
+		return allowDisabled ? query->components : query->enabled;
+	}
+
+	/**
+	 * Gets the cached pool of every component of a type, including disabled components.
+	 * The pool is rebuilt only when components of the type have been added or removed since the last call,
+	 * the reference is invalidated by the next such change.
+	 * @tparam T The components type to get.
+	 * @return The cached list of components that match the type.
+	 */
+	template<typename T>
+	const std::vector<T *> &GetComponentPool() {
+		return QueryComponents<T>(true);
 	}
 
 	/**
@@ -131,7 +160,86 @@ public:
 	 */
 	bool Contains(Entity *object);
 
+	/**
+	 * Gets if components are stored in archetype pools.
+	 * @return If archetype storage is enabled.
+	 */
+	bool IsArchetypes() const { return m_archetypes; }
+
+	/**
+	 * Enables or disables archetype storage, enabling rebuilds the pools from every entity in the structure.
+	 * @param archetypes If archetype storage is enabled.
+	 */
+	void SetArchetypes(bool archetypes);
+
 private:
+	static constexpr TypeId UnregisteredTypeId = static_cast<TypeId>(-1);
+
+	class ComponentQueryBase {
+	public:
+		virtual ~ComponentQueryBase() = default;
+
+		virtual bool Matches(Component *component) const = 0;
+
+		// Set when a matching component changes, so queries of other types stay cached.
+		bool dirty = true;
+	};
+
+	template<typename T>
+	class ComponentQuery : public ComponentQueryBase {
+	public:
+		bool Matches(Component *component) const override { return dynamic_cast<T *>(component); }
+
+		void Rebuild(const std::unordered_map<TypeId, std::vector<Component *>> &pools) {
+			components.clear();
+			enabled.clear();
+
+			for (const auto &[typeId, pool] : pools) {
+				// Pools are keyed by the exact type, so one failed cast rejects the whole pool.
+				if (pool.empty() || (typeId != UnregisteredTypeId && !dynamic_cast<T *>(pool.front())))
+					continue;
+
+				for (const auto &component : pool) {
+					if (auto casted = dynamic_cast<T *>(component)) {
+						components.emplace_back(casted);
+						if (casted->IsEnabled())
+							enabled.emplace_back(casted);
+					}
+				}
+			}
+
+			dirty = false;
+		}
+
+		std::vector<T *> components;
+		std::vector<T *> enabled;
+	};
+
+	template<typename T>
+	ComponentQuery<T> *GetQuery() {
+		auto &query = m_queries[typeid(T)];
+		if (!query)
+			query = std::make_unique<ComponentQuery<T>>();
+		return static_cast<ComponentQuery<T> *>(query.get());
+	}
+
+	void AttachEntity(Entity *object);
+	void DetachEntity(Entity *object);
+	void AttachComponent(Component *component);
+	void DetachComponent(Component *component);
+	/**
+	 * Marks the cached queries that contain a component for a rebuild.
+	 * @param component The component that was added, removed, enabled or disabled.
+	 */
+	void InvalidateQueries(Component *component);
+	void InvalidateQueries();
+
 	std::vector<std::unique_ptr<Entity>> m_objects;
+
+	bool m_archetypes;
+	// Components by their exact factory type id.
+	std::unordered_map<TypeId, std::vector<Component *>> m_pools;
+	// Cached typed views over the pools, keyed by the queried type.
+	std::unordered_map<std::type_index, std::unique_ptr<ComponentQueryBase>> m_queries;
 };
 }
@@ -1,5 +1,7 @@
 #include "Scenes.hpp"
 
+#include "Maths/Transform.hpp"
+
 namespace acid {
 Scenes::Scenes() {
 }
@@ -19,6 +21,13 @@ void Scenes::Update() {
 
 	if (m_scene->GetStructure()) {
 		m_scene->GetStructure()->Update();
+
+		// Every moved transform is calculated once here, so rendering reads cached world matrices.
+		m_transformHierarchy.Update(m_scene->GetStructure()->QueryComponents<Transform>(), &Engine::Get()->GetUpdatePool());
+
+		// Components that work together, like animated meshes, are updated once every entity has updated so they can be spread across the update pool.
+		for (const auto &batchUpdate : Component::GetBatchUpdates())
+			batchUpdate(*m_scene->GetStructure(), &Engine::Get()->GetUpdatePool());
 	}
 
 	if (m_scene->GetCamera()) {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Engine/Engine.hpp"
+#include "Maths/TransformHierarchy.hpp"
 #include "Scene.hpp"
 #include "SceneStructure.hpp"
 
@@ -52,5 +53,6 @@ public:
 
 private:
 	std::unique_ptr<Scene> m_scene;
+	TransformHierarchy m_transformHierarchy;
 };
 }
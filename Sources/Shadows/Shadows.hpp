@@ -2,13 +2,14 @@
 
 #include "Engine/Engine.hpp"
 #include "Maths/Vector3.hpp"
+#include "Scenes/Scenes.hpp"
 #include "ShadowBox.hpp"
 
 namespace acid {
 /**
  * @brief Module used for managing a shadow map.
  */
-class ACID_EXPORT Shadows : public Module::Registrar<Shadows, Module::Stage::Normal> {
+class ACID_EXPORT Shadows : public Module::Registrar<Shadows, Module::Stage::Normal, Module::Concurrent, Module::Reads<Scenes>> {
 public:
 	Shadows();
 
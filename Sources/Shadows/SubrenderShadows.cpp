@@ -17,7 +17,7 @@ void SubrenderShadows::Render(const CommandBuffer &commandBuffer) {
 
 	m_pipeline.BindPipeline(commandBuffer);
 
-	auto sceneShadowRenders = Scenes::Get()->GetStructure()->QueryComponents<ShadowRender>();
+	const auto &sceneShadowRenders = Scenes::Get()->GetStructure()->QueryComponents<ShadowRender>();
 
 	for (const auto &shadowRender : sceneShadowRenders) {
 		shadowRender->CmdRender(commandBuffer, m_pipeline);
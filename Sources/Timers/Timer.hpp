@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <optional>
+
+#include "Helpers/Delegate.hpp"
+#include "Maths/Time.hpp"
+
+namespace acid {
+class ACID_EXPORT Timer {
+	friend class Timers;
+	friend class TimerWheel;
+public:
+	/**
+	 * @brief Where the ticks of a timer are run.
+	 */
+	enum class Dispatch {
+		// On the timers thread, as soon as the timer is due.
+		Thread,
+		// On the main thread, in a batch with other due timers when the timers module updates.
+		Main,
+		// On the engine update pool, the timers thread does not wait for it. A tick is skipped while the last tick of the timer is still running.
+		Workers
+	};
+
+	Timer(const Time &interval, const std::optional<uint32_t> &repeat, Dispatch dispatch = Dispatch::Thread) :
+		m_interval(interval),
+		m_next(Time::Now() + m_interval),
+		m_repeat(repeat),
+		m_dispatch(dispatch) {
+	}
+
+	const Time &GetInterval() const { return m_interval; }
+	const Time &GetNext() const { return m_next; }
+	const std::optional<uint32_t> &GetRepeat() const { return m_repeat; }
+	Dispatch GetDispatch() const { return m_dispatch; }
+	bool IsDestroyed() const { return m_destroyed; }
+	/**
+	 * Cancels the timer, it will not tick again and is removed from the timers when its next tick is reached.
+	 */
+	void Destroy() { m_destroyed = true; }
+	Delegate<void()> &OnTick() { return m_onTick; };
+
+private:
+	Time m_interval;
+	Time m_next;
+	std::optional<uint32_t> m_repeat;
+	Dispatch m_dispatch;
+	std::atomic_bool m_destroyed = false;
+	// If a tick submitted to the update pool has not finished.
+	std::atomic_bool m_ticking = false;
+	Delegate<void()> m_onTick;
+
+	// The wheel tick the timer is due on.
+	uint64_t m_tick = 0;
+};
+}
@@ -0,0 +1,114 @@
+#include "TimerWheel.hpp"
+
+namespace acid {
+TimerWheel::TimerWheel(const Time &start, const Time &resolution) :
+	m_start(start),
+	m_resolution(resolution) {
+}
+
+void TimerWheel::Add(std::shared_ptr<Timer> timer) {
+	timer->m_tick = std::max(GetTick(timer->m_next), m_tick + 1);
+	Place(std::move(timer));
+	m_size++;
+}
+
+void TimerWheel::Advance(const Time &time, std::vector<std::shared_ptr<Timer>> &due) {
+	auto target = time > m_start ? static_cast<uint64_t>((time - m_start).AsMicroseconds() / m_resolution.AsMicroseconds()) : 0;
+
+	if (m_size == 0) {
+		m_tick = std::max(m_tick, target);
+		return;
+	}
+
+	while (m_tick < target && m_size != 0) {
+		m_tick++;
+
+		if ((m_tick & (SlotCount - 1)) == 0) {
+			// Levels are cascaded from the highest level that wrapped, so timers can move down more than one level.
+			uint32_t wrapped = 1;
+			while (wrapped < LevelCount && (m_tick >> (SlotBits * wrapped) & (SlotCount - 1)) == 0)
+				wrapped++;
+
+			if (wrapped == LevelCount) {
+				auto overflow = std::move(m_overflow);
+				m_overflow.clear();
+
+				for (auto &timer : overflow) {
+					if (timer->m_destroyed)
+						m_size--;
+					else
+						Place(std::move(timer));
+				}
+
+				wrapped = LevelCount - 1;
+			}
+
+			for (auto level = wrapped; level > 0; level--)
+				Cascade(level);
+		}
+
+		auto &slot = m_levels[0][m_tick & (SlotCount - 1)];
+		m_size -= slot.size();
+
+		for (auto &timer : slot) {
+			if (!timer->m_destroyed)
+				due.emplace_back(std::move(timer));
+		}
+
+		slot.clear();
+	}
+
+	m_tick = std::max(m_tick, target);
+}
+
+std::optional<Time> TimerWheel::GetNextTime() const {
+	if (m_size == 0)
+		return std::nullopt;
+
+	// Level 0 only holds timers due before it wraps, after it wraps timers may cascade down from a higher level.
+	auto tick = m_tick + 1;
+	for (; (tick & (SlotCount - 1)) != 0; tick++) {
+		if (!m_levels[0][tick & (SlotCount - 1)].empty())
+			break;
+	}
+
+	return m_start + m_resolution * static_cast<int64_t>(tick);
+}
+
+uint64_t TimerWheel::GetTick(const Time &time) const {
+	if (time <= m_start)
+		return 0;
+
+	// Rounded up, a timer is never due before its time.
+	auto resolution = m_resolution.AsMicroseconds();
+	return static_cast<uint64_t>(((time - m_start).AsMicroseconds() + resolution - 1) / resolution);
+}
+
+void TimerWheel::Place(std::shared_ptr<Timer> &&timer) {
+	// The level is the highest group of slot bits where the due tick differs from the current tick.
+	auto difference = timer->m_tick ^ m_tick;
+	uint32_t level = 0;
+	while (level < LevelCount && difference >> (SlotBits * (level + 1)) != 0)
+		level++;
+
+	if (level == LevelCount) {
+		m_overflow.emplace_back(std::move(timer));
+		return;
+	}
+
+	m_levels[level][timer->m_tick >> (SlotBits * level) & (SlotCount - 1)].emplace_back(std::move(timer));
+}
+
+void TimerWheel::Cascade(uint32_t level) {
+	auto &slot = m_levels[level][m_tick >> (SlotBits * level) & (SlotCount - 1)];
+	auto timers = std::move(slot);
+	slot.clear();
+
+	for (auto &timer : timers) {
+		if (timer->m_destroyed)
+			m_size--;
+		else
+			Place(std::move(timer));
+	}
+}
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "Timer.hpp"
+
+namespace acid {
+/**
+ * @brief Class that schedules timers in a hierarchical timing wheel, with constant time inserts.
+ * Time is split into ticks, each level has 256 slots and each slot of a level covers all slots of the level below.
+ * Timers are placed on the lowest level that holds their tick, and are moved down a level when the level below wraps.
+ * Destroyed timers are dropped when their slot is reached, so canceling is constant time.
+ */
+class ACID_EXPORT TimerWheel {
+public:
+	static constexpr uint32_t SlotBits = 8;
+	static constexpr uint32_t SlotCount = 1 << SlotBits;
+	static constexpr uint32_t LevelCount = 4;
+
+	/**
+	 * Creates a new timer wheel.
+	 * @param start The time of the first tick.
+	 * @param resolution The length of a tick, timers are due on the first tick at or after their time.
+	 */
+	explicit TimerWheel(const Time &start = Time::Now(), const Time &resolution = 1ms);
+
+	/**
+	 * Schedules a timer for the time it is next due, a timer that is already due is due on the next tick.
+	 * @param timer The timer to schedule.
+	 */
+	void Add(std::shared_ptr<Timer> timer);
+
+	/**
+	 * Advances the wheel to a time, collecting the timers due on every tick passed.
+	 * @param time The time to advance to.
+	 * @param due The vector to append due timers to, in the order they became due. Destroyed timers are removed instead.
+	 */
+	void Advance(const Time &time, std::vector<std::shared_ptr<Timer>> &due);
+
+	/**
+	 * Gets the time the wheel should next be advanced to, no timer is due before this time.
+	 * @return The time, or nullopt if no timers are scheduled.
+	 */
+	std::optional<Time> GetNextTime() const;
+
+	/**
+	 * Gets the number of timers scheduled, including destroyed timers that have not yet been removed.
+	 * @return The number of timers.
+	 */
+	std::size_t GetSize() const { return m_size; }
+
+	const Time &GetResolution() const { return m_resolution; }
+
+private:
+	using Slot = std::vector<std::shared_ptr<Timer>>;
+
+	uint64_t GetTick(const Time &time) const;
+	void Place(std::shared_ptr<Timer> &&timer);
+	void Cascade(uint32_t level);
+
+	Time m_start;
+	Time m_resolution;
+	// The last tick that has been processed.
+	uint64_t m_tick = 0;
+	std::size_t m_size = 0;
+
+	std::array<std::array<Slot, SlotCount>, LevelCount> m_levels;
+	// Timers due after the highest level wraps.
+	Slot m_overflow;
+};
+}
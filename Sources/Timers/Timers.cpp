@@ -11,42 +11,91 @@ Timers::~Timers() {
 
 	m_condition.notify_all();
 	m_worker.join();
+
+	// Ticks on the update pool may still be running.
+	while (!m_workerTicks.IsDone())
+		std::this_thread::yield();
 }
 
 void Timers::Update() {
+	{
+		std::unique_lock<std::mutex> lock(m_mainMutex);
+		std::swap(m_mainTicks, m_mainRunning);
+	}
+
+	for (const auto &timer : m_mainRunning) {
+		if (!timer->m_destroyed)
+			timer->m_onTick();
+	}
+
+	m_mainRunning.clear();
+}
+
+void Timers::Add(std::shared_ptr<Timer> timer) {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_wheel.Add(std::move(timer));
+	m_condition.notify_all();
 }
 
 void Timers::ThreadRun() {
 	std::unique_lock<std::mutex> lock(m_mutex);
+	std::vector<std::shared_ptr<Timer>> due;
 
 	while (!m_stop) {
-		if (m_timers.empty()) {
-			m_condition.wait(lock);
-		} else {
-			std::sort(m_timers.begin(), m_timers.end(), [](const auto &a, const auto &b) {
-				return a->m_next < b->m_next;
-			});
-
-			auto &instance = m_timers.front();
-			auto time = Time::Now();
-
-			if (time >= instance->m_next) {
-				//Log::Error("Timer variation: ", (time - instance->m_next).AsMilliseconds<float>(), "ms\n");
-				lock.unlock();
-				instance->m_onTick();
-				lock.lock();
-
-				instance->m_next += instance->m_interval;
-
-				if (instance->m_repeat) {
-					if (--(*instance->m_repeat) == 0) {
-						m_timers.erase(std::remove(m_timers.begin(), m_timers.end(), instance), m_timers.end());
-					}
+		m_wheel.Advance(Time::Now(), m_due);
+
+		if (m_due.empty()) {
+			if (auto next = m_wheel.GetNextTime())
+				m_condition.wait_for(lock, std::chrono::microseconds(*next - Time::Now()));
+			else
+				m_condition.wait(lock);
+			continue;
+		}
+
+		std::swap(m_due, due);
+		lock.unlock();
+		Dispatch(due);
+		lock.lock();
+
+		// Timers are rescheduled from when they were due, so a late tick does not delay the ticks after it.
+		for (auto &timer : due) {
+			if (timer->m_destroyed || (timer->m_repeat && --*timer->m_repeat == 0))
+				continue;
+
+			timer->m_next += timer->m_interval;
+			m_wheel.Add(std::move(timer));
+		}
+
+		due.clear();
+	}
+}
+
+void Timers::Dispatch(const std::vector<std::shared_ptr<Timer>> &due) {
+	auto pool = Engine::Get() ? &Engine::Get()->GetUpdatePool() : nullptr;
+
+	for (const auto &timer : due) {
+		switch (timer->m_dispatch) {
+		case Timer::Dispatch::Main: {
+			std::unique_lock<std::mutex> lock(m_mainMutex);
+			m_mainTicks.emplace_back(timer);
+			break;
+		}
+		case Timer::Dispatch::Workers:
+			if (pool) {
+				// Submitted without waiting, so a slow tick does not delay the timers due after it.
+				if (!timer->m_ticking.exchange(true)) {
+					pool->Submit([timer]() {
+						if (!timer->m_destroyed)
+							timer->m_onTick();
+						timer->m_ticking = false;
+					}, &m_workerTicks);
 				}
-			} else {
-				std::chrono::microseconds timePoint(instance->m_next - time);
-				m_condition.wait_for(lock, timePoint);
+				break;
 			}
+			[[fallthrough]];
+		case Timer::Dispatch::Thread:
+			timer->m_onTick();
+			break;
 		}
 	}
 }
@@ -1,40 +1,17 @@
 #pragma once
 
-#include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <thread>
 
 #include "Engine/Engine.hpp"
-#include "Helpers/Delegate.hpp"
-#include "Maths/Time.hpp"
+#include "TimerWheel.hpp"
 
 namespace acid {
-class ACID_EXPORT Timer {
-	friend class Timers;
-public:
-	Timer(const Time &interval, const std::optional<uint32_t> &repeat) :
-		m_interval(interval),
-		m_next(Time::Now() + m_interval),
-		m_repeat(repeat) {
-	}
-
-	const Time &GetInterval() const { return m_interval; }
-	const std::optional<uint32_t> &GetRepeat() const { return m_repeat; }
-	bool IsDestroyed() const { return m_destroyed; }
-	void Destroy() { m_destroyed = true; }
-	Delegate<void()> &OnTick() { return m_onTick; };
-
-private:
-	Time m_interval;
-	Time m_next;
-	std::optional<uint32_t> m_repeat;
-	bool m_destroyed = false;
-	Delegate<void()> m_onTick;
-};
-
 /**
  * @brief Module used for timed events.
+ * Timers are scheduled in a {@link TimerWheel} on a timers thread, the returned timers can be destroyed to cancel them.
+ * The module is not concurrent, main dispatched ticks run in its update so they must stay on the main thread.
  */
 class ACID_EXPORT Timers : public Module::Registrar<Timers, Module::Stage::Post> {
 public:
@@ -45,44 +22,62 @@ public:
 	void Update() override;
 
 	template<typename ...Args>
-	Timer *Once(const Time &delay, std::function<void()> &&function, Args ...args) {
-		std::unique_lock<std::mutex> lock(m_mutex);
-		auto instance = std::make_unique<Timer>(delay, 1);
+	std::shared_ptr<Timer> Once(const Time &delay, std::function<void()> &&function, Args ...args) {
+		return Once(delay, Timer::Dispatch::Thread, std::move(function), args...);
+	}
+
+	template<typename ...Args>
+	std::shared_ptr<Timer> Once(const Time &delay, Timer::Dispatch dispatch, std::function<void()> &&function, Args ...args) {
+		auto instance = std::make_shared<Timer>(delay, 1, dispatch);
 		instance->m_onTick.Add(std::move(function), args...);
-		m_timers.emplace_back(std::move(instance));
-		m_condition.notify_all();
-		return instance.get();
+		Add(instance);
+		return instance;
+	}
+
+	template<typename ...Args>
+	std::shared_ptr<Timer> Every(const Time &interval, std::function<void()> &&function, Args ...args) {
+		return Every(interval, Timer::Dispatch::Thread, std::move(function), args...);
 	}
 
 	template<typename ...Args>
-	Timer *Every(const Time &interval, std::function<void()> &&function, Args ...args) {
-		std::unique_lock<std::mutex> lock(m_mutex);
-		auto instance = std::make_unique<Timer>(interval, std::nullopt);
+	std::shared_ptr<Timer> Every(const Time &interval, Timer::Dispatch dispatch, std::function<void()> &&function, Args ...args) {
+		auto instance = std::make_shared<Timer>(interval, std::nullopt, dispatch);
 		instance->m_onTick.Add(std::move(function), args...);
-		m_timers.emplace_back(std::move(instance));
-		m_condition.notify_all();
-		return instance.get();
+		Add(instance);
+		return instance;
+	}
+
+	template<typename ...Args>
+	std::shared_ptr<Timer> Repeat(const Time &interval, uint32_t repeat, std::function<void()> &&function, Args ...args) {
+		return Repeat(interval, repeat, Timer::Dispatch::Thread, std::move(function), args...);
 	}
 
 	template<typename ...Args>
-	Timer *Repeat(const Time &interval, uint32_t repeat, std::function<void()> &&function, Args ...args) {
-		std::unique_lock<std::mutex> lock(m_mutex);
-		auto instance = std::make_unique<Timer>(interval, repeat);
+	std::shared_ptr<Timer> Repeat(const Time &interval, uint32_t repeat, Timer::Dispatch dispatch, std::function<void()> &&function, Args ...args) {
+		auto instance = std::make_shared<Timer>(interval, repeat, dispatch);
 		instance->m_onTick.Add(std::move(function), args...);
-		m_timers.emplace_back(std::move(instance));
-		m_condition.notify_all();
-		return instance.get();
+		Add(instance);
+		return instance;
 	}
 
 private:
+	void Add(std::shared_ptr<Timer> timer);
 	void ThreadRun();
+	void Dispatch(const std::vector<std::shared_ptr<Timer>> &due);
 
-	std::vector<std::unique_ptr<Timer>> m_timers;
+	TimerWheel m_wheel;
+	// Timers that are due, taken from the wheel by the timers thread.
+	std::vector<std::shared_ptr<Timer>> m_due;
+	// Ticks waiting for the main thread, and the ticks being run by the main thread.
+	std::vector<std::shared_ptr<Timer>> m_mainTicks, m_mainRunning;
+	// Counts the ticks running on the update pool.
+	JobCounter m_workerTicks;
 
 	std::atomic_bool m_stop = false;
 	std::thread m_worker;
 
 	std::mutex m_mutex;
+	std::mutex m_mainMutex;
 	std::condition_variable m_condition;
 };
 }
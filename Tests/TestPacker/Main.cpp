@@ -1,4 +1,5 @@
 #include <Engine/Log.hpp>
+#include <Files/Pack/PackArchive.hpp>
 #include <Files/Zip/ZipArchive.hpp>
 #include "Config.hpp"
 
@@ -18,6 +19,8 @@ int main(int argc, char **argv) {
 	auto maxFraction = 16 * 1000000;
 
 	auto archive = NewArchive(0);
+	// The pack holds every file, it is mounted by adding it as a search path.
+	acid::PackWriter pack(std::filesystem::current_path() / "data.pak");
 	int index = 1;
 	int currentSizeBytes = 0;
 	
@@ -36,10 +39,12 @@ int main(int argc, char **argv) {
 		std::string str((std::istreambuf_iterator<char>(t)),
 			std::istreambuf_iterator<char>());
 		archive->AddEntry(file.path().string().substr(PATH.string().length() + 1), str);
+		pack.AddEntry(file.path().string().substr(PATH.string().length() + 1), str, acid::PackArchive::Compression::Deflate);
 		currentSizeBytes += file.file_size();
 	}
 	
 	archive->Write();
+	pack.Finish();
 
 	// Pauses the console.
 	std::cout << "Press enter to continue...";
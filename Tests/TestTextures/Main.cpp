@@ -0,0 +1,50 @@
+#include <Bitmaps/CompressedBitmap.hpp>
+#include <Engine/Log.hpp>
+#include "Config.hpp"
+
+using namespace acid;
+
+// Normal maps keep two channels, textures with transparency keep full alpha.
+BlockCompression::Format ChooseFormat(const std::filesystem::path &filename, const Bitmap &bitmap) {
+	if (filename.stem().string().find("normal") != std::string::npos || filename.stem().string().find("Normal") != std::string::npos)
+		return BlockCompression::Format::Bc5;
+
+	for (uint32_t i = 0; i < bitmap.GetSize().m_x * bitmap.GetSize().m_y; i++) {
+		if (bitmap.GetData()[4 * i + 3] != 255)
+			return BlockCompression::Format::Bc7;
+	}
+
+	return BlockCompression::Format::Bc1;
+}
+
+int main(int argc, char **argv) {
+	std::filesystem::path input = argc > 1 ? argv[1] : ACID_RESOURCES_DEV;
+	std::filesystem::path output = argc > 2 ? argv[2] : std::filesystem::current_path() / "Textures";
+
+	ThreadPool pool;
+	std::size_t inputBytes = 0, outputBytes = 0;
+
+	for (auto &file : std::filesystem::recursive_directory_iterator(input)) {
+		if (!file.is_regular_file() || file.path().extension() != ".png") continue;
+
+		Bitmap bitmap(file.path());
+		if (!bitmap) continue;
+
+		auto format = ChooseFormat(file.path(), bitmap);
+		CompressedBitmap compressed(bitmap, format, true, &pool);
+
+		auto filename = output / std::filesystem::relative(file.path(), input).replace_extension(".ktx2");
+		compressed.Write(filename);
+
+		inputBytes += bitmap.GetLength();
+		outputBytes += std::filesystem::file_size(filename);
+		Log::Out(filename, ": format ", static_cast<uint32_t>(format), ", ", compressed.GetMipLevels(), " mip levels\n");
+	}
+
+	Log::Out("Compressed ", inputBytes / 1024, "KiB of RGBA8 to ", outputBytes / 1024, "KiB with mip levels\n");
+
+	// Pauses the console.
+	std::cout << "Press enter to continue...";
+	std::cin.get();
+	return 0;
+}
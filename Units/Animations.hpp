@@ -0,0 +1,84 @@
+#pragma once
+
+#include <map>
+#include <random>
+
+#include <Animations/Animation/Animation.hpp>
+#include <Animations/Skeleton/Joint.hpp>
+
+namespace acid::test {
+// A chain of limbs from the root, each joint has the next joint as its child.
+inline Joint CreateJoints(uint32_t count, uint32_t &index) {
+	Joint joint(index, "Joint" + std::to_string(index), Matrix4().Translate(Vector3f(0.0f, 0.1f, 0.0f)));
+	index++;
+
+	// Every fourth joint branches, like the spine a arm is attached to.
+	while (index < count && joint.GetChildren().size() < (joint.GetIndex() % 4 == 0 ? 2u : 1u))
+		joint.AddChild(CreateJoints(count, index));
+
+	return joint;
+}
+
+inline Joint CreateSkeleton(uint32_t count) {
+	uint32_t index = 0;
+	auto headJoint = CreateJoints(count, index);
+	headJoint.CalculateInverseBindTransform({});
+	return headJoint;
+}
+
+inline Animation CreateAnimation(uint32_t jointCount, uint32_t keyframeCount, float length) {
+	std::mt19937 random(7);
+	std::uniform_real_distribution<float> angle(-0.1f, 0.1f);
+	std::vector<Keyframe> keyframes;
+
+	for (uint32_t k = 0; k < keyframeCount; k++) {
+		std::map<std::string, JointTransform> pose;
+
+		for (uint32_t j = 0; j < jointCount; j++) {
+			Vector3f position(0.0f, 0.1f + 0.01f * static_cast<float>(k % 3), 0.0f);
+			Quaternion rotation(Vector3f(angle(random), angle(random), angle(random)));
+			pose.emplace("Joint" + std::to_string(j), JointTransform(position, rotation));
+		}
+
+		keyframes.emplace_back(Time::Seconds(length * static_cast<float>(k) / static_cast<float>(keyframeCount - 1)), std::move(pose));
+	}
+
+	return {Time::Seconds(length), keyframes};
+}
+
+// The map based animator CompiledAnimation replaced, kept as a reference and as a baseline for the benchmark.
+inline void ReferenceJointPose(const std::map<std::string, Matrix4> &currentPose, const Joint &joint, const Matrix4 &parentTransform,
+	std::vector<Matrix4> &jointMatrices) {
+	auto currentTransform = parentTransform * currentPose.find(joint.GetName())->second;
+
+	for (const auto &childJoint : joint.GetChildren())
+		ReferenceJointPose(currentPose, childJoint, currentTransform, jointMatrices);
+
+	if (joint.GetIndex() < jointMatrices.size())
+		jointMatrices[joint.GetIndex()] = currentTransform * joint.GetInverseBindTransform();
+}
+
+inline void ReferenceUpdate(const Animation &animation, const Time &time, const Joint &headJoint, std::vector<Matrix4> &jointMatrices) {
+	const Keyframe *previousFrame = nullptr;
+	const Keyframe *nextFrame = nullptr;
+
+	for (const auto &frame : animation.GetKeyframes()) {
+		nextFrame = &frame;
+		if (frame.GetTimeStamp() > time)
+			break;
+
+		previousFrame = &frame;
+	}
+
+	auto totalTime = nextFrame->GetTimeStamp() - previousFrame->GetTimeStamp();
+	auto progression = totalTime > Time() ? static_cast<float>((time - previousFrame->GetTimeStamp()) / totalTime) : 0.0f;
+	std::map<std::string, Matrix4> currentPose;
+
+	for (const auto &[name, transform] : previousFrame->GetPose()) {
+		auto currentTransform = JointTransform::Interpolate(transform, nextFrame->GetPose().find(name)->second, progression);
+		currentPose.emplace(name, currentTransform.GetLocalTransform());
+	}
+
+	ReferenceJointPose(currentPose, headJoint, {}, jointMatrices);
+}
+}
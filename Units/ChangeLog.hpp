@@ -0,0 +1,66 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+
+#include <Files/FileObserver.hpp>
+
+namespace acid::test {
+/**
+ * @brief Collects the changes from a observer, so tests can wait for them. Must outlive the observer.
+ */
+class ChangeLog {
+public:
+	void Listen(FileObserver &observer) {
+		observer.OnChanges().Add([this](const std::vector<FileObserver::Change> &changes) {
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_batches.emplace_back(changes);
+			m_condition.notify_all();
+		});
+	}
+
+	/**
+	 * Waits for a change to a path.
+	 * @param path The path.
+	 * @return The status the path changed to, or std::nullopt if it did not change within a few seconds.
+	 */
+	std::optional<FileObserver::Status> Wait(const std::filesystem::path &path) {
+		std::unique_lock<std::mutex> lock(m_mutex);
+		std::optional<FileObserver::Status> status;
+		m_condition.wait_for(lock, std::chrono::seconds(5), [&]() {
+			status = Find(path);
+			return status.has_value();
+		});
+		return status;
+	}
+
+	std::optional<FileObserver::Status> Find(const std::filesystem::path &path) const {
+		for (const auto &batch : m_batches) {
+			for (const auto &change : batch) {
+				if (change.path == path)
+					return change.status;
+			}
+		}
+		return std::nullopt;
+	}
+
+	std::size_t GetChangeCount() {
+		std::unique_lock<std::mutex> lock(m_mutex);
+		std::size_t count = 0;
+		for (const auto &batch : m_batches)
+			count += batch.size();
+		return count;
+	}
+
+	void Clear() {
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_batches.clear();
+	}
+
+private:
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::vector<std::vector<FileObserver::Change>> m_batches;
+};
+}
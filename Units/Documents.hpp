@@ -0,0 +1,174 @@
+#pragma once
+
+#include <random>
+#include <sstream>
+
+#include <Files/Json/Json.hpp>
+
+namespace acid::test {
+// The character at a time tokenizer Json replaced, kept as a baseline for the benchmark and to check documents it parsed are unchanged.
+class LegacyJson : public Json {
+public:
+	void ParseString(std::string_view string) override {
+		Tokens tokens;
+
+		std::size_t tokenStart = 0;
+		enum class QuoteState : char {
+			None = '\0', Single = '\'', Double = '"'
+		} quoteState = QuoteState::None;
+
+		for (std::size_t index = 0; index < string.length(); ++index) {
+			auto c = string[index];
+			if (c == '\'' && quoteState != QuoteState::Double && string[index - 1] != '\\')
+				quoteState = quoteState == QuoteState::None ? QuoteState::Single : QuoteState::None;
+			else if (c == '"' && quoteState != QuoteState::Single && string[index - 1] != '\\')
+				quoteState = quoteState == QuoteState::None ? QuoteState::Double : QuoteState::None;
+
+			if (quoteState == QuoteState::None) {
+				if (String::IsWhitespace(c)) {
+					AddToken(std::string_view(string.data() + tokenStart, index - tokenStart), tokens);
+					tokenStart = index + 1;
+				} else if (c == ':' || c == '{' || c == '}' || c == ',' || c == '[' || c == ']') {
+					AddToken(std::string_view(string.data() + tokenStart, index - tokenStart), tokens);
+					tokens.emplace_back(Type::Token, std::string_view(string.data() + index, 1));
+					tokenStart = index + 1;
+				}
+			}
+		}
+
+		int32_t k = 0;
+		Convert(*this, tokens, 0, k);
+	}
+
+private:
+	static void AddToken(std::string_view view, Tokens &tokens) {
+		if (view.length() == 0)
+			return;
+
+		if (view == "null")
+			tokens.emplace_back(Type::Null, std::string_view());
+		else if (view == "true" || view == "false")
+			tokens.emplace_back(Type::Boolean, view);
+		else if (String::IsNumber(view))
+			tokens.emplace_back(view.find('.') != std::string::npos ? Type::Decimal : Type::Integer, view);
+		else
+			tokens.emplace_back(Type::String, view.substr(1, view.length() - 2));
+	}
+
+	static void Convert(Node &current, const Tokens &tokens, int32_t i, int32_t &r) {
+		if (tokens[i] == Token(Type::Token, "{")) {
+			auto k = i + 1;
+
+			while (tokens[k] != Token(Type::Token, "}")) {
+				auto key = tokens[k].view;
+				k += 2;
+				Convert(current.AddProperty(key), tokens, k, k);
+				if (tokens[k].view == ",")
+					k++;
+			}
+
+			current.SetType(Type::Object);
+			r = k + 1;
+		} else if (tokens[i] == Token(Type::Token, "[")) {
+			auto k = i + 1;
+
+			while (tokens[k] != Token(Type::Token, "]")) {
+				Convert(current.AddProperty(), tokens, k, k);
+				if (tokens[k].view == ",")
+					k++;
+			}
+
+			current.SetType(Type::Array);
+			r = k + 1;
+		} else {
+			std::string str(tokens[i].view);
+			if (tokens[i].type == Type::String)
+				str = String::UnfixEscapedChars(str);
+			current.SetValue(str);
+			current.SetType(tokens[i].type);
+			r = i + 1;
+		}
+	}
+};
+
+/**
+ * Creates a Json document of entries with strings, escapes, numbers and nested values.
+ * @param entries The number of entries.
+ * @param trailingBackslashes If strings end with a escaped backslash, the legacy tokenizer can not parse them.
+ * @return The document.
+ */
+inline std::string CreateJsonDocument(uint32_t entries, bool trailingBackslashes) {
+	std::mt19937 generator(7);
+	std::uniform_int_distribution<uint32_t> length(0, 150);
+	std::stringstream stream;
+	stream << "{\"entries\":\t[\r\n";
+
+	for (uint32_t i = 0; i < entries; i++) {
+		// Long strings of varied length put strings, escapes and values across every block and chunk boundary.
+		std::string text(length(generator), 'a' + i % 26);
+		stream << (i != 0 ? ",\n  " : "  ") << "{\"id\": " << i << ", \"text\": \"" << text << (trailingBackslashes ? "\\\\" : "") << "\", \"quoted\": \"say \\\"" << text.substr(0, 3)
+			<< "\\\"\", \"values\": [" << i * 0.5 << ", -" << i << ", true, null, []], \"child\": {}}";
+	}
+
+	stream << "\n]}";
+	return stream.str();
+}
+
+/**
+ * Creates a Xml level of entities with attributes, escaped text, comments and CDATA.
+ * @param entries The number of entities.
+ * @return The document.
+ */
+inline std::string CreateXmlDocument(uint32_t entries) {
+	std::stringstream stream;
+	stream << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<!-- Generated level -->\n<level name=\"Test &amp; Benchmark\">\n";
+
+	for (uint32_t i = 0; i < entries; i++) {
+		stream << "\t<entity id=\"" << i << "\" prefab=\"Prefabs/Tree" << i % 7 << ".json\">\n"
+			<< "\t\t<position x=\"" << i * 0.5f << "\" y=\"0\" z=\"-" << i << "\"/>\n"
+			<< "\t\t<tag>Tree &lt;" << i % 3 << "&gt;</tag>\n"
+			<< "\t\t<script><![CDATA[if (a < b && c) {}]]></script>\n"
+			<< "\t</entity>\n";
+	}
+
+	stream << "</level>\n";
+	return stream.str();
+}
+
+/**
+ * Creates a Json scene of entities like the ones scenes are saved as.
+ * @param entities The number of entities.
+ * @return The document.
+ */
+inline std::string CreateScene(uint32_t entities) {
+	std::stringstream stream;
+	stream << "{\"entities\": [";
+
+	for (uint32_t i = 0; i < entities; i++) {
+		stream << (i != 0 ? ",\n" : "\n") << "{\"name\": \"Entity \\\"" << i << "\\\"\", \"enabled\": " << (i % 2 ? "true" : "false")
+			<< ", \"parent\": null, \"transform\": {\"position\": [" << i << ".5, " << -1.25f * i << ", 0.0], \"rotation\": [0.0, " << i % 360
+			<< ", 0.0], \"scale\": [1.0, 1.0, 1.0]}, \"mesh\": {\"model\": \"Objects/Crate/Crate.obj\", \"material\": {\"baseDiffuse\": \"#ffffff\", \"metallic\": 0.1}}}";
+	}
+
+	stream << "\n]}";
+	return stream.str();
+}
+
+/**
+ * Creates text with repeated words, so files compress like shaders and scene files do.
+ * @param index The index of the file, different files have different text.
+ * @param length The length in bytes.
+ * @return The text.
+ */
+inline std::string CreateText(std::size_t index, std::size_t length) {
+	static constexpr std::string_view Words[] = {"vec4 ", "uniform ", "layout ", "position ", "normal ", "entity ", "{\"name\": ", "0.5, ", "\n"};
+	std::string data = "// File " + std::to_string(index) + "\n";
+	auto seed = static_cast<uint32_t>(index);
+	while (data.size() < length) {
+		seed = seed * 1664525 + 1013904223;
+		data += Words[(seed >> 24) % std::size(Words)];
+	}
+	data.resize(length);
+	return data;
+}
+}
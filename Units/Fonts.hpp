@@ -0,0 +1,32 @@
+#pragma once
+
+#include <fstream>
+
+#include <Fonts/GlyphAtlas.hpp>
+
+namespace acid::test {
+inline const std::filesystem::path FontPath = std::filesystem::path(__FILE__).parent_path().parent_path() / "Resources/Fonts/OpenSans-Regular.ttf";
+inline constexpr std::wstring_view Characters = L"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz1234567890 \"!`?'.,;:()[]{}<>|/@\\^$-%+=#_&~*";
+
+/**
+ * Reads the font tests lay text out with.
+ * @return The font file, empty if it was not found.
+ */
+inline std::vector<uint8_t> ReadFont() {
+	std::ifstream stream(FontPath, std::ios::binary);
+	return {std::istreambuf_iterator<char>(stream), {}};
+}
+
+/**
+ * Gets a atlas of the font at 32px with every preset character, it is created the first time it is used.
+ * @return The atlas.
+ */
+inline GlyphAtlas &GetAtlas() {
+	static auto atlas = []() {
+		auto atlas = std::make_unique<GlyphAtlas>(ReadFont(), 32);
+		atlas->AddGlyphs(Characters);
+		return atlas;
+	}();
+	return *atlas;
+}
+}
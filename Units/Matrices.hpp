@@ -0,0 +1,39 @@
+#pragma once
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include <Maths/Matrix4.hpp>
+
+namespace acid::test {
+/**
+ * Creates a matrix with every value random.
+ * @param random The generator of the values.
+ * @return The matrix.
+ */
+inline Matrix4 RandomMatrix(std::mt19937 &random) {
+	std::uniform_real_distribution<float> distribution(-2.0f, 2.0f);
+	Matrix4 result;
+
+	for (uint32_t row = 0; row < 4; row++) {
+		for (uint32_t col = 0; col < 4; col++)
+			result[row][col] = distribution(random);
+	}
+
+	return result;
+}
+
+/**
+ * Checks every value of two matrices is close, the first value that is not fails the test.
+ * @param a The first matrix.
+ * @param b The second matrix.
+ * @param tolerance The largest difference allowed.
+ */
+inline void ExpectNear(const Matrix4 &a, const Matrix4 &b, float tolerance) {
+	for (uint32_t row = 0; row < 4; row++) {
+		for (uint32_t col = 0; col < 4; col++)
+			ASSERT_NEAR(a[row][col], b[row][col], tolerance) << "row " << row << ", column " << col;
+	}
+}
+}
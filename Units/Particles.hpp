@@ -0,0 +1,23 @@
+#pragma once
+
+#include <random>
+
+#include <Particles/ParticleStore.hpp>
+
+namespace acid::test {
+/**
+ * Adds particles spread around the origin, all moving the same way and with random lives.
+ * @param store The store to add to.
+ * @param count The number of particles.
+ */
+inline void FillStore(ParticleStore &store, std::size_t count) {
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+	std::uniform_real_distribution<float> life(2.0f, 10.0f);
+	store.Reserve(count);
+
+	for (std::size_t i = 0; i < count; i++) {
+		store.Add({position(generator), position(generator), position(generator)}, {1.0f, 5.0f, -1.0f}, life(generator), 1.0f, 0.0f, 1.0f, 1.0f);
+	}
+}
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <Resources/Resources.hpp>
+
+namespace acid::test {
+class TestResource : public Resource {
+public:
+	std::type_index GetTypeIndex() const override { return typeid(TestResource); }
+};
+
+/**
+ * Creates the node a texture resource is found by.
+ * @param index The index of the texture, different indices give different nodes.
+ * @return The node.
+ */
+inline Node CreateResourceNode(uint32_t index) {
+	Node node;
+	node["filename"] = "Textures/Generated/" + std::to_string(index) + ".png";
+	node["filter"] = std::string("linear");
+	node["mipmap"] = true;
+	return node;
+}
+}
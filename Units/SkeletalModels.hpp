@@ -0,0 +1,34 @@
+#pragma once
+
+#include <fstream>
+#include <sstream>
+
+#include <Animations/SkeletalModel.hpp>
+#include <Files/Json/Json.hpp>
+
+namespace acid::test {
+inline const std::filesystem::path ColladaPath = std::filesystem::path(__FILE__).parent_path().parent_path() / "Resources/Objects/Animated/Model.dae.json";
+
+/**
+ * Reads a whole file.
+ * @param path The path of the file.
+ * @return The contents, empty if the file was not found.
+ */
+inline std::string ReadFile(const std::filesystem::path &path) {
+	std::ifstream stream(path, std::ios::binary);
+	std::stringstream buffer;
+	buffer << stream.rdbuf();
+	return buffer.str();
+}
+
+/**
+ * Parses the document and runs every COLLADA loader, what each animated mesh did when it started.
+ * @param source The COLLADA document converted to Json.
+ * @param skeletalModel The model to load into.
+ */
+inline void LoadCollada(const std::string &source, SkeletalModel &skeletalModel) {
+	Json json;
+	json.ParseString(source);
+	skeletalModel.LoadCollada(json["COLLADA"]);
+}
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include <Animations/Animator.hpp>
+
+#include "Animations.hpp"
+
+using namespace std::chrono_literals;
+
+TEST(Animation, matchesReference) {
+	constexpr uint32_t JointCount = 50;
+	auto headJoint = acid::test::CreateSkeleton(JointCount);
+	acid::Skeleton skeleton(headJoint);
+	auto animation = acid::test::CreateAnimation(JointCount, 12, 2.0f);
+	acid::CompiledAnimation compiled(animation, skeleton);
+
+	EXPECT_EQ(skeleton.GetJointCount(), JointCount);
+	EXPECT_EQ(compiled.GetStride(), 52u);
+	EXPECT_EQ(compiled.GetKeyframeCount(), 12u);
+	EXPECT_EQ(skeleton.GetNames()[*skeleton.FindJoint("Joint7")], "Joint7");
+	EXPECT_FALSE(skeleton.FindJoint("Missing"));
+
+	for (uint32_t j = 1; j < JointCount; j++)
+		EXPECT_LT(skeleton.GetParents()[j], static_cast<int32_t>(j));
+
+	acid::Animator animator;
+	animator.DoAnimation(&compiled);
+	std::vector<acid::Matrix4> jointMatrices(JointCount), referenceMatrices(JointCount);
+
+	// Steps through the animation more than once, so the cursor loops back to the start.
+	for (uint32_t frame = 0; frame < 300; frame++) {
+		animator.Update(acid::Time::Seconds(1.0f / 60.0f), skeleton, jointMatrices);
+		acid::test::ReferenceUpdate(animation, animator.GetAnimationTime(), headJoint, referenceMatrices);
+
+		for (uint32_t j = 0; j < JointCount; j++) {
+			for (uint32_t row = 0; row < 4; row++) {
+				for (uint32_t column = 0; column < 4; column++)
+					ASSERT_NEAR(jointMatrices[j][row][column], referenceMatrices[j][row][column], 2e-3f) << "frame " << frame << ", joint " << j;
+			}
+		}
+	}
+}
+
+TEST(Animation, missingJointsKeepBindPose) {
+	auto headJoint = acid::test::CreateSkeleton(6);
+	acid::Skeleton skeleton(headJoint);
+	acid::CompiledAnimation compiled(acid::Animation(1s, {}), skeleton);
+	EXPECT_EQ(compiled.GetKeyframeCount(), 1u);
+
+	std::vector<float> pose(compiled.GetPoseLength());
+	uint32_t cursor = 0;
+	compiled.Sample(0.5f, cursor, pose.data());
+
+	// With no animation every joint is in its bind pose, so every joint matrix is the identity.
+	std::vector<acid::Matrix4> modelTransforms, jointMatrices(6);
+	acid::Animator::CalculateJointMatrices(skeleton, pose.data(), compiled.GetStride(), modelTransforms, jointMatrices);
+
+	for (const auto &jointMatrix : jointMatrices) {
+		for (uint32_t row = 0; row < 4; row++) {
+			for (uint32_t column = 0; column < 4; column++)
+				EXPECT_NEAR(jointMatrix[row][column], row == column ? 1.0f : 0.0f, 1e-5f);
+		}
+	}
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include <Bitmaps/Bitmap.hpp>
+
+#include "Textures.hpp"
+
+static const std::filesystem::path BitmapPath = std::filesystem::temp_directory_path() / "AcidTestBitmaps";
+
+TEST(Bitmap, sniffFormat) {
+	std::filesystem::create_directories(BitmapPath);
+	auto bitmap = acid::test::CreateBitmap(64, 1);
+	bitmap->Write(BitmapPath / "Sniff.png");
+
+	// The loader is found from the data, not the extension.
+	std::filesystem::copy_file(BitmapPath / "Sniff.png", BitmapPath / "Sniff.dat", std::filesystem::copy_options::overwrite_existing);
+	acid::Bitmap loaded(BitmapPath / "Sniff.dat");
+	ASSERT_TRUE(loaded);
+	ASSERT_EQ(loaded.GetSize(), bitmap->GetSize());
+	ASSERT_EQ(loaded.GetBytesPerPixel(), 4u);
+	EXPECT_EQ(std::memcmp(loaded.GetData().get(), bitmap->GetData().get(), bitmap->GetLength()), 0);
+
+	// Formats without a registered loader fall back to stb.
+	acid::Bitmap ppm;
+	ppm.LoadMemory(std::string_view("P6 2 1 255 \xff\x00\x00\x00\xff\x00", 17));
+	ASSERT_TRUE(ppm);
+	EXPECT_EQ(ppm.GetSize(), acid::Vector2ui(2, 1));
+	EXPECT_EQ(ppm.GetData()[0], 255);
+	EXPECT_EQ(ppm.GetData()[5], 255);
+
+	acid::Bitmap invalid;
+	invalid.LoadMemory("not an image");
+	EXPECT_FALSE(invalid);
+}
+
+TEST(Bitmap, loadAll) {
+	constexpr uint32_t TextureCount = 6;
+	std::filesystem::create_directories(BitmapPath);
+	std::vector<std::filesystem::path> filenames;
+	std::vector<std::unique_ptr<acid::Bitmap>> sources;
+
+	for (uint32_t i = 0; i < TextureCount; i++) {
+		filenames.emplace_back(BitmapPath / ("Texture" + std::to_string(i) + ".png"));
+		sources.emplace_back(acid::test::CreateBitmap(64, i));
+		sources.back()->Write(filenames.back());
+	}
+
+	// Bitmaps loaded across the pool are in the order of their files, like the ones loaded on this thread.
+	acid::ThreadPool pool(4);
+	for (auto threadPool : {static_cast<acid::ThreadPool *>(nullptr), &pool}) {
+		auto loaded = acid::Bitmap::LoadAll(filenames, threadPool);
+		ASSERT_EQ(loaded.size(), TextureCount);
+		for (uint32_t i = 0; i < TextureCount; i++) {
+			ASSERT_TRUE(*loaded[i]);
+			ASSERT_EQ(loaded[i]->GetSize(), sources[i]->GetSize());
+			EXPECT_EQ(std::memcmp(loaded[i]->GetData().get(), sources[i]->GetData().get(), sources[i]->GetLength()), 0) << filenames[i];
+		}
+	}
+
+	std::filesystem::remove_all(BitmapPath);
+}
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+
+#include <Bitmaps/CompressedBitmap.hpp>
+
+#include "Textures.hpp"
+
+using Format = acid::BlockCompression::Format;
+
+static std::vector<uint8_t> RoundTrip(Format format, const std::vector<uint8_t> &pixels, const acid::Vector2ui &size) {
+	auto data = acid::BlockCompression::Encode(format, pixels.data(), size);
+	EXPECT_EQ(data.size(), acid::BlockCompression::GetLength(format, size));
+
+	std::vector<uint8_t> decoded(pixels.size());
+	EXPECT_TRUE(acid::BlockCompression::Decode(format, data.data(), size, decoded.data()));
+	return decoded;
+}
+
+TEST(BlockCompression, roundTrip) {
+	// Sizes that are not a multiple of the block size are padded.
+	for (auto size : {acid::Vector2ui(64, 64), acid::Vector2ui(13, 7)}) {
+		auto pixels = acid::test::CreateTexture(size, 3);
+		EXPECT_EQ(RoundTrip(Format::Rgba8, pixels, size), pixels);
+		EXPECT_LT(acid::test::RmsError(pixels, RoundTrip(Format::Bc1, pixels, size), 0b0111), 6.0);
+		EXPECT_LT(acid::test::RmsError(pixels, RoundTrip(Format::Bc3, pixels, size), 0b1111), 6.0);
+		EXPECT_LT(acid::test::RmsError(pixels, RoundTrip(Format::Bc5, pixels, size), 0b0011), 2.0);
+		EXPECT_LT(acid::test::RmsError(pixels, RoundTrip(Format::Bc7, pixels, size), 0b1111), 3.0);
+	}
+
+	acid::Vector2ui size(8, 8);
+	auto pixels = acid::test::CreateTexture(size, 5);
+
+	// BC5 only keeps red and green.
+	auto bc5 = RoundTrip(Format::Bc5, pixels, size);
+	EXPECT_EQ(bc5[2], 0);
+	EXPECT_EQ(bc5[3], 255);
+
+	// BC1 keeps alpha as a single bit per pixel.
+	for (uint32_t i = 0; i < 64; i++)
+		pixels[4 * i + 3] = i % 3 == 0 ? 0 : 255;
+	auto bc1 = RoundTrip(Format::Bc1, pixels, size);
+	for (uint32_t i = 0; i < 64; i++)
+		EXPECT_EQ(bc1[4 * i + 3], pixels[4 * i + 3]) << "pixel " << i;
+}
+
+TEST(BlockCompression, bc7) {
+	acid::Vector2ui size(4, 4);
+	std::vector<uint8_t> pixels(64);
+
+	// The first pixel is the brightest, so its index has the highest bit set before the endpoints are swapped.
+	for (uint32_t i = 0; i < 16; i++) {
+		for (uint32_t c = 0; c < 4; c++)
+			pixels[4 * i + c] = static_cast<uint8_t>(255 - 16 * i);
+	}
+
+	auto data = acid::BlockCompression::Encode(Format::Bc7, pixels.data(), size);
+	// Mode 6 has a single 1 at bit 6.
+	EXPECT_EQ(data[0] & 0x7f, 0x40);
+
+	std::vector<uint8_t> decoded(64);
+	EXPECT_TRUE(acid::BlockCompression::Decode(Format::Bc7, data.data(), size, decoded.data()));
+	EXPECT_LT(acid::test::RmsError(pixels, decoded, 0b1111), 3.0);
+
+	// Mode 5 with every field set: endpoints of 255 and a rotation that swaps alpha and red.
+	std::vector<uint8_t> mode5(16, 0xff);
+	mode5[0] = 0b0110'0000;
+	EXPECT_TRUE(acid::BlockCompression::Decode(Format::Bc7, mode5.data(), size, decoded.data()));
+	EXPECT_EQ(decoded[0], 255);
+	EXPECT_EQ(decoded[3], 255);
+
+	// A block without a mode bit is reserved and decodes as magenta.
+	std::vector<uint8_t> reserved(16, 0);
+	EXPECT_FALSE(acid::BlockCompression::Decode(Format::Bc7, reserved.data(), size, decoded.data()));
+	EXPECT_EQ(decoded[0], 255);
+	EXPECT_EQ(decoded[1], 0);
+	EXPECT_EQ(decoded[2], 255);
+}
+
+TEST(BlockCompression, bc7Partitions) {
+	// Pixels 1, 2, 3 and 7 are in the second subset of two subset partition 17, pixel 2 is its anchor.
+	constexpr uint32_t Partition2 = 17;
+	constexpr uint32_t Subsets2[16] = {0, 1, 1, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0};
+	// Pixels 3 and 8 are the anchors of three subset partition 1.
+	constexpr uint32_t Partition3 = 1;
+	constexpr uint32_t Subsets3[16] = {0, 0, 0, 1, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 2, 1};
+	constexpr uint32_t Anchors3[2] = {3, 8};
+
+	enum class PBits { None, Endpoint, Shared };
+	struct Layout {
+		uint32_t m_mode, m_subsets, m_partitionBits, m_colourBits, m_alphaBits;
+		PBits m_pBits;
+		uint32_t m_indexBits;
+	};
+
+	acid::Vector2ui size(4, 4);
+
+	for (auto layout : {Layout{0, 3, 4, 4, 0, PBits::Endpoint, 3}, Layout{1, 2, 6, 6, 0, PBits::Shared, 3}, Layout{2, 3, 6, 5, 0, PBits::None, 2},
+		Layout{3, 2, 6, 7, 0, PBits::Endpoint, 2}, Layout{7, 2, 6, 5, 5, PBits::Endpoint, 2}}) {
+		std::vector<uint8_t> data(16);
+		uint32_t position = 0;
+		auto write = [&](uint32_t value, uint32_t count) {
+			for (uint32_t i = 0; i < count; i++, position++)
+				data[position / 8] |= static_cast<uint8_t>((value >> i & 1) << position % 8);
+		};
+
+		auto partition = layout.m_subsets == 2 ? Partition2 : Partition3;
+		auto subsets = layout.m_subsets == 2 ? Subsets2 : Subsets3;
+		auto endpointCount = 2 * layout.m_subsets;
+
+		// The first endpoint of each subset is a different colour, every second endpoint is white.
+		auto field = [&](uint32_t endpoint, uint32_t c) {
+			auto mask = (1u << (c < 3 ? layout.m_colourBits : layout.m_alphaBits)) - 1;
+			return endpoint % 2 == 1 ? mask : (7 * endpoint + 3 * c + 2) & mask;
+		};
+		auto expected = [&](uint32_t endpoint, uint32_t c) {
+			auto bits = c < 3 ? layout.m_colourBits : layout.m_alphaBits;
+			if (bits == 0)
+				return 255u;
+			auto value = field(endpoint, c);
+			if (layout.m_pBits != PBits::None) {
+				value = value << 1 | 1;
+				bits++;
+			}
+			return value << (8 - bits) | value >> (2 * bits - 8);
+		};
+
+		write(1u << layout.m_mode, layout.m_mode + 1);
+		write(partition, layout.m_partitionBits);
+		for (uint32_t c = 0; c < 4; c++) {
+			for (uint32_t e = 0; e < endpointCount && (c < 3 || layout.m_alphaBits > 0); e++)
+				write(field(e, c), c < 3 ? layout.m_colourBits : layout.m_alphaBits);
+		}
+		if (layout.m_pBits != PBits::None)
+			write(0xff, layout.m_pBits == PBits::Shared ? layout.m_subsets : endpointCount);
+
+		// Only the last pixel has the highest index, the indices after a misplaced anchor would not line up with the end of the block.
+		for (uint32_t i = 0; i < 16; i++) {
+			auto anchor = i == 0 || (layout.m_subsets == 2 ? i == 2 : i == Anchors3[0] || i == Anchors3[1]);
+			auto bits = anchor ? layout.m_indexBits - 1 : layout.m_indexBits;
+			write(i == 15 ? (1u << bits) - 1 : 0, bits);
+		}
+		ASSERT_EQ(position, 128u) << "mode " << layout.m_mode;
+
+		std::vector<uint8_t> decoded(64);
+		EXPECT_TRUE(acid::BlockCompression::Decode(Format::Bc7, data.data(), size, decoded.data()));
+
+		for (uint32_t i = 0; i < 16; i++) {
+			for (uint32_t c = 0; c < 4; c++) {
+				auto value = i == 15 ? 255u : expected(2 * subsets[i], c);
+				EXPECT_EQ(decoded[4 * i + c], value) << "mode " << layout.m_mode << " pixel " << i << " channel " << c;
+			}
+		}
+	}
+}
+
+TEST(BlockCompression, ktx2) {
+	acid::Vector2ui size(64, 32);
+	auto pixels = acid::test::CreateTexture(size, 7);
+	acid::Bitmap bitmap(std::make_unique<uint8_t[]>(pixels.size()), size);
+	std::copy(pixels.begin(), pixels.end(), bitmap.GetData().get());
+
+	acid::CompressedBitmap compressed(bitmap, Format::Bc3);
+	ASSERT_TRUE(compressed);
+	EXPECT_EQ(compressed.GetMipLevels(), 7u);
+	EXPECT_EQ(compressed.GetSize(6), acid::Vector2ui(1, 1));
+	EXPECT_EQ(compressed.GetLevel(0).size(), 16u * 8 * 16);
+	EXPECT_EQ(compressed.GetLevel(6).size(), 16u);
+
+	auto file = compressed.WriteMemory();
+	ASSERT_TRUE(acid::CompressedBitmap::IsKtx2(file));
+
+	acid::CompressedBitmap loaded;
+	ASSERT_TRUE(loaded.LoadMemory(file));
+	EXPECT_EQ(loaded.GetFormat(), Format::Bc3);
+	EXPECT_EQ(loaded.GetSize(), size);
+	ASSERT_EQ(loaded.GetMipLevels(), compressed.GetMipLevels());
+	for (uint32_t level = 0; level < loaded.GetMipLevels(); level++)
+		EXPECT_EQ(loaded.GetLevel(level), compressed.GetLevel(level)) << "level " << level;
+
+	auto decompressed = loaded.Decompress();
+	ASSERT_TRUE(decompressed);
+	EXPECT_EQ(decompressed->GetSize(), size);
+	EXPECT_LT(acid::test::RmsError(pixels, std::vector<uint8_t>(decompressed->GetData().get(), decompressed->GetData().get() + decompressed->GetLength()), 0b1111), 6.0);
+
+	// Truncated files and other formats are rejected.
+	EXPECT_FALSE(loaded.LoadMemory(std::string_view(file).substr(0, file.size() - 1)));
+	EXPECT_FALSE(loaded);
+	EXPECT_FALSE(loaded.LoadMemory("\x89PNG\r\n\x1a\n"));
+}
+
+TEST(BlockCompression, parallelEncode) {
+	// Rows of blocks are split across the pool, the data matches encoding on one thread.
+	acid::Vector2ui size(100, 60);
+	auto pixels = acid::test::CreateTexture(size, 11);
+	acid::ThreadPool pool(4);
+
+	for (auto format : {Format::Bc1, Format::Bc3, Format::Bc5, Format::Bc7})
+		EXPECT_EQ(acid::BlockCompression::Encode(format, pixels.data(), size, &pool), acid::BlockCompression::Encode(format, pixels.data(), size));
+}
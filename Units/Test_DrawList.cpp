@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include <Meshes/DrawList.hpp>
+
+static void ExpectSorted(const acid::DrawList &drawList, const std::vector<uint64_t> &keys, bool itemOrder = true) {
+	const auto &draws = drawList.GetDraws();
+	ASSERT_EQ(draws.size(), keys.size());
+	std::vector<bool> seen(keys.size());
+
+	for (std::size_t i = 0; i < draws.size(); i++) {
+		EXPECT_EQ(draws[i].m_key, keys[draws[i].m_index]);
+		EXPECT_FALSE(seen[draws[i].m_index]);
+		seen[draws[i].m_index] = true;
+
+		// When sorted from scratch equal keys stay in the order of their items, resorting keeps them in their last order.
+		if (i > 0) {
+			ASSERT_LE(draws[i - 1].m_key, draws[i].m_key);
+			if (itemOrder && draws[i - 1].m_key == draws[i].m_key && draws[i - 1].m_index > draws[i].m_index)
+				ADD_FAILURE() << "draw " << i << " is out of item order";
+		}
+	}
+}
+
+TEST(DrawList, keys) {
+	int pipelines[2]{}, models[2]{};
+	using Order = acid::DrawList::Order;
+
+	EXPECT_LT(acid::DrawList::CreateKey(&pipelines[0], &models[0], 1.0f, Order::FrontToBack),
+		acid::DrawList::CreateKey(&pipelines[0], &models[0], 2.0f, Order::FrontToBack));
+	EXPECT_GT(acid::DrawList::CreateKey(&pipelines[0], &models[0], 1.0f, Order::BackToFront),
+		acid::DrawList::CreateKey(&pipelines[0], &models[0], 2.0f, Order::BackToFront));
+	EXPECT_EQ(acid::DrawList::CreateKey(&pipelines[1], &models[1], 1.0f, Order::None),
+		acid::DrawList::CreateKey(&pipelines[1], &models[1], 200.0f, Order::None));
+	EXPECT_EQ(acid::DrawList::CreateKey(&pipelines[0], &models[0], -1.0f, Order::FrontToBack),
+		acid::DrawList::CreateKey(&pipelines[0], &models[0], 0.0f, Order::FrontToBack));
+
+	// Front to back draws are grouped by pipeline before depth, back to front draws order by depth before pipeline.
+	auto near0 = acid::DrawList::CreateKey(&pipelines[0], &models[0], 1.0f, Order::FrontToBack);
+	auto far0 = acid::DrawList::CreateKey(&pipelines[0], &models[0], 9.0f, Order::FrontToBack);
+	auto near1 = acid::DrawList::CreateKey(&pipelines[1], &models[0], 1.0f, Order::FrontToBack);
+	EXPECT_EQ(near0 < near1, far0 < near1);
+	EXPECT_LT(acid::DrawList::CreateKey(&pipelines[0], &models[0], 9.0f, Order::BackToFront),
+		acid::DrawList::CreateKey(&pipelines[1], &models[1], 1.0f, Order::BackToFront));
+}
+
+TEST(DrawList, sortAndResort) {
+	constexpr std::size_t Count = 5000;
+	std::mt19937 random(23);
+	std::uniform_int_distribution<uint64_t> keyDistribution;
+	std::uniform_int_distribution<uint64_t> smallDistribution(0, 20);
+
+	acid::DrawList drawList;
+	drawList.Sort({});
+	EXPECT_TRUE(drawList.GetDraws().empty());
+
+	// Keys with many duplicates, and keys spread over every bit.
+	for (auto distribution : {&keyDistribution, &smallDistribution}) {
+		std::vector<uint64_t> keys(Count);
+		for (auto &key : keys)
+			key = (*distribution)(random);
+
+		drawList.Sort(keys);
+		ExpectSorted(drawList, keys);
+
+		// A few keys change, like a camera moving a little.
+		for (std::size_t i = 0; i < Count; i += 97)
+			keys[i] = (*distribution)(random);
+		drawList.Resort(keys);
+		ExpectSorted(drawList, keys, false);
+
+		// Every key changes, so the list is radix sorted.
+		for (auto &key : keys)
+			key = (*distribution)(random);
+		drawList.Resort(keys);
+		ExpectSorted(drawList, keys, false);
+
+		// A different number of items is sorted from scratch.
+		keys.resize(Count / 2);
+		drawList.Resort(keys);
+		ExpectSorted(drawList, keys);
+	}
+}
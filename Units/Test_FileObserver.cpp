@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <fstream>
+
+#include <Files/FileObserver.hpp>
+
+#include "ChangeLog.hpp"
+
+using namespace std::chrono_literals;
+
+static const std::filesystem::path ObserverPath = std::filesystem::temp_directory_path() / "AcidTestFileObserver";
+
+class FileObserverTest : public testing::TestWithParam<acid::FileObserver::Backend> {
+};
+
+TEST_P(FileObserverTest, changes) {
+	auto path = ObserverPath / "Changes";
+	std::filesystem::remove_all(path);
+	std::filesystem::create_directories(path);
+	std::ofstream(path / "Existing.txt") << "existing";
+
+	acid::test::ChangeLog changes;
+	acid::FileObserver observer(path, 50ms, GetParam(), 50ms);
+	EXPECT_EQ(observer.GetBackend(), GetParam());
+	changes.Listen(observer);
+
+	// A burst of writes is one change, a file created and erased in the burst is not reported.
+	for (uint32_t i = 0; i < 5; i++)
+		std::ofstream(path / "File.txt", std::ios::app) << i;
+	std::ofstream(path / "File.tmp") << "temporary";
+	std::filesystem::remove(path / "File.tmp");
+
+	EXPECT_EQ(changes.Wait(path / "File.txt"), acid::FileObserver::Status::Created);
+	EXPECT_EQ(changes.GetChangeCount(), 1u);
+	changes.Clear();
+
+	std::ofstream(path / "Existing.txt") << "modified";
+	EXPECT_EQ(changes.Wait(path / "Existing.txt"), acid::FileObserver::Status::Modified);
+	changes.Clear();
+
+	// Files in new directories are found.
+	std::filesystem::create_directories(path / "Folder" / "Nested");
+	std::ofstream(path / "Folder" / "Nested" / "Nested.txt") << "nested";
+	EXPECT_EQ(changes.Wait(path / "Folder" / "Nested" / "Nested.txt"), acid::FileObserver::Status::Created);
+	EXPECT_EQ(changes.Wait(path / "Folder"), acid::FileObserver::Status::Created);
+	changes.Clear();
+
+	std::ofstream(path / "Folder" / "Nested" / "Nested.txt") << "modified";
+	EXPECT_EQ(changes.Wait(path / "Folder" / "Nested" / "Nested.txt"), acid::FileObserver::Status::Modified);
+	changes.Clear();
+
+	std::filesystem::remove(path / "File.txt");
+	EXPECT_EQ(changes.Wait(path / "File.txt"), acid::FileObserver::Status::Erased);
+}
+
+INSTANTIATE_TEST_CASE_P(Backends, FileObserverTest, testing::Values(acid::FileObserver::Backend::Polling, acid::FileObserver::Backend::Inotify));
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include <Files/FileQueue.hpp>
+
+static const std::filesystem::path QueuePath = std::filesystem::temp_directory_path() / "AcidTestFileQueue";
+
+static std::string CreateFile(std::size_t index, std::size_t length) {
+	std::string data(length, '\0');
+	auto seed = static_cast<uint32_t>(index);
+	for (auto &c : data) {
+		seed = seed * 1664525 + 1013904223;
+		c = static_cast<char>(seed >> 24);
+	}
+	return data;
+}
+
+class FileQueueTest : public testing::TestWithParam<acid::FileQueue::Backend> {
+};
+
+TEST_P(FileQueueTest, readAndCancel) {
+	std::filesystem::create_directories(QueuePath);
+	std::vector<std::string> files;
+	for (std::size_t i = 0; i < 8; i++) {
+		// Lengths that are not a multiple of a page, and a empty file.
+		files.emplace_back(CreateFile(i, i * 70001));
+		std::ofstream(QueuePath / ("File" + std::to_string(i) + ".bin"), std::ios::binary) << files.back();
+	}
+
+	acid::ThreadPool pool(2);
+	acid::FileQueue queue(&pool, GetParam(), 4);
+
+	std::atomic<uint32_t> called = 0;
+	std::vector<std::shared_ptr<acid::FileRequest>> requests;
+	for (std::size_t i = 0; i < files.size(); i++) {
+		requests.emplace_back(queue.Read(QueuePath / ("File" + std::to_string(i) + ".bin"), [&](acid::FileRequest &request) {
+			EXPECT_EQ(request.GetStatus(), acid::FileRequest::Status::Completed);
+			called++;
+		}));
+	}
+
+	auto missing = queue.Read(QueuePath / "Missing.bin", [&](acid::FileRequest &request) {
+		EXPECT_EQ(request.GetStatus(), acid::FileRequest::Status::Failed);
+		called++;
+	});
+
+	queue.Wait();
+	EXPECT_EQ(called, files.size() + 1);
+	EXPECT_TRUE(missing->IsDone());
+
+	for (std::size_t i = 0; i < files.size(); i++) {
+		EXPECT_TRUE(requests[i]->IsDone());
+		EXPECT_EQ(requests[i]->GetData(), files[i]);
+	}
+
+	// Completed requests can not be cancelled.
+	EXPECT_FALSE(queue.Cancel(*requests[1]));
+
+	// A request that waits on a slow callback blocks the I/O thread,
+	// so requests queued behind it are started by priority and can be cancelled.
+	acid::FileQueue blocked(nullptr, GetParam(), 1);
+	std::mutex mutex;
+	std::unique_lock<std::mutex> hold(mutex);
+	std::vector<std::size_t> order;
+
+	auto first = blocked.Read(QueuePath / "File1.bin", [&](acid::FileRequest &) {
+		std::unique_lock<std::mutex> lock(mutex);
+		order.emplace_back(0);
+	});
+	while (first->GetStatus() == acid::FileRequest::Status::Queued)
+		std::this_thread::yield();
+
+	auto low = blocked.Read(QueuePath / "File2.bin", [&](acid::FileRequest &) {
+		order.emplace_back(1);
+	}, acid::FileRequest::Priority::Low);
+	auto high = blocked.Read(QueuePath / "File3.bin", [&](acid::FileRequest &) {
+		order.emplace_back(2);
+	}, acid::FileRequest::Priority::High);
+	auto cancelled = blocked.Read(QueuePath / "File4.bin", [&](acid::FileRequest &) {
+		order.emplace_back(3);
+	}, acid::FileRequest::Priority::High);
+
+	EXPECT_TRUE(blocked.Cancel(*cancelled));
+	EXPECT_EQ(cancelled->GetStatus(), acid::FileRequest::Status::Cancelled);
+	EXPECT_TRUE(cancelled->IsDone());
+	hold.unlock();
+
+	blocked.Wait();
+	EXPECT_EQ(order, (std::vector<std::size_t>{0, 2, 1}));
+	EXPECT_TRUE(cancelled->GetData().empty());
+}
+
+INSTANTIATE_TEST_CASE_P(Backends, FileQueueTest, testing::Values(acid::FileQueue::Backend::Threads, acid::FileQueue::Backend::IoUring));
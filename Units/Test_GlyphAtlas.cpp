@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+
+#include <Fonts/GlyphAtlas.hpp>
+
+#include "Fonts.hpp"
+
+using acid::test::Characters;
+
+static const std::filesystem::path CachePath = "Cache/TestFonts/OpenSans-Regular_32.glyphs";
+
+TEST(GlyphAtlas, parallelCache) {
+	auto fontData = acid::test::ReadFont();
+	ASSERT_FALSE(fontData.empty()) << acid::test::FontPath << " was not found";
+
+	acid::GlyphAtlas serial(fontData, 32);
+	EXPECT_EQ(serial.AddGlyphs(Characters), Characters.size());
+
+	acid::ThreadPool pool(4);
+	acid::GlyphAtlas parallel(fontData, 32);
+	EXPECT_EQ(parallel.AddGlyphs(Characters, &pool), Characters.size());
+	EXPECT_EQ(parallel.AddGlyphs(L"ABCabc"), 0u);
+	EXPECT_EQ(parallel.GetPixels(), serial.GetPixels());
+	EXPECT_EQ(parallel.GetGlyph(*parallel.GetLayer(L'W')).m_advance, serial.GetGlyph(*serial.GetLayer(L'W')).m_advance);
+
+	// Glyphs outside of the preset are added after the preset, and are kept in the cache.
+	EXPECT_EQ(parallel.AddGlyphs(L"éèé", &pool), 2u);
+	EXPECT_EQ(*parallel.GetLayer(L'è'), Characters.size() + 1);
+	ASSERT_TRUE(parallel.WriteCache(CachePath));
+
+	acid::GlyphAtlas cached(fontData, 32);
+	ASSERT_TRUE(cached.ReadCache(CachePath));
+	EXPECT_EQ(cached.GetGlyphCount(), Characters.size() + 2);
+	EXPECT_EQ(cached.GetPixels(), parallel.GetPixels());
+	EXPECT_EQ(*cached.GetLayer(L'è'), Characters.size() + 1);
+	EXPECT_EQ(cached.GetGlyph(*cached.GetLayer(L'g')).m_i0, parallel.GetGlyph(*parallel.GetLayer(L'g')).m_i0);
+
+	// A cache is only read by the same font and size.
+	acid::GlyphAtlas otherSize(fontData, 24);
+	EXPECT_FALSE(otherSize.ReadCache(CachePath));
+
+	std::filesystem::remove_all(CachePath.parent_path());
+}
@@ -0,0 +1,15 @@
+#include <gtest/gtest.h>
+
+#include <Helpers/Hash.hpp>
+
+TEST(Hash, fnv1a) {
+	// Published 64-bit FNV-1a values, hashes are stored in pack archives and cache keys so they must never change.
+	EXPECT_EQ(acid::HashBytes("", 0), 0xcbf29ce484222325ull);
+	EXPECT_EQ(acid::HashBytes("a", 1), 0xaf63dc4c8601ec8cull);
+	EXPECT_EQ(acid::HashBytes("foobar", 6), 0x85944171f73967e8ull);
+	EXPECT_EQ(acid::HashByte('r', acid::HashBytes("fooba", 5)), acid::HashBytes("foobar", 6));
+
+	// The length is part of a string hash, so moving characters between strings changes the hash.
+	EXPECT_NE(acid::HashString("b", acid::HashString("a")), acid::HashString("", acid::HashString("ab")));
+	EXPECT_EQ(acid::HashValue(uint32_t(7)), acid::HashBytes("\x07\0\0\0", 4));
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include <Files/Json/Json.hpp>
+
+#include "Documents.hpp"
+
+TEST(Json, parse) {
+	acid::Json json;
+	json.ParseString(R"({"a": "x\\", "b": "say \"hi\"", "c": [1, 2.5, -3, true, null, {}], "d": {"e": "\\\\"}, "f": "{[:,]}"})");
+
+	EXPECT_EQ(json["a"].Get<std::string>(), "x\\");
+	EXPECT_EQ(json["b"].Get<std::string>(), "say \"hi\"");
+	EXPECT_EQ(json["c"].GetProperties().size(), 6u);
+	EXPECT_EQ(json["c"][1]->GetType(), acid::Node::Type::Decimal);
+	EXPECT_EQ(json["c"][2].Get<int32_t>(), -3);
+	EXPECT_EQ(json["c"][4]->GetType(), acid::Node::Type::Null);
+	EXPECT_EQ(json["c"][5]->GetType(), acid::Node::Type::Object);
+	EXPECT_EQ(json["d"]["e"].Get<std::string>(), "\\\\");
+	EXPECT_EQ(json["f"].Get<std::string>(), "{[:,]}");
+
+	acid::Json array;
+	array.ParseString("[1,[2,[3]]]");
+	EXPECT_EQ(array.GetType(), acid::Node::Type::Array);
+	EXPECT_EQ(array[1][1][0].Get<int32_t>(), 3);
+
+	EXPECT_THROW(acid::Json().ParseString(""), std::runtime_error);
+	EXPECT_THROW(acid::Json().ParseString("{\"a\": \"b"), std::runtime_error);
+	EXPECT_THROW(acid::Json().ParseString("{\"a\" 1}"), std::runtime_error);
+	EXPECT_THROW(acid::Json().ParseString("{\"a\": [1}"), std::runtime_error);
+	EXPECT_THROW(acid::Json().ParseString("{\"a\": 1"), std::runtime_error);
+}
+
+static std::string ParseError(std::string_view string) {
+	try {
+		acid::Json().ParseString(string);
+	} catch (const std::runtime_error &e) {
+		return e.what();
+	}
+
+	return "";
+}
+
+TEST(Json, parseErrors) {
+	EXPECT_EQ(ParseError(R"({"a": 1,})"), "Trailing comma before }");
+	EXPECT_EQ(ParseError(R"([1, 2,])"), "Trailing comma before ]");
+	EXPECT_EQ(ParseError(R"([1,, 2])"), "Unexpected , after a comma");
+	EXPECT_EQ(ParseError(R"({, "a": 1})"), "Unexpected , before a value");
+	EXPECT_EQ(ParseError(R"({"a": tru})"), "Unexpected tru, expected a number, true, false or null");
+	EXPECT_EQ(ParseError(R"([nul])"), "Unexpected nul, expected a number, true, false or null");
+	EXPECT_EQ(ParseError(R"({"a": 1}{"b": 2})"), "Unexpected { after the end of the document");
+	EXPECT_EQ(ParseError(R"([1] 2)"), "Unexpected 2 after the end of the document");
+	EXPECT_EQ(ParseError(R"({"a": 1 2})"), "Missing comma before 2");
+	EXPECT_EQ(ParseError(R"({"a": 1 "b": 2})"), "Missing comma before \"b\"");
+	EXPECT_EQ(ParseError(R"([[1] [2]])"), "Missing comma before [");
+	EXPECT_EQ(ParseError(R"({"a" 1})"), "Missing object colon before 1");
+	EXPECT_EQ(ParseError(R"({1: 2})"), "Object key 1 is not a string");
+
+	// Whitespace after the root value is not content, and a byte order mark before it is skipped.
+	EXPECT_EQ(ParseError("{\"a\": 1}\n\t "), "");
+	EXPECT_EQ(ParseError("\xEF\xBB\xBF{\"a\": 1}"), "");
+
+	std::stringstream stream("\xEF\xBB\xBF{\"a\": 1}");
+	acid::Json json;
+	json.ParseStream(stream);
+	EXPECT_EQ(json["a"].Get<int32_t>(), 1);
+}
+
+TEST(Json, streamMatchesString) {
+	auto source = acid::test::CreateJsonDocument(5000, true);
+
+	acid::Json json;
+	json.ParseString(source);
+
+	std::istringstream stream(source);
+	acid::Json streamed;
+	streamed.ParseStream(stream);
+
+	// The legacy tokenizer ended strings at a quote after a escaped backslash.
+	auto legacySource = acid::test::CreateJsonDocument(5000, false);
+	acid::Json current;
+	current.ParseString(legacySource);
+	acid::test::LegacyJson legacy;
+	legacy.ParseString(legacySource);
+
+	EXPECT_EQ(json["entries"].GetProperties().size(), 5000u);
+	EXPECT_EQ(json["entries"][4321]["quoted"].Get<std::string>(), "say \"" + std::string(3, 'a' + 4321 % 26) + "\"");
+	EXPECT_TRUE(json.WriteString() == streamed.WriteString());
+	EXPECT_TRUE(current.WriteString() == legacy.WriteString());
+	EXPECT_TRUE(acid::Json(acid::Json::ParseDocument(source).GetRoot().ToNode()).WriteString() == json.WriteString());
+}
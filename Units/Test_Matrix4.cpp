@@ -0,0 +1,231 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include <Maths/Matrix3.hpp>
+#include <Maths/Matrix4.hpp>
+#include <Physics/Frustum.hpp>
+
+#include "Matrices.hpp"
+
+// The scalar loops Matrix4 used before its SIMD kernels, kept as a reference the kernels are checked against.
+namespace reference {
+static acid::Matrix4 Multiply(const acid::Matrix4 &left, const acid::Matrix4 &right) {
+	acid::Matrix4 result;
+
+	for (uint32_t row = 0; row < 4; row++) {
+		for (uint32_t col = 0; col < 4; col++)
+			result[row][col] = left[0][col] * right[row][0] + left[1][col] * right[row][1] + left[2][col] * right[row][2] + left[3][col] * right[row][3];
+	}
+
+	return result;
+}
+
+static acid::Vector4f Transform(const acid::Matrix4 &matrix, const acid::Vector4f &vector) {
+	acid::Vector4f result;
+
+	for (uint32_t row = 0; row < 4; row++)
+		result[row] = matrix[0][row] * vector.m_x + matrix[1][row] * vector.m_y + matrix[2][row] * vector.m_z + matrix[3][row] * vector.m_w;
+
+	return result;
+}
+
+static acid::Matrix4 Rotate(const acid::Matrix4 &matrix, float angle, const acid::Vector3f &axis) {
+	auto c = std::cos(angle);
+	auto s = std::sin(angle);
+	auto o = 1.0f - c;
+
+	acid::Matrix3 f;
+	f[0][0] = axis.m_x * axis.m_x * o + c;
+	f[0][1] = axis.m_x * axis.m_y * o + axis.m_z * s;
+	f[0][2] = axis.m_x * axis.m_z * o - axis.m_y * s;
+	f[1][0] = axis.m_x * axis.m_y * o - axis.m_z * s;
+	f[1][1] = axis.m_y * axis.m_y * o + c;
+	f[1][2] = axis.m_y * axis.m_z * o + axis.m_x * s;
+	f[2][0] = axis.m_x * axis.m_z * o + axis.m_y * s;
+	f[2][1] = axis.m_y * axis.m_z * o - axis.m_x * s;
+	f[2][2] = axis.m_z * axis.m_z * o + c;
+
+	acid::Matrix4 result;
+
+	for (uint32_t row = 0; row < 3; row++) {
+		for (uint32_t col = 0; col < 4; col++)
+			result[row][col] = matrix[0][col] * f[row][0] + matrix[1][col] * f[row][1] + matrix[2][col] * f[row][2];
+	}
+
+	result[3] = matrix[3];
+	return result;
+}
+
+static float Determinant(const acid::Matrix4 &matrix) {
+	float result = 0.0f;
+
+	for (uint32_t i = 0; i < 4; i++)
+		result += (i % 2 == 1 ? -1.0f : 1.0f) * matrix[0][i] * matrix.GetSubmatrix(0, i).Determinant();
+
+	return result;
+}
+
+static acid::Matrix4 Inverse(const acid::Matrix4 &matrix) {
+	acid::Matrix4 result;
+	auto det = Determinant(matrix);
+
+	for (uint32_t j = 0; j < 4; j++) {
+		for (uint32_t i = 0; i < 4; i++)
+			result[i][j] = ((i + j) % 2 == 1 ? -1.0f : 1.0f) * matrix.GetSubmatrix(j, i).Determinant() / det;
+	}
+
+	return result;
+}
+
+// The planes Frustum extracted with its hand written clip matrix.
+static std::array<acid::Vector4f, 6> FrustumPlanes(const acid::Matrix4 &view, const acid::Matrix4 &projection) {
+	float clip[16];
+
+	for (uint32_t row = 0; row < 4; row++) {
+		for (uint32_t col = 0; col < 4; col++)
+			clip[row * 4 + col] = view[row][0] * projection[0][col] + view[row][1] * projection[1][col] + view[row][2] * projection[2][col] + view[row][3] * projection[3][col];
+	}
+
+	auto column = [&](uint32_t col) { return acid::Vector4f(clip[col], clip[4 + col], clip[8 + col], clip[12 + col]); };
+	std::array<acid::Vector4f, 6> planes = {column(3) + column(0), column(3) - column(0), column(3) + column(1), column(3) - column(1),
+		column(3) + column(2), column(3) - column(2)};
+
+	for (auto &plane : planes)
+		plane /= acid::Vector3f(plane).Length();
+
+	return planes;
+}
+
+static bool SphereInFrustum(const std::array<acid::Vector4f, 6> &planes, const acid::Vector3f &position, float radius) {
+	for (const auto &plane : planes) {
+		if (plane.m_x * position.m_x + plane.m_y * position.m_y + plane.m_z * position.m_z + plane.m_w <= -radius)
+			return false;
+	}
+
+	return true;
+}
+}
+
+TEST(Matrix4, matchesScalar) {
+	std::mt19937 random(11);
+	std::uniform_real_distribution<float> distribution(-2.0f, 2.0f);
+
+	for (uint32_t i = 0; i < 1000; i++) {
+		auto a = acid::test::RandomMatrix(random);
+		auto b = acid::test::RandomMatrix(random);
+		acid::Vector4f vector(distribution(random), distribution(random), distribution(random), distribution(random));
+		auto axis = acid::Vector3f(distribution(random), distribution(random), distribution(random)).Normalize();
+
+		acid::test::ExpectNear(a * b, reference::Multiply(a, b), 1e-5f);
+		acid::test::ExpectNear(a.Rotate(1.3f, axis), reference::Rotate(a, 1.3f, axis), 1e-5f);
+		acid::test::ExpectNear(a.Translate(acid::Vector3f(vector)), reference::Multiply(a, acid::Matrix4().Translate(acid::Vector3f(vector))), 1e-5f);
+
+		auto sum = a + b, difference = a - b, scaled = a * vector;
+
+		for (uint32_t row = 0; row < 4; row++) {
+			EXPECT_EQ(sum[row], a[row] + b[row]);
+			EXPECT_EQ(difference[row], a[row] - b[row]);
+			EXPECT_EQ(scaled[row], a[row] * vector[row]);
+		}
+
+		EXPECT_EQ(-a, a * -1.0f);
+		EXPECT_EQ(a.Transpose().Transpose(), a);
+		EXPECT_EQ(a.Transpose()[1][2], a[2][1]);
+
+		auto transformed = a.Transform(vector);
+		auto expected = reference::Transform(a, vector);
+		EXPECT_NEAR((transformed - expected).Length(), 0.0f, 1e-5f);
+
+		// Random matrices can be close to singular, so the inverse is compared relative to its size.
+		auto det = reference::Determinant(a);
+		EXPECT_NEAR(a.Determinant(), det, 1e-4f * std::max(1.0f, std::abs(det)));
+
+		if (std::abs(det) > 0.1f) {
+			auto inverse = a.Inverse();
+			acid::test::ExpectNear(inverse, reference::Inverse(a), 1e-4f * std::max(1.0f, std::abs(inverse[0][0]) + std::abs(inverse[1][1])));
+			acid::test::ExpectNear(a * inverse, acid::Matrix4(), 1e-3f);
+		}
+	}
+
+	EXPECT_THROW(acid::Matrix4(0.0f).Inverse(), std::runtime_error);
+}
+
+TEST(Matrix4, batches) {
+	constexpr std::size_t Count = 67;
+	std::mt19937 random(13);
+	std::uniform_real_distribution<float> distribution(-5.0f, 5.0f);
+	auto matrix = acid::test::RandomMatrix(random);
+
+	std::vector<acid::Matrix4> left(Count), right(Count), results(Count);
+	std::vector<acid::Vector4f> vectors(Count), transformed(Count);
+	std::vector<acid::Vector3f> points(Count), transformedPoints(Count);
+
+	for (std::size_t i = 0; i < Count; i++) {
+		left[i] = acid::test::RandomMatrix(random);
+		right[i] = acid::test::RandomMatrix(random);
+		vectors[i] = {distribution(random), distribution(random), distribution(random), distribution(random)};
+		points[i] = {distribution(random), distribution(random), distribution(random)};
+	}
+
+	acid::Matrix4::Multiply(left.data(), right.data(), results.data(), Count);
+	matrix.Transform(vectors.data(), transformed.data(), Count);
+	matrix.TransformPoints(points.data(), transformedPoints.data(), Count);
+
+	for (std::size_t i = 0; i < Count; i++) {
+		EXPECT_EQ(results[i], left[i] * right[i]);
+		EXPECT_EQ(transformed[i], matrix.Transform(vectors[i]));
+		EXPECT_EQ(transformedPoints[i], acid::Vector3f(matrix.Transform(acid::Vector4f(points[i], 1.0f))));
+	}
+
+	// Results may be written over either input.
+	auto expected = results;
+	acid::Matrix4::Multiply(left.data(), right.data(), right.data(), Count);
+	EXPECT_EQ(right, expected);
+	matrix.TransformPoints(points.data(), points.data(), Count);
+	EXPECT_EQ(points, transformedPoints);
+}
+
+TEST(Matrix4, spheresInFrustum) {
+	constexpr std::size_t Count = 1003;
+	auto view = acid::Matrix4::ViewMatrix({1.0f, 2.0f, -3.0f}, {0.3f, -0.7f, 0.1f});
+	auto projection = acid::Matrix4::PerspectiveMatrix(1.2f, 1.6f, 0.1f, 100.0f);
+	acid::Frustum frustum;
+	frustum.Update(view, projection);
+	auto planes = reference::FrustumPlanes(view, projection);
+
+	std::mt19937 random(17);
+	std::uniform_real_distribution<float> distribution(-60.0f, 60.0f);
+	std::uniform_real_distribution<float> radiusDistribution(0.0f, 4.0f);
+	std::vector<float> x(Count), y(Count), z(Count), radius(Count);
+
+	for (std::size_t i = 0; i < Count; i++) {
+		x[i] = distribution(random);
+		y[i] = distribution(random);
+		z[i] = distribution(random);
+		radius[i] = radiusDistribution(random);
+	}
+
+	std::vector<uint8_t> visible(Count);
+	frustum.SpheresInFrustum(x.data(), y.data(), z.data(), radius.data(), Count, visible.data(), 2.0f);
+	std::size_t visibleCount = 0;
+
+	for (std::size_t i = 0; i < Count; i++) {
+		acid::Vector3f position(x[i], y[i], z[i]);
+		EXPECT_EQ(visible[i] == 1, frustum.SphereInFrustum(position, radius[i] * 2.0f)) << "sphere " << i;
+
+		// Spheres touching a plane may round either way, the extracted planes are compared away from them.
+		auto nearPlane = false;
+		for (const auto &plane : planes)
+			nearPlane |= std::abs(plane.m_x * x[i] + plane.m_y * y[i] + plane.m_z * z[i] + plane.m_w + radius[i] * 2.0f) < 1e-3f;
+
+		if (!nearPlane) {
+			EXPECT_EQ(visible[i] == 1, reference::SphereInFrustum(planes, position, radius[i] * 2.0f)) << "sphere " << i;
+		}
+
+		visibleCount += visible[i];
+	}
+
+	EXPECT_GT(visibleCount, 0u);
+	EXPECT_LT(visibleCount, Count);
+}
@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+
+#include <Files/Json/Json.hpp>
+
+#include "Documents.hpp"
+
+TEST(NodeDocument, matchesJson) {
+	auto source = acid::test::CreateScene(50);
+
+	acid::Json json;
+	json.ParseString(source);
+	auto document = acid::Json::ParseDocument(source);
+
+	EXPECT_EQ(acid::Json(document.GetRoot().ToNode()).WriteString(), json.WriteString());
+	EXPECT_EQ(document["entities"].GetPropertyCount(), 50u);
+	EXPECT_EQ(document["entities"][3]["name"].Get<std::string>(), "Entity \"3\"");
+	EXPECT_EQ(document["entities"][3]["name"].GetValueView(), "Entity \\\"3\\\"");
+	EXPECT_TRUE(document["entities"][3]["enabled"].Get<bool>());
+	EXPECT_EQ(document["entities"][3]["parent"].GetType(), acid::Node::Type::Null);
+	EXPECT_FLOAT_EQ(document["entities"][3]["transform"]["position"][0].Get<float>(), 3.5f);
+	EXPECT_EQ(document["entities"][3]["transform"]["rotation"].Get<std::vector<int32_t>>(), (std::vector<int32_t>{0, 3, 0}));
+	EXPECT_EQ(document["entities"][3]["mesh"]["material"].Get<acid::Node>()["metallic"].Get<float>(), 0.1f);
+
+	// Missing properties chain like on a node.
+	EXPECT_FALSE(document["entities"][3]["missing"]["deeper"]);
+	EXPECT_EQ(document["entities"][3]["missing"].Get<float>(2.0f), 2.0f);
+	EXPECT_EQ(document["entities"][999]["name"].Get<std::string>(), "");
+
+	EXPECT_THROW(acid::Json::ParseDocument("{\"a\": [1, 2}"), std::runtime_error);
+	EXPECT_THROW(acid::Json::ParseDocument("{\"a\" 1}"), std::runtime_error);
+	EXPECT_THROW(acid::Json::ParseDocument("  "), std::runtime_error);
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include <Files/Pack/PackArchive.hpp>
+
+#include "Documents.hpp"
+
+static const std::filesystem::path PackPath = std::filesystem::temp_directory_path() / "AcidTestPacks";
+
+TEST(PackArchive, writeAndRead) {
+	std::filesystem::create_directories(PackPath);
+	auto filename = PackPath / "Test.pak";
+	auto text = acid::test::CreateText(1, 10000);
+	std::string binary(1000, '\0');
+	for (std::size_t i = 0; i < binary.size(); i++)
+		binary[i] = static_cast<char>(i * 7919 >> 3);
+
+	{
+		acid::PackWriter writer(filename);
+		EXPECT_TRUE(writer.AddEntry("Shaders\\Text.glsl", text, acid::PackArchive::Compression::Deflate));
+		EXPECT_TRUE(writer.AddEntry("Binary.bin", binary, acid::PackArchive::Compression::Deflate));
+		EXPECT_TRUE(writer.AddEntry("Stored.txt", text));
+		EXPECT_TRUE(writer.AddEntry("Empty.txt", ""));
+		// Names are unique after separators are normalized.
+		EXPECT_FALSE(writer.AddEntry("Shaders/Text.glsl", "again"));
+		EXPECT_TRUE(writer.Finish());
+	}
+
+	acid::PackArchive archive(filename);
+	ASSERT_TRUE(archive);
+	EXPECT_EQ(archive.GetEntryCount(), 4u);
+	EXPECT_EQ(archive.GetEntryNames()[0], "Shaders/Text.glsl");
+
+	// Text is deflated, data that deflate cannot shrink is stored.
+	auto text0 = archive.Find("Shaders/Text.glsl");
+	ASSERT_NE(text0, nullptr);
+	EXPECT_EQ(text0->m_compression, acid::PackArchive::Compression::Deflate);
+	EXPECT_LT(text0->m_storedLength, text.size() / 2);
+	EXPECT_EQ(archive.Find("Shaders\\Text.glsl"), text0);
+
+	EXPECT_EQ(archive.ReadView("Shaders/Text.glsl"), std::string_view(text));
+	EXPECT_EQ(archive.Read("Shaders/Text.glsl"), text);
+	EXPECT_EQ(archive.ReadView("Binary.bin"), std::string_view(binary));
+	EXPECT_EQ(archive.ReadView("Empty.txt"), std::string_view());
+
+	// Stored entries are viewed straight from the mapping, aligned to 64 bytes.
+	auto stored = archive.ReadView("Stored.txt");
+	ASSERT_TRUE(stored);
+	EXPECT_EQ(*stored, text);
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(stored->data()) % 64, 0u);
+	EXPECT_EQ(archive.ReadView("Stored.txt")->data(), stored->data());
+
+	// Inflated entries are kept, so views stay valid.
+	EXPECT_EQ(archive.ReadView("Shaders/Text.glsl")->data(), archive.ReadView("Shaders/Text.glsl")->data());
+
+	EXPECT_FALSE(archive.ReadView("Missing.txt"));
+	EXPECT_FALSE(archive.Exists("Shaders"));
+
+	// Truncated and foreign files are rejected.
+	auto size = std::filesystem::file_size(filename);
+	std::filesystem::copy_file(filename, PackPath / "Truncated.pak", std::filesystem::copy_options::overwrite_existing);
+	std::filesystem::resize_file(PackPath / "Truncated.pak", size - 1);
+	EXPECT_FALSE(acid::PackArchive(PackPath / "Truncated.pak"));
+
+	std::ofstream(PackPath / "Text.pak") << text;
+	EXPECT_FALSE(acid::PackArchive(PackPath / "Text.pak"));
+	EXPECT_FALSE(acid::PackArchive(PackPath / "Missing.pak"));
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include <Particles/ParticleStore.hpp>
+
+#include "Particles.hpp"
+
+TEST(Particles, updateAndRemove) {
+	acid::ParticleStore store;
+	store.Add({0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, 10.0f, 1.0f, 0.0f, 1.0f, 0.0f);
+	store.Add({0.0f, 0.0f, 5.0f}, {0.0f, 0.0f, 0.0f}, 0.5f, 1.0f, 0.0f, 1.0f, 1.0f);
+	store.Add({0.0f, 0.0f, 20.0f}, {0.0f, 0.0f, 0.0f}, 10.0f, 1.0f, 0.0f, 1.0f, 0.0f);
+
+	// The second particle starts fading immediately and is gone after one fade time.
+	store.Update(1.1f, {0.0f, 0.0f, 0.0f});
+	ASSERT_EQ(store.GetSize(), 2u);
+	EXPECT_FLOAT_EQ(store.GetPosition(0).m_x, 1.1f);
+	EXPECT_FLOAT_EQ(store.GetElapsedTime(0), 1.1f);
+	EXPECT_FLOAT_EQ(store.GetTransparency(0), 1.0f);
+
+	// Furthest from the camera first.
+	ASSERT_EQ(store.GetDrawOrder().size(), 2u);
+	EXPECT_FLOAT_EQ(store.GetPosition(store.GetDrawOrder()[0]).m_z, 20.0f);
+	EXPECT_FLOAT_EQ(store.GetPosition(store.GetDrawOrder()[1]).m_z, 0.0f);
+}
+
+TEST(Particles, simdMatchesScalar) {
+	// 37 particles leave a remainder for the scalar tail after the vector loop.
+	acid::ParticleStore store;
+	acid::test::FillStore(store, 37);
+
+	for (uint32_t frame = 0; frame < 250; frame++) {
+		auto before = store.GetSize();
+		std::vector<acid::Vector3f> expected;
+
+		for (std::size_t i = 0; i < before; i++) {
+			auto velocity = store.GetVelocity(i);
+			velocity.m_y += -10.0f * 0.05f;
+			expected.emplace_back(store.GetPosition(i) + velocity * 0.05f);
+		}
+
+		store.Update(0.05f, {0.0f, 0.0f, 0.0f});
+
+		if (store.GetSize() == before) {
+			for (std::size_t i = 0; i < before; i++) {
+				EXPECT_NEAR(store.GetPosition(i).m_y, expected[i].m_y, 1e-3f);
+			}
+		}
+
+		for (std::size_t i = 1; i < store.GetDrawOrder().size(); i++) {
+			// Keys keep the top 16 bits of the distance, ties within that precision may be in any order.
+			EXPECT_GE(store.GetDistanceToCamera(store.GetDrawOrder()[i - 1]) * 1.01f, store.GetDistanceToCamera(store.GetDrawOrder()[i]));
+		}
+	}
+
+	EXPECT_TRUE(store.IsEmpty());
+}
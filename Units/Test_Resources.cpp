@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+
+#include <Resources/Resources.hpp>
+
+#include "ResourceNodes.hpp"
+
+using acid::test::CreateResourceNode;
+
+TEST(Resources, hashConsistency) {
+	auto a = CreateResourceNode(42);
+	auto b = CreateResourceNode(42);
+	auto c = CreateResourceNode(43);
+
+	EXPECT_TRUE(a == b);
+	EXPECT_EQ(a.GetHash(), b.GetHash());
+	EXPECT_NE(a.GetHash(), c.GetHash());
+}
+
+TEST(Resources, find) {
+	acid::Resources resources;
+	std::vector<std::shared_ptr<acid::test::TestResource>> alive;
+
+	for (uint32_t i = 0; i < 100; i++) {
+		auto resource = alive.emplace_back(std::make_shared<acid::test::TestResource>());
+		resources.Add(CreateResourceNode(i), resource);
+	}
+
+	// A equal node built again finds the same resource.
+	EXPECT_EQ(resources.Find<acid::test::TestResource>(CreateResourceNode(37)), alive[37]);
+	EXPECT_FALSE(resources.Find<acid::test::TestResource>(CreateResourceNode(100)));
+
+	resources.Remove(alive[37]);
+	EXPECT_FALSE(resources.Find<acid::test::TestResource>(CreateResourceNode(37)));
+	EXPECT_EQ(resources.Find<acid::test::TestResource>(CreateResourceNode(38)), alive[38]);
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include <Graphics/Pipelines/Shader.hpp>
+#include <Graphics/Pipelines/ShaderCache.hpp>
+
+static const std::filesystem::path CacheDirectory = "Cache/TestShaders";
+static const std::filesystem::path ShadersPath = std::filesystem::path(__FILE__).parent_path().parent_path() / "Resources/Shaders";
+
+static acid::ShaderCache::Entry CreateEntry(const std::filesystem::path &includePath) {
+	acid::ShaderCache::Entry entry;
+	entry.m_spirv = {0x07230203, 0x00010300, 0x00080007, 0x00000010, 0x00000000};
+	entry.m_reflection["uniformBlocks"]["UniformObject"]["binding"] = 0;
+	entry.m_reflection["uniformBlocks"]["UniformObject"]["size"] = 64;
+	entry.m_reflection["localSizes"] = std::vector<uint32_t>{16, 16, 0};
+	entry.m_includes[includePath.string()] = acid::ShaderCache::HashContents("vec3 Lighting();\n");
+	return entry;
+}
+
+TEST(ShaderCache, keys) {
+	auto key = acid::ShaderCache::GetKey("void main() {}", "#define MAX_LIGHTS 32\n", 0x10);
+	EXPECT_EQ(key, acid::ShaderCache::GetKey("void main() {}", "#define MAX_LIGHTS 32\n", 0x10));
+	EXPECT_NE(key, acid::ShaderCache::GetKey("void main() {}", "#define MAX_LIGHTS 64\n", 0x10));
+	EXPECT_NE(key, acid::ShaderCache::GetKey("void main() {}", "#define MAX_LIGHTS 32\n", 0x01));
+	EXPECT_NE(key, acid::ShaderCache::GetKey("void main() { }", "#define MAX_LIGHTS 32\n", 0x10));
+}
+
+TEST(ShaderCache, includeInvalidation) {
+	acid::ShaderCache cache(CacheDirectory);
+	cache.Clear();
+
+	std::filesystem::create_directories(CacheDirectory);
+	auto includePath = CacheDirectory / "Lighting.glsl";
+	std::ofstream(includePath) << "vec3 Lighting();\n";
+
+	auto key = acid::ShaderCache::GetKey("void main() {}", "", 0x10);
+	EXPECT_FALSE(cache.Load(key));
+
+	auto entry = CreateEntry(includePath);
+	cache.Store(key, entry);
+
+	auto loaded = cache.Load(key);
+	ASSERT_TRUE(loaded);
+	EXPECT_EQ(loaded->m_spirv, entry.m_spirv);
+	EXPECT_EQ(loaded->m_reflection["uniformBlocks"]["UniformObject"]["size"].Get<int32_t>(), 64);
+	EXPECT_EQ(loaded->m_reflection["localSizes"].Get<std::vector<uint32_t>>(), (std::vector<uint32_t>{16, 16, 0}));
+
+	std::ofstream(includePath) << "vec3 Lighting(vec3 normal);\n";
+	EXPECT_FALSE(cache.Load(key));
+
+	cache.Clear();
+}
+
+TEST(ShaderCache, compileModule) {
+	std::filesystem::path filename = "Guis/Gui.frag";
+	std::ifstream stream(ShadersPath / filename);
+	ASSERT_TRUE(stream) << filename;
+	std::string source(std::istreambuf_iterator<char>(stream), {});
+
+	acid::Shader::Compiler compiler;
+	acid::ShaderCache cache(CacheDirectory);
+	cache.Clear();
+
+	// The first compile runs glslang and stores the stage, the second loads it.
+	auto compile = [&]() {
+		acid::Shader shader;
+		return shader.CompileModule(filename, source, "", acid::Shader::GetShaderStage(filename), &cache);
+	};
+
+	auto cold = compile();
+	ASSERT_FALSE(cold.empty());
+	EXPECT_TRUE(cache.Load(acid::ShaderCache::GetKey(source, "", acid::Shader::GetShaderStage(filename))));
+	EXPECT_EQ(compile(), cold);
+
+	cache.Clear();
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <Animations/SkeletalModel.hpp>
+
+#include "SkeletalModels.hpp"
+
+using acid::test::ColladaPath;
+using acid::test::ReadFile;
+
+TEST(SkeletalModel, bakedMatchesCollada) {
+	auto source = ReadFile(ColladaPath);
+	ASSERT_FALSE(source.empty());
+
+	acid::SkeletalModel collada("", false);
+	acid::test::LoadCollada(source, collada);
+	ASSERT_FALSE(collada.GetVertices().empty());
+	ASSERT_GT(collada.GetSkeleton().GetJointCount(), 0u);
+	ASSERT_TRUE(collada.GetAnimation());
+
+	auto data = collada.WriteMemory();
+	acid::SkeletalModel baked("", false);
+	ASSERT_TRUE(baked.LoadMemory(data));
+
+	EXPECT_EQ(baked.GetVertices(), collada.GetVertices());
+	EXPECT_EQ(baked.GetIndices(), collada.GetIndices());
+	EXPECT_EQ(baked.GetSkeleton().GetNames(), collada.GetSkeleton().GetNames());
+	EXPECT_EQ(baked.GetSkeleton().GetParents(), collada.GetSkeleton().GetParents());
+	EXPECT_EQ(baked.GetSkeleton().GetMatrixIndices(), collada.GetSkeleton().GetMatrixIndices());
+	EXPECT_EQ(baked.GetSkeleton().GetInverseBindTransforms(), collada.GetSkeleton().GetInverseBindTransforms());
+	EXPECT_EQ(baked.GetAnimation()->GetLength(), collada.GetAnimation()->GetLength());
+	EXPECT_EQ(baked.GetAnimation()->GetTimes(), collada.GetAnimation()->GetTimes());
+	EXPECT_EQ(baked.GetAnimation()->GetTracks(), collada.GetAnimation()->GetTracks());
+	EXPECT_EQ(baked.WriteMemory(), data);
+
+	// Truncated or foreign files are rejected.
+	EXPECT_FALSE(acid::SkeletalModel("", false).LoadMemory(std::string_view(data).substr(0, data.size() - 1)));
+	EXPECT_FALSE(acid::SkeletalModel("", false).LoadMemory(source));
+	EXPECT_FALSE(acid::SkeletalModel("", false).LoadMemory(""));
+
+	// Counts so large their lengths would overflow, and parents that are not joints.
+	auto SetValue = [](std::string &data, std::size_t offset, uint32_t value) {
+		for (std::size_t i = 0; i < 4; i++)
+			data[offset + i] = static_cast<char>(value >> 8 * i);
+	};
+
+	for (auto offset : {8, 12, 16, 20, 32}) {
+		auto corrupt = data;
+		SetValue(corrupt, offset, 0xFFFFFFFF);
+		EXPECT_FALSE(acid::SkeletalModel("", false).LoadMemory(corrupt)) << "count at " << offset;
+	}
+
+	auto corrupt = data;
+	auto parentsOffset = 40 + collada.GetVertices().size() * sizeof(acid::VertexAnimated) + collada.GetIndices().size() * sizeof(uint32_t);
+	SetValue(corrupt, parentsOffset + sizeof(int32_t), static_cast<uint32_t>(-2));
+	EXPECT_FALSE(acid::SkeletalModel("", false).LoadMemory(corrupt));
+}
+
+TEST(SkeletalModel, bake) {
+	auto baked = std::filesystem::temp_directory_path() / "Acid/SkeletalModel.skm";
+	ASSERT_TRUE(acid::SkeletalModel::Bake(ColladaPath, baked));
+	EXPECT_FALSE(acid::SkeletalModel::Bake(ColladaPath.parent_path() / "Missing.dae.json", baked));
+
+	acid::SkeletalModel collada("", false);
+	acid::test::LoadCollada(ReadFile(ColladaPath), collada);
+	EXPECT_EQ(ReadFile(baked), collada.WriteMemory());
+	std::filesystem::remove(baked);
+}
@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include <Audio/SoundStream.hpp>
+
+static const std::filesystem::path MusicPath = std::filesystem::path(__FILE__).parent_path().parent_path() / "Resources/Sounds/Music/Hiitori-Bocchi.ogg";
+
+// A sink that keeps every queued sample instead of playing it, chunks are never freed so the test controls how many are queued.
+class NullSink : public acid::SoundSink {
+public:
+	uint32_t GetFreeChunks() override {
+		return m_capacity > m_chunks ? m_capacity - m_chunks : 0;
+	}
+
+	void Queue(const int16_t *samples, uint64_t frameCount, uint32_t channels, uint32_t sampleRate) override {
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_samples.insert(m_samples.end(), samples, samples + frameCount * channels);
+		m_chunks++;
+	}
+
+	void Flush() override {
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_samples.clear();
+		m_chunks = 0;
+		m_flushes++;
+	}
+
+	std::vector<int16_t> GetSamples() {
+		std::unique_lock<std::mutex> lock(m_mutex);
+		return m_samples;
+	}
+
+	std::atomic<uint32_t> m_capacity = 0;
+	std::atomic<uint32_t> m_chunks = 0;
+	std::atomic<uint32_t> m_flushes = 0;
+
+private:
+	std::mutex m_mutex;
+	std::vector<int16_t> m_samples;
+};
+
+// Writes a 16 bit stereo wave file where the left sample of each frame is its index and the right sample is the negated index.
+static std::unique_ptr<std::istream> CreateWave(uint32_t frameCount) {
+	std::ostringstream wave;
+	auto write = [&wave](auto value) {
+		wave.write(reinterpret_cast<const char *>(&value), sizeof(value));
+	};
+
+	uint32_t dataSize = frameCount * 2 * sizeof(int16_t);
+	wave.write("RIFF", 4);
+	write(uint32_t(36 + dataSize));
+	wave.write("WAVEfmt ", 8);
+	write(uint32_t(16));
+	write(uint16_t(1));
+	write(uint16_t(2));
+	write(uint32_t(44100));
+	write(uint32_t(44100 * 2 * sizeof(int16_t)));
+	write(uint16_t(2 * sizeof(int16_t)));
+	write(uint16_t(16));
+	wave.write("data", 4);
+	write(dataSize);
+
+	for (uint32_t i = 0; i < frameCount; i++) {
+		write(static_cast<int16_t>(i % 32768));
+		write(static_cast<int16_t>(-static_cast<int32_t>(i % 32768)));
+	}
+
+	return std::make_unique<std::istringstream>(wave.str());
+}
+
+static std::vector<int16_t> ReadAll(acid::SoundDecoder &decoder) {
+	std::vector<int16_t> samples(decoder.GetFrameCount() * decoder.GetChannels());
+	samples.resize(decoder.Read(samples.data(), decoder.GetFrameCount()) * decoder.GetChannels());
+	return samples;
+}
+
+template<typename Predicate>
+static bool WaitFor(Predicate &&predicate) {
+	for (uint32_t i = 0; i < 1000 && !predicate(); i++)
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	return predicate();
+}
+
+TEST(SoundStream, decoderSeek) {
+	auto decoder = acid::SoundDecoder::Create(".wav", CreateWave(50000));
+	ASSERT_NE(decoder, nullptr);
+	EXPECT_EQ(decoder->GetChannels(), 2u);
+	EXPECT_EQ(decoder->GetSampleRate(), 44100u);
+	EXPECT_EQ(decoder->GetFrameCount(), 50000u);
+
+	auto samples = ReadAll(*decoder);
+	ASSERT_EQ(samples.size(), 100000u);
+	EXPECT_EQ(samples[2 * 40000], 40000 % 32768);
+
+	ASSERT_TRUE(decoder->Seek(12345));
+	int16_t frame[2];
+	ASSERT_EQ(decoder->Read(frame, 1), 1u);
+	EXPECT_EQ(frame[0], 12345);
+	EXPECT_EQ(frame[1], -12345);
+
+	EXPECT_EQ(acid::SoundDecoder::Create(".unknown", CreateWave(1)), nullptr);
+	EXPECT_EQ(acid::SoundDecoder::Create(".wav", std::make_unique<std::istringstream>("not a wave")), nullptr);
+}
+
+TEST(SoundStream, boundedQueue) {
+	NullSink sink;
+	acid::SoundStream stream(acid::SoundDecoder::Create(".wav", CreateWave(50000)), &sink, 4096);
+
+	// Only as many chunks as the sink has space for are decoded.
+	sink.m_capacity = 3;
+	ASSERT_TRUE(WaitFor([&]() { return sink.m_chunks == 3; }));
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	EXPECT_EQ(sink.m_chunks, 3u);
+	EXPECT_FALSE(stream.IsEnded());
+
+	auto samples = sink.GetSamples();
+	ASSERT_EQ(samples.size(), 3u * 4096 * 2);
+	for (uint32_t i = 0; i < 3 * 4096; i++)
+		ASSERT_EQ(samples[2 * i], static_cast<int16_t>(i % 32768));
+
+	// A seek flushes the sink and decodes from the new frame.
+	stream.Seek(30000);
+	ASSERT_TRUE(WaitFor([&]() { return sink.m_flushes == 1 && sink.m_chunks == 3; }));
+	EXPECT_EQ(sink.GetSamples()[0], 30000 % 32768);
+
+	// The end is reached once the sink has space for the rest.
+	sink.m_capacity = 100;
+	ASSERT_TRUE(WaitFor([&]() { return stream.IsEnded(); }));
+	EXPECT_EQ(sink.GetSamples().size(), 2u * (50000 - 30000));
+}
+
+TEST(SoundStream, loop) {
+	NullSink sink;
+	acid::SoundStream stream(acid::SoundDecoder::Create(".wav", CreateWave(5000)), &sink, 4096);
+	stream.SetLoop(true);
+	stream.Seek(0);
+
+	// Looping fills chunks across the end without a gap, so the stream never ends.
+	sink.m_capacity = 4;
+	ASSERT_TRUE(WaitFor([&]() { return sink.m_chunks == 4; }));
+	EXPECT_FALSE(stream.IsEnded());
+
+	auto samples = sink.GetSamples();
+	ASSERT_EQ(samples.size(), 4u * 4096 * 2);
+	for (uint32_t i = 0; i < 4 * 4096; i++)
+		ASSERT_EQ(samples[2 * i], static_cast<int16_t>(i % 5000));
+}
+
+TEST(SoundStream, music) {
+	// The end of the track streamed in chunks matches the same frames read at once, only the last few seconds are decoded so the test stays fast.
+	auto decoder = acid::SoundDecoder::Create(".ogg", std::make_unique<std::ifstream>(MusicPath, std::ios::binary));
+	ASSERT_NE(decoder, nullptr);
+	auto frameCount = decoder->GetFrameCount();
+	ASSERT_GT(frameCount, 100000u);
+	auto start = frameCount - 100000;
+	ASSERT_TRUE(decoder->Seek(start));
+	std::vector<int16_t> tail((frameCount - start) * decoder->GetChannels());
+	EXPECT_EQ(decoder->Read(tail.data(), frameCount - start), frameCount - start);
+
+	// Nothing is decoded until the sink has space, so the stream starts at the seek.
+	NullSink sink;
+	acid::SoundStream stream(acid::SoundDecoder::Create(".ogg", std::make_unique<std::ifstream>(MusicPath, std::ios::binary)), &sink);
+	stream.Seek(start);
+	ASSERT_TRUE(WaitFor([&]() { return sink.m_flushes == 1; }));
+	sink.m_capacity = std::numeric_limits<uint32_t>::max();
+	ASSERT_TRUE(WaitFor([&]() { return stream.IsEnded(); }));
+	EXPECT_EQ(sink.GetSamples(), tail);
+}
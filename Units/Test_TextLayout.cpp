@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <Fonts/TextLayout.hpp>
+
+#include "Fonts.hpp"
+
+static void ExpectSameGlyphs(const acid::TextLayout &a, const acid::TextLayout &b) {
+	ASSERT_EQ(a.GetGlyphs().size(), b.GetGlyphs().size());
+	for (std::size_t i = 0; i < a.GetGlyphs().size(); i++) {
+		EXPECT_EQ(a.GetGlyphs()[i].m_position, b.GetGlyphs()[i].m_position) << "glyph " << i;
+		EXPECT_EQ(a.GetGlyphs()[i].m_layer, b.GetGlyphs()[i].m_layer) << "glyph " << i;
+	}
+	EXPECT_EQ(a.GetLineCount(), b.GetLineCount());
+	EXPECT_EQ(a.GetSize(), b.GetSize());
+}
+
+TEST(TextLayout, wrapAndJustify) {
+	auto &atlas = acid::test::GetAtlas();
+	acid::TextLayout::Style style;
+	style.m_fontSize = 16.0f;
+
+	acid::TextLayout single;
+	single.Update(atlas, L"The quick brown fox jumps over the lazy dog", style);
+	EXPECT_EQ(single.GetLineCount(), 1u);
+	// Spaces are not drawn.
+	EXPECT_EQ(single.GetGlyphs().size(), 35u);
+
+	style.m_maxWidth = 0.4f * single.GetSize().m_x;
+	acid::TextLayout left;
+	left.Update(atlas, L"The quick brown fox jumps over the lazy dog", style);
+	EXPECT_GT(left.GetLineCount(), 2u);
+	EXPECT_LE(left.GetSize().m_x, style.m_maxWidth);
+	EXPECT_EQ(left.GetGlyphs().size(), single.GetGlyphs().size());
+
+	style.m_justify = acid::TextLayout::Justify::Right;
+	acid::TextLayout right;
+	right.Update(atlas, L"The quick brown fox jumps over the lazy dog", style);
+	ASSERT_EQ(right.GetGlyphs().size(), left.GetGlyphs().size());
+	for (std::size_t i = 0; i < left.GetGlyphs().size(); i++) {
+		EXPECT_GE(right.GetGlyphs()[i].m_position.m_x, left.GetGlyphs()[i].m_position.m_x);
+		EXPECT_EQ(right.GetGlyphs()[i].m_position.m_y, left.GetGlyphs()[i].m_position.m_y);
+	}
+
+	// Newlines always break, empty lines are kept.
+	style = {};
+	acid::TextLayout lines;
+	lines.Update(atlas, L"a\nb\n\nc", style);
+	EXPECT_EQ(lines.GetLineCount(), 4u);
+	EXPECT_GT(lines.GetGlyphs()[2].m_position.m_y, lines.GetGlyphs()[1].m_position.m_y);
+}
+
+TEST(TextLayout, incremental) {
+	auto &atlas = acid::test::GetAtlas();
+	acid::TextLayout::Style style;
+	style.m_fontSize = 14.0f;
+	style.m_maxWidth = 200.0f;
+	style.m_justify = acid::TextLayout::Justify::Centre;
+
+	const std::wstring before = L"Health: 100 Armour: 50 Ammo: 30 / 90\nScore: 1234567 Time: 12:59";
+	const std::wstring after = L"Health: 100 Armour: 50 Ammo: 30 / 90\nScore: 1234568 Time: 12:59";
+
+	acid::TextLayout layout;
+	layout.Update(atlas, before, style);
+	EXPECT_EQ(layout.Update(atlas, before, style), layout.GetGlyphs().size());
+
+	auto first = layout.Update(atlas, after, style);
+	EXPECT_GT(first, 0u);
+
+	acid::TextLayout full;
+	full.Update(atlas, after, style);
+	ExpectSameGlyphs(layout, full);
+
+	// Shrinking a word can pull it back onto the line before it.
+	const std::wstring shorter = L"Health: 100 Armour: 50 Ammo: 3\nScore: 1 Time: 1";
+	layout.Update(atlas, shorter, style);
+	full.Update(atlas, shorter, style);
+	ExpectSameGlyphs(layout, full);
+
+	// A new style lays out everything.
+	style.m_justify = acid::TextLayout::Justify::Fully;
+	EXPECT_EQ(layout.Update(atlas, shorter, style), 0u);
+}
+
+TEST(TextLayout, cache) {
+	auto &atlas = acid::test::GetAtlas();
+	acid::TextLayoutCache cache(2);
+	acid::TextLayout::Style style;
+
+	auto a = cache.Get(atlas, L"Frame 1", style);
+	auto b = cache.Get(atlas, L"Frame 1", style);
+	EXPECT_EQ(a, b);
+
+	// A layout shared by two texts is copied when one of them changes.
+	b = cache.Get(atlas, L"Frame 2", style, b);
+	EXPECT_NE(a, b);
+	EXPECT_EQ(a->GetString(), L"Frame 1");
+
+	// A layout only held by one text is updated in place.
+	auto previous = b.get();
+	b = cache.Get(atlas, L"Frame 3", style, b);
+	EXPECT_EQ(b.get(), previous);
+	EXPECT_EQ(b->GetString(), L"Frame 3");
+	EXPECT_EQ(cache.GetSize(), 2u);
+
+	// Layouts no text holds are removed once the cache is over capacity.
+	a = nullptr;
+	auto c = cache.Get(atlas, L"Other", style);
+	EXPECT_EQ(cache.GetSize(), 2u);
+}
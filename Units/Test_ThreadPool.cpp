@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <numeric>
+
+#include <Helpers/ThreadPool.hpp>
+
+TEST(ThreadPool, enqueue) {
+	acid::ThreadPool pool(4);
+
+	auto result = pool.Enqueue([](int32_t a, int32_t b) {
+		return a + b;
+	}, 20, 22);
+	EXPECT_EQ(result.get(), 42);
+}
+
+TEST(ThreadPool, waitForRunning) {
+	acid::ThreadPool pool(2);
+	std::atomic<uint32_t> finished = 0;
+
+	for (uint32_t i = 0; i < 8; i++) {
+		pool.Submit([&finished]() {
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+			++finished;
+		});
+	}
+
+	pool.Wait();
+	EXPECT_EQ(finished, 8u);
+}
+
+TEST(ThreadPool, parallelForReduce) {
+	acid::ThreadPool pool(4);
+	std::vector<uint64_t> values(100000);
+
+	pool.ParallelFor(0, values.size(), [&values](std::size_t i) {
+		values[i] = i;
+	});
+	EXPECT_EQ(std::accumulate(values.begin(), values.end(), uint64_t(0)), uint64_t(99999) * 100000 / 2);
+
+	auto sum = pool.ParallelReduce(0, values.size(), uint64_t(0), [&values](std::size_t i) {
+		return values[i];
+	}, std::plus<>());
+	EXPECT_EQ(sum, uint64_t(99999) * 100000 / 2);
+}
+
+TEST(ThreadPool, nestedForkJoin) {
+	acid::ThreadPool pool(4);
+	std::atomic<uint32_t> leaves = 0;
+
+	pool.ParallelFor(0, 64, [&](std::size_t) {
+		acid::JobCounter counter;
+
+		for (uint32_t i = 0; i < 64; i++) {
+			pool.Submit([&leaves]() {
+				++leaves;
+			}, &counter);
+		}
+
+		pool.Wait(counter);
+	}, 1);
+	EXPECT_EQ(leaves, 64u * 64u);
+}
+
+TEST(ThreadPool, exceptions) {
+	acid::ThreadPool pool(4);
+	std::atomic<uint32_t> finished = 0;
+
+	// Every other job still runs, and the waiter gets the exception.
+	EXPECT_THROW(pool.ParallelFor(0, 64, [&finished](std::size_t i) {
+		if (i % 16 == 3)
+			throw std::runtime_error("Job failed");
+		++finished;
+	}, 1), std::runtime_error);
+	EXPECT_EQ(finished, 60u);
+
+	pool.Submit([]() {
+		throw std::runtime_error("Job failed");
+	});
+	EXPECT_THROW(pool.Wait(), std::runtime_error);
+	EXPECT_NO_THROW(pool.Wait());
+
+	// The pool keeps working after a job has thrown.
+	EXPECT_EQ(pool.Enqueue([]() { return 42; }).get(), 42);
+}
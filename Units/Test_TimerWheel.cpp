@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include <Timers/TimerWheel.hpp>
+
+TEST(TimerWheel, dueOrder) {
+	auto start = acid::Time::Now();
+	acid::TimerWheel wheel(start);
+
+	// Delays across every level, and past the highest level.
+	std::mt19937 generator(3);
+	std::vector<std::shared_ptr<acid::Timer>> timers;
+	for (auto maxDelay : {200.0f, 60.0f * 1000.0f, 24.0f * 3600.0f * 1000.0f, 80.0f * 24.0f * 3600.0f * 1000.0f}) {
+		std::uniform_real_distribution<float> delay(1.0f, maxDelay);
+		for (uint32_t i = 0; i < 500; i++) {
+			auto &timer = timers.emplace_back(std::make_shared<acid::Timer>(acid::Time::Milliseconds(delay(generator)), 1));
+			wheel.Add(timer);
+		}
+	}
+
+	// Destroyed timers are never due.
+	for (std::size_t i = 0; i < timers.size(); i += 10)
+		timers[i]->Destroy();
+
+	std::vector<std::shared_ptr<acid::Timer>> due;
+	std::uniform_int_distribution<int64_t> step(1, 1000000);
+	auto previous = start;
+	uint32_t dueCount = 0;
+
+	for (auto time = start; wheel.GetSize() != 0; time += acid::Time::Microseconds(step(generator) * step(generator) / 1000)) {
+		wheel.Advance(time, due);
+
+		for (const auto &timer : due) {
+			EXPECT_FALSE(timer->IsDestroyed());
+			EXPECT_LE(timer->GetNext(), time);
+			EXPECT_GT(timer->GetNext() + wheel.GetResolution(), previous);
+		}
+
+		dueCount += static_cast<uint32_t>(due.size());
+		due.clear();
+		previous = time;
+	}
+
+	EXPECT_EQ(dueCount, timers.size() - timers.size() / 10);
+}
+
+TEST(TimerWheel, nextTime) {
+	auto start = acid::Time::Now();
+	acid::TimerWheel wheel(start);
+	EXPECT_FALSE(wheel.GetNextTime());
+
+	auto timer = std::make_shared<acid::Timer>(acid::Time::Seconds(2), 1);
+	wheel.Add(timer);
+
+	// The wheel is woken at least every rotation of the first level until the timer is due.
+	std::vector<std::shared_ptr<acid::Timer>> due;
+	uint32_t wakes = 0;
+	while (due.empty()) {
+		auto next = wheel.GetNextTime();
+		ASSERT_TRUE(next);
+		EXPECT_LE(*next - start, timer->GetNext() - start + wheel.GetResolution());
+		wheel.Advance(*next, due);
+		wakes++;
+	}
+
+	EXPECT_LE(wakes, 2000u / acid::TimerWheel::SlotCount + 2);
+	EXPECT_EQ(wheel.GetSize(), 0u);
+}
@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include <Timers/Timers.hpp>
+
+TEST(Timers, mainDispatch) {
+	acid::Timers timers;
+
+	// Main ticks run inside the modules update, so it has to update on the main thread and never on the update pool.
+	EXPECT_TRUE(timers.GetDependencies().exclusive);
+
+	std::atomic<std::thread::id> mainTickThread;
+	std::atomic<std::thread::id> threadTickThread;
+	std::atomic_bool mainTicked = false;
+	std::atomic_bool threadTicked = false;
+	auto mainTimer = timers.Once(acid::Time::Milliseconds(2), acid::Timer::Dispatch::Main, [&]() {
+		mainTickThread = std::this_thread::get_id();
+		mainTicked = true;
+	});
+	auto threadTimer = timers.Once(acid::Time::Milliseconds(2), [&]() {
+		threadTickThread = std::this_thread::get_id();
+		threadTicked = true;
+	});
+
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+	while (!(mainTicked && threadTicked) && std::chrono::steady_clock::now() < deadline) {
+		timers.Update();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	ASSERT_TRUE(mainTicked);
+	ASSERT_TRUE(threadTicked);
+	EXPECT_EQ(mainTickThread.load(), std::this_thread::get_id());
+	EXPECT_NE(threadTickThread.load(), std::this_thread::get_id());
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+#include <Maths/Transform.hpp>
+#include <Maths/TransformHierarchy.hpp>
+#include <Helpers/ThreadPool.hpp>
+
+#include "Matrices.hpp"
+#include "Transforms.hpp"
+
+TEST(Transform, transformationMatrix) {
+	std::mt19937 random(5);
+	std::uniform_real_distribution<float> distribution(-3.0f, 3.0f);
+
+	for (uint32_t i = 0; i < 100; i++) {
+		acid::Vector3f translation(distribution(random), distribution(random), distribution(random));
+		acid::Vector3f rotation(distribution(random), distribution(random), distribution(random));
+		acid::Vector3f scale(distribution(random), distribution(random), distribution(random));
+		acid::test::ExpectNear(acid::Matrix4::TransformationMatrix(translation, rotation, scale), acid::test::ReferenceMatrix(translation, rotation, scale), 1e-5f);
+	}
+}
+
+TEST(Transform, cachedWorldTransforms) {
+	auto transforms = acid::test::CreateHierarchy(200, 4);
+	std::vector<acid::Transform *> pointers;
+	for (const auto &transform : transforms)
+		pointers.emplace_back(transform.get());
+
+	auto expectMatches = [&]() {
+		for (const auto &transform : transforms) {
+			acid::Vector3f position, rotation, scale;
+			acid::test::ExpectNear(transform->GetWorldMatrix(), acid::test::ReferenceWorldMatrix(*transform, position, rotation, scale), 1e-3f);
+			EXPECT_NEAR((transform->GetPosition() - position).Length(), 0.0f, 1e-3f);
+			EXPECT_NEAR((transform->GetRotation() - rotation).Length(), 0.0f, 1e-4f);
+			EXPECT_NEAR((transform->GetScale() - scale).Length(), 0.0f, 1e-4f);
+		}
+	};
+
+	// Read lazily before any update pass.
+	expectMatches();
+
+	// Changes to a transform move every transform below it.
+	acid::TransformHierarchy hierarchy;
+	transforms[5]->SetLocalPosition({1.0f, 2.0f, 3.0f});
+	transforms[9]->SetLocalRotation({0.5f, 0.0f, 0.0f});
+	transforms[2]->SetLocalScale(acid::Vector3f(2.0f));
+	hierarchy.Update(pointers);
+	expectMatches();
+
+	// Every parent is before its children.
+	const auto &order = hierarchy.GetOrder();
+	ASSERT_EQ(order.size(), transforms.size());
+	for (std::size_t i = 0; i < order.size(); i++) {
+		if (auto parent = order[i]->GetParent()) {
+			EXPECT_LT(std::find(order.begin(), order.end(), parent) - order.begin(), static_cast<std::ptrdiff_t>(i));
+		}
+	}
+
+	// Moving after the rotation changed, and then only moving, which keeps the rotation of the last calculation.
+	transforms[9]->SetLocalPosition({0.0f, 0.0f, 4.0f});
+	hierarchy.Update(pointers);
+	expectMatches();
+	transforms[9]->SetLocalRotation({0.0f, 0.5f, 0.0f});
+	hierarchy.Update(pointers);
+	expectMatches();
+
+	// Moving a subtree to another parent rebuilds the order.
+	transforms[13]->SetParent(transforms[150].get());
+	acid::ThreadPool pool;
+	hierarchy.Update(pointers, &pool);
+	expectMatches();
+
+	*transforms[0] *= acid::Transform({0.0f, 1.0f, 0.0f});
+	expectMatches();
+
+	// Assigning only sets the local values, and a copy is not in the hierarchy.
+	auto parent = transforms[20]->GetParent();
+	auto children = transforms[20]->GetChildren();
+	*transforms[20] = acid::Transform({1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.5f});
+	EXPECT_EQ(transforms[20]->GetParent(), parent);
+	EXPECT_EQ(transforms[20]->GetChildren(), children);
+	{
+		acid::Transform copy(*transforms[20]);
+		EXPECT_EQ(copy, *transforms[20]);
+		EXPECT_EQ(copy.GetParent(), nullptr);
+		EXPECT_TRUE(copy.GetChildren().empty());
+	}
+	EXPECT_EQ(transforms[20]->GetChildren(), children);
+	hierarchy.Update(pointers, &pool);
+	expectMatches();
+
+	// Children of a destroyed transform become roots.
+	transforms[1].reset();
+	pointers.clear();
+	for (const auto &transform : transforms) {
+		if (transform)
+			pointers.emplace_back(transform.get());
+	}
+
+	hierarchy.Update(pointers, &pool);
+	EXPECT_EQ(hierarchy.GetOrder().size(), pointers.size());
+	for (const auto &transform : pointers) {
+		if (!transform->GetParent()) {
+			EXPECT_EQ(transform->GetPosition(), transform->GetLocalPosition());
+		}
+	}
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include <Files/Xml/Xml.hpp>
+#include <Files/Xml/XmlReader.hpp>
+
+#include "Documents.hpp"
+
+TEST(Xml, parse) {
+	acid::Xml xml("root");
+	xml.ParseString(R"(<?xml version="1.0"?>
+<!DOCTYPE ui [<!ENTITY test "<>">]>
+<ui version='2'>
+	<!-- A comment with <tags> -->
+	<button id="ok" text="&quot;Ok&quot; &amp; close"/>
+	<label>Caf&#233; &#x263A; &unknown; a&amp;b</label>
+	<script><![CDATA[if (a < b) {}]]></script>
+	<empty></empty>
+</ui>)");
+
+	EXPECT_EQ(xml.GetName(), "ui");
+	EXPECT_EQ(xml["_version"].Get<int32_t>(), 2);
+	EXPECT_EQ(xml["button"]["_id"].Get<std::string>(), "ok");
+	EXPECT_EQ(xml["button"]["_text"].Get<std::string>(), "\"Ok\" & close");
+	EXPECT_EQ(xml["label"]->GetValue(), "Caf\xc3\xa9 \xe2\x98\xba &unknown; a&b");
+	EXPECT_EQ(xml["script"]->GetValue(), "if (a < b) {}");
+	EXPECT_EQ(xml["empty"]->GetType(), acid::Node::Type::Null);
+	EXPECT_EQ(xml.GetType(), acid::Node::Type::Object);
+
+	EXPECT_THROW(acid::Xml("root").ParseString(""), std::runtime_error);
+	EXPECT_THROW(acid::Xml("root").ParseString("<a><b></a>"), std::runtime_error);
+	EXPECT_THROW(acid::Xml("root").ParseString("<a><b>"), std::runtime_error);
+	EXPECT_THROW(acid::Xml("root").ParseString("<a x=1/>"), std::runtime_error);
+	EXPECT_THROW(acid::Xml("root").ParseString("<a/><b/>"), std::runtime_error);
+	EXPECT_THROW(acid::Xml("root").ParseString("<a/>text"), std::runtime_error);
+}
+
+TEST(Xml, reader) {
+	auto source = acid::test::CreateXmlDocument(3);
+	acid::XmlReader reader(source);
+
+	ASSERT_EQ(reader.Next(), acid::XmlReader::Event::StartElement);
+	EXPECT_EQ(reader.GetName(), "level");
+	EXPECT_EQ(reader.GetAttributes().front().m_value, "Test &amp; Benchmark");
+	EXPECT_EQ(reader.GetAttribute("name"), "Test & Benchmark");
+	EXPECT_EQ(reader.GetAttribute("missing", "fallback"), "fallback");
+
+	uint32_t entities = 0, positions = 0, texts = 0;
+	std::size_t maxDepth = 0;
+
+	for (auto event = reader.Next(); event != acid::XmlReader::Event::EndDocument; event = reader.Next()) {
+		maxDepth = std::max(maxDepth, reader.GetDepth());
+
+		if (event == acid::XmlReader::Event::StartElement && reader.GetName() == "entity") {
+			EXPECT_EQ(reader.GetAttribute("id"), std::to_string(entities));
+			entities++;
+		} else if (event == acid::XmlReader::Event::EndElement && reader.GetName() == "position") {
+			positions++;
+		} else if (event == acid::XmlReader::Event::Text) {
+			texts++;
+		}
+	}
+
+	EXPECT_EQ(entities, 3u);
+	EXPECT_EQ(positions, 3u);
+	EXPECT_EQ(texts, 6u);
+	EXPECT_EQ(maxDepth, 3u);
+	EXPECT_EQ(reader.GetDepth(), 0u);
+}
+
+TEST(Xml, roundTrip) {
+	acid::Node node;
+	node["_version"] = 3;
+	node["name"] = "Tom & \"Jerry\" <3";
+	node["window"]["_title"] = "A <b> & \"c\"";
+	node["window"]["width"] = 1080;
+	node["window"]["fullscreen"] = false;
+	node["window"]["position"]["x"] = 0.25f;
+	node["window"]["position"]["y"] = -4;
+	node["empty"]["_unused"] = "";
+
+	for (auto format : {acid::Node::Format::Minified, acid::Node::Format::Beautified}) {
+		auto written = acid::Xml("root", node).WriteString(format);
+
+		acid::Xml parsed("root");
+		parsed.ParseString(written);
+		EXPECT_EQ(parsed.WriteString(format), written);
+		EXPECT_EQ(parsed["name"].Get<std::string>(), "Tom & \"Jerry\" <3");
+		EXPECT_EQ(parsed["window"]["_title"].Get<std::string>(), "A <b> & \"c\"");
+		EXPECT_EQ(parsed["window"]["position"]["y"].Get<int32_t>(), -4);
+	}
+
+	// Streamed with a small chunk size, so tags, text and entities are split between reads.
+	auto source = acid::test::CreateXmlDocument(2000);
+	acid::Xml xml("root");
+	xml.ParseString(source);
+
+	for (std::size_t chunkSize : {1, 7, 4096}) {
+		std::istringstream stream(source);
+		acid::XmlReader reader(stream, chunkSize);
+		acid::Xml streamed("root");
+		streamed.Parse(reader);
+		EXPECT_EQ(streamed.WriteString(), xml.WriteString());
+	}
+
+	std::istringstream stream(source);
+	acid::Xml streamed("root");
+	streamed.ParseStream(stream);
+	EXPECT_EQ(streamed.WriteString(), xml.WriteString());
+	EXPECT_EQ(streamed.GetProperties().size(), 2001u);
+	EXPECT_EQ(streamed.GetProperties()[1999]["tag"]->GetValue(), "Tree <" + std::to_string(1998 % 3) + ">");
+}
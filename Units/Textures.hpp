@@ -0,0 +1,66 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <Bitmaps/Bitmap.hpp>
+
+namespace acid::test {
+/**
+ * Creates RGBA8 pixels of smooth gradients with a little noise, they compress like real textures do.
+ * @param size The size in pixels.
+ * @param seed The seed of the noise, different seeds give different textures.
+ * @return The pixels, rows are tightly packed.
+ */
+inline std::vector<uint8_t> CreateTexture(const Vector2ui &size, uint32_t seed) {
+	std::vector<uint8_t> pixels(4 * size.m_x * size.m_y);
+
+	for (uint32_t y = 0; y < size.m_y; y++) {
+		for (uint32_t x = 0; x < size.m_x; x++) {
+			auto pixel = &pixels[4 * (y * size.m_x + x)];
+			seed = seed * 1664525 + 1013904223;
+			pixel[0] = static_cast<uint8_t>(2 * x + (seed >> 29));
+			pixel[1] = static_cast<uint8_t>(3 * y + (seed >> 28 & 1));
+			pixel[2] = static_cast<uint8_t>(x + y);
+			pixel[3] = static_cast<uint8_t>(255 - x / 4);
+		}
+	}
+
+	return pixels;
+}
+
+/**
+ * Creates a square bitmap of a texture.
+ * @param size The width and height in pixels.
+ * @param seed The seed of the noise.
+ * @return The bitmap.
+ */
+inline std::unique_ptr<Bitmap> CreateBitmap(uint32_t size, uint32_t seed) {
+	auto bitmap = std::make_unique<Bitmap>(Vector2ui(size, size));
+	auto pixels = CreateTexture(bitmap->GetSize(), seed);
+	std::copy(pixels.begin(), pixels.end(), bitmap->GetData().get());
+	return bitmap;
+}
+
+/**
+ * Gets the root mean square error between two sets of RGBA8 pixels.
+ * @param a The first pixels.
+ * @param b The second pixels.
+ * @param channels The mask of channels that are compared, red is the lowest bit.
+ * @return The error.
+ */
+inline double RmsError(const std::vector<uint8_t> &a, const std::vector<uint8_t> &b, uint32_t channels) {
+	double sum = 0.0;
+	std::size_t count = 0;
+	for (std::size_t i = 0; i < a.size(); i++) {
+		if (channels >> i % 4 & 1) {
+			sum += (a[i] - b[i]) * (a[i] - b[i]);
+			count++;
+		}
+	}
+	return std::sqrt(sum / count);
+}
+}
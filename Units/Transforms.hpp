@@ -0,0 +1,55 @@
+#pragma once
+
+#include <memory>
+#include <random>
+
+#include <Maths/Transform.hpp>
+
+namespace acid::test {
+// The matrix TransformationMatrix built before it was calculated directly.
+inline Matrix4 ReferenceMatrix(const Vector3f &translation, const Vector3f &rotation, const Vector3f &scale) {
+	Matrix4 result;
+	result = result.Translate(translation);
+	result = result.Rotate(rotation.m_x, Vector3f::Right);
+	result = result.Rotate(rotation.m_y, Vector3f::Up);
+	result = result.Rotate(rotation.m_z, Vector3f::Front);
+	result = result.Scale(scale);
+	return result;
+}
+
+// How Transform calculated its world matrix before it was cached, walking up every parent on each call.
+inline Matrix4 ReferenceWorldMatrix(const Transform &transform, Vector3f &position, Vector3f &rotation, Vector3f &scale) {
+	position = transform.GetLocalPosition();
+	rotation = transform.GetLocalRotation();
+	scale = transform.GetLocalScale();
+
+	if (auto parent = transform.GetParent()) {
+		Vector3f parentPosition, parentRotation, parentScale;
+		auto parentMatrix = ReferenceWorldMatrix(*parent, parentPosition, parentRotation, parentScale);
+		position = Vector3f(parentMatrix.Transform(Vector4f(position)));
+		rotation = parentRotation + rotation;
+		scale = parentScale * scale;
+	}
+
+	return ReferenceMatrix(position, rotation, scale);
+}
+
+// Roots with binary trees below them, so hierarchies are deep and have many subtrees.
+inline std::vector<std::unique_ptr<Transform>> CreateHierarchy(std::size_t count, std::size_t rootCount) {
+	std::mt19937 random(3);
+	std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+	std::vector<std::unique_ptr<Transform>> transforms;
+	transforms.reserve(count);
+
+	for (std::size_t i = 0; i < count; i++) {
+		transforms.emplace_back(std::make_unique<Transform>(Vector3f(distribution(random), distribution(random), distribution(random)),
+			Vector3f(distribution(random), distribution(random), distribution(random)) * 0.2f, Vector3f(1.0f + 0.01f * distribution(random))));
+
+		auto tree = i % rootCount, index = i / rootCount;
+		if (index > 0)
+			transforms[i]->SetParent(transforms[tree + (index - 1) / 2 * rootCount].get());
+	}
+
+	return transforms;
+}
+}